@@ -44,6 +44,7 @@ public class SkywalkerActivity extends QtActivity {
     public static native void emitShowNotifications();
     public static native void emitShowDirectMessages();
     public static native void emitShowLink(String uri);
+    public static native void emitTrimMemory(int level);
 
     private boolean mIsIntentPending = false;
     private boolean mIsReady = false;
@@ -87,6 +88,19 @@ public class SkywalkerActivity extends QtActivity {
         NewMessageNotifier.clearNotifications();
     }
 
+    @Override
+    public void onTrimMemory(int level) {
+        Log.d(LOGTAG, "onTrimMemory: " + level);
+        super.onTrimMemory(level);
+
+        // The native callbacks are registered once the app is initialized.
+        try {
+            emitTrimMemory(level);
+        } catch (UnsatisfiedLinkError e) {
+            Log.w(LOGTAG, "Cannot trim memory yet: " + e.getMessage());
+        }
+    }
+
     @Override
     public void onNewIntent(Intent intent) {
         super.onNewIntent(intent);
@@ -2,8 +2,10 @@
 // License: GPLv3
 #include "atproto_image_provider.h"
 #include "font_downloader.h"
+#include "media_cache.h"
 #include "shared_image_provider.h"
 #include "skywalker.h"
+#include "startup_tracer.h"
 #include "temp_file_holder.h"
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
@@ -23,10 +25,16 @@ int main(int argc, char *argv[])
     app.setOrganizationName(Skywalker::Skywalker::APP_NAME);
     app.setApplicationName(Skywalker::Skywalker::APP_NAME);
 
+    Skywalker::StartupTracer::initFromEnvironment();
     Skywalker::TempFileHolder::init();
     Skywalker::FontDownloader::initAppFonts();
 
+    // Images load through the media cache, such that prefetched media are
+    // taken from memory.
+    Skywalker::MediaCache::instance().registerWithMemoryBudget();
+    Skywalker::MediaNetworkAccessManagerFactory networkFactory;
     QQmlApplicationEngine engine;
+    engine.setNetworkAccessManagerFactory(&networkFactory);
     auto* providerId = Skywalker::SharedImageProvider::SHARED_IMAGE;
     engine.addImageProvider(providerId, Skywalker::SharedImageProvider::getProvider(providerId));
     providerId = Skywalker::ATProtoImageProvider::DRAFT_IMAGE;
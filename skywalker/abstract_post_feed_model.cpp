@@ -915,122 +915,120 @@ void AbstractPostFeedModel::beginInsertRowsPhysical(int firstPhysicalIndex, int
 
 void AbstractPostFeedModel::postIndexedSecondsAgoChanged()
 {
-    changeData({ int(Role::PostIndexedSecondsAgo) });
+    changePostData({ int(Role::PostIndexedSecondsAgo) });
 }
 
-// For a change on a single post a single row change would be sufficient.
-// However the model may have changed while waiting for a confirmation from the
-// network about the change, so we don't know which row this CID is anymore.
-// Also for reposts a CID may apply to multiple rows. Therefor all rows
-// are marked as change. Performance seems not an issue.
+// The model may have changed while waiting for a confirmation from the network
+// about the change, and for reposts a CID may apply to multiple rows. Therefor
+// the rows of the changed CIDs are looked up when the change is signalled.
 void AbstractPostFeedModel::likeCountChanged()
 {
-    changeData({ int(Role::PostLikeCount) });
+    changePostData({ int(Role::PostLikeCount) });
 }
 
 void AbstractPostFeedModel::likeUriChanged()
 {
-    changeData({ int(Role::PostLikeUri) });
+    changePostData({ int(Role::PostLikeUri) });
 }
 
 void AbstractPostFeedModel::likeTransientChanged()
 {
-    changeData({ int(Role::PostLikeTransient) });
+    changePostData({ int(Role::PostLikeTransient) });
 }
 
 void AbstractPostFeedModel::replyCountChanged()
 {
-    changeData({ int(Role::PostReplyCount) });
+    changePostData({ int(Role::PostReplyCount) });
 }
 
 void AbstractPostFeedModel::repostCountChanged()
 {
-    changeData({ int(Role::PostRepostCount) });
+    changePostData({ int(Role::PostRepostCount) });
 }
 
 void AbstractPostFeedModel::quoteCountChanged()
 {
-    changeData({ int(Role::PostQuoteCount) });
+    changePostData({ int(Role::PostQuoteCount) });
 }
 
 void AbstractPostFeedModel::repostUriChanged()
 {
-    changeData({ int(Role::PostRepostUri), int(Role::PostLocallyDeleted) });
+    changePostData({ int(Role::PostRepostUri), int(Role::PostLocallyDeleted) });
 }
 
 void AbstractPostFeedModel::threadgateUriChanged()
 {
-    changeData({ int(Role::PostThreadgateUri) });
+    changePostData({ int(Role::PostThreadgateUri) });
 }
 
 void AbstractPostFeedModel::replyRestrictionChanged()
 {
-    changeData({ int(Role::PostReplyRestriction) });
+    changePostData({ int(Role::PostReplyRestriction) });
 }
 
 void AbstractPostFeedModel::replyRestrictionListsChanged()
 {
-    changeData({ int(Role::PostReplyRestrictionLists) });
+    changePostData({ int(Role::PostReplyRestrictionLists) });
 }
 
 void AbstractPostFeedModel::hiddenRepliesChanged()
 {
-    changeData({ int(Role::PostHiddenReplies), int(Role::PostIsHiddenReply) });
+    changePostData({ int(Role::PostHiddenReplies), int(Role::PostIsHiddenReply) });
 }
 
 void AbstractPostFeedModel::threadMutedChanged()
 {
-    changeData({ int(Role::PostThreadMuted) });
+    changePostData({ int(Role::PostThreadMuted) });
 }
 
 void AbstractPostFeedModel::detachedRecordChanged()
 {
-    changeData({ int(Role::PostRecord), int(Role::PostRecordWithMedia) });
+    changePostData({ int(Role::PostRecord), int(Role::PostRecordWithMedia) });
 }
 
 void AbstractPostFeedModel::reAttachedRecordChanged()
 {
-    changeData({ int(Role::PostRecord), int(Role::PostRecordWithMedia) });
+    changePostData({ int(Role::PostRecord), int(Role::PostRecordWithMedia) });
 }
 
 void AbstractPostFeedModel::viewerStatePinnedChanged()
 {
-    changeData({ int(Role::PostViewerStatePinned) });
+    changePostData({ int(Role::PostViewerStatePinned) });
 }
 
 void AbstractPostFeedModel::postDeletedChanged()
 {
-    changeData({ int(Role::PostLocallyDeleted) });
+    changePostData({ int(Role::PostLocallyDeleted) });
 }
 
 void AbstractPostFeedModel::profileChanged()
 {
-    changeData({ int(Role::Author), int(Role::PostReplyToAuthor), int(Role::PostRepostedByAuthor) });
+    changeProfileData({ int(Role::Author), int(Role::PostReplyToAuthor), int(Role::PostRepostedByAuthor) });
 }
 
 void AbstractPostFeedModel::locallyBlockedChanged()
 {
-    changeData({ int(Role::PostBlocked), int(Role::PostLocallyDeleted) });
+    changeProfileData({ int(Role::PostBlocked), int(Role::PostLocallyDeleted) });
 }
 
 void AbstractPostFeedModel::bookmarkedChanged()
 {
-    changeData({ int(Role::PostBookmarked) });
+    changePostData({ int(Role::PostBookmarked) });
 }
 
 void AbstractPostFeedModel::bookmarkTransientChanged()
 {
-    changeData({ int(Role::PostBookmarkTransient) });
+    changePostData({ int(Role::PostBookmarkTransient) });
 }
 
 void AbstractPostFeedModel::feedbackChanged()
 {
-    changeData({ int(Role::PostFeedback) });
+    changePostData({ int(Role::PostFeedback) });
 }
 
 void AbstractPostFeedModel::feedbackTransientChanged()
 {
-    changeData({ int(Role::PostFeedbackTransient) });
+    changePostData({ int(Role::PostFeedbackTransient) });
 }
 
 void AbstractPostFeedModel::changeData(const QList<int>& roles)
@@ -1038,6 +1036,68 @@ void AbstractPostFeedModel::changeData(const QList<int>& roles)
     emit dataChanged(createIndex(0, 0), createIndex(mFeed.size() - 1, 0), roles);
 }
 
+void AbstractPostFeedModel::changeRowRanges(const std::vector<int>& rows, const QList<int>& roles)
+{
+    forEachRowRange(rows, [this, &roles](int first, int last){
+        emit dataChanged(createIndex(first, 0), createIndex(last, 0), roles);
+    });
+}
+
+void AbstractPostFeedModel::changePostData(const QList<int>& roles)
+{
+    const auto& keys = getChangedPostKeys();
+
+    if (keys.isAll())
+    {
+        changeData(roles);
+        return;
+    }
+
+    // Thread mute changes are keyed by URI, all other changes by CID. Root
+    // changes affect the threadgate and thread mute roles of replies.
+    std::vector<int> rows;
+
+    for (int i = 0; i < (int)mFeed.size(); ++i)
+    {
+        const Post& post = mFeed[i];
+
+        if (keys.contains(post.getCid()) || keys.contains(post.getUri()) ||
+            keys.contains(post.getReplyRootCid()) || keys.contains(post.getReplyRootUri()))
+        {
+            rows.push_back(toVisibleIndex(i));
+        }
+    }
+
+    changeRowRanges(rows, roles);
+}
+
+void AbstractPostFeedModel::changeProfileData(const QList<int>& roles)
+{
+    const auto& dids = getChangedProfileDids();
+
+    if (dids.isAll())
+    {
+        changeData(roles);
+        return;
+    }
+
+    std::vector<int> rows;
+
+    for (int i = 0; i < (int)mFeed.size(); ++i)
+    {
+        const Post& post = mFeed[i];
+        const auto repostedBy = post.getRepostedBy();
+
+        if (dids.contains(post.getAuthor().getDid()) || dids.contains(post.getReplyToAuthorDid()) ||
+            (repostedBy && dids.contains(repostedBy->getDid())))
+        {
+            rows.push_back(toVisibleIndex(i));
+        }
+    }
+
+    changeRowRanges(rows, roles);
+}
+
 // Easier would be to do this:
 //
 // changeData({ int(Role::PostIsThread), int(Role::PostRecord), int(Role::PostRecordWithMedia) });
@@ -1045,7 +1105,7 @@ void AbstractPostFeedModel::changeData(const QList<int>& roles)
 // However the code below is faster as it will not trigger a redraw of all posts.
 void AbstractPostFeedModel::postIsThreadChanged(const QString& postUri)
 {
-    const bool* isThread = PostThreadCache::instance().getIsThread(postUri);
+    const auto isThread = PostThreadCache::instance().getIsThread(postUri);
 
     // If the post is not a thread, then model assumed correctly it is not a thread,
     // so no change in the GUI.
@@ -1113,7 +1173,7 @@ void AbstractPostFeedModel::authorAdded(const QString& did)
 
 void AbstractPostFeedModel::labelerAdded(const QString& did)
 {
-    const auto* profile = AuthorCache::instance().get(did);
+    const auto profile = AuthorCache::instance().get(did);
 
     if (profile && profile->getAssociated().isLabeler())
         changeData({ int(Role::PostContentLabeler), int(Role::PostRecord), int(Role::PostRecordWithMedia) });
@@ -1160,7 +1220,7 @@ BasicProfile AbstractPostFeedModel::getContentLabeler(QEnums::ContentVisibility
     if (labelerDid.isEmpty())
         return {};
 
-    const BasicProfile* profile = AuthorCache::instance().get(labelerDid);
+    const auto profile = AuthorCache::instance().get(labelerDid);
 
     if (profile)
         return *profile;
@@ -238,6 +238,11 @@ protected:
 
     void changeData(const QList<int>& roles) override;
 
+    // Signal a local change only for the rows of the changed posts or profiles.
+    void changePostData(const QList<int>& roles);
+    void changeProfileData(const QList<int>& roles);
+    void changeRowRanges(const std::vector<int>& rows, const QList<int>& roles);
+
     using TimelineFeed = std::deque<Post>;
     TimelineFeed mFeed;
     bool mReverseFeed = false;
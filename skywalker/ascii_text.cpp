@@ -0,0 +1,220 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "ascii_text.h"
+#include <array>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Skywalker {
+
+namespace {
+
+// Word break classes (UAX #29) of the ASCII characters.
+enum class CharClass : quint8
+{
+    OTHER,
+    LETTER,
+    DIGIT,
+    EXTEND_NUM_LET,
+    MID_LETTER,
+    MID_LETTER_NUM, // MidNumLet, Single_Quote
+    MID_NUM
+};
+
+constexpr std::array<CharClass, 128> CHAR_CLASSES = []{
+    std::array<CharClass, 128> classes{};
+
+    for (int c = 'a'; c <= 'z'; ++c)
+        classes[c] = CharClass::LETTER;
+
+    for (int c = 'A'; c <= 'Z'; ++c)
+        classes[c] = CharClass::LETTER;
+
+    for (int c = '0'; c <= '9'; ++c)
+        classes[c] = CharClass::DIGIT;
+
+    classes['.'] = CharClass::MID_LETTER_NUM;
+    classes['\''] = CharClass::MID_LETTER_NUM;
+    classes[','] = CharClass::MID_NUM;
+    classes[';'] = CharClass::MID_NUM;
+    classes[':'] = CharClass::MID_LETTER;
+    classes['_'] = CharClass::EXTEND_NUM_LET;
+    return classes;
+}();
+
+constexpr char16_t ASCII_END = 0x80;
+constexpr qsizetype CHUNK_SIZE = 8; // UTF-16 code units in 128 bits
+
+// Letters, digits and ExtendNumLet do not break between each other (WB5,
+// WB8, WB9, WB10, WB13a, WB13b).
+bool isWordChar(CharClass cls)
+{
+    return cls == CharClass::LETTER || cls == CharClass::DIGIT || cls == CharClass::EXTEND_NUM_LET;
+}
+
+// A mid character does not break between letters (WB6, WB7) or digits (WB11,
+// WB12).
+bool joinsMid(CharClass prevCls, CharClass midCls, CharClass nextCls)
+{
+    switch (midCls)
+    {
+    case CharClass::MID_LETTER:
+        return prevCls == CharClass::LETTER && nextCls == CharClass::LETTER;
+    case CharClass::MID_NUM:
+        return prevCls == CharClass::DIGIT && nextCls == CharClass::DIGIT;
+    case CharClass::MID_LETTER_NUM:
+        return (prevCls == CharClass::LETTER && nextCls == CharClass::LETTER) ||
+               (prevCls == CharClass::DIGIT && nextCls == CharClass::DIGIT);
+    default:
+        return false;
+    }
+}
+
+// Returns true if all code units in the chunk are ASCII.
+bool isAsciiChunk(const char16_t* chars)
+{
+#if defined(__SSE2__)
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+    const __m128i nonAscii = _mm_and_si128(chunk, _mm_set1_epi16(static_cast<short>(0xFF80)));
+    return _mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) == 0xFFFF;
+#elif defined(__ARM_NEON)
+    const uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(chars));
+    const uint64x2_t nonAscii = vreinterpretq_u64_u16(vcgeq_u16(chunk, vdupq_n_u16(ASCII_END)));
+    return (vgetq_lane_u64(nonAscii, 0) | vgetq_lane_u64(nonAscii, 1)) == 0;
+#else
+    for (qsizetype i = 0; i < CHUNK_SIZE; ++i)
+    {
+        if (chars[i] >= ASCII_END)
+            return false;
+    }
+
+    return true;
+#endif
+}
+
+// Converts a chunk of ASCII code units to lower case.
+void toLowerChunk(const char16_t* chars, char16_t* lower)
+{
+#if defined(__SSE2__)
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+    const __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi16(chunk, _mm_set1_epi16('A' - 1)),
+                                          _mm_cmplt_epi16(chunk, _mm_set1_epi16('Z' + 1)));
+    const __m128i result = _mm_or_si128(chunk, _mm_and_si128(isUpper, _mm_set1_epi16(0x20)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lower), result);
+#elif defined(__ARM_NEON)
+    const uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(chars));
+    const uint16x8_t isUpper = vandq_u16(vcgeq_u16(chunk, vdupq_n_u16('A')),
+                                         vcleq_u16(chunk, vdupq_n_u16('Z')));
+    const uint16x8_t result = vorrq_u16(chunk, vandq_u16(isUpper, vdupq_n_u16(0x20)));
+    vst1q_u16(reinterpret_cast<uint16_t*>(lower), result);
+#else
+    for (qsizetype i = 0; i < CHUNK_SIZE; ++i)
+        lower[i] = (chars[i] >= 'A' && chars[i] <= 'Z') ? chars[i] | 0x20 : chars[i];
+#endif
+}
+
+}
+
+bool AsciiText::isAscii(QStringView text)
+{
+    const char16_t* chars = text.utf16();
+    const qsizetype size = text.size();
+    qsizetype i = 0;
+
+    for (; i + CHUNK_SIZE <= size; i += CHUNK_SIZE)
+    {
+        if (!isAsciiChunk(chars + i))
+            return false;
+    }
+
+    for (; i < size; ++i)
+    {
+        if (chars[i] >= ASCII_END)
+            return false;
+    }
+
+    return true;
+}
+
+bool AsciiText::toLower(QStringView text, QString& lower)
+{
+    const char16_t* chars = text.utf16();
+    const qsizetype size = text.size();
+    lower.resize(size);
+    char16_t* lowerChars = reinterpret_cast<char16_t*>(lower.data());
+    qsizetype i = 0;
+
+    for (; i + CHUNK_SIZE <= size; i += CHUNK_SIZE)
+    {
+        if (!isAsciiChunk(chars + i))
+            return false;
+
+        toLowerChunk(chars + i, lowerChars + i);
+    }
+
+    for (; i < size; ++i)
+    {
+        const char16_t c = chars[i];
+
+        if (c >= ASCII_END)
+            return false;
+
+        lowerChars[i] = (c >= 'A' && c <= 'Z') ? c | 0x20 : c;
+    }
+
+    return true;
+}
+
+bool AsciiText::getWords(QStringView text, std::vector<QStringView>& words)
+{
+    words.clear();
+
+    if (!isAscii(text))
+        return false;
+
+    const char16_t* chars = text.utf16();
+    const qsizetype size = text.size();
+    qsizetype i = 0;
+
+    while (i < size)
+    {
+        const CharClass cls = CHAR_CLASSES[chars[i]];
+
+        if (!isWordChar(cls))
+        {
+            ++i;
+            continue;
+        }
+
+        const qsizetype start = i++;
+
+        while (i < size)
+        {
+            const CharClass nextCls = CHAR_CLASSES[chars[i]];
+
+            if (isWordChar(nextCls))
+            {
+                ++i;
+                continue;
+            }
+
+            if (i + 1 < size && joinsMid(CHAR_CLASSES[chars[i - 1]], nextCls, CHAR_CLASSES[chars[i + 1]]))
+            {
+                i += 2;
+                continue;
+            }
+
+            break;
+        }
+
+        words.push_back(text.sliced(start, i - start));
+    }
+
+    return true;
+}
+
+}
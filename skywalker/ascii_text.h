@@ -0,0 +1,31 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QString>
+#include <QStringView>
+#include <vector>
+
+namespace Skywalker {
+
+// Fast paths for text that is all ASCII, which is most post text. The scans
+// process 8 UTF-16 code units at a time with SSE2 or NEON when available.
+class AsciiText
+{
+public:
+    static bool isAscii(QStringView text);
+
+    // Sets lower to the lower case version of text. Returns false, with lower
+    // undefined, if text is not all ASCII.
+    static bool toLower(QStringView text, QString& lower);
+
+    // Splits text into words following the Unicode word boundary rules
+    // (UAX #29) as QTextBoundaryFinder does. The words are views on text, no
+    // strings are allocated. The words vector is cleared first, such that it
+    // can be reused as arena.
+    //
+    // A word starts with a letter, digit or underscore. Returns false if the
+    // text is not all ASCII. The words are undefined then.
+    static bool getWords(QStringView text, std::vector<QStringView>& words);
+};
+
+}
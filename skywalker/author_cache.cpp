@@ -8,15 +8,21 @@ using namespace std::chrono_literals;
 
 std::unique_ptr<AuthorCache> AuthorCache::sInstance;
 
-AuthorCache::Entry::Entry(const BasicProfile& profile) :
-    mAuthor(profile)
+AuthorCache::AuthorCache(QObject* parent) :
+    WrappedSkywalker(parent),
+    mCache("AuthorCache", 0, &AuthorCache::getCost,
+           [](const BasicProfile& author){ return author.getWithViewerCost(); },
+           [](const BasicProfile& author, const BasicProfile& viewerSource){ return author.withViewer(viewerSource.getViewer()); },
+           [](const BasicProfile& author){ return author.getViewer().isValid(); },
+           BUDGET_WEIGHT)
 {
 }
 
-AuthorCache::AuthorCache(QObject* parent) :
-    WrappedSkywalker(parent),
-    mCache(1000)
+qsizetype AuthorCache::getCost(const QString& did, const BasicProfile& author)
 {
+    return sizeof(BasicProfile) + CacheCost::string(did) + CacheCost::string(author.getHandle()) +
+           CacheCost::string(author.getDisplayName()) + CacheCost::string(author.getPronouns()) +
+           CacheCost::string(author.getAvatarUrl());
 }
 
 void AuthorCache::clear()
@@ -24,22 +30,20 @@ void AuthorCache::clear()
     mCache.clear();
 }
 
-void AuthorCache::put(const BasicProfile& author)
+void AuthorCache::put(const BasicProfile& author, const QString& viewerDid)
 {
     const QString& did = author.getDid();
     Q_ASSERT(!did.isEmpty());
     if (did.isEmpty())
         return;
 
-    if (did == mUser.getDid())
+    if (did == mUser->getDid())
         return;
 
-    const auto* profile = getFromStores(did);
-    if (profile)
+    if (getFromStores(did))
         return;
 
-    auto* entry = new Entry(author);
-    mCache.insert(did, entry);
+    mCache.put(did, author, viewerDid);
 }
 
 void AuthorCache::putProfile(const QString& did, const std::function<void()>& addedCb)
@@ -58,11 +62,12 @@ void AuthorCache::putProfile(const QString& did, const std::function<void()>& ad
 
     mFetchingDids.insert(did);
 
+    // The viewer may switch while the request is in progress.
     bskyClient()->getProfile(did,
-        [this, addedCb](auto profile){
+        [this, addedCb, viewerDid=mCache.getViewer()](auto profile){
             mFetchingDids.erase(profile->mDid);
             mFailedDids.erase(profile->mDid);
-            put(BasicProfile(profile));
+            put(BasicProfile(profile), viewerDid);
             emit profileAdded(profile->mDid);
 
             if (addedCb)
@@ -84,17 +89,16 @@ void AuthorCache::putProfile(const QString& did, const std::function<void()>& ad
         });
 }
 
-const BasicProfile* AuthorCache::get(const QString& did) const
+std::shared_ptr<const BasicProfile> AuthorCache::get(const QString& did) const
 {
-    if (did == mUser.getDid())
-        return &mUser;
+    if (did == mUser->getDid())
+        return mUser;
 
-    const auto* profile = getFromStores(did);
+    auto profile = getFromStores(did);
     if (profile)
         return profile;
 
-    auto* entry = mCache[did];
-    return entry ? &entry->getAuthor() : nullptr;
+    return mCache.get(did);
 }
 
 bool AuthorCache::contains(const QString& did) const
@@ -104,7 +108,22 @@ bool AuthorCache::contains(const QString& did) const
 
 void AuthorCache::setUser(const BasicProfile& user)
 {
-    mUser = user;
+    mUser = std::make_shared<BasicProfile>(user);
+    setViewer(user.getDid());
+}
+
+void AuthorCache::setViewer(const QString& did)
+{
+    if (did != mCache.getViewer())
+    {
+        qDebug() << "Author cache viewer:" << did << "profiles:" << mCache.size();
+        mCache.setViewer(did);
+    }
+}
+
+void AuthorCache::removeViewer(const QString& did)
+{
+    mCache.removeViewer(did);
 }
 
 void AuthorCache::addProfileStore(const IProfileStore* store)
@@ -112,13 +131,14 @@ void AuthorCache::addProfileStore(const IProfileStore* store)
     mProfileStores.insert(store);
 }
 
-const BasicProfile* AuthorCache::getFromStores(const QString& did) const
+std::shared_ptr<const BasicProfile> AuthorCache::getFromStores(const QString& did) const
 {
+    // The stores own their profiles, return a copy.
     for (const auto* store : mProfileStores)
     {
         auto* profile = store->get(did);
         if (profile)
-            return profile;
+            return std::make_shared<BasicProfile>(*profile);
     }
 
     return nullptr;
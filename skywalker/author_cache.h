@@ -3,38 +3,35 @@
 #pragma once
 #include "profile.h"
 #include "profile_store.h"
+#include "viewer_cache.h"
 #include "wrapped_skywalker.h"
-#include <QCache>
 #include <unordered_set>
 
 namespace Skywalker {
 
+// Profiles are shared by all accounts. The viewer state (following, muted, ...)
+// is kept per account, see ViewerCache.
 class AuthorCache : public WrappedSkywalker
 {
     Q_OBJECT
 
 public:
-    class Entry : public QObject
-    {
-    public:
-        Entry() = default;
-        Entry(const BasicProfile& profile);
-
-        const BasicProfile& getAuthor() const { return mAuthor; }
-
-    private:
-        BasicProfile mAuthor;
-    };
+    static constexpr int BUDGET_WEIGHT = 25;
 
     static AuthorCache& instance();
 
     void clear();
-    void put(const BasicProfile& author);
+    // The viewer state of the author belongs to viewerDid, by default the
+    // active user.
+    void put(const BasicProfile& author, const QString& viewerDid = {});
     void putProfile(const QString& did, const std::function<void()>& addedCb = {});
-    const BasicProfile* get(const QString& did) const;
+    std::shared_ptr<const BasicProfile> get(const QString& did) const;
     bool contains(const QString& did) const;
 
+    // Sets the active user, which is the viewer for get()
     void setUser(const BasicProfile& user);
+    void setViewer(const QString& did);
+    void removeViewer(const QString& did);
     void addProfileStore(const IProfileStore* store);
 
 signals:
@@ -43,11 +40,12 @@ signals:
 private:
     explicit AuthorCache(QObject* parent = nullptr);
 
-    const BasicProfile* getFromStores(const QString& did) const;
+    std::shared_ptr<const BasicProfile> getFromStores(const QString& did) const;
+    static qsizetype getCost(const QString& did, const BasicProfile& author);
 
-    QCache<QString, Entry> mCache; // key is did
+    ViewerCache<BasicProfile> mCache; // key is did
     std::unordered_set<const IProfileStore*> mProfileStores;
-    BasicProfile mUser;
+    std::shared_ptr<const BasicProfile> mUser = std::make_shared<BasicProfile>();
     std::unordered_set<QString> mFetchingDids;
     std::unordered_set<QString> mFailedDids;
 
@@ -107,7 +107,7 @@ AuthorFeedModel::Page::Ptr AuthorFeedModel::createPage(ATProto::AppBskyFeed::Out
 
             if (auto reason = mustHideContent(post); reason.first != QEnums::HIDE_REASON_NONE)
             {
-                mContentFilterStats.report(post, reason.first, reason.second);
+                mContentFilterStats.report(std::move(post), reason.first, reason.second);
                 continue;
             }
 
@@ -269,32 +269,32 @@ QHash<int, QByteArray> AuthorListModel::roleNames() const
 
 void AuthorListModel::blockingUriChanged()
 {
-    changeData({ int(Role::BlockingUri) });
+    changeAuthorData({ int(Role::BlockingUri) });
 }
 
 void AuthorListModel::followingUriChanged()
 {
-    changeData({ int(Role::FollowingUri) });
+    changeAuthorData({ int(Role::FollowingUri) });
 }
 
 void AuthorListModel::activitySubscriptionChanged()
 {
-    changeData({ int(Role::ActivitySubscription) });
+    changeAuthorData({ int(Role::ActivitySubscription) });
 }
 
 void AuthorListModel::mutedChanged()
 {
-    changeData({ int(Role::AuthorMuted) });
+    changeAuthorData({ int(Role::AuthorMuted) });
 }
 
 void AuthorListModel::mutedRepostsChanged()
 {
-    changeData({ int(Role::MutedReposts) });
+    changeAuthorData({ int(Role::MutedReposts) });
 }
 
 void AuthorListModel::hideFromTimelineChanged()
 {
-    changeData({ int(Role::HideFromTimeline) });
+    changeAuthorData({ int(Role::HideFromTimeline) });
 }
 
 void AuthorListModel::changeData(const QList<int>& roles)
@@ -302,4 +302,27 @@ void AuthorListModel::changeData(const QList<int>& roles)
     emit dataChanged(createIndex(0, 0), createIndex(mList.size() - 1, 0), roles);
 }
 
+void AuthorListModel::changeAuthorData(const QList<int>& roles)
+{
+    const auto& dids = getChangedAuthorDids();
+
+    if (dids.isAll())
+    {
+        changeData(roles);
+        return;
+    }
+
+    std::vector<int> rows;
+
+    for (int i = 0; i < (int)mList.size(); ++i)
+    {
+        if (dids.contains(mList[i].mProfile.getDid()))
+            rows.push_back(i);
+    }
+
+    forEachRowRange(rows, [this, &roles](int first, int last){
+        emit dataChanged(createIndex(first, 0), createIndex(last, 0), roles);
+    });
+}
+
 }
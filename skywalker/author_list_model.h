@@ -90,6 +90,7 @@ private:
     void setEndOfList();
     AuthorList filterAuthors(const ATProto::AppBskyActor::ProfileView::List& authors) const;
     void changeData(const QList<int>& roles) override;
+    void changeAuthorData(const QList<int>& roles);
 
     Type mType;
     QString mAtId;
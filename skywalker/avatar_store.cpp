@@ -0,0 +1,387 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "avatar_store.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+
+namespace Skywalker {
+
+static constexpr char const* STORE_SUB_DIR = "avatars";
+static constexpr char const* INDEX_FILE_NAME = "index.json";
+static constexpr int INDEX_VERSION = 1;
+
+QString AvatarStore::getStorePath(const QString& settingsFileName)
+{
+    const QFileInfo info(settingsFileName);
+    return info.absolutePath() + "/" + STORE_SUB_DIR;
+}
+
+bool AvatarStore::isImmutable(const QString& url)
+{
+    // E.g. https://cdn.bsky.app/img/avatar_thumbnail/plain/did:plc:.../bafkrei...@jpeg
+    return url.startsWith("https://cdn.bsky.app/img/");
+}
+
+bool AvatarStore::isAvatar(const QString& url)
+{
+    // E.g. https://cdn.bsky.app/img/avatar/plain/did:plc:.../bafkrei...@jpeg
+    return url.startsWith("https://cdn.bsky.app/img/avatar");
+}
+
+std::shared_ptr<AvatarStore> AvatarStore::getShared(const QString& path)
+{
+    static QMutex sMutex;
+    static std::unordered_map<QString, std::weak_ptr<AvatarStore>> sStores;
+    QMutexLocker locker(&sMutex);
+    auto& weakStore = sStores[path];
+    auto store = weakStore.lock();
+
+    if (store && store->thread() == QThread::currentThread())
+        return store;
+
+    if (store)
+        qWarning() << "Avatar store in use by another thread:" << path;
+
+    store = std::make_shared<AvatarStore>(path);
+    weakStore = store;
+    return store;
+}
+
+AvatarStore::AvatarStore(const QString& path, QNetworkAccessManager* network, QObject* parent) :
+    QObject(parent),
+    mPath(path),
+    mNetwork(network)
+{
+    if (!mNetwork)
+    {
+        mNetwork = new QNetworkAccessManager(this);
+        mNetwork->setTransferTimeout(TRANSFER_TIMEOUT_MS);
+    }
+
+    if (!QDir().mkpath(mPath))
+        qWarning() << "Cannot create avatar store:" << mPath;
+
+    loadIndex();
+
+    mAccessTimeSaveTimer.setSingleShot(true);
+    mAccessTimeSaveTimer.setInterval(ACCESS_TIME_SAVE_DELAY);
+    connect(&mAccessTimeSaveTimer, &QTimer::timeout, this, [this]{ saveAccessTimes(); });
+}
+
+AvatarStore::~AvatarStore()
+{
+    saveAccessTimes();
+}
+
+void AvatarStore::saveAccessTimes()
+{
+    if (mAccessTimesChanged)
+        saveIndex();
+}
+
+void AvatarStore::get(const QString& url, const DataCb& dataCb, const ErrorCb& errorCb)
+{
+    auto it = mEntries.find(url);
+
+    if (it == mEntries.end())
+    {
+        fetch(url, {}, dataCb, errorCb);
+        return;
+    }
+
+    Entry& entry = it->second;
+    const QByteArray data = readBlob(entry.mHash);
+
+    if (data.isEmpty())
+    {
+        qWarning() << "Avatar missing from store:" << url << entry.mHash;
+        removeEntry(url);
+        saveIndex();
+        fetch(url, {}, dataCb, errorCb);
+        return;
+    }
+
+    const auto now = QDateTime::currentDateTimeUtc();
+    entry.mLastAccess = now;
+    mAccessTimesChanged = true;
+
+    if (!mAccessTimeSaveTimer.isActive())
+        mAccessTimeSaveTimer.start();
+
+    if (isImmutable(url) || entry.mValidated.addSecs(std::chrono::seconds(MAX_AGE).count()) > now)
+    {
+        ++mStats.mHits;
+
+        // The caller may call the store again from the callback.
+        QTimer::singleShot(0, this, [dataCb, data]{ dataCb(data); });
+        return;
+    }
+
+    fetch(url, data, dataCb, errorCb);
+}
+
+void AvatarStore::fetch(const QString& url, const QByteArray& cachedData, const DataCb& dataCb, const ErrorCb& errorCb)
+{
+    const QUrl requestUrl(url);
+
+    if (!requestUrl.isValid())
+    {
+        qWarning() << "Invalid avatar url:" << url;
+        const QString error = tr("Invalid url: %1").arg(url);
+        QTimer::singleShot(0, this, [errorCb, error]{ errorCb(error); });
+        return;
+    }
+
+    QNetworkRequest request(requestUrl);
+
+    if (!cachedData.isEmpty())
+    {
+        const Entry& entry = mEntries[url];
+
+        if (!entry.mETag.isEmpty())
+            request.setRawHeader("If-None-Match", entry.mETag.toUtf8());
+
+        if (!entry.mLastModified.isEmpty())
+            request.setRawHeader("If-Modified-Since", entry.mLastModified.toUtf8());
+    }
+
+    QNetworkReply* reply = mNetwork->get(request);
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, url, cachedData, dataCb, errorCb]{
+        replyFinished(reply, url, cachedData, dataCb, errorCb);
+        reply->deleteLater();
+    });
+}
+
+void AvatarStore::replyFinished(QNetworkReply* reply, const QString& url, const QByteArray& cachedData,
+                                const DataCb& dataCb, const ErrorCb& errorCb)
+{
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    if (status == 304 && !cachedData.isEmpty())
+    {
+        qDebug() << "Avatar not modified:" << url;
+        ++mStats.mNotModified;
+        auto it = mEntries.find(url);
+
+        if (it != mEntries.end())
+        {
+            it->second.mValidated = QDateTime::currentDateTimeUtc();
+            saveIndex();
+        }
+
+        dataCb(cachedData);
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError)
+    {
+        qWarning() << "Failed to get avatar:" << url << reply->errorString();
+
+        if (!cachedData.isEmpty())
+        {
+            qDebug() << "Use stale avatar:" << url;
+            dataCb(cachedData);
+            return;
+        }
+
+        errorCb(reply->errorString());
+        return;
+    }
+
+    const QByteArray data = reply->readAll();
+
+    if (data.isEmpty())
+    {
+        qWarning() << "Empty avatar:" << url;
+        errorCb(tr("Empty image"));
+        return;
+    }
+
+    ++mStats.mDownloads;
+
+    if (store(url, data, reply))
+        saveIndex();
+
+    dataCb(data);
+}
+
+bool AvatarStore::store(const QString& url, const QByteArray& data, const QNetworkReply* reply)
+{
+    const QString hash = QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+
+    if (!mRefCounts.contains(hash) && !writeBlob(hash, data))
+        return false;
+
+    auto it = mEntries.find(url);
+
+    if (it == mEntries.end() || it->second.mHash != hash)
+    {
+        if (it != mEntries.end())
+            removeEntry(url);
+
+        ++mRefCounts[hash];
+    }
+
+    const auto now = QDateTime::currentDateTimeUtc();
+    Entry& entry = mEntries[url];
+    entry.mHash = hash;
+    entry.mETag = QString::fromUtf8(reply->rawHeader("ETag"));
+    entry.mLastModified = QString::fromUtf8(reply->rawHeader("Last-Modified"));
+    entry.mValidated = now;
+    entry.mLastAccess = now;
+
+    evict();
+    return true;
+}
+
+void AvatarStore::removeEntry(const QString& url)
+{
+    auto it = mEntries.find(url);
+
+    if (it == mEntries.end())
+        return;
+
+    const QString hash = it->second.mHash;
+    mEntries.erase(it);
+    auto refIt = mRefCounts.find(hash);
+
+    if (refIt == mRefCounts.end())
+        return;
+
+    if (--refIt->second <= 0)
+    {
+        mRefCounts.erase(refIt);
+        QFile::remove(getBlobFileName(hash));
+    }
+}
+
+void AvatarStore::evict()
+{
+    while ((int)mEntries.size() > MAX_ENTRIES)
+    {
+        auto oldest = std::min_element(mEntries.begin(), mEntries.end(),
+            [](const auto& lhs, const auto& rhs){ return lhs.second.mLastAccess < rhs.second.mLastAccess; });
+
+        qDebug() << "Evict avatar:" << oldest->first;
+        removeEntry(oldest->first);
+    }
+}
+
+QString AvatarStore::getBlobFileName(const QString& hash) const
+{
+    return mPath + "/" + hash;
+}
+
+QByteArray AvatarStore::readBlob(const QString& hash) const
+{
+    QFile file(getBlobFileName(hash));
+
+    if (!file.open(QFile::ReadOnly))
+        return {};
+
+    return file.readAll();
+}
+
+bool AvatarStore::writeBlob(const QString& hash, const QByteArray& data) const
+{
+    QSaveFile file(getBlobFileName(hash));
+
+    if (!file.open(QFile::WriteOnly) || file.write(data) != data.size() || !file.commit())
+    {
+        qWarning() << "Cannot write avatar:" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+void AvatarStore::loadIndex()
+{
+    QFile file(mPath + "/" + INDEX_FILE_NAME);
+
+    if (!file.open(QFile::ReadOnly))
+    {
+        qDebug() << "No avatar index:" << file.fileName();
+        return;
+    }
+
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    const QJsonObject json = doc.object();
+
+    if (json["version"].toInt() != INDEX_VERSION)
+    {
+        qWarning() << "Unsupported avatar index version:" << json["version"];
+        return;
+    }
+
+    for (const auto& value : json["entries"].toArray())
+    {
+        const QJsonObject entryJson = value.toObject();
+        const QString url = entryJson["url"].toString();
+        Entry entry;
+        entry.mHash = entryJson["hash"].toString();
+        entry.mETag = entryJson["etag"].toString();
+        entry.mLastModified = entryJson["lastModified"].toString();
+        entry.mValidated = QDateTime::fromString(entryJson["validated"].toString(), Qt::ISODate);
+        entry.mLastAccess = QDateTime::fromString(entryJson["lastAccess"].toString(), Qt::ISODate);
+
+        if (url.isEmpty() || entry.mHash.isEmpty() || mEntries.contains(url))
+            continue;
+
+        ++mRefCounts[entry.mHash];
+        mEntries[url] = entry;
+    }
+
+    qDebug() << "Avatar index loaded:" << mEntries.size() << "blobs:" << mRefCounts.size();
+}
+
+void AvatarStore::saveIndex()
+{
+    QJsonArray entriesJson;
+
+    for (const auto& [url, entry] : mEntries)
+    {
+        QJsonObject entryJson;
+        entryJson.insert("url", url);
+        entryJson.insert("hash", entry.mHash);
+
+        if (!entry.mETag.isEmpty())
+            entryJson.insert("etag", entry.mETag);
+
+        if (!entry.mLastModified.isEmpty())
+            entryJson.insert("lastModified", entry.mLastModified);
+
+        entryJson.insert("validated", entry.mValidated.toString(Qt::ISODate));
+        entryJson.insert("lastAccess", entry.mLastAccess.toString(Qt::ISODate));
+        entriesJson.append(entryJson);
+    }
+
+    mAccessTimesChanged = false;
+    QJsonObject json;
+    json.insert("version", INDEX_VERSION);
+    json.insert("entries", entriesJson);
+
+    QSaveFile file(mPath + "/" + INDEX_FILE_NAME);
+
+    if (!file.open(QFile::WriteOnly))
+    {
+        qWarning() << "Cannot write avatar index:" << file.fileName() << file.errorString();
+        return;
+    }
+
+    file.write(QJsonDocument(json).toJson(QJsonDocument::Compact));
+
+    if (!file.commit())
+        qWarning() << "Cannot save avatar index:" << file.fileName() << file.errorString();
+}
+
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QDateTime>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QTimer>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+
+namespace Skywalker {
+
+using namespace std::chrono_literals;
+
+// Persistent avatar cache on disk. Images are stored by the SHA-256 hash of
+// their content, so URLs with the same image share a file. A file is deleted
+// when no URL refers to it anymore. An index maps URLs to content hashes and
+// HTTP validators.
+//
+// Bluesky CDN URLs contain the CID of the image, so their content never
+// changes and they are never revalidated. Other URLs are revalidated with a
+// conditional request after MAX_AGE.
+class AvatarStore : public QObject
+{
+public:
+    static constexpr int MAX_ENTRIES = 500;
+    static constexpr std::chrono::hours MAX_AGE = 24h;
+    static constexpr int TRANSFER_TIMEOUT_MS = 30000;
+
+    // Access times are only needed for eviction. They are saved this long
+    // after a hit, instead of on each hit.
+    static constexpr std::chrono::seconds ACCESS_TIME_SAVE_DELAY = 30s;
+
+    using DataCb = std::function<void(const QByteArray& data)>;
+    using ErrorCb = std::function<void(const QString& error)>;
+
+    struct Stats
+    {
+        int mHits = 0;
+        int mNotModified = 0;
+        int mDownloads = 0;
+    };
+
+    // The store is located next to the settings file, such that the offline
+    // message checker finds it when running as a background task.
+    static QString getStorePath(const QString& settingsFileName);
+
+    static bool isImmutable(const QString& url);
+
+    // Returns true for avatar images on the Bluesky CDN.
+    static bool isAvatar(const QString& url);
+
+    // Returns the store for path. The store is shared by all users in the
+    // same thread, e.g. the app and the offline message checker running in
+    // the app process, such that they do not overwrite each other's index.
+    static std::shared_ptr<AvatarStore> getShared(const QString& path);
+
+    // Without network, the store creates its own.
+    explicit AvatarStore(const QString& path, QNetworkAccessManager* network = nullptr, QObject* parent = nullptr);
+    ~AvatarStore();
+
+    // Returns the image data from the store, the network or, if the network
+    // fails, a stale copy from the store. The callbacks are always called from
+    // the event loop, never from within get().
+    void get(const QString& url, const DataCb& dataCb, const ErrorCb& errorCb);
+
+    bool contains(const QString& url) const { return mEntries.contains(url); }
+    int size() const { return (int)mEntries.size(); }
+    int getBlobCount() const { return (int)mRefCounts.size(); }
+    const Stats& getStats() const { return mStats; }
+
+private:
+    struct Entry
+    {
+        QString mHash;
+        QString mETag;
+        QString mLastModified;
+        QDateTime mValidated;
+        QDateTime mLastAccess;
+    };
+
+    void fetch(const QString& url, const QByteArray& cachedData, const DataCb& dataCb, const ErrorCb& errorCb);
+    void replyFinished(QNetworkReply* reply, const QString& url, const QByteArray& cachedData,
+                       const DataCb& dataCb, const ErrorCb& errorCb);
+    bool store(const QString& url, const QByteArray& data, const QNetworkReply* reply);
+    void removeEntry(const QString& url);
+    void evict();
+    QString getBlobFileName(const QString& hash) const;
+    QByteArray readBlob(const QString& hash) const;
+    bool writeBlob(const QString& hash, const QByteArray& data) const;
+    void loadIndex();
+    void saveIndex();
+    void saveAccessTimes();
+
+    QString mPath;
+    QNetworkAccessManager* mNetwork;
+    std::unordered_map<QString, Entry> mEntries; // URL -> entry
+    std::unordered_map<QString, int> mRefCounts; // hash -> number of URLs
+    Stats mStats;
+    bool mAccessTimesChanged = false;
+    QTimer mAccessTimeSaveTimer;
+};
+
+}
@@ -124,6 +124,7 @@ void ContentFilter::removeListPrefs(const QString& listUri)
 {
     qDebug() << "Remove list prefs:" << listUri;
     mListPrefs.erase(listUri);
+    clearLabelDecisions();
 }
 
 const ContentFilter::GlobalContentGroupMap& ContentFilter::getGlobalContentGroups()
@@ -173,6 +174,9 @@ ContentFilter::ContentFilter(const QString& userDid,
 {
     connect(mListsWithPolicies, &ListStore::listRemoved, this,
             [this](const QString& uri){ removeListPrefs(uri); });
+    connect(mListsWithPolicies, &ListStore::listRefreshed, this, [this]{ clearLabelDecisions(); });
+    connect(this, &ContentFilter::contentGroupsChanged, this, [this]{ clearLabelDecisions(); });
+    connect(this, &ContentFilter::listPrefsChanged, this, [this]{ clearLabelDecisions(); });
 }
 
 void ContentFilter::clear()
@@ -180,6 +184,7 @@ void ContentFilter::clear()
     mLabelerGroupMap.clear();
     clearFollowingPrefs();
     mListPrefs.clear();
+    clearLabelDecisions();
 }
 
 void ContentFilter::initListPrefs()
@@ -201,6 +206,8 @@ void ContentFilter::initListPrefs()
         qDebug() << "list:" << listUri << "labeler:" << labelerDid << "label:" << labelId << "pref:" << pref;
         setListPref(listUri, labelerDid, labelId, pref);
     }
+
+    clearLabelDecisions();
 }
 
 const ContentGroup* ContentFilter::getContentGroup(const QString& did, const QString& labelId) const
@@ -442,16 +449,21 @@ std::tuple<QEnums::ContentVisibility, QString, int> ContentFilter::getVisibility
     QString warning;
     int labelIndex = -1;
 
+    if (contentLabels.empty())
+        return {visibility, warning, labelIndex};
+
+    const auto authorContext = getAuthorContext(author);
+
     for (int i = 0; i < contentLabels.size(); ++i)
     {
         const auto& label = contentLabels[i];
-        const auto v = getVisibility(author, label, adultOverrideVisibility);
+        const auto decision = getLabelDecision(author, authorContext, label, adultOverrideVisibility);
 
-        if (v <= visibility)
+        if (decision.mVisibility <= visibility)
             continue;
 
-        visibility = v;
-        warning = getWarning(label);
+        visibility = decision.mVisibility;
+        warning = decision.mWarning;
         labelIndex = i;
 
         if (visibility == QEnums::CONTENT_VISIBILITY_LAST)
@@ -461,6 +473,77 @@ std::tuple<QEnums::ContentVisibility, QString, int> ContentFilter::getVisibility
     return {visibility, warning, labelIndex};
 }
 
+std::optional<uint64_t> ContentFilter::getAuthorContext(const BasicProfile& author) const
+{
+    // The author prefs only depend on following the author and the membership
+    // of the lists with prefs. The lists are ordered by URI, so a bit always
+    // stands for the same list.
+    if (author.isNull())
+        return 0;
+
+    uint64_t context = 0;
+
+    if (!mFollowingPrefs.empty() && author.getViewer().isFollowing())
+        context |= 1;
+
+    int bit = 1;
+
+    for (const auto& [listUri, _] : mListPrefs)
+    {
+        if (bit >= 64)
+            return {};
+
+        if (mListsWithPolicies->containsListMember(listUri, author.getDid()))
+            context |= (uint64_t(1) << bit);
+
+        ++bit;
+    }
+
+    return context;
+}
+
+ContentFilter::LabelDecision ContentFilter::getLabelDecision(
+    const BasicProfile& author,
+    std::optional<uint64_t> authorContext,
+    const ContentLabel& label,
+    std::optional<QEnums::ContentVisibility> adultOverrideVisibility) const
+{
+    if (!authorContext)
+        return { getVisibility(author, label, adultOverrideVisibility), getWarning(label) };
+
+    const auto* group = getContentGroup(label.getDid(), label.getLabelId());
+
+    if (!group)
+        return { getVisibility(author, label, adultOverrideVisibility), getWarning(label) };
+
+    // The user preferences can change without a signal, e.g. by setLabelVisibility.
+    // Therefor the preference for this label is part of the key.
+    const LabelDecisionKey key{
+        label.getDid(),
+        label.getLabelId(),
+        *authorContext,
+        adultOverrideVisibility ? (int)*adultOverrideVisibility : -1,
+        getAdultContent(),
+        (int)getVisibilityDefaultPrefs(*group) };
+
+    auto it = mLabelDecisions.find(key);
+
+    if (it != mLabelDecisions.end())
+        return *it;
+
+    if (mLabelDecisions.size() >= MAX_LABEL_DECISIONS)
+        mLabelDecisions.clear();
+
+    LabelDecision decision{ getVisibility(author, label, adultOverrideVisibility), getWarning(label) };
+    mLabelDecisions.insert(key, decision);
+    return decision;
+}
+
+void ContentFilter::clearLabelDecisions()
+{
+    mLabelDecisions.clear();
+}
+
 bool ContentFilter::isSubscribedToLabeler(const QString& did) const
 {
     if (isFixedLabelerSubscription(did))
@@ -551,6 +634,7 @@ void ContentFilter::addContentGroupMap(const QString& did, const ContentGroupMap
     Q_ASSERT(!did.isEmpty());
     qDebug() << "Add content group map for did:" << did;
     mLabelerGroupMap[did] = contentGroupMap;
+    clearLabelDecisions();
 }
 
 void ContentFilter::addContentGroups(const QString& did, const std::vector<ContentGroup>& contentGroups)
@@ -562,6 +646,7 @@ void ContentFilter::addContentGroups(const QString& did, const std::vector<Conte
     for (const auto& group : contentGroups)
         groupMap[group.getLabelId()] = group;
 
+    clearLabelDecisions();
     saveLabelIdsToSettings(did);
 }
 
@@ -569,6 +654,7 @@ void ContentFilter::removeContentGroups(const QString& did)
 {
     Q_ASSERT(!did.isEmpty());
     mLabelerGroupMap.erase(did);
+    clearLabelDecisions();
     removeLabelIdsFromSettings(did);
 }
 
@@ -726,6 +812,7 @@ void ContentFilter::clearFollowingPrefs()
     if (!mFollowingPrefs.empty())
     {
         mFollowingPrefs.clear();
+        clearLabelDecisions();
         emit hasFollowingPrefsChanged();
     }
 }
@@ -740,6 +827,7 @@ void ContentFilter::createFollowingPrefs()
 
     // Insert empty prefs for the global labels
     mFollowingPrefs[""] = {};
+    clearLabelDecisions();
     emit hasFollowingPrefsChanged();
 }
 
@@ -753,6 +841,7 @@ void ContentFilter::createListPref(const ListViewBasic& list)
 {
     const QString listUri = list.getUri();
     mListPrefs[listUri][""] = {};
+    clearLabelDecisions();
 
     if (!mListsWithPolicies->hasList(listUri))
     {
@@ -3,6 +3,8 @@
 #pragma once
 #include "content_label.h"
 #include "content_group.h"
+#include <QHash>
+#include <map>
 #include <tuple>
 
 namespace Skywalker {
@@ -70,6 +72,9 @@ public:
     void clear();
     void initListPrefs();
 
+    // Empty for a filter without user
+    QString getUserDid() const { return mUserDid ? *mUserDid : QString{}; }
+
     // Returns a global content group if the labelId is a global label
     const ContentGroup* getContentGroup(const QString& did, const QString& labelId) const override;
 
@@ -136,6 +141,31 @@ signals:
     void listAddingFailed(const QString& listUri, const QString& error);
 
 private:
+    struct LabelDecisionKey
+    {
+        QString mLabelerDid;
+        QString mLabelId;
+        uint64_t mAuthorContext; // bit 0: following, bit n: member of n-th list with prefs
+        int mAdultOverride; // -1 is no override
+        bool mAdultContent;
+        int mLabelPref; // user preference for the label
+
+        bool operator==(const LabelDecisionKey&) const = default;
+
+        friend size_t qHash(const LabelDecisionKey& key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.mLabelerDid, key.mLabelId, key.mAuthorContext,
+                              key.mAdultOverride, key.mAdultContent, key.mLabelPref);
+        }
+    };
+
+    struct LabelDecision
+    {
+        QEnums::ContentVisibility mVisibility;
+        QString mWarning;
+    };
+
+    static constexpr int MAX_LABEL_DECISIONS = 5000;
     static GlobalContentGroupMap CONTENT_GROUPS;
 
     static void initContentGroups();
@@ -153,6 +183,16 @@ private:
         const ContentLabel& label,
         std::optional<QEnums::ContentVisibility> adultOverrideVisibility = {}) const;
 
+    // Visibility decisions per label are cached. The cache is cleared when content
+    // groups or list prefs change.
+    void clearLabelDecisions();
+    std::optional<uint64_t> getAuthorContext(const BasicProfile& author) const;
+    LabelDecision getLabelDecision(
+        const BasicProfile& author,
+        std::optional<uint64_t> authorContext,
+        const ContentLabel& label,
+        std::optional<QEnums::ContentVisibility> adultOverrideVisibility) const;
+
     QString getGroupWarning(const ContentGroup& group) const;
     QString getWarning(const ContentLabel& label) const;
 
@@ -171,7 +211,9 @@ private:
     std::unordered_map<QString, ContentGroupMap> mLabelerGroupMap; // labeler DID -> group map
 
     ATProto::UserPreferences::ContentLabelPrefs mFollowingPrefs; // labeler DID -> label visibility
-    std::unordered_map<QString, ATProto::UserPreferences::ContentLabelPrefs> mListPrefs; // list uri -> prefs
+    std::map<QString, ATProto::UserPreferences::ContentLabelPrefs> mListPrefs; // list uri -> prefs
+
+    mutable QHash<LabelDecisionKey, LabelDecision> mLabelDecisions;
 };
 
 class ContentFilterShowAll : public IContentFilter
@@ -9,6 +9,11 @@ namespace Skywalker {
 
 static constexpr size_t MAX_FILTERED_POSTS = 2000;
 
+static bool isCountedReason(QEnums::HideReasonType hideReason)
+{
+    return hideReason != QEnums::HIDE_REASON_NONE && hideReason != QEnums::HIDE_REASON_ANY;
+}
+
 QString ContentFilterStats::detailsToString(const Details& details, const IContentFilter& contentFilter)
 {
     if (std::holds_alternative<BasicProfile>(details))
@@ -37,45 +42,21 @@ ContentFilterStats::ContentFilterStats(const IListStore& timelineHide) :
 
 void ContentFilterStats::clear()
 {
-    mMutedAuthor = 0;
+    mHideReasonCounts.fill(0);
     mAuthorsMutedAuthor.clear();
-
-    mRepostsFromAuthor = 0;
     mAuthorsRepostsFromAuthor.clear();
-
-    mHideFromFollowingFeed = 0;
     mListsHideFromFollowingFeed.clear();
-
-    mLabel = 0;
     mLabelMap.clear();
-
-    mMutedWord = 0;
     mEntriesMutedWord.clear();
-
-    mHideFollowingFromFeed = 0;
-
-    mLanguage = 0;
     mEntriesLanguage.clear();
-
-    mQuotesBlockedPost = 0;
-    mRepliesFromUnfollowed = 0;
-    mRepliesThreadUnfollowed = 0;
-    mSelfReposts = 0;
-    mFollowingReposts = 0;
-
-    mReplies = 0;
-    mReposts = 0;
-    mQuotes = 0;
-
-    mContentMode = 0;
-
     mProfileMap.clear();
+    mListMap.clear();
     mPosts.clear();
     mPostHideInfoMap.clear();
     mCheckedPostCids.clear();
 }
 
-void ContentFilterStats::report(const Post& post, QEnums::HideReasonType hideReason, const Details& details)
+void ContentFilterStats::report(Post post, QEnums::HideReasonType hideReason, const Details& details)
 {
     if (mPostHideInfoMap.contains(post.getCid()))
     {
@@ -89,13 +70,11 @@ void ContentFilterStats::report(const Post& post, QEnums::HideReasonType hideRea
         if (std::holds_alternative<BasicProfile>(details)) // safety check (should always pass)
             add(std::get<BasicProfile>(details), mAuthorsMutedAuthor);
 
-        ++mMutedAuthor;
         break;
     case QEnums::HIDE_REASON_REPOST_FROM_AUTHOR:
         if (std::holds_alternative<BasicProfile>(details))
             add(std::get<BasicProfile>(details), mAuthorsRepostsFromAuthor);
 
-        ++mRepostsFromAuthor;
         break;
     case QEnums::HIDE_REASON_HIDE_FROM_FOLLOWING_FEED:
         if (std::holds_alternative<BasicProfile>(details))
@@ -115,7 +94,6 @@ void ContentFilterStats::report(const Post& post, QEnums::HideReasonType hideRea
             }
         }
 
-        ++mHideFromFollowingFeed;
         break;
     case QEnums::HIDE_REASON_LABEL:
         if (std::holds_alternative<ContentLabel>(details))
@@ -124,49 +102,28 @@ void ContentFilterStats::report(const Post& post, QEnums::HideReasonType hideRea
             ++mLabelMap[contentLabel.getDid()][contentLabel.getLabelId()];
         }
 
-        ++mLabel;
         break;
     case QEnums::HIDE_REASON_MUTED_WORD:
         if (std::holds_alternative<MutedWordEntry>(details))
             ++mEntriesMutedWord[std::get<MutedWordEntry>(details)];
 
-        ++mMutedWord;
-        break;
-    case QEnums::HIDE_REASON_HIDE_FOLLOWING_FROM_FEED:
-        ++mHideFollowingFromFeed;
         break;
     case QEnums::HIDE_REASON_LANGUAGE:
         if (std::holds_alternative<QString>(details))
             ++mEntriesLanguage[std::get<QString>(details)];
 
-        ++mLanguage;
         break;
+    case QEnums::HIDE_REASON_HIDE_FOLLOWING_FROM_FEED:
     case QEnums::HIDE_REASON_QUOTE_BLOCKED_POST:
-        ++mQuotesBlockedPost;
-        break;
     case QEnums::HIDE_REASON_REPLY_TO_UNFOLLOWED:
-        ++mRepliesFromUnfollowed;
-        break;
     case QEnums::HIDE_REASON_REPLY_THREAD_UNFOLLOWED:
-        ++mRepliesThreadUnfollowed;
-        break;
     case QEnums::HIDE_REASON_SELF_REPOST:
-        ++mSelfReposts;
-        break;
     case QEnums::HIDE_REASON_FOLLOWING_REPOST:
-        ++mFollowingReposts;
-        break;
     case QEnums::HIDE_REASON_REPLY:
-        ++mReplies;
-        break;
     case QEnums::HIDE_REASON_REPOST:
-        ++mReposts;
-        break;
     case QEnums::HIDE_REASON_QUOTE:
-        ++mQuotes;
-        break;
     case QEnums::HIDE_REASON_CONTENT_MODE:
-        ++mContentMode;
+        // Only counted
         break;
     case QEnums::HIDE_REASON_NONE:
         qWarning() << "Content not hidden";
@@ -176,8 +133,11 @@ void ContentFilterStats::report(const Post& post, QEnums::HideReasonType hideRea
         break;
     }
 
+    if (isCountedReason(hideReason))
+        ++mHideReasonCounts[hideReason];
+
     mPostHideInfoMap[post.getCid()] = { hideReason, details };
-    addPost(post);
+    addPost(std::move(post));
 }
 
 void ContentFilterStats::reportChecked(const Post& post)
@@ -261,15 +221,31 @@ std::vector<ContentFilterStats::ProfileStat> ContentFilterStats::getProfileStats
     return result;
 }
 
-static auto postTimelineCompare = [](const Post& lhs, const Post& rhs)
+static auto postTimelineCompare = [](const ContentFilterStats::PostHandle& lhs, const QDateTime& rhs)
 {
-    return lhs.getTimelineTimestamp() > rhs.getTimelineTimestamp();
+    return lhs->getTimelineTimestamp() > rhs;
 };
 
-void ContentFilterStats::addPost(const Post& post)
+void ContentFilterStats::addPost(Post post)
 {
-    const auto it = std::lower_bound(mPosts.cbegin(), mPosts.cend(), post, postTimelineCompare);
-    mPosts.insert(it, post);
+    const QDateTime timestamp = post.getTimelineTimestamp();
+    auto handle = std::make_shared<const Post>(std::move(post));
+
+    // Posts mostly arrive in timeline order, i.e. older pages at the back and
+    // new posts at the front. Only posts from threads land in the middle.
+    if (mPosts.empty() || timestamp < mPosts.back()->getTimelineTimestamp())
+    {
+        mPosts.push_back(std::move(handle));
+    }
+    else if (timestamp >= mPosts.front()->getTimelineTimestamp())
+    {
+        mPosts.push_front(std::move(handle));
+    }
+    else
+    {
+        const auto it = std::lower_bound(mPosts.cbegin(), mPosts.cend(), timestamp, postTimelineCompare);
+        mPosts.insert(it, std::move(handle));
+    }
 
     if (mPosts.size() > MAX_FILTERED_POSTS)
     {
@@ -283,17 +259,17 @@ void ContentFilterStats::removeLastPost()
     if (mPosts.empty())
         return;
 
-    const auto& lastPost = mPosts.back();
-    const auto& lastCid = lastPost.getCid();
+    const PostHandle lastPost = mPosts.back();
+    const auto& lastCid = lastPost->getCid();
 
     const auto it = mPostHideInfoMap.find(lastCid);
 
     if (it != mPostHideInfoMap.end())
-        removeReport(lastPost, it->second.mHideReason, it->second.mDetails);
+        removeReport(*lastPost, it->second.mHideReason, it->second.mDetails);
 
     mPostHideInfoMap.erase(lastCid);
     mCheckedPostCids.erase(lastCid);
-    mPosts.erase(mPosts.end() - 1);
+    mPosts.pop_back();
 
     qDebug() << "Last post removed, size:" << mPosts.size();
 }
@@ -308,13 +284,11 @@ void ContentFilterStats::removeReport(const Post& post, QEnums::HideReasonType h
         if (std::holds_alternative<BasicProfile>(details)) // safety check (should always pass)
             remove(std::get<BasicProfile>(details), mAuthorsMutedAuthor);
 
-        --mMutedAuthor;
         break;
     case QEnums::HIDE_REASON_REPOST_FROM_AUTHOR:
         if (std::holds_alternative<BasicProfile>(details))
             remove(std::get<BasicProfile>(details), mAuthorsRepostsFromAuthor);
 
-        --mRepostsFromAuthor;
         break;
     case QEnums::HIDE_REASON_HIDE_FROM_FOLLOWING_FEED:
         if (std::holds_alternative<BasicProfile>(details))
@@ -334,7 +308,6 @@ void ContentFilterStats::removeReport(const Post& post, QEnums::HideReasonType h
             }
         }
 
-        --mHideFromFollowingFeed;
         break;
     case QEnums::HIDE_REASON_LABEL:
         if (std::holds_alternative<ContentLabel>(details))
@@ -349,7 +322,6 @@ void ContentFilterStats::removeReport(const Post& post, QEnums::HideReasonType h
                 mLabelMap.erase(contentLabel.getDid());
         }
 
-        --mLabel;
         break;
     case QEnums::HIDE_REASON_MUTED_WORD:
         if (std::holds_alternative<MutedWordEntry>(details))
@@ -360,10 +332,6 @@ void ContentFilterStats::removeReport(const Post& post, QEnums::HideReasonType h
                 mEntriesMutedWord.erase(entry);
         }
 
-        --mMutedWord;
-        break;
-    case QEnums::HIDE_REASON_HIDE_FOLLOWING_FROM_FEED:
-        --mHideFollowingFromFeed;
         break;
     case QEnums::HIDE_REASON_LANGUAGE:
         if (std::holds_alternative<QString>(details))
@@ -374,42 +342,26 @@ void ContentFilterStats::removeReport(const Post& post, QEnums::HideReasonType h
                 mEntriesLanguage.erase(language);
         }
 
-        --mLanguage;
         break;
+    case QEnums::HIDE_REASON_HIDE_FOLLOWING_FROM_FEED:
     case QEnums::HIDE_REASON_QUOTE_BLOCKED_POST:
-        --mQuotesBlockedPost;
-        break;
     case QEnums::HIDE_REASON_REPLY_TO_UNFOLLOWED:
-        --mRepliesFromUnfollowed;
-        break;
     case QEnums::HIDE_REASON_REPLY_THREAD_UNFOLLOWED:
-        --mRepliesThreadUnfollowed;
-        break;
     case QEnums::HIDE_REASON_SELF_REPOST:
-        --mSelfReposts;
-        break;
     case QEnums::HIDE_REASON_FOLLOWING_REPOST:
-        --mFollowingReposts;
-        break;
     case QEnums::HIDE_REASON_REPLY:
-        --mReplies;
-        break;
     case QEnums::HIDE_REASON_REPOST:
-        --mReposts;
-        break;
     case QEnums::HIDE_REASON_QUOTE:
-        --mQuotes;
-        break;
     case QEnums::HIDE_REASON_CONTENT_MODE:
-        --mContentMode;
+        // Only counted
         break;
     case QEnums::HIDE_REASON_NONE:
-        qWarning() << "Content not hidden";
-        break;
     case QEnums::HIDE_REASON_ANY:
-        qWarning() << "ANY is not a valid reason on a post";
         break;
     }
+
+    if (isCountedReason(hideReason))
+        --mHideReasonCounts[hideReason];
 }
 
 std::vector<ContentFilterStats::ProfileStat> ContentFilterStats::authorsMutedAuthor() const
@@ -7,7 +7,9 @@
 #include "muted_words.h"
 #include "post.h"
 #include "profile.h"
+#include <array>
 #include <deque>
+#include <memory>
 
 namespace Skywalker {
 
@@ -35,47 +37,56 @@ public:
 
     using PostHideInfoMap = std::unordered_map<QString, PostHideInfo>; // cid -> info
 
+    // Filtered posts are shared by copies of the stats, e.g. the copy held by
+    // ContentFilterStatsModel, instead of being copied.
+    using PostHandle = std::shared_ptr<const Post>;
+    using PostList = std::deque<PostHandle>; // newest first
+
     explicit ContentFilterStats(const IListStore& timelineHide);
     ContentFilterStats(const ContentFilterStats&) = default;
     ContentFilterStats& operator=(const ContentFilterStats&) = default;
 
     int total() const { return mPosts.size(); }
     int checkedPosts() const { return mCheckedPostCids.size(); }
+    int count(QEnums::HideReasonType hideReason) const { return mHideReasonCounts[hideReason]; }
+    const PostList& posts() const { return mPosts; }
 
-    int mutedAuthor() const { return mMutedAuthor; }
+    int mutedAuthor() const { return count(QEnums::HIDE_REASON_MUTED_AUTHOR); }
     std::vector<ProfileStat> authorsMutedAuthor() const;
 
-    int repostsFromAuthor() const { return mRepostsFromAuthor; }
+    int repostsFromAuthor() const { return count(QEnums::HIDE_REASON_REPOST_FROM_AUTHOR); }
     std::vector<ProfileStat> authorsRepostsFromAuthor() const;
 
-    int hideFromFollowingFeed() const { return mHideFromFollowingFeed; }
+    int hideFromFollowingFeed() const { return count(QEnums::HIDE_REASON_HIDE_FROM_FOLLOWING_FEED); }
     std::vector<ListProfileStat> listsHideFromFollowingFeed() const;
 
-    int label() const { return mLabel; }
+    int label() const { return count(QEnums::HIDE_REASON_LABEL); }
     const LabelerDidLabelStatMap& labelMap() const { return mLabelMap; }
 
-    int mutedWord() const { return mMutedWord; }
+    int mutedWord() const { return count(QEnums::HIDE_REASON_MUTED_WORD); }
     const std::map<MutedWordEntry, int>& entriesMutedWord() const { return mEntriesMutedWord; }
 
-    int hideFollowingFromFeed() const { return mHideFollowingFromFeed; }
+    int hideFollowingFromFeed() const { return count(QEnums::HIDE_REASON_HIDE_FOLLOWING_FROM_FEED); }
 
-    int language() const { return mLanguage; }
+    int language() const { return count(QEnums::HIDE_REASON_LANGUAGE); }
     const std::map<QString, int>& entriesLanguage() const { return mEntriesLanguage; }
 
-    int quotesBlockedPost() const { return mQuotesBlockedPost; }
-    int repliesFromUnfollowed() const { return mRepliesFromUnfollowed; }
-    int repliesThreadUnfollowed() const { return mRepliesThreadUnfollowed; }
-    int selfReposts() const { return mSelfReposts; }
-    int followingReposts() const { return mFollowingReposts; }
+    int quotesBlockedPost() const { return count(QEnums::HIDE_REASON_QUOTE_BLOCKED_POST); }
+    int repliesFromUnfollowed() const { return count(QEnums::HIDE_REASON_REPLY_TO_UNFOLLOWED); }
+    int repliesThreadUnfollowed() const { return count(QEnums::HIDE_REASON_REPLY_THREAD_UNFOLLOWED); }
+    int selfReposts() const { return count(QEnums::HIDE_REASON_SELF_REPOST); }
+    int followingReposts() const { return count(QEnums::HIDE_REASON_FOLLOWING_REPOST); }
 
-    int replies() const { return mReplies; }
-    int reposts() const { return mReposts; }
-    int quotes() const { return mQuotes; }
+    int replies() const { return count(QEnums::HIDE_REASON_REPLY); }
+    int reposts() const { return count(QEnums::HIDE_REASON_REPOST); }
+    int quotes() const { return count(QEnums::HIDE_REASON_QUOTE); }
 
-    int contentMode() const { return mContentMode; }
+    int contentMode() const { return count(QEnums::HIDE_REASON_CONTENT_MODE); }
 
     void clear();
-    void report(const Post& post, QEnums::HideReasonType hideReason, const Details& details);
+    // Pass the post as rvalue when the caller does not need it anymore. Filtered
+    // posts are not stored in the feed, the stats keep the only copy.
+    void report(Post post, QEnums::HideReasonType hideReason, const Details& details);
     void reportChecked(const Post& post);
 
     void setFeed(PostFeedModel* model, QVariantList detailList) const;
@@ -86,42 +97,20 @@ private:
     void remove(const BasicProfile& profile, DidStatMap& didStatMap);
     void remove(const ListViewBasic& list, const BasicProfile& profile, ListUriProfileStatsMap& listUriProfileStatMap);
     std::vector<ProfileStat> getProfileStats(const DidStatMap& didStatMap) const;
-    void addPost(const Post& post);
+    void addPost(Post post);
     void removeLastPost();
     void removeReport(const Post& post, QEnums::HideReasonType hideReason, const Details& details);
 
-    int mMutedAuthor = 0;
-    DidStatMap mAuthorsMutedAuthor;
+    // Number of filtered posts per hide reason
+    std::array<int, QEnums::HIDE_REASON_ANY + 1> mHideReasonCounts = {};
 
-    int mRepostsFromAuthor = 0;
+    DidStatMap mAuthorsMutedAuthor;
     DidStatMap mAuthorsRepostsFromAuthor;
-
-    int mHideFromFollowingFeed = 0;
     ListUriProfileStatsMap mListsHideFromFollowingFeed;
-
-    int mLabel = 0;
     LabelerDidLabelStatMap mLabelMap;
-
-    int mMutedWord = 0;
     std::map<MutedWordEntry, int> mEntriesMutedWord;
-
-    int mHideFollowingFromFeed = 0;
-
-    int mLanguage = 0;
     std::map<QString, int> mEntriesLanguage;
 
-    int mQuotesBlockedPost = 0;
-    int mRepliesFromUnfollowed = 0;
-    int mRepliesThreadUnfollowed = 0;
-    int mSelfReposts = 0;
-    int mFollowingReposts = 0;
-
-    int mReplies = 0;
-    int mReposts = 0;
-    int mQuotes = 0;
-
-    int mContentMode = 0;
-
     struct ProfileLink
     {
         BasicProfile mProfile;
@@ -137,7 +126,7 @@ private:
     const IListStore* mTimelineHide = nullptr;
     std::unordered_map<QString, ProfileLink> mProfileMap;
     std::unordered_map<QString, ListLink> mListMap;
-    std::deque<Post> mPosts;
+    PostList mPosts;
     PostHideInfoMap mPostHideInfoMap;
     std::unordered_set<QString> mCheckedPostCids;
 };
@@ -0,0 +1,289 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "dag_cbor.h"
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QJsonArray>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace Skywalker::DagCbor {
+
+namespace {
+
+constexpr char const* BASE32_ALPHABET = "abcdefghijklmnopqrstuvwxyz234567";
+constexpr char MULTIBASE_BASE32 = 'b';
+constexpr uint8_t CID_V1 = 0x01;
+constexpr uint8_t CODEC_DAG_CBOR = 0x71;
+constexpr uint8_t HASH_SHA2_256 = 0x12;
+constexpr uint8_t HASH_SHA2_256_LENGTH = 0x20;
+constexpr uint64_t TAG_CID = 42;
+
+enum MajorType : uint8_t
+{
+    UNSIGNED_INT = 0,
+    NEGATIVE_INT = 1,
+    BYTE_STRING = 2,
+    TEXT_STRING = 3,
+    ARRAY = 4,
+    MAP = 5,
+    TAG = 6,
+    SIMPLE = 7
+};
+
+void writeHead(QByteArray& out, MajorType type, uint64_t value)
+{
+    const uint8_t major = type << 5;
+
+    if (value < 24)
+    {
+        out.append(char(major | value));
+    }
+    else if (value <= 0xff)
+    {
+        out.append(char(major | 24));
+        out.append(char(value));
+    }
+    else if (value <= 0xffff)
+    {
+        out.append(char(major | 25));
+        for (int shift = 8; shift >= 0; shift -= 8)
+            out.append(char((value >> shift) & 0xff));
+    }
+    else if (value <= 0xffffffff)
+    {
+        out.append(char(major | 26));
+        for (int shift = 24; shift >= 0; shift -= 8)
+            out.append(char((value >> shift) & 0xff));
+    }
+    else
+    {
+        out.append(char(major | 27));
+        for (int shift = 56; shift >= 0; shift -= 8)
+            out.append(char((value >> shift) & 0xff));
+    }
+}
+
+void writeNumber(QByteArray& out, double number)
+{
+    const double integral = std::trunc(number);
+
+    if (integral == number && std::abs(number) < 9007199254740992.0) // 2^53
+    {
+        const auto value = (int64_t)integral;
+
+        if (value >= 0)
+            writeHead(out, UNSIGNED_INT, (uint64_t)value);
+        else
+            writeHead(out, NEGATIVE_INT, (uint64_t)(-1 - value));
+
+        return;
+    }
+
+    // ATProto records should not have floats, DAG-CBOR mandates 64 bit.
+    out.append(char((SIMPLE << 5) | 27));
+    uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+
+    for (int shift = 56; shift >= 0; shift -= 8)
+        out.append(char((bits >> shift) & 0xff));
+}
+
+void writeBytes(QByteArray& out, const QByteArray& bytes)
+{
+    writeHead(out, BYTE_STRING, bytes.size());
+    out.append(bytes);
+}
+
+void writeText(QByteArray& out, const QString& text)
+{
+    const QByteArray utf8 = text.toUtf8();
+    writeHead(out, TEXT_STRING, utf8.size());
+    out.append(utf8);
+}
+
+void writeValue(QByteArray& out, const QJsonValue& value);
+
+void writeObject(QByteArray& out, const QJsonObject& object)
+{
+    if (object.size() == 1)
+    {
+        const auto it = object.begin();
+
+        if (it.key() == "$link" && it.value().isString())
+        {
+            const QByteArray cid = cidToBytes(it.value().toString());
+
+            if (!cid.isEmpty())
+            {
+                // Binary CID is prefixed with the identity multibase
+                writeHead(out, TAG, TAG_CID);
+                writeBytes(out, QByteArray(1, '\0') + cid);
+                return;
+            }
+
+            qWarning() << "Invalid CID link:" << it.value().toString();
+        }
+        else if (it.key() == "$bytes" && it.value().isString())
+        {
+            const auto bytes = QByteArray::fromBase64(it.value().toString().toLatin1());
+            writeBytes(out, bytes);
+            return;
+        }
+    }
+
+    std::vector<std::pair<QByteArray, QJsonValue>> entries;
+    entries.reserve(object.size());
+
+    for (auto it = object.begin(); it != object.end(); ++it)
+        entries.push_back({ it.key().toUtf8(), it.value() });
+
+    std::sort(entries.begin(), entries.end(),
+        [](const auto& lhs, const auto& rhs){
+            if (lhs.first.size() != rhs.first.size())
+                return lhs.first.size() < rhs.first.size();
+
+            return lhs.first < rhs.first;
+        });
+
+    writeHead(out, MAP, entries.size());
+
+    for (const auto& [key, val] : entries)
+    {
+        writeHead(out, TEXT_STRING, key.size());
+        out.append(key);
+        writeValue(out, val);
+    }
+}
+
+void writeValue(QByteArray& out, const QJsonValue& value)
+{
+    switch (value.type())
+    {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        out.append(char((SIMPLE << 5) | 22));
+        break;
+    case QJsonValue::Bool:
+        out.append(char((SIMPLE << 5) | (value.toBool() ? 21 : 20)));
+        break;
+    case QJsonValue::Double:
+        writeNumber(out, value.toDouble());
+        break;
+    case QJsonValue::String:
+        writeText(out, value.toString());
+        break;
+    case QJsonValue::Array:
+    {
+        const auto array = value.toArray();
+        writeHead(out, ARRAY, array.size());
+
+        for (const auto& element : array)
+            writeValue(out, element);
+
+        break;
+    }
+    case QJsonValue::Object:
+        writeObject(out, value.toObject());
+        break;
+    }
+}
+
+QString base32Encode(const QByteArray& bytes)
+{
+    QString result;
+    result.reserve((bytes.size() * 8 + 4) / 5);
+    uint32_t buffer = 0;
+    int bits = 0;
+
+    for (const char c : bytes)
+    {
+        buffer = (buffer << 8) | uint8_t(c);
+        bits += 8;
+
+        while (bits >= 5)
+        {
+            result.append(QChar(BASE32_ALPHABET[(buffer >> (bits - 5)) & 0x1f]));
+            bits -= 5;
+        }
+    }
+
+    if (bits > 0)
+        result.append(QChar(BASE32_ALPHABET[(buffer << (5 - bits)) & 0x1f]));
+
+    return result;
+}
+
+QByteArray base32Decode(QStringView str)
+{
+    QByteArray result;
+    result.reserve(str.size() * 5 / 8);
+    uint32_t buffer = 0;
+    int bits = 0;
+
+    for (const QChar ch : str)
+    {
+        const char c = ch.toLatin1();
+        int value;
+
+        if (c >= 'a' && c <= 'z')
+            value = c - 'a';
+        else if (c >= '2' && c <= '7')
+            value = c - '2' + 26;
+        else
+            return {};
+
+        buffer = (buffer << 5) | value;
+        bits += 5;
+
+        if (bits >= 8)
+        {
+            result.append(char((buffer >> (bits - 8)) & 0xff));
+            bits -= 8;
+        }
+    }
+
+    return result;
+}
+
+}
+
+QByteArray encode(const QJsonValue& value)
+{
+    QByteArray out;
+    writeValue(out, value);
+    return out;
+}
+
+QString recordCid(const QJsonObject& record)
+{
+    const QByteArray cbor = encode(record);
+    const QByteArray digest = QCryptographicHash::hash(cbor, QCryptographicHash::Sha256);
+
+    QByteArray cid;
+    cid.reserve(4 + digest.size());
+    cid.append(char(CID_V1));
+    cid.append(char(CODEC_DAG_CBOR));
+    cid.append(char(HASH_SHA2_256));
+    cid.append(char(HASH_SHA2_256_LENGTH));
+    cid.append(digest);
+
+    return cidFromBytes(cid);
+}
+
+QByteArray cidToBytes(const QString& cid)
+{
+    if (cid.size() < 2 || cid[0] != MULTIBASE_BASE32)
+        return {};
+
+    return base32Decode(QStringView(cid).sliced(1));
+}
+
+QString cidFromBytes(const QByteArray& bytes)
+{
+    return QChar(MULTIBASE_BASE32) + base32Encode(bytes);
+}
+
+}
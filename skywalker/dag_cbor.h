@@ -0,0 +1,27 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+namespace Skywalker::DagCbor {
+
+// Encode a JSON value in canonical DAG-CBOR as used by ATProto repositories.
+// - {"$link": cid} is encoded as a CID link (tag 42)
+// - {"$bytes": base64} is encoded as a byte string
+// - map keys are sorted by length, then bytewise
+// - integral numbers are encoded as integers
+QByteArray encode(const QJsonValue& value);
+
+// Compute the CIDv1 (dag-cbor, sha2-256) of a record in base32 string format.
+// This is the CID the PDS will assign to the record.
+QString recordCid(const QJsonObject& record);
+
+// Convert a base32 CID string to its binary format. Returns an empty
+// byte array if the CID is not valid.
+QByteArray cidToBytes(const QString& cid);
+QString cidFromBytes(const QByteArray& bytes);
+
+}
@@ -3,8 +3,10 @@
 #include "draft_posts.h"
 #include "atproto_image_provider.h"
 #include "content_filter.h"
+#include "file_copier.h"
 #include "file_utils.h"
 #include "gif_utils.h"
+#include "image_upload_pipeline.h"
 #include "photo_picker.h"
 #include "skywalker.h"
 #include "temp_file_holder.h"
@@ -1460,7 +1462,7 @@ ATProto::Blob::SharedPtr DraftPosts::saveVideo(
         return nullptr;
     }
 
-    if (toFile.write(fromFile.readAll()) < 0)
+    if (FileCopier::copy(fromFile, toFile) < 0)
     {
         qWarning() << "Failed to save video:" << absDraftFileName << toFile.errorString();
         toFile.close();
@@ -1639,39 +1641,6 @@ void DraftPosts::deleteRecord(const QString& recordUri)
         });
 }
 
-bool DraftPosts::uploadImage(const QString& imageName, const UploadImageSuccessCb& successCb, const ErrorCb& errorCb)
-{
-    Q_ASSERT(mStorageType == STORAGE_REPO);
-    Q_ASSERT(successCb);
-    Q_ASSERT(errorCb);
-
-    QByteArray imgData;
-    const auto [mimeType, imgSize] = PhotoPicker::createBlob(imgData, imageName);
-
-    if (imgData.isEmpty())
-    {
-        qWarning() << "Image blob could not be created:" << imageName;
-        return false;
-    }
-
-    bskyClient()->uploadBlob(imgData, mimeType,
-        [presence=getPresence(), imgSize, successCb](auto blob){
-            if (!presence)
-                return;
-
-            successCb(std::move(blob), imgSize);
-        },
-        [presence=getPresence(), errorCb](const QString& error, const QString& msg){
-            if (!presence)
-                return;
-
-            qWarning() << "Upload image failed:" << error << " - " << msg;
-            errorCb(error, msg);
-        });
-
-    return true;
-}
-
 void DraftPosts::addGifToPost(ATProto::AppBskyFeed::Record::Post& post, const TenorGif& gif) const
 {
     // Pack all gif properties into the URI.
@@ -1697,7 +1666,7 @@ void DraftPosts::addExternalLinkToPost(ATProto::AppBskyFeed::Record::Post& post,
 
 void DraftPosts::addImagesToPost(ATProto::AppBskyFeed::Record::Post& post,
                      const QList<ImageView>& images,
-                     const std::function<void()>& continueCb, int imgSeq)
+                     const std::function<void()>& continueCb)
 {
     Q_ASSERT(mStorageType == STORAGE_REPO);
 
@@ -1707,25 +1676,48 @@ void DraftPosts::addImagesToPost(ATProto::AppBskyFeed::Record::Post& post,
         return;
     }
 
-    emit uploadingImage(imgSeq);
+    // The images are loaded by the pipeline workers.
+    std::vector<ImageUploadPipeline::Image> pipelineImages;
+    pipelineImages.reserve(images.size());
+
+    for (const auto& image : images)
+        pipelineImages.push_back({ {}, image.getFullSizeUrl() });
+
+    emit uploadingImage(1);
+
+    auto pipeline = ImageUploadPipeline::create(makeBlobUploader());
+    pipeline->setProgressCb(
+        [this, presence=getPresence()](int uploaded, int total){
+            if (!presence)
+                return;
 
-    const QString imgName = images.first().getFullSizeUrl();
-    const QString altText = images.first().getAlt();
-    const auto remainingImages = images.mid(1);
+            if (uploaded < total)
+                emit uploadingImage(uploaded + 1);
+        });
 
-    uploadImage(imgName,
-        [this, presence=getPresence(), &post, altText, remainingImages, continueCb, imgSeq](auto blob, QSize imgSize){
+    pipeline->start(std::move(pipelineImages),
+        [this, presence=getPresence(), &post, images, continueCb](auto uploadedImages){
             if (!presence)
                 return;
 
-            ATProto::PostMaster::addImageToPost(post, std::move(blob), imgSize.width(), imgSize.height(), altText);
-            addImagesToPost(post, remainingImages, continueCb, imgSeq + 1);
+            for (int i = 0; i < (int)uploadedImages.size(); ++i)
+            {
+                auto& img = uploadedImages[i];
+                ATProto::PostMaster::addImageToPost(post, std::move(img.mBlob), img.mSize.width(), img.mSize.height(), images[i].getAlt());
+            }
+
+            continueCb();
         },
-        [this, presence=getPresence()](const QString&, const QString& msg){
+        [this, presence=getPresence(), images](int imgIndex, const QString& error, const QString& msg){
             if (!presence)
                 return;
 
-            emit saveDraftPostFailed(tr("Image upload failed: %1").arg(msg));
+            qWarning() << "Upload image failed:" << error << " - " << msg;
+
+            if (error == ImageUploadPipeline::ERROR_ENCODE_FAILED)
+                emit saveDraftPostFailed(tr("Image upload failed: %1").arg(images[imgIndex].getFullSizeUrl()));
+            else
+                emit saveDraftPostFailed(tr("Image upload failed: %1").arg(msg));
         });
 }
 
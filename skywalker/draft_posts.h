@@ -85,7 +85,6 @@ signals:
     void storageTypeChanged();
 
 private:
-    using UploadImageSuccessCb = std::function<void(ATProto::Blob::SharedPtr, QSize)>;
     using SuccessCb = std::function<void()>;
     using DoneCb = std::function<void()>;
     using ErrorCb = std::function<void(const QString& error, const QString& message)>;
@@ -160,10 +159,9 @@ private:
     bool writeRecord(const Draft::Draft& draft);
     void listRecords();
     void deleteRecord(const QString& recordUri);
-    bool uploadImage(const QString& imageName, const UploadImageSuccessCb& successCb, const ErrorCb& errorCb);
     void addImagesToPost(ATProto::AppBskyFeed::Record::Post& post,
                          const QList<ImageView>& images,
-                         const std::function<void()>& continueCb, int imgSeq = 1);
+                         const std::function<void()>& continueCb);
 
     DraftPostsModel::Ptr mDraftPostsModel;
 
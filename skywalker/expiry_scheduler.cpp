@@ -0,0 +1,94 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "expiry_scheduler.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace Skywalker {
+
+ExpiryScheduler& ExpiryScheduler::instance()
+{
+    static ExpiryScheduler sInstance;
+    return sInstance;
+}
+
+ExpiryScheduler::ExpiryScheduler(QObject* parent) :
+    QObject(parent)
+{
+    mTimer.setSingleShot(true);
+    connect(&mTimer, &QTimer::timeout, this, [this]{ expire(); });
+}
+
+ExpiryScheduler::Id ExpiryScheduler::schedule(const QDateTime& expiry, const ExpiredFn& expiredFn)
+{
+    if (!expiry.isValid())
+    {
+        qWarning() << "Invalid expiry";
+        return NULL_ID;
+    }
+
+    const Id id = mNextId++;
+    const QDateTime utcExpiry = expiry.toUTC();
+    mEntries[{utcExpiry, id}] = expiredFn;
+    mExpiryById[id] = utcExpiry;
+
+    if (mEntries.begin()->first.second == id)
+        arm();
+
+    return id;
+}
+
+void ExpiryScheduler::cancel(Id id)
+{
+    auto it = mExpiryById.find(id);
+
+    if (it == mExpiryById.end())
+        return;
+
+    const Key key{ it->second, id };
+    const bool first = mEntries.begin()->first == key;
+    mEntries.erase(key);
+    mExpiryById.erase(it);
+
+    if (first)
+        arm();
+}
+
+void ExpiryScheduler::expire()
+{
+    const auto now = QDateTime::currentDateTimeUtc();
+
+    // An expired function may schedule or cancel entries.
+    while (!mEntries.empty() && mEntries.begin()->first.first <= now)
+    {
+        auto it = mEntries.begin();
+        const ExpiredFn expiredFn = std::move(it->second);
+        mExpiryById.erase(it->first.second);
+        mEntries.erase(it);
+
+        if (expiredFn)
+            expiredFn();
+    }
+
+    arm();
+}
+
+QDateTime ExpiryScheduler::getNextExpiry() const
+{
+    return mEntries.empty() ? QDateTime{} : mEntries.begin()->first.first;
+}
+
+void ExpiryScheduler::arm()
+{
+    if (mEntries.empty())
+    {
+        mTimer.stop();
+        return;
+    }
+
+    const auto now = QDateTime::currentDateTimeUtc();
+    const auto interval = std::chrono::milliseconds(now.msecsTo(getNextExpiry()));
+    mTimer.start(std::clamp(interval, std::chrono::milliseconds(0), MAX_TIMER_INTERVAL));
+}
+
+}
@@ -0,0 +1,60 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QDateTime>
+#include <QObject>
+#include <QTimer>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+namespace Skywalker {
+
+// Calls functions when their expiry time has passed. A single timer is armed
+// for the first expiry of all scheduled entries, e.g. muted words, and mutes
+// and blocks with expiry.
+//
+// Not thread-safe, use it from the GUI thread only.
+class ExpiryScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Id = quint64;
+    using ExpiredFn = std::function<void()>;
+
+    static constexpr Id NULL_ID = 0;
+
+    // The timer is re-armed at least this often, such that changes of the
+    // system clock are picked up.
+    static constexpr std::chrono::milliseconds MAX_TIMER_INTERVAL = std::chrono::hours(1);
+
+    static ExpiryScheduler& instance();
+
+    explicit ExpiryScheduler(QObject* parent = nullptr);
+
+    // The expiredFn is called from the event loop once, at or after the expiry.
+    // Returns NULL_ID if the expiry is not valid.
+    Id schedule(const QDateTime& expiry, const ExpiredFn& expiredFn);
+
+    void cancel(Id id);
+
+    // Calls the functions of all passed expiries.
+    void expire();
+
+    int size() const { return mEntries.size(); }
+    QDateTime getNextExpiry() const;
+
+private:
+    void arm();
+
+    using Key = std::pair<QDateTime, Id>;
+
+    std::map<Key, ExpiredFn> mEntries; // ordered by expiry
+    std::unordered_map<Id, QDateTime> mExpiryById;
+    Id mNextId = 1;
+    QTimer mTimer;
+};
+
+}
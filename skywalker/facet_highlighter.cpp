@@ -2,9 +2,27 @@
 // License: GPLv3
 #include "facet_highlighter.h"
 #include <atproto/lib/rich_text_master.h>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <algorithm>
 
 namespace Skywalker {
 
+// The index holds the text of the blocks as passed to highlightBlock, separated
+// by newlines. Unlike toPlainText, non-breaking spaces are kept.
+static void toBlockText(QString& text)
+{
+    text.replace(QChar::ParagraphSeparator, '\n');
+    text.replace(QChar::LineSeparator, '\n');
+}
+
+static QString getDocumentText(const QTextDocument& doc)
+{
+    QString text = doc.toRawText();
+    toBlockText(text);
+    return text;
+}
+
 FacetHighlighter::FacetHighlighter(QTextDocument* parent) :
     EmojiFixHighlighter(parent)
 {
@@ -27,12 +45,64 @@ void FacetHighlighter::setEmbeddedLinks(const WebLink::List* links)
     mEmbeddedLinks = links;
 }
 
+void FacetHighlighter::setFacetDocument(QTextDocument* doc)
+{
+    disconnect(mContentsChangeConnection);
+    mFacetIndex.clear();
+
+    // Connect before QSyntaxHighlighter connects to the same signal, such that
+    // the index is up to date when the changed blocks are highlighted.
+    if (doc)
+    {
+        mFacetIndex.update(getDocumentText(*doc));
+        mContentsChangeConnection = connect(doc, &QTextDocument::contentsChange,
+                                            this, &FacetHighlighter::updateFacetIndex);
+    }
+
+    setDocument(doc);
+}
+
+void FacetHighlighter::updateFacetIndex(int position, int charsRemoved, int charsAdded)
+{
+    auto* doc = document();
+
+    if (!doc)
+        return;
+
+    // The document always ends with a paragraph separator that is not in the plain text.
+    const int docLength = doc->characterCount() - 1;
+    const int end = std::min(position + charsAdded, docLength);
+    QString added;
+
+    if (end > position)
+    {
+        QTextCursor cursor(doc);
+        cursor.setPosition(position);
+        cursor.setPosition(end, QTextCursor::KeepAnchor);
+        added = cursor.selectedText();
+        toBlockText(added);
+    }
+
+    // Format changes are signalled as a change without a change of text.
+    if (charsRemoved == added.size() && mFacetIndex.matches(position, added))
+        return;
+
+    mFacetIndex.applyChange(position, charsRemoved, added);
+
+    if (mFacetIndex.getText().size() != docLength)
+    {
+        qWarning() << "Facet index out of sync, length:" << mFacetIndex.getText().size() << "document:" << docLength;
+        mFacetIndex.clear();
+        mFacetIndex.update(getDocumentText(*doc));
+    }
+}
+
 void FacetHighlighter::highlightBlock(const QString& text)
 {
     EmojiFixHighlighter::highlightBlock(text);
 
     // NOTE: unfortunately the text does not contain text from the preedit buffer.
-    const auto facets = ATProto::RichTextMaster::parseFacets(text);
+    const auto facets = getBlockFacets(text);
 
     for (const auto& facet : facets)
     {
@@ -58,6 +128,19 @@ void FacetHighlighter::highlightBlock(const QString& text)
     highlightEmbeddedLinks(text);
 }
 
+FacetIndex::FacetList FacetHighlighter::getBlockFacets(const QString& text) const
+{
+    const int blockPosition = currentBlock().position();
+
+    if (!mFacetIndex.matches(blockPosition, text))
+    {
+        qDebug() << "Block not in facet index:" << currentBlock().blockNumber() << "position:" << blockPosition;
+        return ATProto::RichTextMaster::parseFacets(text);
+    }
+
+    return mFacetIndex.getFacets(blockPosition, blockPosition + text.size());
+}
+
 bool FacetHighlighter::facetOverlapsWithEmbeddedLink(const ATProto::RichTextMaster::ParsedMatch& facet, const QString& text) const
 {
     if (!mEmbeddedLinks)
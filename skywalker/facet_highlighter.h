@@ -2,6 +2,7 @@
 // License: GPLv3
 #pragma once
 #include "emoji_fix_highlighter.h"
+#include "facet_index.h"
 #include "web_link.h"
 #include <atproto/lib/rich_text_master.h>
 
@@ -17,16 +18,24 @@ public:
     void setErrorColor(const QString& colorName);
     void setEmbeddedLinks(const WebLink::List* links);
 
+    // Sets the document to highlight. The facet index of the document is updated
+    // on each content change, before the changed blocks get highlighted.
+    void setFacetDocument(QTextDocument* doc);
+
 protected:
     void highlightBlock(const QString& text) override;
 
 private:
+    FacetIndex::FacetList getBlockFacets(const QString& text) const;
     bool facetOverlapsWithEmbeddedLink(const ATProto::RichTextMaster::ParsedMatch& facet, const QString& text) const;
     void highlightEmbeddedLinks(const QString& text);
+    void updateFacetIndex(int position, int charsRemoved, int charsAdded);
 
     QTextCharFormat mHighlightFormat;
     QTextCharFormat mErrorFormat;
     const WebLink::List* mEmbeddedLinks = nullptr;
+    FacetIndex mFacetIndex;
+    QMetaObject::Connection mContentsChangeConnection;
 };
 
 }
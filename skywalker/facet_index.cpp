@@ -0,0 +1,138 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "facet_index.h"
+#include "text_differ.h"
+#include <algorithm>
+
+namespace Skywalker {
+
+void FacetIndex::update(const QString& text)
+{
+    const TextDiffer::Result diff = TextDiffer::diff(mText, text);
+    int changeStart = 0;
+    int newChangeEnd = 0; // exclusive
+
+    switch (diff.mType)
+    {
+    case TextDiffType::NONE:
+        mLastParseLength = 0;
+        return;
+    case TextDiffType::INSERTED:
+    case TextDiffType::REPLACED:
+        changeStart = diff.mNewStartIndex;
+        newChangeEnd = diff.mNewEndIndex + 1;
+        break;
+    case TextDiffType::DELETED:
+        changeStart = diff.mOldStartIndex;
+        newChangeEnd = changeStart;
+        break;
+    }
+
+    const int delta = (int)(text.size() - mText.size());
+    mText = text;
+    parseChange(changeStart, newChangeEnd, delta);
+}
+
+void FacetIndex::applyChange(int position, int charsRemoved, const QString& added)
+{
+    position = std::clamp(position, 0, (int)mText.size());
+    charsRemoved = std::clamp(charsRemoved, 0, (int)mText.size() - position);
+    mText.replace(position, charsRemoved, added);
+    parseChange(position, position + added.size(), added.size() - charsRemoved);
+}
+
+void FacetIndex::parseChange(int changeStart, int newChangeEnd, int delta)
+{
+    int start = changeStart;
+
+    while (start > 0 && !mText[start - 1].isSpace())
+        --start;
+
+    int end = newChangeEnd;
+
+    while (end < mText.size() && !mText[end].isSpace())
+        ++end;
+
+    parse(start, end, end - delta);
+}
+
+void FacetIndex::clear()
+{
+    mText.clear();
+    mFacets.clear();
+    mLastParseLength = 0;
+}
+
+void FacetIndex::parse(int start, int end, int oldEnd)
+{
+    const int delta = end - oldEnd;
+
+    // Facets in the old text overlapping with [start, oldEnd)
+    auto first = std::partition_point(mFacets.begin(), mFacets.end(),
+        [start](const ParsedMatch& facet){ return facet.mEndIndex <= start; });
+    auto last = std::partition_point(first, mFacets.end(),
+        [oldEnd](const ParsedMatch& facet){ return facet.mStartIndex < oldEnd; });
+
+    if (first != last)
+    {
+        start = std::min(start, first->mStartIndex);
+        oldEnd = std::max(oldEnd, std::prev(last)->mEndIndex);
+        end = oldEnd + delta;
+    }
+
+    auto facets = ATProto::RichTextMaster::parseFacets(mText.sliced(start, end - start));
+
+    for (auto& facet : facets)
+    {
+        facet.mStartIndex += start;
+        facet.mEndIndex += start;
+    }
+
+    for (auto it = last; it != mFacets.end(); ++it)
+    {
+        it->mStartIndex += delta;
+        it->mEndIndex += delta;
+    }
+
+    auto pos = mFacets.erase(first, last);
+    mFacets.insert(pos, std::make_move_iterator(facets.begin()), std::make_move_iterator(facets.end()));
+    mLastParseLength = end - start;
+}
+
+bool FacetIndex::matches(int position, const QString& text) const
+{
+    if (position < 0 || position + text.size() > mText.size())
+        return false;
+
+    return QStringView(mText).sliced(position, text.size()) == text;
+}
+
+const FacetIndex::ParsedMatch* FacetIndex::findFacet(int cursor) const
+{
+    auto it = std::partition_point(mFacets.begin(), mFacets.end(),
+        [cursor](const ParsedMatch& facet){ return facet.mStartIndex < cursor; });
+
+    if (it == mFacets.begin())
+        return nullptr;
+
+    --it;
+    return cursor <= it->mEndIndex ? &(*it) : nullptr;
+}
+
+FacetIndex::FacetList FacetIndex::getFacets(int start, int end) const
+{
+    FacetList facets;
+    auto it = std::partition_point(mFacets.begin(), mFacets.end(),
+        [start](const ParsedMatch& facet){ return facet.mStartIndex < start; });
+
+    for (; it != mFacets.end() && it->mEndIndex <= end; ++it)
+    {
+        auto& facet = facets.emplace_back(*it);
+        facet.mStartIndex -= start;
+        facet.mEndIndex -= start;
+    }
+
+    return facets;
+}
+
+}
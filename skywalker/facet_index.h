@@ -0,0 +1,53 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <atproto/lib/rich_text_master.h>
+#include <QString>
+#include <vector>
+
+namespace Skywalker {
+
+// Sorted list of facets in a text. On an update only the whitespace delimited
+// token window around the edit is parsed again. Facets after the edit are shifted.
+// Facets do not contain whitespace, so a token window parses the same as it would
+// within the full text.
+class FacetIndex
+{
+public:
+    using ParsedMatch = ATProto::RichTextMaster::ParsedMatch;
+    using FacetList = std::vector<ParsedMatch>;
+
+    void update(const QString& text);
+
+    // Incremental update with a known change, e.g. from QTextDocument::contentsChange.
+    void applyChange(int position, int charsRemoved, const QString& added);
+
+    void clear();
+
+    const QString& getText() const { return mText; }
+    const FacetList& getFacets() const { return mFacets; }
+
+    // Returns true if the text at position is equal to text.
+    bool matches(int position, const QString& text) const;
+
+    // Facet that contains the cursor: start < cursor <= end. The cursor is
+    // in a facet when it is directly behind the last character.
+    // Returns nullptr if there is no such facet.
+    const ParsedMatch* findFacet(int cursor) const;
+
+    // Facets within [start, end). Indexes are relative to start.
+    FacetList getFacets(int start, int end) const;
+
+    // Number of characters parsed by the last update.
+    int getLastParseLength() const { return mLastParseLength; }
+
+private:
+    void parseChange(int changeStart, int newChangeEnd, int delta);
+    void parse(int start, int end, int oldEnd);
+
+    QString mText;
+    FacetList mFacets;
+    int mLastParseLength = 0;
+};
+
+}
@@ -23,7 +23,8 @@ FacetUtils::FacetUtils(QObject* parent) :
 void FacetUtils::setHighlightDocument(QQuickTextDocument* doc, const QString& highlightColor,
                                      const QString& errorColor, int maxLength, const QString& lengthExceededColor)
 {
-    mFacetHighlighter.setDocument(doc->textDocument());
+    mFacetIndex.clear();
+    mFacetHighlighter.setFacetDocument(doc->textDocument());
     mFacetHighlighter.setHighlightColor(highlightColor);
     mFacetHighlighter.setErrorColor(errorColor);
     mFacetHighlighter.setMaxLength(maxLength, lengthExceededColor);
@@ -41,7 +42,8 @@ void FacetUtils::extractMentionsAndLinks(const QString& text, const QString& pre
         cursor = text.size();
 
     const QString fullText = text.sliced(0, cursor) + preeditText + text.sliced(cursor);
-    const auto facets = ATProto::RichTextMaster::parseFacets(fullText);
+    mFacetIndex.update(fullText);
+    const auto facets = mFacetIndex.getFacets();
 
     int preeditCursor = cursor + preeditText.length();
     bool editMentionFound = false;
@@ -135,34 +137,43 @@ void FacetUtils::extractMentionsAndLinks(const QString& text, const QString& pre
         }
         case ATProto::RichTextMaster::ParsedMatch::Type::PARTIAL_MENTION:
         case ATProto::RichTextMaster::ParsedMatch::Type::MENTION:
-            if (facet.mStartIndex < preeditCursor && preeditCursor <= facet.mEndIndex)
-            {
-                mEditMentionIndex = facet.mStartIndex + 1;
-                setEditMention(facet.mMatch.sliced(1)); // strip @-symbol
-                editMentionFound = true;
-            }
-
             mentions.push_back(facet.mMatch.sliced(1));
             textWithoutLinks += fullText.sliced(textIndex, facet.mStartIndex - textIndex);
             textIndex = facet.mEndIndex;
             break;
         case ATProto::RichTextMaster::ParsedMatch::Type::TAG:
-            if (facet.mStartIndex < preeditCursor && preeditCursor <= facet.mEndIndex)
+        case ATProto::RichTextMaster::ParsedMatch::Type::UNKNOWN:
+            break;
+        }
+    }
+
+    const auto* editFacet = mFacetIndex.findFacet(preeditCursor);
+
+    if (editFacet && !facetOverlapsWithEmbeddedLink(*editFacet))
+    {
+        switch (editFacet->mType)
+        {
+        case ATProto::RichTextMaster::ParsedMatch::Type::PARTIAL_MENTION:
+        case ATProto::RichTextMaster::ParsedMatch::Type::MENTION:
+            mEditMentionIndex = editFacet->mStartIndex + 1;
+            setEditMention(editFacet->mMatch.sliced(1)); // strip @-symbol
+            editMentionFound = true;
+            break;
+        case ATProto::RichTextMaster::ParsedMatch::Type::TAG:
+            if (editFacet->mMatch.startsWith('#'))
             {
-                if (facet.mMatch.startsWith('#'))
-                {
-                    mEditTagIndex = facet.mStartIndex + 1;
-                    setEditTag(facet.mMatch.sliced(1)); // strip #-symbol
-                    editTagFound = true;
-                }
-                else if (facet.mMatch.startsWith('$'))
-                {
-                    mEditCashtagIndex = facet.mStartIndex + 1;
-                    setEditCashtag(facet.mMatch.sliced(1)); // strip $-symbol
-                    editCashtagFound = true;
-                }
+                mEditTagIndex = editFacet->mStartIndex + 1;
+                setEditTag(editFacet->mMatch.sliced(1)); // strip #-symbol
+                editTagFound = true;
+            }
+            else if (editFacet->mMatch.startsWith('$'))
+            {
+                mEditCashtagIndex = editFacet->mStartIndex + 1;
+                setEditCashtag(editFacet->mMatch.sliced(1)); // strip $-symbol
+                editCashtagFound = true;
             }
             break;
+        case ATProto::RichTextMaster::ParsedMatch::Type::LINK:
         case ATProto::RichTextMaster::ParsedMatch::Type::UNKNOWN:
             break;
         }
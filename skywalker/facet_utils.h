@@ -2,6 +2,7 @@
 // License: GPLv3
 #pragma once
 #include "facet_highlighter.h"
+#include "facet_index.h"
 #include "text_differ.h"
 #include "presence.h"
 #include "enums.h"
@@ -153,6 +154,7 @@ private:
     WebLink::List mEmbeddedLinks;
     int mCursorInEmbeddedLink = -1;
 
+    FacetIndex mFacetIndex; // includes the preedit text
     FacetHighlighter mFacetHighlighter;
 };
 
@@ -0,0 +1,226 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "file_copier.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QThreadPool>
+#include <algorithm>
+
+#if defined(Q_OS_LINUX)
+#include <cerrno>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
+
+namespace Skywalker {
+
+qint64 FileCopier::copy(QFile& from, QFile& to, const ProgressCb& progressCb, bool kernelCopy)
+{
+    Q_ASSERT(from.isOpen());
+    Q_ASSERT(to.isOpen());
+    const qint64 inOffset = from.pos();
+    const qint64 total = std::max(from.size() - inOffset, 0LL);
+    qint64 copied = 0;
+
+    if (kernelCopy && total > 0 && from.handle() >= 0 && to.handle() >= 0)
+    {
+        if (!to.flush())
+        {
+            qWarning() << "Failed to flush:" << to.fileName() << to.errorString();
+            return -1;
+        }
+
+        const qint64 outOffset = to.pos();
+        copied = copyInKernel(from.handle(), to.handle(), inOffset, outOffset, total, progressCb);
+
+        // The kernel copy does not move the file positions.
+        if (!from.seek(inOffset + copied) || !to.seek(outOffset + copied))
+        {
+            qWarning() << "Failed to seek after copy:" << from.fileName() << to.fileName();
+            return -1;
+        }
+    }
+
+    // Copies the remainder if the kernel copy did not complete, e.g. when it is
+    // not supported for the file systems involved. On an error this returns the
+    // error from the file.
+    const qint64 buffered = copyBuffered(from, to, copied, total, progressCb);
+
+    if (buffered < 0)
+        return -1;
+
+    qDebug() << "Copied:" << from.fileName() << "to:" << to.fileName() << "kernel:" << copied << "buffered:" << buffered;
+    return copied + buffered;
+}
+
+qint64 FileCopier::copyInKernel(int inFd, int outFd, qint64 inOffset, qint64 outOffset, qint64 size,
+                                const ProgressCb& progressCb)
+{
+#if defined(Q_OS_LINUX)
+#ifdef FICLONE
+    // Copy-on-write file systems can share the data blocks.
+    if (inOffset == 0 && outOffset == 0 && ioctl(outFd, FICLONE, inFd) == 0)
+    {
+        if (progressCb)
+            progressCb(size, size);
+
+        return size;
+    }
+#endif
+
+#if defined(Q_OS_ANDROID)
+    bool useCopyFileRange = false; // only available from API 34
+#else
+    bool useCopyFileRange = true;
+#endif
+    qint64 copied = 0;
+
+    while (copied < size)
+    {
+        const size_t chunk = (size_t)std::min(size - copied, KERNEL_CHUNK_SIZE);
+        ssize_t n = -1;
+
+        if (useCopyFileRange)
+        {
+#if !defined(Q_OS_ANDROID)
+            loff_t inPos = inOffset + copied;
+            loff_t outPos = outOffset + copied;
+            n = copy_file_range(inFd, &inPos, outFd, &outPos, chunk, 0);
+
+            if (n < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP))
+            {
+                qDebug() << "copy_file_range not supported:" << errno;
+                useCopyFileRange = false;
+                continue;
+            }
+#endif
+        }
+        else
+        {
+            // sendfile writes at the current position of the output file.
+            if (lseek(outFd, outOffset + copied, SEEK_SET) < 0)
+                break;
+
+            off_t inPos = inOffset + copied;
+            n = sendfile(outFd, inFd, &inPos, chunk);
+        }
+
+        if (n <= 0)
+        {
+            qDebug() << "Kernel copy stopped:" << n << "errno:" << errno << "copied:" << copied;
+            break;
+        }
+
+        copied += n;
+
+        if (progressCb)
+            progressCb(copied, size);
+    }
+
+    return copied;
+#else
+    Q_UNUSED(inFd)
+    Q_UNUSED(outFd)
+    Q_UNUSED(inOffset)
+    Q_UNUSED(outOffset)
+    Q_UNUSED(size)
+    Q_UNUSED(progressCb)
+    return 0;
+#endif
+}
+
+qint64 FileCopier::copyBuffered(QFile& from, QFile& to, qint64 alreadyCopied, qint64 total,
+                                const ProgressCb& progressCb)
+{
+    QByteArray buffer(BUFFER_SIZE, Qt::Uninitialized);
+    qint64 copied = 0;
+
+    while (true)
+    {
+        const qint64 n = from.read(buffer.data(), buffer.size());
+
+        if (n < 0)
+        {
+            qWarning() << "Failed to read:" << from.fileName() << from.errorString();
+            return -1;
+        }
+
+        if (n == 0)
+            break;
+
+        if (to.write(buffer.constData(), n) != n)
+        {
+            qWarning() << "Failed to write:" << to.fileName() << to.errorString();
+            return -1;
+        }
+
+        copied += n;
+
+        if (progressCb)
+            progressCb(alreadyCopied + copied, std::max(total, alreadyCopied + copied));
+    }
+
+    return copied;
+}
+
+void FileCopier::copyAsync(const QString& fromFileName, const QString& toFileName,
+                           const ProgressCb& progressCb, const SuccessCb& successCb, const ErrorCb& errorCb)
+{
+    Q_ASSERT(successCb);
+    Q_ASSERT(errorCb);
+    auto* app = QCoreApplication::instance();
+
+    QThreadPool::globalInstance()->start([=]{
+        const auto postError = [app, errorCb](const QString& error){
+            QMetaObject::invokeMethod(app, [errorCb, error]{ errorCb(error); }, Qt::QueuedConnection);
+        };
+
+        QFile fromFile(fromFileName);
+
+        if (!fromFile.open(QFile::ReadOnly))
+        {
+            qWarning() << "Cannot open file:" << fromFileName << fromFile.errorString();
+            postError(QObject::tr("Cannot read file: %1").arg(fromFile.errorString()));
+            return;
+        }
+
+        QFile toFile(toFileName);
+
+        if (!toFile.open(QFile::WriteOnly))
+        {
+            qWarning() << "Cannot create file:" << toFileName << toFile.errorString();
+            postError(QObject::tr("Cannot write file: %1").arg(toFile.errorString()));
+            return;
+        }
+
+        int lastPercentage = -1;
+        const auto progress = [app, progressCb, &lastPercentage](qint64 copied, qint64 total){
+            if (!progressCb || total <= 0)
+                return;
+
+            const int percentage = (int)(copied * 100 / total);
+
+            if (percentage == lastPercentage)
+                return;
+
+            lastPercentage = percentage;
+            QMetaObject::invokeMethod(app, [progressCb, copied, total]{ progressCb(copied, total); }, Qt::QueuedConnection);
+        };
+
+        if (copy(fromFile, toFile, progress) < 0 || !toFile.flush())
+        {
+            const QString error = toFile.error() != QFile::NoError ? toFile.errorString() : fromFile.errorString();
+            toFile.close();
+            toFile.remove();
+            postError(QObject::tr("Failed to copy file: %1").arg(error));
+            return;
+        }
+
+        toFile.close();
+        QMetaObject::invokeMethod(app, [successCb]{ successCb(); }, Qt::QueuedConnection);
+    });
+}
+
+}
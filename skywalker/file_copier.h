@@ -0,0 +1,40 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QFile>
+#include <functional>
+
+namespace Skywalker {
+
+// Streaming file copy. The file is never held in memory as a whole. Where
+// available the kernel copies the data (reflink, copy_file_range, sendfile),
+// otherwise a fixed-size buffer is used.
+class FileCopier
+{
+public:
+    static constexpr qint64 BUFFER_SIZE = 256 * 1024;
+    static constexpr qint64 KERNEL_CHUNK_SIZE = 8 * 1024 * 1024;
+
+    using ProgressCb = std::function<void(qint64 bytesCopied, qint64 bytesTotal)>;
+    using SuccessCb = std::function<void()>;
+    using ErrorCb = std::function<void(const QString& error)>;
+
+    // Copies from the current position of from till the end, to the current
+    // position of to. Both files must be open. Progress is reported from the
+    // calling thread.
+    // Returns the number of bytes copied, -1 on failure.
+    static qint64 copy(QFile& from, QFile& to, const ProgressCb& progressCb = {}, bool kernelCopy = true);
+
+    // Copies on a background thread. The callbacks are called on the main thread.
+    // Progress is reported per percent. On failure the output file is removed.
+    static void copyAsync(const QString& fromFileName, const QString& toFileName,
+                          const ProgressCb& progressCb, const SuccessCb& successCb, const ErrorCb& errorCb);
+
+private:
+    static qint64 copyInKernel(int inFd, int outFd, qint64 inOffset, qint64 outOffset, qint64 size,
+                               const ProgressCb& progressCb);
+    static qint64 copyBuffered(QFile& from, QFile& to, qint64 alreadyCopied, qint64 total,
+                               const ProgressCb& progressCb);
+};
+
+}
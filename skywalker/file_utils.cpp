@@ -1,6 +1,7 @@
 // Copyright (C) 2024 Michel de Boer
 // License: GPLv3
 #include "file_utils.h"
+#include "file_copier.h"
 #include "temp_file_holder.h"
 #include <QDir>
 #include <QStandardPaths>
@@ -377,7 +378,7 @@ std::unique_ptr<QTemporaryFile> FileUtils::createTempFile(QFile& file, const QSt
     if (!tmpFile)
         return nullptr;
 
-    if (tmpFile->write(file.readAll()) < 0)
+    if (FileCopier::copy(file, *tmpFile) < 0)
     {
         const QString fileError = tmpFile->errorString();
         qWarning() << "Failed to write file to tmp file:" << fileError;
@@ -2,6 +2,7 @@
 // License: GPLv3
 #include "filtered_post_feed_model.h"
 #include "post_feed_model.h"
+#include "post_filter_evaluator.h"
 #include <ranges>
 
 namespace Skywalker {
@@ -43,17 +44,48 @@ void FilteredPostFeedModel::clear()
 }
 
 void FilteredPostFeedModel::setPosts(const TimelineFeed& posts, size_t numPosts)
+{
+    setPosts(posts, numPosts, matchPosts(posts, 0, numPosts));
+}
+
+void FilteredPostFeedModel::addPosts(const TimelineFeed& posts, size_t numPosts)
+{
+    addPosts(posts, numPosts, matchPosts(posts, 0, numPosts));
+}
+
+void FilteredPostFeedModel::prependPosts(const TimelineFeed& posts, size_t numPosts)
+{
+    prependPosts(posts, numPosts, matchPosts(posts, 0, numPosts));
+}
+
+void FilteredPostFeedModel::gapFill(const TimelineFeed& posts, size_t numPosts, int gapId)
+{
+    gapFill(posts, numPosts, gapId, matchPosts(posts, 0, numPosts));
+}
+
+void FilteredPostFeedModel::removeHeadPosts(const TimelineFeed& posts, size_t numPosts)
+{
+    removeHeadPosts(posts, numPosts, matchPosts(posts, 0, numPosts));
+}
+
+void FilteredPostFeedModel::removeTailPosts(const TimelineFeed& posts, size_t numPosts)
+{
+    Q_ASSERT(numPosts <= posts.size());
+    removeTailPosts(posts, numPosts, matchPosts(posts, posts.size() - numPosts, numPosts));
+}
+
+void FilteredPostFeedModel::setPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices)
 {
     Q_ASSERT(numPosts <= posts.size());
     clear();
-    addPosts(posts, numPosts);
+    addPosts(posts, numPosts, matchedIndices);
 }
 
-void FilteredPostFeedModel::addPosts(const TimelineFeed& posts, size_t numPosts)
+void FilteredPostFeedModel::addPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices)
 {
     Q_ASSERT(numPosts <= posts.size());
     qDebug() << "Add posts:" << getFeedName() << "posts:" << numPosts;
-    auto page = createPage(posts, 0, numPosts);
+    auto page = createPage(posts, 0, numPosts, matchedIndices);
 
     if (page->mFeed.empty())
         setNumPostsChecked(mNumPostsChecked + numPosts);
@@ -72,15 +104,15 @@ void FilteredPostFeedModel::addPosts(const TimelineFeed& posts, size_t numPosts)
     }
 }
 
-void FilteredPostFeedModel::prependPosts(const TimelineFeed& posts, size_t numPosts)
+void FilteredPostFeedModel::prependPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices)
 {
     Q_ASSERT(numPosts <= posts.size());
     qDebug() << "Prepend posts:" << getFeedName() << "posts:" << numPosts;
-    auto page = createPage(posts, 0, numPosts);
+    auto page = createPage(posts, 0, numPosts, matchedIndices);
     prependPage(std::move(page));
 }
 
-void FilteredPostFeedModel::gapFill(const TimelineFeed& posts, size_t numPosts, int gapId)
+void FilteredPostFeedModel::gapFill(const TimelineFeed& posts, size_t numPosts, int gapId, const std::vector<int>& matchedIndices)
 {
     qDebug() << "Fill gap:" << getFeedName() << gapId << "posts:" << numPosts;
 
@@ -109,7 +141,7 @@ void FilteredPostFeedModel::gapFill(const TimelineFeed& posts, size_t numPosts,
     endRemoveRows();
 
     qDebug() << "Removed place holder gap post:" << getFeedName() << gapIndex;
-    auto page = createPage(posts, 0, numPosts);
+    auto page = createPage(posts, 0, numPosts, matchedIndices);
 
     if (page->mFeed.empty())
     {
@@ -122,21 +154,21 @@ void FilteredPostFeedModel::gapFill(const TimelineFeed& posts, size_t numPosts,
     endInsertRows();
 }
 
-void FilteredPostFeedModel::removeHeadPosts(const TimelineFeed& posts, size_t numPosts)
+void FilteredPostFeedModel::removeHeadPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices)
 {
     Q_ASSERT(numPosts <= posts.size());
     qDebug() << "Remove head posts:" << getFeedName() << "posts:" << numPosts;
-    auto page = createPage(posts, 0, numPosts);
+    auto page = createPage(posts, 0, numPosts, matchedIndices);
     const size_t removeCount = page->mFeed.size();
     qDebug() << "Remove filtered head posts:" << getFeedName() << "num:" << removeCount;
     removePosts(0, removeCount);
 }
 
-void FilteredPostFeedModel::removeTailPosts(const TimelineFeed& posts, size_t numPosts)
+void FilteredPostFeedModel::removeTailPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices)
 {
     Q_ASSERT(numPosts <= posts.size());
     qDebug() << "Remove tail posts:" << getFeedName() << "posts:" << numPosts;
-    auto page = createPage(posts, posts.size() - numPosts, numPosts);
+    auto page = createPage(posts, posts.size() - numPosts, numPosts, matchedIndices);
     const size_t removeCount = page->mFeed.size();
     qDebug() << "Remove filtered tail posts:" << getFeedName() << "num:" << removeCount;
     removePosts(mFeed.size() - removeCount, removeCount);
@@ -245,33 +277,40 @@ int FilteredPostFeedModel::Page::addThread(const TimelineFeed& posts, int startI
     return endThread;
 }
 
-FilteredPostFeedModel::Page::Ptr FilteredPostFeedModel::createPage(const TimelineFeed& posts, int startIndex, size_t numPosts)
+std::vector<int> FilteredPostFeedModel::matchPosts(const TimelineFeed& posts, int startIndex, size_t numPosts) const
+{
+    PostFilterEvaluator evaluator({ mPostFilter.get() });
+    evaluator.evaluate(posts, startIndex, numPosts);
+    return evaluator.getMatchedIndices(0);
+}
+
+FilteredPostFeedModel::Page::Ptr FilteredPostFeedModel::createPage(const TimelineFeed& posts, int startIndex, size_t numPosts,
+                                                                   const std::vector<int>& matchedIndices)
 {
     Q_ASSERT(startIndex + numPosts <= posts.size());
     auto page = std::make_unique<Page>();
+    int lastAddedIndex = startIndex - 1;
 
-    for (int i = startIndex; i < startIndex + (int)numPosts; ++i)
+    for (const int i : matchedIndices)
     {
-        const auto& post = posts[i];
+        Q_ASSERT(i >= startIndex && i < startIndex + (int)numPosts);
 
-        // By copying all gaps from the full time line, we can fill them in when they
-        // get filled in the full timeline.
-        if (post.isGap())
-        {
-            page->addPost(&post);
+        // Already added as part of a thread
+        if (i <= lastAddedIndex)
             continue;
-        }
 
-        if (!mPostFilter->match(post))
-            continue;
+        const auto& post = posts[i];
 
-        if (post.getPostType() == QEnums::POST_STANDALONE || !mPostFilter->mustAddThread())
+        // By copying all gaps from the full time line, we can fill them in when they
+        // get filled in the full timeline.
+        if (post.isGap() || post.getPostType() == QEnums::POST_STANDALONE || !mPostFilter->mustAddThread())
         {
             page->addPost(&post);
+            lastAddedIndex = i;
             continue;
         }
 
-        i = page->addThread(posts, startIndex, numPosts, i);
+        lastAddedIndex = page->addThread(posts, startIndex, numPosts, i);
     }
 
     return page;
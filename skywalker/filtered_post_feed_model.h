@@ -36,6 +36,15 @@ public:
     void removeHeadPosts(const TimelineFeed& posts, size_t numPosts);
     void removeTailPosts(const TimelineFeed& posts, size_t numPosts);
 
+    // The same functions with the indices of the posts matching the post filter,
+    // as computed by a PostFilterEvaluator for all filtered models at once.
+    void setPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices);
+    void addPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices);
+    void prependPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices);
+    void gapFill(const TimelineFeed& posts, size_t numPosts, int gapId, const std::vector<int>& matchedIndices);
+    void removeHeadPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices);
+    void removeTailPosts(const TimelineFeed& posts, size_t numPosts, const std::vector<int>& matchedIndices);
+
     void setEndOfFeed(bool endOfFeed) override;
 
     Q_INVOKABLE void getFeed(IFeedPager* pager);
@@ -55,7 +64,8 @@ private:
         int addThread(const TimelineFeed& posts, int startIndex, size_t numPosts, int matchedPostIndex);
     };
 
-    Page::Ptr createPage(const TimelineFeed& posts, int startIndex, size_t numPosts);
+    std::vector<int> matchPosts(const TimelineFeed& posts, int startIndex, size_t numPosts) const;
+    Page::Ptr createPage(const TimelineFeed& posts, int startIndex, size_t numPosts, const std::vector<int>& matchedIndices);
     void insertPage(const TimelineFeed::iterator& feedInsertIt, const Page& page);
     void addPage(Page::Ptr page);
     void prependPage(Page::Ptr page);
@@ -302,6 +302,17 @@ std::set<QString> FocusHashtags::getNormalizedMatchHashtags(const NormalizedWord
     return matchHashtags;
 }
 
+std::vector<QString> FocusHashtags::getNormalizedHashtags() const
+{
+    std::vector<QString> hashtags;
+    hashtags.reserve(mAllHashtags.size());
+
+    for (const auto& [normalizedTag, _] : mAllHashtags)
+        hashtags.push_back(normalizedTag);
+
+    return hashtags;
+}
+
 void FocusHashtags::save(const QString& did, UserSettings* settings) const
 {
     Q_ASSERT(settings);
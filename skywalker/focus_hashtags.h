@@ -84,6 +84,7 @@ public:
 
     FocusHashtagEntryList getMatchEntries(const NormalizedWordIndex& post) const;
     std::set<QString> getNormalizedMatchHashtags(const NormalizedWordIndex& post) const;
+    std::vector<QString> getNormalizedHashtags() const;
 
     Q_INVOKABLE void save(const QString& did, UserSettings* settings) const;
     Q_INVOKABLE void load(const QString& did, const UserSettings* settings);
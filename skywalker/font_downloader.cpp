@@ -2,6 +2,7 @@
 // License: GPLv3
 #include "font_downloader.h"
 #include "file_utils.h"
+#include "startup_tracer.h"
 #include "temp_file_holder.h"
 #include "unicode_fonts.h"
 #include "user_settings.h"
@@ -35,6 +36,7 @@ QFont FontDownloader::getEmojiFont()
 
 void FontDownloader::initAppFonts()
 {
+    StartupTracer::beginPhase("initAppFonts");
     UserSettings userSettings;
 
     addApplicationFonts();
@@ -62,6 +64,7 @@ void FontDownloader::initAppFonts()
     qInfo() << "Font emoji source:" << getEmojiFontSource();
 
     ATProto::RichTextMaster::setHtmlCleanup([](const QString& s){ return UnicodeFonts::setEmojiFontCombinedEmojis(s); });
+    StartupTracer::endPhase("initAppFonts");
 }
 
 void FontDownloader::addFont(const QString& fontFileName)
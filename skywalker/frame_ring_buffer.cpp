@@ -0,0 +1,74 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "frame_ring_buffer.h"
+#include <algorithm>
+
+namespace Skywalker {
+
+FrameRingBuffer::FrameRingBuffer(int capacity) :
+    mFrames(std::max(capacity, 1))
+{
+}
+
+bool FrameRingBuffer::push(QImage frame)
+{
+    QMutexLocker locker(&mMutex);
+    Q_ASSERT(!mClosed);
+
+    while (mCount == capacity() && !mCanceled)
+        mNotFull.wait(&mMutex);
+
+    if (mCanceled)
+        return false;
+
+    mFrames[(mHead + mCount) % capacity()] = std::move(frame);
+    ++mCount;
+    mNotEmpty.wakeOne();
+    return true;
+}
+
+std::optional<QImage> FrameRingBuffer::pop()
+{
+    QMutexLocker locker(&mMutex);
+
+    while (mCount == 0 && !mClosed && !mCanceled)
+        mNotEmpty.wait(&mMutex);
+
+    if (mCanceled || mCount == 0)
+        return {};
+
+    QImage frame = std::move(mFrames[mHead]);
+    mFrames[mHead] = QImage();
+    mHead = (mHead + 1) % capacity();
+    --mCount;
+    mNotFull.wakeOne();
+    return frame;
+}
+
+void FrameRingBuffer::close()
+{
+    QMutexLocker locker(&mMutex);
+    mClosed = true;
+    mNotEmpty.wakeAll();
+}
+
+void FrameRingBuffer::cancel()
+{
+    QMutexLocker locker(&mMutex);
+    mCanceled = true;
+
+    for (auto& frame : mFrames)
+        frame = QImage();
+
+    mCount = 0;
+    mNotFull.wakeAll();
+    mNotEmpty.wakeAll();
+}
+
+int FrameRingBuffer::size() const
+{
+    QMutexLocker locker(&mMutex);
+    return mCount;
+}
+
+}
@@ -0,0 +1,46 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QImage>
+#include <QMutex>
+#include <QWaitCondition>
+#include <optional>
+#include <vector>
+
+namespace Skywalker {
+
+// Bounded queue of frames between a producer and a consumer thread. The
+// producer blocks when the buffer is full, the consumer when it is empty,
+// such that decoding runs ahead of encoding by at most capacity frames.
+class FrameRingBuffer
+{
+public:
+    explicit FrameRingBuffer(int capacity);
+
+    // Returns false if the buffer got canceled.
+    bool push(QImage frame);
+
+    // Returns nullopt when the buffer is closed and empty, or canceled.
+    std::optional<QImage> pop();
+
+    // No more frames will be pushed. The consumer gets the remaining frames.
+    void close();
+
+    // Stop producer and consumer. Remaining frames are dropped.
+    void cancel();
+
+    int capacity() const { return mFrames.size(); }
+    int size() const;
+
+private:
+    std::vector<QImage> mFrames;
+    int mHead = 0; // next frame to pop
+    int mCount = 0;
+    bool mClosed = false;
+    bool mCanceled = false;
+    mutable QMutex mMutex;
+    QWaitCondition mNotFull;
+    QWaitCondition mNotEmpty;
+};
+
+}
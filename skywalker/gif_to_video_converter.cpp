@@ -9,6 +9,11 @@ namespace Skywalker {
 constexpr int VIDEO_BIT_RATE_SD = 4'000'000;
 constexpr int VIDEO_BIT_RATE_HD = 8'000'000;
 
+GifToVideoConverter::GifToVideoConverter(QObject* parent) :
+    QObject(parent)
+{
+}
+
 void GifToVideoConverter::convert(const QString& gifFileName)
 {
     qDebug() << "Convert:" << gifFileName;
@@ -42,6 +47,7 @@ void GifToVideoConverter::convert(const QString& gifFileName)
     }
 
     qDebug() << "Frame count:" << mGif->frameCount();
+    mFrameCount = mGif->frameCount();
 
     // Frames start at 0, but the delay between frame 0 and 1 seems not always right
     mGif->jumpToFrame(0);
@@ -86,58 +92,90 @@ void GifToVideoConverter::convert(const QString& gifFileName)
 
     int maxSize = std::max(width, height);
     const int bitRate = maxSize <= 720 ? VIDEO_BIT_RATE_SD : VIDEO_BIT_RATE_HD;
-    mVideoEncoder = std::make_unique<VideoEncoder>();
+    mVideoEncoder = mEncoderFactory();
 
     if (!mVideoEncoder->open(mVideoFile->fileName(), width, height, fps, bitRate))
     {
         qWarning() << "Cannot encode video";
+        mVideoEncoder = nullptr;
         emit conversionFailed("Cannot encode video");
         return;
     }
 
-    startThread();
+    startThreads();
 }
 
 void GifToVideoConverter::cancel()
 {
     qDebug() << "Cancel";
     mCanceled = true;
+
+    if (mFrameBuffer)
+        mFrameBuffer->cancel();
 }
 
-void GifToVideoConverter::startThread()
+void GifToVideoConverter::startThreads()
 {
     mCanceled = false;
-    QThread* thread = QThread::create([this]{ mConversionDone = pushFrames(); });
-
-    if (!thread)
+    mDecodeDone = false;
+    mEncodeDone = false;
+    mEncodedFrames = 0;
+    mFrameBuffer = std::make_unique<FrameRingBuffer>(FRAME_BUFFER_SIZE);
+    std::unique_ptr<QThread> decodeThread(QThread::create([this]{ mDecodeDone = decodeFrames(); }));
+    std::unique_ptr<QThread> encodeThread(QThread::create([this]{ mEncodeDone = encodeFrames(); }));
+
+    if (!decodeThread || !encodeThread)
     {
         qWarning() << "Failed to start thread";
+        mVideoEncoder->close();
+        mVideoEncoder = nullptr;
+        mFrameBuffer = nullptr;
         emit conversionFailed("Failed to start thread");
         return;
     }
 
-    mThread.reset(thread);
-    connect(thread, &QThread::finished, this, [this]{ finished(); }, Qt::SingleShotConnection);
-    mThread->start();
+    mDecodeThread = std::move(decodeThread);
+    mEncodeThread = std::move(encodeThread);
+    connect(mDecodeThread.get(), &QThread::finished, this, [this]{ threadFinished(); }, Qt::SingleShotConnection);
+    connect(mEncodeThread.get(), &QThread::finished, this, [this]{ threadFinished(); }, Qt::SingleShotConnection);
+    mConversionTimer.start();
+    mDecodeThread->start();
+    mEncodeThread->start();
+}
+
+void GifToVideoConverter::threadFinished()
+{
+    // Both threads report finished, the last one completes the conversion.
+    if (!mDecodeThread || !mEncodeThread)
+        return;
+
+    if (!mDecodeThread->isFinished() || !mEncodeThread->isFinished())
+        return;
+
+    finished();
 }
 
 void GifToVideoConverter::finished()
 {
-    mVideoEncoder->close();
+    mDecodeThread->wait();
+    mEncodeThread->wait();
+    mDecodeThread = nullptr;
+    mEncodeThread = nullptr;
+    mFrameBuffer = nullptr;
     mVideoEncoder = nullptr;
-    mThread->wait();
-    mThread = nullptr;
 
     if (mCanceled)
         return;
 
-    if (!mConversionDone)
+    if (!mDecodeDone || !mEncodeDone)
     {
         emit conversionFailed("Conversion failed");
         return;
     }
 
-    qDebug() << "Conversion finished";
+    const qint64 elapsedMs = mConversionTimer.elapsed();
+    qDebug() << "Conversion finished, frames:" << mEncodedFrames << "ms:" << elapsedMs
+             << "fps:" << (elapsedMs > 0 ? mEncodedFrames * 1000.0 / elapsedMs : 0.0);
     mVideoFile->flush();
     mVideoFile->close();
     const QString fileName = mVideoFile->fileName();
@@ -145,44 +183,78 @@ void GifToVideoConverter::finished()
     emit conversionOk(fileName);
 }
 
-bool GifToVideoConverter::pushFrames()
+bool GifToVideoConverter::decodeFrames()
 {
-    qDebug() << "Push frames to video encoder";
+    qDebug() << "Decode frames";
     mGif->jumpToFrame(0);
-    const int frameCount = mGif->frameCount();
     int frameIndex = 0;
 
     do {
-        qDebug() << "Push frame:" << frameIndex << "/" << frameCount << "next frame delay:" << mGif->nextFrameDelay();
+        qDebug() << "Decode frame:" << frameIndex << "/" << mFrameCount << "next frame delay:" << mGif->nextFrameDelay();
         QImage frame = mGif->currentImage();
 
         if (frame.isNull())
         {
             qWarning() << "Failed to read frame:" << frameIndex;
+            mFrameBuffer->cancel();
             return false;
         }
 
         frame.convertTo(QImage::Format_RGBA8888); // must match format in QVideoEncoder.java
 
-        if (!mVideoEncoder->push(frame))
+        if (!mFrameBuffer->push(std::move(frame)))
         {
-            qWarning() << "Failed to push frame to video enoder:" << frameIndex;
+            qDebug() << "Frame buffer canceled";
             return false;
         }
 
-        emit conversionProgress(frameIndex / double(frameCount));
-
         if (mCanceled)
         {
             qDebug() << "Canceled";
             return false;
         }
-    } while (mGif->jumpToNextFrame() && ++frameIndex <= frameCount);
+    } while (mGif->jumpToNextFrame() && ++frameIndex <= mFrameCount);
     // Frames start counting at zero still there is a frame at index frameCount.
     // Seems frame 0 is not counted in the count??
 
-    qDebug() << "All frames pushed";
+    qDebug() << "All frames decoded";
+    mFrameBuffer->close();
     return true;
 }
 
+bool GifToVideoConverter::encodeFrames()
+{
+    qDebug() << "Push frames to video encoder";
+    bool pushed = true;
+
+    while (const auto frame = mFrameBuffer->pop())
+    {
+        if (!mVideoEncoder->push(*frame))
+        {
+            qWarning() << "Failed to push frame to video enoder:" << mEncodedFrames;
+            mFrameBuffer->cancel();
+            pushed = false;
+            break;
+        }
+
+        ++mEncodedFrames;
+        emit conversionProgress(std::min(mEncodedFrames / double(mFrameCount), 1.0));
+    }
+
+    // The encoder must be closed before the video file is complete.
+    const bool closed = mVideoEncoder->close();
+
+    if (!closed)
+        qWarning() << "Failed to close video encoder";
+
+    if (mCanceled)
+    {
+        qDebug() << "Canceled";
+        return false;
+    }
+
+    qDebug() << "All frames pushed:" << mEncodedFrames;
+    return pushed && closed;
+}
+
 }
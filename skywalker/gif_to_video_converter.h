@@ -1,8 +1,10 @@
 // Copyright (C) 2024 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "frame_ring_buffer.h"
 #include "video_encoder.h"
 #include <QAtomicInt>
+#include <QElapsedTimer>
 #include <QMovie>
 #include <QObject>
 #include <QTemporaryFile>
@@ -17,6 +19,16 @@ class GifToVideoConverter : public QObject
     QML_ELEMENT
 
 public:
+    using EncoderFactory = std::function<VideoEncoder::Ptr()>;
+
+    // Number of decoded frames that can wait for the encoder
+    static constexpr int FRAME_BUFFER_SIZE = 8;
+
+    explicit GifToVideoConverter(QObject* parent = nullptr);
+
+    // Replaces the platform encoder, e.g. for testing.
+    void setEncoderFactory(const EncoderFactory& encoderFactory) { mEncoderFactory = encoderFactory; }
+
     Q_INVOKABLE void convert(const QString& gifFileName);
     Q_INVOKABLE void cancel();
 
@@ -26,16 +38,28 @@ signals:
     void conversionProgress(double progress); // 0.0 => 1.0
 
 private:
-    void startThread();
+    void startThreads();
+    void threadFinished();
     void finished();
-    bool pushFrames();
+    bool decodeFrames();
+    bool encodeFrames();
 
-    std::unique_ptr<VideoEncoder> mVideoEncoder;
+    EncoderFactory mEncoderFactory = &VideoEncoder::create;
+    VideoEncoder::Ptr mVideoEncoder;
     std::unique_ptr<QMovie> mGif;
     std::unique_ptr<QTemporaryFile> mVideoFile;
-    std::unique_ptr<QThread> mThread;
-    bool mConversionDone = false;
+    std::unique_ptr<FrameRingBuffer> mFrameBuffer;
+
+    // The decode thread reads and color converts GIF frames, while the encode
+    // thread pushes them to the video encoder.
+    std::unique_ptr<QThread> mDecodeThread;
+    std::unique_ptr<QThread> mEncodeThread;
+    int mFrameCount = 0;
+    int mEncodedFrames = 0;
+    bool mDecodeDone = false;
+    bool mEncodeDone = false;
     QAtomicInteger<bool> mCanceled = false;
+    QElapsedTimer mConversionTimer;
 };
 
 }
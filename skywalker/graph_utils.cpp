@@ -13,8 +13,6 @@ namespace Skywalker {
 
 using namespace std::chrono_literals;
 
-static constexpr auto EXPIRY_CHECK_INTERVAL = 59s;
-
 GraphUtils::GraphUtils(QObject* parent) :
     WrappedSkywalker(parent),
     Presence()
@@ -29,21 +27,53 @@ GraphUtils::GraphUtils(QObject* parent) :
                     mGraphMaster = nullptr;
                 });
     });
-
-    connect(&mExpiryCheckTimer, &QTimer::timeout, this, [this]{ checkExpiry(); });
 }
 
-void GraphUtils::startExpiryCheckTimer()
+void GraphUtils::startExpiryCheck()
 {
-    qDebug() << "Start expiry check timer";
-    mExpiryCheckTimer.start(EXPIRY_CHECK_INTERVAL);
-    checkExpiry();
+    qDebug() << "Start expiry check";
+    mExpiryCheckActive = true;
+
+    if (!mSkywalker)
+    {
+        qWarning() << "Skywalker not set";
+        return;
+    }
+
+    // The sets of the active user get recreated when the user changes.
+    auto* settings = mSkywalker->getUserSettings();
+
+    // Entries that expired while the check was not active are signalled on
+    // activation.
+    if (auto* blocks = settings->getBlocksWithExpiry())
+    {
+        connect(blocks, &UriWithExpirySet::expired, this, &GraphUtils::expireBlocks, Qt::UniqueConnection);
+        blocks->setActive(true);
+    }
+
+    if (auto* mutes = settings->getMutesWithExpiry())
+    {
+        connect(mutes, &UriWithExpirySet::expired, this, &GraphUtils::expireMutes, Qt::UniqueConnection);
+        mutes->setActive(true);
+    }
 }
 
-void GraphUtils::stopExpiryCheckTimer()
+void GraphUtils::stopExpiryCheck()
 {
-    qDebug() << "Stop expiry check timer";
-    mExpiryCheckTimer.stop();
+    qDebug() << "Stop expiry check";
+    mExpiryCheckActive = false;
+
+    if (!mSkywalker)
+        return;
+
+    // Stop the retries of expired entries till the check is started again.
+    auto* settings = mSkywalker->getUserSettings();
+
+    if (auto* blocks = settings->getBlocksWithExpiry())
+        blocks->setActive(false);
+
+    if (auto* mutes = settings->getMutesWithExpiry())
+        mutes->setActive(false);
 }
 
 ATProto::GraphMaster* GraphUtils::graphMaster()
@@ -615,7 +645,7 @@ void GraphUtils::deleteList(const QString& listUri)
 ListViewBasic GraphUtils::getCachedListView(const QString& listUri)
 {
     auto& listCache = ListCache::instance();
-    const auto* list = listCache.get(listUri);
+    const auto list = listCache.get(listUri);
 
     if (list)
         return *list;
@@ -628,7 +658,7 @@ ListViewBasic GraphUtils::getCachedListView(const QString& listUri)
             if (!presence)
                 return;
 
-            const auto* list = ListCache::instance().get(listUri);
+            const auto list = ListCache::instance().get(listUri);
             Q_ASSERT(list);
 
             if (list)
@@ -1024,7 +1054,7 @@ void GraphUtils::expireBlocks()
 {
     qDebug() << "Check blocks expiry";
 
-    if (!mExpiryCheckTimer.isActive())
+    if (!mExpiryCheckActive)
     {
         qDebug() << "Expiry check is not active";
         return;
@@ -1061,7 +1091,7 @@ void GraphUtils::expireMutes()
 {
     qDebug() << "Check mutes expiry";
 
-    if (!mExpiryCheckTimer.isActive())
+    if (!mExpiryCheckActive)
     {
         qDebug() << "Expiry check is not active";
         return;
@@ -1094,10 +1124,4 @@ void GraphUtils::expireMutes()
         unmute(uriWithExpiry->getUri());
 }
 
-void GraphUtils::checkExpiry()
-{
-    expireBlocks();
-    expireMutes();
-}
-
 }
@@ -8,7 +8,6 @@
 #include "web_link.h"
 #include "wrapped_skywalker.h"
 #include <atproto/lib/graph_master.h>
-#include <QTimer>
 
 namespace Skywalker {
 
@@ -72,8 +71,10 @@ public:
     // Check if a list is a list internally used by Skywalker
     static bool isInternalList(const QString& listUri);
 
-    void startExpiryCheckTimer();
-    void stopExpiryCheckTimer();
+    // Mutes and blocks with expiry are only undone while the expiry check
+    // is active.
+    void startExpiryCheck();
+    void stopExpiryCheck();
 
 signals:
     void followOk(QString uri);
@@ -132,11 +133,10 @@ private:
     void continueCreateListFromStarterPack(const StarterPackView& starterPack, const QString &listUri, const QString& listCid, int maxPages = 3, const std::optional<QString> cursor = {});
     void expireBlocks();
     void expireMutes();
-    void checkExpiry();
 
     ATProto::GraphMaster* graphMaster();
     std::unique_ptr<ATProto::GraphMaster> mGraphMaster;
-    QTimer mExpiryCheckTimer;
+    bool mExpiryCheckActive = false;
     bool mBlockBusy = false;
     bool mMuteBusy = false;
 };
@@ -5,22 +5,11 @@
 
 namespace Skywalker {
 
-HashtagIndex::Entry::Entry(HashtagIndex* index, const QString& hashtag) :
-    mHashtagIndex(index),
-    mHashtag(hashtag),
-    mNormalized(SearchUtils::normalizeText(hashtag))
-{
-}
-
-HashtagIndex::Entry::~Entry()
-{
-    if (mHashtagIndex)
-        mHashtagIndex->removeFromIndex(mHashtag, mNormalized);
-}
-
 HashtagIndex::HashtagIndex(int maxEntries) :
-    mCache(maxEntries)
+    mCache("HashtagIndex", maxEntries)
 {
+    mCache.setEvictedCallback([this](const QString& hashtag, const QString& normalized){
+        removeFromIndex(hashtag, normalized); });
 }
 
 void HashtagIndex::clear()
@@ -33,15 +22,13 @@ void HashtagIndex::clear()
 void HashtagIndex::insert(const QString& hashtag)
 {
     qDebug() << "Insert hashtag:" << hashtag;
-    auto* entry = new Entry(this, hashtag);
-    const QString normalized = entry->getNormalized();
-    mCache.insert(hashtag, entry);
+    const QString normalized = SearchUtils::normalizeText(hashtag);
 
     // Adding to index must be done after insert in cache.
-    // If the entry already exists, then the cache will destroy the new entry which triggers
-    // removed from the index. The index not be removed as there is already an entry in the
-    // cache. addToIndex will re-insert in that case.
-    addToIndex(hashtag, normalized);
+    // Inserting may evict the least recently used hashtag, which removes
+    // it from the index.
+    if (mCache.insert(hashtag, normalized))
+        addToIndex(hashtag, normalized);
     setDirty(true);
 }
 
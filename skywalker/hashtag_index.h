@@ -1,8 +1,7 @@
 // Copyright (C) 2024 Michel de Boer
 // License: GPLv3
 #pragma once
-#include <QCache>
-#include <QObject>
+#include "memory_cache.h"
 #include <QString>
 #include <map>
 #include <set>
@@ -24,21 +23,6 @@ public:
     void setDirty(bool dirty) { mDirty = dirty; }
 
 private:
-    class Entry : public QObject
-    {
-    public:
-        Entry() = default;
-        Entry(HashtagIndex* index, const QString& hashtag);
-        ~Entry();
-
-        const QString& getNormalized() const { return mNormalized; }
-
-    private:
-        HashtagIndex* mHashtagIndex = nullptr;
-        QString mHashtag;
-        QString mNormalized;
-    };
-
     void addToIndex(const QString& hashtag, const QString& normalized);
     void removeFromIndex(const QString& hashtag, const QString& normalized);
     void findFullMatch(const QString& normalized, int limit, QStringList& result,
@@ -49,8 +33,9 @@ private:
     // normalized hashtag -> hashtags
     std::map<QString, std::set<QString>> mIndex;
 
-    // hashtag -> Entry
-    QCache<QString, Entry> mCache;
+    // hashtag -> normalized hashtag
+    // The index is persisted as a list of hashtags, so the cost is 1 per entry.
+    MemoryCache<QString, QString> mCache;
 
     bool mDirty = false;
 };
@@ -2,6 +2,7 @@
 // License: GPLv3
 #include "image_reader.h"
 #include "photo_picker.h"
+#include <QBuffer>
 #include <QImageReader>
 
 namespace Skywalker {
@@ -51,6 +52,23 @@ bool ImageReader::getImageFromWeb(const QString& urlString, const ImageCb& image
         return false;
     }
 
+    if (mAvatarStore && AvatarStore::isAvatar(url.toString()))
+    {
+        mAvatarStore->get(url.toString(),
+            [this, url, imageCb, errorCb](const QByteArray& data){
+                QBuffer buffer;
+                buffer.setData(data);
+                buffer.open(QBuffer::ReadOnly);
+                readImage(&buffer, url, imageCb, errorCb);
+            },
+            [errorCb](const QString& error){
+                if (errorCb)
+                    errorCb(error);
+            });
+
+        return true;
+    }
+
     QNetworkRequest request(url);
     QNetworkReply* reply = mNetwork->get(request);
 
@@ -73,13 +91,18 @@ void ImageReader::replyFinished(QNetworkReply* reply, const ImageCb& imageCb, co
         return;
     }
 
-    QImageReader reader(reply);
+    readImage(reply, reply->request().url(), imageCb, errorCb);
+}
+
+void ImageReader::readImage(QIODevice* device, const QUrl& url, const ImageCb& imageCb, const ErrorCb& errorCb)
+{
+    QImageReader reader(device);
     reader.setAutoTransform(true);
     QImage img = reader.read();
 
     if (img.isNull())
     {
-        qWarning() << "Failed to read:" << reply->request().url();
+        qWarning() << "Failed to read:" << url;
         if (errorCb)
             errorCb(tr("Could not read image"));
 
@@ -1,6 +1,7 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "avatar_store.h"
 #include <QImage>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
@@ -21,10 +22,15 @@ public:
 
     bool getImageFromWeb(const QString& urlString, const ImageCb& imageCb, const ErrorCb& errorCb);
 
+    // When set, avatar images are read through the store.
+    void setAvatarStore(const std::shared_ptr<AvatarStore>& store) { mAvatarStore = store; }
+
 private:
     void replyFinished(QNetworkReply* reply, const ImageCb& imageCb, const ErrorCb& errorCb);
+    void readImage(QIODevice* device, const QUrl& url, const ImageCb& imageCb, const ErrorCb& errorCb);
 
     QNetworkAccessManager* mNetwork;
+    std::shared_ptr<AvatarStore> mAvatarStore;
 };
 
 }
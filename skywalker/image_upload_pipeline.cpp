@@ -0,0 +1,192 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "image_upload_pipeline.h"
+#include "photo_picker.h"
+#include <QCoreApplication>
+#include <QThreadPool>
+
+namespace Skywalker {
+
+ImageUploadPipeline::SharedPtr ImageUploadPipeline::create(const UploadFun& uploadFun, const EncodeFun& encodeFun,
+                                                           const LoadFun& loadFun)
+{
+    return SharedPtr(new ImageUploadPipeline(uploadFun, encodeFun, loadFun));
+}
+
+ImageUploadPipeline::ImageUploadPipeline(const UploadFun& uploadFun, const EncodeFun& encodeFun,
+                                         const LoadFun& loadFun) :
+    mUploadFun(uploadFun),
+    mEncodeFun(encodeFun),
+    mLoadFun(loadFun)
+{
+    Q_ASSERT(mUploadFun);
+
+    if (!mEncodeFun)
+    {
+        mEncodeFun = [](QByteArray& blob, QImage img, const QString& name){
+            return PhotoPicker::createBlob(blob, img, name);
+        };
+    }
+
+    if (!mLoadFun)
+        mLoadFun = [](const QString& name){ return PhotoPicker::loadImage(name); };
+}
+
+void ImageUploadPipeline::start(std::vector<Image> images, const SuccessCb& successCb, const ErrorCb& errorCb)
+{
+    Q_ASSERT(!mStarted);
+    Q_ASSERT(successCb);
+    Q_ASSERT(errorCb);
+
+    if (mStarted)
+    {
+        qWarning() << "Pipeline already started";
+        return;
+    }
+
+    mStarted = true;
+    mSuccessCb = successCb;
+    mErrorCb = errorCb;
+    mResult.resize(images.size());
+
+    if (images.empty())
+    {
+        mSuccessCb({});
+        return;
+    }
+
+    qDebug() << "Start image upload pipeline, images:" << images.size() << "max in flight:" << mMaxInFlight
+             << "max encodes in flight:" << mMaxEncodesInFlight;
+
+    mImages = std::move(images);
+    startEncodes();
+}
+
+void ImageUploadPipeline::cancel()
+{
+    if (mCancelled || mDone)
+        return;
+
+    qDebug() << "Cancel image upload pipeline, uploaded:" << mUploaded << "in flight:" << mInFlight;
+    mCancelled = true;
+    mUploadQueue.clear();
+    mImages.clear();
+}
+
+void ImageUploadPipeline::startEncodes()
+{
+    while (!mCancelled && mEncodesInFlight < mMaxEncodesInFlight && mNextEncode < (int)mImages.size())
+    {
+        const int index = mNextEncode++;
+        ++mEncodesInFlight;
+
+        // The worker owns the image from here.
+        encode(index, std::move(mImages[index]));
+    }
+}
+
+void ImageUploadPipeline::encode(int index, Image image)
+{
+    // Loading and encoding is CPU intensive (decoding, scaling and compression).
+    // The result is posted back to the GUI thread, the pipeline stays alive till then.
+    QThreadPool::globalInstance()->start(
+        [self=shared_from_this(), index, image=std::move(image)]{
+            QByteArray blob;
+            QString mimeType;
+            QSize size;
+
+            if (!self->mCancelled)
+            {
+                const QImage img = image.mImage.isNull() ? self->mLoadFun(image.mName) : image.mImage;
+
+                if (!img.isNull())
+                    std::tie(mimeType, size) = self->mEncodeFun(blob, img, image.mName);
+            }
+
+            QMetaObject::invokeMethod(QCoreApplication::instance(),
+                [self, index, blob, mimeType, size]{
+                    self->encoded(index, blob, mimeType, size);
+                },
+                Qt::QueuedConnection);
+        });
+}
+
+void ImageUploadPipeline::encoded(int index, QByteArray blob, const QString& mimeType, QSize size)
+{
+    --mEncodesInFlight;
+
+    if (mCancelled)
+        return;
+
+    if (blob.isEmpty())
+    {
+        failed(index, ERROR_ENCODE_FAILED, QString("Could not load image #%1").arg(index + 1));
+        return;
+    }
+
+    startEncodes();
+
+    mResult[index].mSize = size;
+
+    // Keep the upload order close to the image order.
+    auto it = std::find_if(mUploadQueue.begin(), mUploadQueue.end(),
+                           [index](const auto& img){ return img.mIndex > index; });
+    mUploadQueue.insert(it, EncodedImage{ index, std::move(blob), mimeType });
+    startUploads();
+}
+
+void ImageUploadPipeline::startUploads()
+{
+    while (!mCancelled && mInFlight < mMaxInFlight && !mUploadQueue.empty())
+    {
+        auto img = std::move(mUploadQueue.front());
+        mUploadQueue.pop_front();
+        ++mInFlight;
+        const int index = img.mIndex;
+
+        mUploadFun(img.mBlob, img.mMimeType,
+            [self=shared_from_this(), index](ATProto::Blob::SharedPtr blob){
+                self->uploaded(index, std::move(blob));
+            },
+            [self=shared_from_this(), index](const QString& error, const QString& msg){
+                --self->mInFlight;
+                self->failed(index, error, msg);
+            });
+    }
+}
+
+void ImageUploadPipeline::uploaded(int index, ATProto::Blob::SharedPtr blob)
+{
+    --mInFlight;
+
+    if (mCancelled || mDone)
+        return;
+
+    mResult[index].mBlob = std::move(blob);
+    ++mUploaded;
+
+    if (mProgressCb)
+        mProgressCb(mUploaded, (int)mResult.size());
+
+    if (mUploaded < (int)mResult.size())
+    {
+        startUploads();
+        return;
+    }
+
+    qDebug() << "Image upload pipeline done, images:" << mResult.size();
+    mDone = true;
+    mSuccessCb(std::move(mResult));
+}
+
+void ImageUploadPipeline::failed(int index, const QString& error, const QString& msg)
+{
+    if (mCancelled || mDone)
+        return;
+
+    qWarning() << "Image upload failed, index:" << index << "error:" << error << "-" << msg;
+    cancel();
+    mErrorCb(index, error, msg);
+}
+
+}
@@ -0,0 +1,118 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <atproto/lib/lexicon/lexicon.h>
+#include <QByteArray>
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace Skywalker {
+
+// Uploads a set of images for a post. The images are loaded and encoded in
+// parallel on the global thread pool, with a limited number of images in flight
+// as a decoded full size image takes a lot of memory. Uploads start as soon as an
+// image is encoded with a limited number of uploads in flight. The result is
+// delivered in the original order once all images are uploaded.
+//
+// The pipeline keeps itself alive till all callbacks are done. The callbacks
+// are called on the thread that started the pipeline, i.e. the GUI thread.
+class ImageUploadPipeline : public std::enable_shared_from_this<ImageUploadPipeline>
+{
+public:
+    using SharedPtr = std::shared_ptr<ImageUploadPipeline>;
+
+    static constexpr int MAX_UPLOADS_IN_FLIGHT = 3;
+    static constexpr int MAX_ENCODES_IN_FLIGHT = 2;
+
+    // Error code for an image that could not be loaded or encoded.
+    static constexpr char const* ERROR_ENCODE_FAILED = "EncodeFailed";
+
+    struct Image
+    {
+        QImage mImage; // if null, the image is loaded from mName
+        QString mName; // name of the source file, the extension determines the format
+    };
+
+    struct UploadedImage
+    {
+        ATProto::Blob::SharedPtr mBlob;
+        QSize mSize;
+    };
+
+    using BlobSuccessCb = std::function<void(ATProto::Blob::SharedPtr)>;
+    using BlobErrorCb = std::function<void(const QString& error, const QString& msg)>;
+    using UploadFun = std::function<void(const QByteArray& blob, const QString& mimeType,
+                                         const BlobSuccessCb& successCb, const BlobErrorCb& errorCb)>;
+    using EncodeFun = std::function<std::tuple<QString, QSize>(QByteArray& blob, QImage img, const QString& name)>;
+    using LoadFun = std::function<QImage(const QString& name)>;
+    using SuccessCb = std::function<void(std::vector<UploadedImage>)>;
+    using ErrorCb = std::function<void(int imgIndex, const QString& error, const QString& msg)>;
+    using ProgressCb = std::function<void(int uploaded, int total)>;
+
+    // Without encode function, PhotoPicker::createBlob is used.
+    // Without load function, PhotoPicker::loadImage is used.
+    static SharedPtr create(const UploadFun& uploadFun, const EncodeFun& encodeFun = {},
+                            const LoadFun& loadFun = {});
+
+    void setProgressCb(const ProgressCb& progressCb) { mProgressCb = progressCb; }
+
+    // Can be called once. On the first error, all remaining work is cancelled.
+    void start(std::vector<Image> images, const SuccessCb& successCb, const ErrorCb& errorCb);
+
+    // No more callbacks will be called. Uploads in flight cannot be stopped.
+    void cancel();
+    bool isCancelled() const { return mCancelled; }
+
+    int getMaxInFlight() const { return mMaxInFlight; }
+    void setMaxInFlight(int maxInFlight) { mMaxInFlight = std::max(maxInFlight, 1); }
+
+    int getMaxEncodesInFlight() const { return mMaxEncodesInFlight; }
+    void setMaxEncodesInFlight(int maxInFlight) { mMaxEncodesInFlight = std::max(maxInFlight, 1); }
+
+private:
+    ImageUploadPipeline(const UploadFun& uploadFun, const EncodeFun& encodeFun, const LoadFun& loadFun);
+
+    struct EncodedImage
+    {
+        int mIndex;
+        QByteArray mBlob;
+        QString mMimeType;
+    };
+
+    void startEncodes();
+    void encode(int index, Image image);
+    void encoded(int index, QByteArray blob, const QString& mimeType, QSize size);
+    void startUploads();
+    void uploaded(int index, ATProto::Blob::SharedPtr blob);
+    void failed(int index, const QString& error, const QString& msg);
+
+    UploadFun mUploadFun;
+    EncodeFun mEncodeFun;
+    LoadFun mLoadFun;
+    SuccessCb mSuccessCb;
+    ErrorCb mErrorCb;
+    ProgressCb mProgressCb;
+    int mMaxInFlight = MAX_UPLOADS_IN_FLIGHT;
+    int mMaxEncodesInFlight = MAX_ENCODES_IN_FLIGHT;
+
+    std::vector<UploadedImage> mResult;
+    std::vector<Image> mImages;
+    int mNextEncode = 0;
+    int mEncodesInFlight = 0;
+    std::deque<EncodedImage> mUploadQueue;
+    int mInFlight = 0;
+    int mUploaded = 0;
+    bool mStarted = false;
+    std::atomic<bool> mCancelled = false; // read by the encoder threads
+    bool mDone = false;
+};
+
+}
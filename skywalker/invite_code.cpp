@@ -42,7 +42,7 @@ const BasicProfile& InviteCode::getUsedBy()
     if (!mUsedBy.isNull())
         return mUsedBy;
 
-    const BasicProfile* profile = AuthorCache::instance().get(mUsedByDid);
+    const auto profile = AuthorCache::instance().get(mUsedByDid);
 
     if (profile)
     {
@@ -221,6 +221,15 @@ void _handleKeyboardHeightChanged(JNIEnv*, jobject, jint height)
         instance->handleKeyboardHeightChanged((int)height);
 }
 
+void _handleTrimMemory(JNIEnv*, jobject, jint level)
+{
+    qDebug() << "Trim memory:" << (int)level;
+    auto& instance = *gTheInstance;
+
+    if (instance)
+        instance->handleTrimMemory((int)level);
+}
+
 #endif
 
 }
@@ -298,9 +307,10 @@ JNICallbackListener::JNICallbackListener() : QObject()
         { "emitSharedDmTextReceived", "(Ljava/lang/String;)V", reinterpret_cast<void *>(_handleSharedDmTextReceived) },
         { "emitShowNotifications", "()V", reinterpret_cast<void *>(_handleShowNotifications) },
         { "emitShowDirectMessages", "()V", reinterpret_cast<void *>(_handleShowDirectMessages) },
-        { "emitShowLink", "(Ljava/lang/String;)V",  reinterpret_cast<void *>(_handleShowLink) }
+        { "emitShowLink", "(Ljava/lang/String;)V",  reinterpret_cast<void *>(_handleShowLink) },
+        { "emitTrimMemory", "(I)V",  reinterpret_cast<void *>(_handleTrimMemory) }
     };
-    jni.registerNativeMethods("com/gmail/mfnboer/SkywalkerActivity", skywalkerActivityCallbacks, 7);
+    jni.registerNativeMethods("com/gmail/mfnboer/SkywalkerActivity", skywalkerActivityCallbacks, 8);
 #endif
 }
 
@@ -409,4 +419,9 @@ void JNICallbackListener::handleKeyboardHeightChanged(int height)
     emit keyboardHeightChanged(height);
 }
 
+void JNICallbackListener::handleTrimMemory(int level)
+{
+    emit trimMemory(level);
+}
+
 }
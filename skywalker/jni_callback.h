@@ -38,6 +38,7 @@ public:
     void handleShowDirectMessages();
     void handleShowLink(const QString& uri);
     void handleKeyboardHeightChanged(int height);
+    void handleTrimMemory(int level);
 
 signals:
     void photoPicked(int fd, QString mimeType, bool last);
@@ -61,6 +62,7 @@ signals:
     void showNotifications();
     void showDirectMessages();
     void keyboardHeightChanged(int height);
+    void trimMemory(int level);
 
 private:
     JNICallbackListener();
@@ -0,0 +1,478 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "language_identifier.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace Skywalker {
+
+namespace {
+
+struct WordList
+{
+    const char* mLanguageCode;
+    const char* mWords; // most frequent first
+};
+
+constexpr WordList LATIN_WORD_LISTS[] = {
+    { "en",
+        "the of and to a in is you that it he was for on are as with his they i at be this have "
+        "from or one had by word but not what all were we when your can said there use an each "
+        "which she do how their if will up other about out many then them these so some her would "
+        "make like him into time has look two more write go see number no way could people my than "
+        "first water been call who oil its now find long down day did get come made may part just "
+        "know also very good new because any over after most only think should really going want "
+        "today still never here why love thanks thank much well those need even something back "
+        "year work give through before same right take our" },
+    { "de",
+        "der die und in den von zu das mit sich des auf für ist im dem nicht ein eine als auch es "
+        "an werden aus er hat dass sie nach wird bei einer um am sind noch wie einem über einen so "
+        "zum war haben nur oder aber vor zur bis mehr durch man sein wurde sei ich wir ihr uns "
+        "schon wenn kann jetzt heute immer gibt hier mal dann diese dieser doch ganz viel gut sehr "
+        "alle weil habe mich mir was wieder danke einfach mein dein unser euer keine kein nichts "
+        "etwas jemand niemand zeit jahr tag mann frau kind leute land stadt welt leben machen "
+        "sagen gehen kommen sehen wissen geben nehmen finden bleiben müssen können wollen sollen "
+        "dürfen möchte morgen gestern wirklich vielleicht natürlich eigentlich" },
+    { "fr",
+        "de la le et les des en un du une que est pour qui dans a par plus pas au sur ne se ce il "
+        "sont avec son elle nous vous mais ou on je tout bien aussi fait comme été leur sa ses y "
+        "aux cette même très ont sans entre tous peut moi toi ça être avoir faire merci encore "
+        "alors quand déjà c'est j'ai ici toujours rien parce votre notre mon ton ma ta nos vos "
+        "leurs ces cet personne quelque chose temps année jour homme femme enfant gens pays ville "
+        "monde vie dire aller venir voir savoir pouvoir vouloir falloir prendre donner trouver "
+        "demain hier vraiment peut-être beaucoup trop peu maintenant après avant pendant" },
+    { "es",
+        "de la que el en y a los del se las por un para con no una su al lo es como más pero sus "
+        "le ya o este sí porque esta entre cuando muy sin sobre también me hasta hay donde quien "
+        "desde todo nos durante todos uno les ni contra otros ese eso ante ellos esto mí antes "
+        "algunos qué unos yo otro otras otra él tanto esa estos mucho gracias hoy bien así está "
+        "son fue ser tiene hacer mi tu nuestro vuestro nada nadie algo alguien tiempo año día "
+        "hombre mujer niño gente país ciudad mundo vida decir ir venir ver saber poder querer "
+        "tener dar tomar encontrar mañana ayer ahora después siempre nunca voy vas va vamos estoy "
+        "estás estamos noche casa verdad" },
+    { "pt",
+        "de a o que e do da em um para é com não uma os no se na por mais as dos como mas foi ao "
+        "ele das tem à seu sua ou ser quando muito há nos já está eu também só pelo pela até isso "
+        "ela entre era depois sem mesmo aos ter seus quem nas me esse eles estão você tinha foram "
+        "essa num nem suas meu às minha têm numa pelos obrigado hoje bem então agora ainda aqui "
+        "fazer coisa teu nosso nada ninguém algo alguém tempo ano dia homem mulher criança gente "
+        "país cidade mundo vida dizer ir vir ver saber poder querer dar pegar achar amanhã ontem "
+        "antes sempre nunca vou vai vamos estou estamos noite casa verdade ficou fica são" },
+    { "it",
+        "di e il la che in a per un è del non una sono le si con da i al dei gli come più ma anche "
+        "ho lo della nel alla ci se mi cosa questo io tutto lui essere molto quando fare fatto ha "
+        "solo suo era sua loro perché hanno delle ancora stato questa cui tra dove sempre poi "
+        "grazie oggi bene qui oppure niente proprio già allora mio tuo nostro vostro nessuno "
+        "qualcosa qualcuno tempo anno giorno uomo donna bambino gente paese città mondo vita dire "
+        "andare venire vedere sapere potere volere avere dare prendere trovare domani ieri adesso "
+        "dopo prima mai vado va andiamo sto siamo sera casa vero" },
+    { "nl",
+        "de en van het een in is dat op te zijn met voor niet aan er die maar ook als dan bij om "
+        "je hij nog wat uit over zo naar kan door ze wel heb deze was ik we heeft al worden wordt "
+        "geen hun meer dit hebben zich tot mijn moet mij jij jou veel kunnen gaan gewoon echt "
+        "bedankt vandaag goed waar hier weer nu iets jouw ons onze niets niemand iemand tijd jaar "
+        "dag man vrouw kind mensen land stad wereld leven zeggen komen zien weten willen moeten "
+        "geven nemen vinden morgen gisteren misschien natuurlijk eigenlijk altijd nooit avond huis" },
+    { "sv",
+        "och i att det som en på är av för med till den har de inte om ett han men var jag sig "
+        "från vi så kan man när år säger hon under också efter eller nu sin där vid mot ska skulle "
+        "kommer ut får finns vara hade alla andra mycket än här då sedan över bara in blir upp "
+        "även vad två tack idag bra något min din vår er ingenting ingen någon tid dag kvinna barn "
+        "folk land stad värld liv säga gå komma se veta kunna vilja måste ge ta hitta imorgon igår "
+        "kanske verkligen alltid aldrig kväll hus sant" },
+    { "da",
+        "og i at det en den til er som på de med han af for ikke der var mig sig men et har om vi "
+        "min havde ham hun nu over da fra du ud sin dem os op man hans hvor eller hvad skal selv "
+        "her alle vil blev kunne ind når være dog noget ville jo deres efter ned skulle denne end "
+        "dette mit også under have dig tak godt meget bare jeg din vores jeres intet ingen nogen "
+        "tid år dag mand kvinde barn folk land by verden liv sige gå komme se vide give tage finde "
+        "morgen går måske virkelig altid aldrig aften hus sandt ved hvorfor nogle" },
+    { "pl",
+        "w i z na się nie do to że jest o jak ale po co tak za od są tylko jego już jej może przez "
+        "mnie czy ten by był dla ze ma też gdy bardzo mi jestem tym tego go więc jeszcze nawet "
+        "kiedy teraz było bez będzie tu która który które dzięki dziś wszystko można tutaj trzeba "
+        "mój twój nasz wasz nic nikt coś ktoś czas rok dzień mężczyzna kobieta dziecko ludzie kraj "
+        "miasto świat życie mówić iść przyjść widzieć wiedzieć móc chcieć musieć dać wziąć znaleźć "
+        "jutro wczoraj naprawdę zawsze nigdy wieczór dom prawda" },
+    { "tr",
+        "bir ve bu da de için ile çok ne ben sen o ama daha gibi var mı değil en kadar her şey "
+        "olarak sonra yok ki ya diye olan nasıl ise bana beni bunu şimdi neden hiç iyi güzel "
+        "teşekkürler bugün artık zaman oldu olduğu çünkü mi biz siz onlar yani benim senin bizim "
+        "sizin hiçbir kimse biri yıl gün adam kadın çocuk insanlar ülke şehir dünya hayat söylemek "
+        "gitmek gelmek görmek bilmek istemek vermek almak bulmak yarın dün belki gerçekten asla "
+        "akşam ev doğru bilmiyorum" },
+    { "id",
+        "yang dan di itu dengan untuk tidak ini dari dalam akan pada juga saya ke karena tersebut "
+        "bisa ada mereka lebih kami sudah atau saat oleh hanya seperti kita bahwa apa harus banyak "
+        "jika telah tahun bagi sangat aku kamu belum terima kasih hari semua masih lagi bagaimana "
+        "sesuatu seseorang waktu orang laki perempuan anak negara kota dunia hidup bilang pergi "
+        "datang lihat tahu mau beri ambil cari besok kemarin mungkin benar selalu pernah malam "
+        "rumah betul bersama" },
+    { "fi",
+        "ja on ei se että hän oli ole olen mutta kun niin kuin jos vain myös ovat tämä sen hänen "
+        "mitä minä sinä me te he nyt jo sitten kanssa voi olla joka tai vielä paljon aina kiitos "
+        "tänään hyvä koska minun sinun siitä tässä vaan ihan meidän teidän mitään kukaan jotain "
+        "joku aika vuosi päivä mies nainen lapsi ihmiset maa kaupunki maailma elämä sanoa mennä "
+        "tulla nähdä tietää voida haluta täytyy antaa ottaa löytää huomenna eilen ehkä todella "
+        "koskaan ilta koti totta en et emme" },
+};
+
+// Weight of a word in a profile is 1 / (rank + RANK_OFFSET)
+constexpr int RANK_OFFSET = 10;
+
+// Additive smoothing for trigrams not in a profile
+constexpr double SMOOTHING = 0.5;
+
+// Log score bonus for a word from the frequent word list of a language
+constexpr double FREQUENT_WORD_BONUS = 2.0;
+
+quint64 trigramKey(QChar c1, QChar c2, QChar c3)
+{
+    return ((quint64)c1.unicode() << 32) | ((quint64)c2.unicode() << 16) | c3.unicode();
+}
+
+template<typename Fun>
+void forEachTrigram(const QString& word, QString& padded, Fun fun)
+{
+    padded.clear();
+    padded.reserve(word.size() + 2);
+    padded += QChar(' ');
+    padded += word;
+    padded += QChar(' ');
+
+    for (int i = 0; i + 3 <= padded.size(); ++i)
+        fun(trigramKey(padded[i], padded[i + 1], padded[i + 2]));
+}
+
+bool isIgnoredToken(QStringView token)
+{
+    return token.startsWith(u'@') || token.startsWith(u'#') ||
+           token.contains(u"://") || token.startsWith(u"www.");
+}
+
+bool containsAny(const QString& text, std::initializer_list<char16_t> chars)
+{
+    for (const char16_t c : chars)
+    {
+        if (text.contains(QChar(c)))
+            return true;
+    }
+
+    return false;
+}
+
+// Script used by a single language, or a script where a few letters tell
+// the languages apart.
+QString getScriptLanguage(QChar::Script script, const QString& text, bool hasKana)
+{
+    switch (script)
+    {
+    case QChar::Script_Han:
+        return hasKana ? "ja" : "zh";
+    case QChar::Script_Hangul:
+        return "ko";
+    case QChar::Script_Thai:
+        return "th";
+    case QChar::Script_Greek:
+        return "el";
+    case QChar::Script_Hebrew:
+        return "he";
+    case QChar::Script_Devanagari:
+        return "hi";
+    case QChar::Script_Bengali:
+        return "bn";
+    case QChar::Script_Tamil:
+        return "ta";
+    case QChar::Script_Georgian:
+        return "ka";
+    case QChar::Script_Armenian:
+        return "hy";
+    case QChar::Script_Cyrillic:
+        // і ї є ґ
+        return containsAny(text, { 0x0456, 0x0457, 0x0454, 0x0491 }) ? "uk" : "ru";
+    case QChar::Script_Arabic:
+        // پ چ ژ گ ک ی
+        return containsAny(text, { 0x067E, 0x0686, 0x0698, 0x06AF, 0x06A9, 0x06CC }) ? "fa" : "ar";
+    default:
+        break;
+    }
+
+    return {};
+}
+
+}
+
+const LanguageIdentifier& LanguageIdentifier::instance()
+{
+    static const LanguageIdentifier sInstance;
+    return sInstance;
+}
+
+LanguageIdentifier::LanguageIdentifier()
+{
+    const int languageCount = (int)std::size(LATIN_WORD_LISTS);
+    static_assert(std::size(LATIN_WORD_LISTS) <= 32, "Frequent word bits do not fit");
+
+    std::unordered_map<quint64, std::vector<double>> trigramWeights;
+    std::vector<double> totalWeights(languageCount, 0.0);
+    QString padded;
+
+    for (int lang = 0; lang < languageCount; ++lang)
+    {
+        const auto& wordList = LATIN_WORD_LISTS[lang];
+        mLatinLanguages.push_back(wordList.mLanguageCode);
+        const QStringList words = QString::fromUtf8(wordList.mWords).split(' ', Qt::SkipEmptyParts);
+        int rank = 0;
+
+        for (const QString& word : words)
+        {
+            quint32& languageBits = mFrequentWords[word];
+
+            if (languageBits & (1u << lang))
+                continue; // duplicate
+
+            languageBits |= (1u << lang);
+            const double weight = 1.0 / (rank++ + RANK_OFFSET);
+
+            forEachTrigram(word, padded, [&](quint64 key){
+                auto& weights = trigramWeights[key];
+
+                if (weights.empty())
+                    weights.resize(languageCount, 0.0);
+
+                weights[lang] += weight;
+                totalWeights[lang] += weight;
+            });
+        }
+    }
+
+    const double unseenWeight = SMOOTHING / std::max((double)trigramWeights.size(), 1.0);
+    mUnseenLogProbs.resize(languageCount);
+
+    for (int lang = 0; lang < languageCount; ++lang)
+        mUnseenLogProbs[lang] = (float)std::log(unseenWeight / (totalWeights[lang] + SMOOTHING));
+
+    mTrigramLogProbs.reserve(trigramWeights.size() * languageCount);
+
+    for (const auto& [key, weights] : trigramWeights)
+    {
+        mTrigramRows[key] = (int)(mTrigramLogProbs.size() / languageCount);
+
+        for (int lang = 0; lang < languageCount; ++lang)
+            mTrigramLogProbs.push_back((float)std::log((weights[lang] + unseenWeight) / (totalWeights[lang] + SMOOTHING)));
+    }
+
+    qDebug() << "Language profiles:" << mLatinLanguages << "trigrams:" << mTrigramRows.size() << "words:" << mFrequentWords.size();
+}
+
+QStringList LanguageIdentifier::getSupportedLanguages() const
+{
+    QStringList languages = mLatinLanguages;
+    languages.append({ "ar", "bn", "el", "fa", "he", "hi", "hy", "ja", "ka", "ko", "ru", "ta", "th", "uk", "zh" });
+    languages.sort();
+    return languages;
+}
+
+std::vector<LanguageIdentifier::Result> LanguageIdentifier::identify(const QStringList& texts, const QStringList& excludeLanguages) const
+{
+    std::vector<Result> results;
+    results.reserve(texts.size());
+
+    for (const QString& text : texts)
+        results.push_back(identify(text, excludeLanguages));
+
+    return results;
+}
+
+LanguageIdentifier::Result LanguageIdentifier::identify(const QString& text, const QStringList& excludeLanguages) const
+{
+    if (text.size() < MIN_TEXT_LENGTH)
+        return {};
+
+    std::unordered_map<int, int> scriptLetters;
+    int letters = 0;
+    int kanaLetters = 0;
+    std::vector<QString> latinWords;
+    QString word;
+    const QStringView textView(text);
+
+    const auto addWord = [&latinWords, &word]{
+        if (!word.isEmpty())
+        {
+            latinWords.push_back(word);
+            word.clear();
+        }
+    };
+
+    for (int i = 0; i < textView.size(); )
+    {
+        if (textView[i].isSpace())
+        {
+            ++i;
+            continue;
+        }
+
+        int end = i + 1;
+
+        while (end < textView.size() && !textView[end].isSpace())
+            ++end;
+
+        const QStringView token = textView.sliced(i, end - i);
+        i = end;
+
+        if (isIgnoredToken(token))
+            continue;
+
+        for (int j = 0; j < token.size(); ++j)
+        {
+            char32_t ucs4 = token[j].unicode();
+
+            if (token[j].isHighSurrogate() && j + 1 < token.size() && token[j + 1].isLowSurrogate())
+            {
+                ucs4 = QChar::surrogateToUcs4(token[j], token[j + 1]);
+                ++j;
+            }
+
+            if (QChar::isLetter(ucs4))
+            {
+                auto script = QChar::script(ucs4);
+
+                if (script == QChar::Script_Hiragana || script == QChar::Script_Katakana)
+                {
+                    ++kanaLetters;
+                    script = QChar::Script_Han;
+                }
+
+                ++scriptLetters[script];
+                ++letters;
+
+                if (script == QChar::Script_Latin && !QChar::requiresSurrogates(ucs4))
+                {
+                    word += QChar((char16_t)QChar::toLower(ucs4));
+                    continue;
+                }
+            }
+            else if ((ucs4 == '\'' || ucs4 == 0x2019) && !word.isEmpty())
+            {
+                word += QChar('\'');
+                continue;
+            }
+
+            addWord();
+        }
+
+        addWord();
+    }
+
+    if (letters == 0)
+        return {};
+
+    const auto dominant = std::max_element(scriptLetters.begin(), scriptLetters.end(),
+        [](const auto& lhs, const auto& rhs){ return lhs.second < rhs.second; });
+    const auto script = (QChar::Script)dominant->first;
+    const double scriptConfidence = (double)dominant->second / letters;
+
+    if (script == QChar::Script_Latin)
+    {
+        Result result = identifyLatin(latinWords, excludeLanguages);
+        result.mConfidence *= scriptConfidence;
+
+        if (result.mConfidence < MIN_CONFIDENCE)
+            result.mLanguageCode.clear();
+
+        return result;
+    }
+
+    const QString language = getScriptLanguage(script, text, kanaLetters > 0);
+
+    if (language.isEmpty() || excludeLanguages.contains(language) || scriptConfidence < MIN_CONFIDENCE)
+        return { {}, scriptConfidence };
+
+    return { language, scriptConfidence };
+}
+
+LanguageIdentifier::Result LanguageIdentifier::identifyLatin(const std::vector<QString>& words, const QStringList& excludeLanguages) const
+{
+    if ((int)words.size() < MIN_LATIN_WORDS)
+        return {};
+
+    const int languageCount = (int)mLatinLanguages.size();
+    std::vector<double> scores(languageCount, 0.0);
+    std::vector<int> knownTrigrams(languageCount, 0);
+    int trigramCount = 0;
+    QString padded;
+
+    for (const QString& word : words)
+    {
+        forEachTrigram(word, padded, [&](quint64 key){
+            ++trigramCount;
+            const auto it = mTrigramRows.find(key);
+
+            if (it == mTrigramRows.end())
+            {
+                for (int lang = 0; lang < languageCount; ++lang)
+                    scores[lang] += mUnseenLogProbs[lang];
+
+                return;
+            }
+
+            const float* logProbs = &mTrigramLogProbs[it->second * languageCount];
+
+            for (int lang = 0; lang < languageCount; ++lang)
+            {
+                scores[lang] += logProbs[lang];
+
+                if (logProbs[lang] > mUnseenLogProbs[lang])
+                    ++knownTrigrams[lang];
+            }
+        });
+
+        const auto it = mFrequentWords.find(word);
+
+        if (it != mFrequentWords.end())
+        {
+            for (int lang = 0; lang < languageCount; ++lang)
+            {
+                if (it->second & (1u << lang))
+                    scores[lang] += FREQUENT_WORD_BONUS;
+            }
+        }
+    }
+
+    int best = -1;
+
+    for (int lang = 0; lang < languageCount; ++lang)
+    {
+        if (excludeLanguages.contains(mLatinLanguages[lang]))
+            continue;
+
+        if (best < 0 || scores[lang] > scores[best])
+            best = lang;
+    }
+
+    if (best < 0)
+        return {};
+
+    // The softmax below only tells which supported language fits best. Text in
+    // a language without profile still has a best fit, but few of its
+    // trigrams are in that profile.
+    const double knownTrigramRatio = (double)knownTrigrams[best] / trigramCount;
+
+    if (knownTrigramRatio < MIN_KNOWN_TRIGRAM_RATIO)
+        return {};
+
+    // Softmax probability of the best language
+    double sum = 0.0;
+
+    for (int lang = 0; lang < languageCount; ++lang)
+    {
+        if (!excludeLanguages.contains(mLatinLanguages[lang]))
+            sum += std::exp(scores[lang] - scores[best]);
+    }
+
+    return { mLatinLanguages[best], 1.0 / sum };
+}
+
+}
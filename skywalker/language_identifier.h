@@ -0,0 +1,50 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QStringList>
+#include <unordered_map>
+#include <vector>
+
+namespace Skywalker {
+
+// On-device language identification without external services.
+// A text in a script that is used by a single language, e.g. Hangul, is
+// identified by its script. A text in Latin script is scored against character
+// trigram profiles of the most frequent words per language. The profiles are
+// built once from compiled in word lists. Text in a language without profile
+// is not identified.
+class LanguageIdentifier
+{
+public:
+    static constexpr int MIN_TEXT_LENGTH = 20;
+    static constexpr int MIN_LATIN_WORDS = 3;
+    static constexpr double MIN_CONFIDENCE = 0.9;
+    static constexpr double MIN_KNOWN_TRIGRAM_RATIO = 0.4;
+
+    struct Result
+    {
+        QString mLanguageCode; // empty when not identified
+        double mConfidence = 0.0;
+    };
+
+    static const LanguageIdentifier& instance();
+
+    // Mentions, hashtags and links are ignored.
+    Result identify(const QString& text, const QStringList& excludeLanguages = {}) const;
+    std::vector<Result> identify(const QStringList& texts, const QStringList& excludeLanguages = {}) const;
+
+    QStringList getSupportedLanguages() const;
+
+private:
+    LanguageIdentifier();
+
+    Result identifyLatin(const std::vector<QString>& words, const QStringList& excludeLanguages) const;
+
+    QStringList mLatinLanguages;
+    std::unordered_map<quint64, int> mTrigramRows;
+    std::vector<float> mTrigramLogProbs; // row per trigram, column per language
+    std::vector<float> mUnseenLogProbs; // per language
+    std::unordered_map<QString, quint32> mFrequentWords; // bit per language
+};
+
+}
@@ -2,9 +2,11 @@
 // License: GPLv3
 #include "language_utils.h"
 #include "jni_callback.h"
+#include "language_identifier.h"
 #include "skywalker.h"
 #include <QInputMethod>
 #include <QLocale>
+#include <QTimer>
 #include <QGuiApplication>
 #include <unordered_set>
 
@@ -286,8 +288,18 @@ int LanguageUtils::identifyLanguage(QString text)
 
     return requestId;
 #else
-    qDebug() << "Language identification not supported:" << text;
-    return -1;
+    Q_ASSERT(mSkywalker);
+    const int requestId = sNextRequestId++;
+    const QStringList excludeLanguages = mSkywalker->getUserSettings()->getExcludeDetectLanguages(mSkywalker->getUserDid());
+
+    // Async call to guarantee that the caller gets requestId before results from detection.
+    QTimer::singleShot(0, this, [this, text, excludeLanguages, requestId]{
+        const auto result = LanguageIdentifier::instance().identify(text, excludeLanguages);
+        qDebug() << "Identified language:" << result.mLanguageCode << "confidence:" << result.mConfidence;
+        emit languageIdentified(result.mLanguageCode, requestId);
+    });
+
+    return requestId;
 #endif
 }
 
@@ -56,7 +56,7 @@ public:
 LinkCardReader::LinkCardReader(QObject* parent):
     QObject(parent),
     mNetwork(new QNetworkAccessManager(this)),
-    mCardCache(100),
+    mCardCache("LinkCardCache", MAX_CACHED_CARDS),
     mGifUtils(this)
 {
     mNetwork->setAutoDeleteReplies(true);
@@ -69,10 +69,16 @@ LinkCardReader::LinkCardReader(QObject* parent):
     qDebug() << "Accept-Language:" << mAcceptLanguage;
 }
 
+LinkCard* LinkCardReader::getCachedCard(const QUrl& url) const
+{
+    const auto card = mCardCache.get(url);
+    return card ? *card : nullptr;
+}
+
 LinkCard* LinkCardReader::makeLinkCard(const QString& link, const QString& title,
                        const QString& description, const QString& thumb)
 {
-    LinkCard* card = new LinkCard(this);
+    auto* card = new LinkCard(this);
     card->setLink(link);
     card->setTitle(title);
     card->setDescription(description);
@@ -80,7 +86,7 @@ LinkCard* LinkCardReader::makeLinkCard(const QString& link, const QString& title
 
     QUrl url(link);
     mCardCache.insert(url, card);
-    return mCardCache[url];
+    return card;
 }
 
 void LinkCardReader::getLinkCard(const QString& link, bool retry, bool cookieSaveControl)
@@ -105,7 +111,7 @@ void LinkCardReader::getLinkCard(const QString& link, bool retry, bool cookieSav
         return;
     }
 
-    auto* card = mCardCache[url];
+    auto* card = getCachedCard(url);
     if (card)
     {
         qDebug() << "Got card from cache:" << card->getLink();
@@ -344,8 +350,9 @@ void LinkCardReader::extractLinkCard(QNetworkReply* reply)
     }
 
     card->setLink(url.toString());
-    mCardCache.insert(url, card.get());
-    emit linkCard(card.release());
+    auto* cardPtr = card.release();
+    mCardCache.insert(url, cardPtr);
+    emit linkCard(cardPtr);
 }
 
 QString LinkCardReader::toPlainText(const QString& text)
@@ -3,7 +3,7 @@
 #pragma once
 #include "link_card.h"
 #include "gif_utils.h"
-#include <QCache>
+#include "memory_cache.h"
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QtQmlIntegration>
@@ -16,6 +16,8 @@ class LinkCardReader : public QObject
     QML_ELEMENT
 
 public:
+    static constexpr int MAX_CACHED_CARDS = 100;
+
     explicit LinkCardReader(QObject* parent = nullptr);
 
     Q_INVOKABLE void getLinkCard(const QString& link, bool retry = false, bool cookieSaveControl = false);
@@ -32,9 +34,12 @@ private:
     void requestFailed(QNetworkReply* reply, int errCode);
     void requestSslFailed(QNetworkReply* reply);
     void redirect(QNetworkReply* reply, const QUrl& redirectUrl);
+    LinkCard* getCachedCard(const QUrl& url) const;
 
     QNetworkAccessManager* mNetwork;
-    QCache<QUrl, LinkCard> mCardCache;
+    // The cards are owned by the reader (parent) as QML may still show a card
+    // after it got evicted. They are deleted with the reader.
+    MemoryCache<QUrl, LinkCard*> mCardCache;
     QNetworkReply* mInProgress = nullptr;
     QUrl mPrevDestination;
     bool mRetry = false;
@@ -14,15 +14,30 @@ ListCache& ListCache::instance()
     return *sInstance;
 }
 
-ListCache::Entry::Entry(const ListViewBasic& list) :
-    mList(list)
+ListCache::ListCache(QObject* parent) :
+    WrappedSkywalker(parent),
+    mCache("ListCache", 0, &ListCache::getCost, &ListCache::getViewerCost,
+           [](const ListViewBasic& list, const ListViewBasic& viewerSource){
+               ListViewBasic result(list);
+               result.setViewer(viewerSource.getViewer());
+               return result;
+           },
+           [](const ListViewBasic& list){ return list.getViewer().isValid(); },
+           BUDGET_WEIGHT)
 {
 }
 
-ListCache::ListCache(QObject* parent) :
-    WrappedSkywalker(parent),
-    mCache(100)
+qsizetype ListCache::getCost(const QString& uri, const ListViewBasic& list)
 {
+    return sizeof(ListViewBasic) + CacheCost::string(uri) +
+           CacheCost::string(list.getCid()) + CacheCost::string(list.getName()) +
+           CacheCost::string(list.getAvatar());
+}
+
+qsizetype ListCache::getViewerCost(const ListViewBasic& list)
+{
+    return sizeof(ListViewBasic) + sizeof(ATProto::AppBskyGraph::ListViewerState) +
+           CacheCost::string(list.getViewer().getBlocked());
 }
 
 void ListCache::clear()
@@ -30,7 +45,7 @@ void ListCache::clear()
     mCache.clear();
 }
 
-void ListCache::put(const ListViewBasic& list)
+void ListCache::put(const ListViewBasic& list, const QString& viewerDid)
 {
     const QString& uri = list.getUri();
     Q_ASSERT(!uri.isEmpty());
@@ -38,8 +53,7 @@ void ListCache::put(const ListViewBasic& list)
     if (uri.isEmpty())
         return;
 
-    auto* entry = new Entry(list);
-    mCache.insert(uri, entry);
+    mCache.put(uri, list, viewerDid);
 }
 
 void ListCache::putList(const QString& uri, const std::function<void()>& addedCb)
@@ -58,12 +72,13 @@ void ListCache::putList(const QString& uri, const std::function<void()>& addedCb
 
     mFetchingUris.insert(uri);
 
+    // The viewer may switch while the request is in progress.
     bskyClient()->getList(uri, 1, {},
-        [this, addedCb](auto output){
+        [this, addedCb, viewerDid=mCache.getViewer()](auto output){
             const auto& list = output->mList;
             mFetchingUris.erase(list->mUri);
             mFailedUris.erase(list->mUri);
-            put(ListViewBasic(list));
+            put(ListViewBasic(list), viewerDid);
             emit listAdded(list->mUri);
 
             if (addedCb)
@@ -85,10 +100,9 @@ void ListCache::putList(const QString& uri, const std::function<void()>& addedCb
         });
 }
 
-const ListViewBasic* ListCache::get(const QString& uri) const
+std::shared_ptr<const ListViewBasic> ListCache::get(const QString& uri) const
 {
-    auto* entry = mCache[uri];
-    return entry ? &entry->getList() : nullptr;
+    return mCache.get(uri);
 }
 
 bool ListCache::contains(const QString& uri) const
@@ -96,4 +110,18 @@ bool ListCache::contains(const QString& uri) const
     return get(uri) != nullptr;
 }
 
+void ListCache::setViewer(const QString& did)
+{
+    if (did != mCache.getViewer())
+    {
+        qDebug() << "List cache viewer:" << did << "lists:" << mCache.size();
+        mCache.setViewer(did);
+    }
+}
+
+void ListCache::removeViewer(const QString& did)
+{
+    mCache.removeViewer(did);
+}
+
 }
@@ -2,43 +2,41 @@
 // License: GPLv3
 #pragma once
 #include "list_view_include.h"
+#include "viewer_cache.h"
 #include "wrapped_skywalker.h"
-#include <QCache>
 
 namespace Skywalker {
 
+// Lists are shared by all accounts. The viewer state (muted, blocked) is kept
+// per account, see ViewerCache.
 class ListCache : public WrappedSkywalker
 {
     Q_OBJECT
 
 public:
-    class Entry : public QObject
-    {
-    public:
-        Entry() = default;
-        Entry(const ListViewBasic& list);
-
-        const ListViewBasic& getList() const { return mList; }
-
-    private:
-        ListViewBasic mList;
-    };
+    static constexpr int BUDGET_WEIGHT = 5;
 
     static ListCache& instance();
 
     void clear();
-    void put(const ListViewBasic& list);
+    void put(const ListViewBasic& list, const QString& viewerDid = {});
     void putList(const QString& uri, const std::function<void()>& addedCb = {});
-    const ListViewBasic* get(const QString& uri) const;
+    std::shared_ptr<const ListViewBasic> get(const QString& uri) const;
     bool contains(const QString& uri) const;
 
+    void setViewer(const QString& did);
+    void removeViewer(const QString& did);
+
 signals:
     void listAdded(const QString& uri);
 
 private:
     explicit ListCache(QObject* parent = nullptr);
 
-    QCache<QString, Entry> mCache; // key is list uri
+    static qsizetype getCost(const QString& uri, const ListViewBasic& list);
+    static qsizetype getViewerCost(const ListViewBasic& list);
+
+    ViewerCache<ListViewBasic> mCache; // key is list uri
     std::unordered_set<QString> mFetchingUris;
     std::unordered_set<QString> mFailedUris;
 
@@ -0,0 +1,151 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "list_snapshot_store.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+namespace Skywalker {
+
+static constexpr int SNAPSHOT_VERSION = 1;
+
+ListSnapshotStore::ListSnapshotStore(const QString& path) :
+    mPath(path)
+{
+    if (!QDir().mkpath(mPath))
+        qWarning() << "Cannot create list snapshot store:" << mPath;
+}
+
+bool ListSnapshotStore::save(const Snapshot& snapshot) const
+{
+    const ListViewBasic& list = snapshot.mList;
+
+    QJsonObject listJson;
+    listJson.insert("uri", list.getUri());
+    listJson.insert("cid", list.getCid());
+    listJson.insert("name", list.getName());
+    listJson.insert("purpose", (int)list.getPurpose());
+
+    if (!list.getAvatar().isEmpty())
+        listJson.insert("avatar", list.getAvatar());
+
+    QJsonArray membersJson;
+
+    for (const auto& member : snapshot.mMembers)
+    {
+        const BasicProfile& profile = member.mProfile;
+        QJsonObject memberJson;
+        memberJson.insert("listItemUri", member.mListItemUri);
+        memberJson.insert("did", profile.getDid());
+        memberJson.insert("handle", profile.getHandle());
+
+        if (!profile.getDisplayName().isEmpty())
+            memberJson.insert("displayName", profile.getDisplayName());
+
+        if (!profile.getAvatarUrl().isEmpty())
+            memberJson.insert("avatar", profile.getAvatarUrl());
+
+        membersJson.append(memberJson);
+    }
+
+    QJsonObject json;
+    json.insert("version", SNAPSHOT_VERSION);
+    json.insert("list", listJson);
+    json.insert("saved", snapshot.mSaved.toString(Qt::ISODate));
+    json.insert("members", membersJson);
+
+    QSaveFile file(getFileName(list.getUri()));
+
+    if (!file.open(QFile::WriteOnly))
+    {
+        qWarning() << "Cannot write list snapshot:" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    file.write(QJsonDocument(json).toJson(QJsonDocument::Compact));
+
+    if (!file.commit())
+    {
+        qWarning() << "Cannot save list snapshot:" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    qDebug() << "List snapshot saved:" << list.getUri() << "members:" << snapshot.mMembers.size();
+    return true;
+}
+
+std::optional<ListSnapshotStore::Snapshot> ListSnapshotStore::load(const QString& listUri) const
+{
+    QFile file(getFileName(listUri));
+
+    if (!file.open(QFile::ReadOnly))
+    {
+        qDebug() << "No list snapshot:" << listUri;
+        return {};
+    }
+
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    const QJsonObject json = doc.object();
+
+    if (json["version"].toInt() != SNAPSHOT_VERSION)
+    {
+        qWarning() << "Unsupported list snapshot version:" << listUri << json["version"];
+        return {};
+    }
+
+    const QJsonObject listJson = json["list"].toObject();
+
+    // The file name is a hash, make sure it is the right list.
+    if (listJson["uri"].toString() != listUri)
+    {
+        qWarning() << "List snapshot mismatch:" << listUri << listJson["uri"];
+        return {};
+    }
+
+    Snapshot snapshot;
+    snapshot.mList = ListViewBasic(listUri,
+                                   listJson["cid"].toString(),
+                                   listJson["name"].toString(),
+                                   ATProto::AppBskyGraph::ListPurpose(listJson["purpose"].toInt()),
+                                   listJson["avatar"].toString());
+    snapshot.mSaved = QDateTime::fromString(json["saved"].toString(), Qt::ISODate);
+
+    for (const auto& value : json["members"].toArray())
+    {
+        const QJsonObject memberJson = value.toObject();
+        const QString listItemUri = memberJson["listItemUri"].toString();
+        const QString did = memberJson["did"].toString();
+
+        if (listItemUri.isEmpty() || did.isEmpty())
+            continue;
+
+        const BasicProfile profile(did,
+                                   memberJson["handle"].toString(),
+                                   memberJson["displayName"].toString(),
+                                   memberJson["avatar"].toString());
+        snapshot.mMembers.push_back({ listItemUri, profile });
+    }
+
+    qDebug() << "List snapshot loaded:" << listUri << "saved:" << snapshot.mSaved << "members:" << snapshot.mMembers.size();
+    return snapshot;
+}
+
+void ListSnapshotStore::remove(const QString& listUri) const
+{
+    const QString fileName = getFileName(listUri);
+
+    if (QFile::exists(fileName) && !QFile::remove(fileName))
+        qWarning() << "Cannot remove list snapshot:" << fileName;
+}
+
+QString ListSnapshotStore::getFileName(const QString& listUri) const
+{
+    const QByteArray hash = QCryptographicHash::hash(listUri.toUtf8(), QCryptographicHash::Sha256).toHex();
+    return mPath + "/" + QString::fromLatin1(hash) + ".json";
+}
+
+}
@@ -0,0 +1,47 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include "list_view.h"
+#include <QDateTime>
+#include <optional>
+#include <vector>
+
+namespace Skywalker {
+
+// Snapshots of lists and their members on disk, one file per list. Lists used
+// for filtering are served from their snapshot at startup, such that filtering
+// is correct before the list has been loaded from the network.
+//
+// The list record CID is saved as the revision of the list. Adding or removing
+// members does not change it, so a snapshot must always be refreshed.
+class ListSnapshotStore
+{
+public:
+    struct Member
+    {
+        QString mListItemUri;
+        BasicProfile mProfile;
+    };
+
+    struct Snapshot
+    {
+        ListViewBasic mList;
+        QDateTime mSaved;
+        std::vector<Member> mMembers;
+    };
+
+    explicit ListSnapshotStore(const QString& path);
+
+    bool save(const Snapshot& snapshot) const;
+    std::optional<Snapshot> load(const QString& listUri) const;
+    void remove(const QString& listUri) const;
+
+    const QString& getPath() const { return mPath; }
+
+private:
+    QString getFileName(const QString& listUri) const;
+
+    QString mPath;
+};
+
+}
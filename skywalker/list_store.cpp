@@ -14,6 +14,9 @@ const ListStore ListStore::NULL_STORE;
 ListStore::ListStore(QObject* parent) :
     WrappedSkywalker(parent)
 {
+    mSnapshotSaveTimer.setSingleShot(true);
+    connect(&mSnapshotSaveTimer, &QTimer::timeout, this, [this]{ saveChangedSnapshots(); });
+
     auto& graphListener = GraphListener::instance();
 
     connect(&graphListener, &GraphListener::listDeleted, this,
@@ -35,57 +38,324 @@ ListStore::ListStore(QObject* parent) :
             });
 }
 
+ListStore::~ListStore()
+{
+    // The static null stores never load, and should not touch the shared
+    // page requests on exit.
+    if (!mPendingLoads.empty())
+        cancelLoads();
+
+    if (!mChangedSnapshots.empty())
+        saveChangedSnapshots();
+}
+
+void ListStore::setSnapshotPath(const QString& path)
+{
+    if (mSnapshotStore && mSnapshotStore->getPath() == path)
+        return;
+
+    saveChangedSnapshots();
+    qDebug() << "List snapshot path:" << path;
+
+    if (path.isEmpty())
+        mSnapshotStore = nullptr;
+    else
+        mSnapshotStore = std::make_unique<ListSnapshotStore>(path);
+}
+
 void ListStore::clear()
 {
+    saveChangedSnapshots();
+    cancelLoads();
     mLists.clear();
+    mSnapshotStore = nullptr;
 }
 
 void ListStore::loadList(const QString& uri, const SuccessCb& successCb, const ErrorCb& errorCb,
                             int maxPages, int pagesLoaded, const QString& cursor)
 {
     qDebug() << "Load list:" << uri << "maxPages:" << maxPages << "cursor:" << cursor;
+    auto it = mPendingLoads.find(uri);
+
+    if (it != mPendingLoads.end())
+    {
+        qDebug() << "List already loading:" << uri;
+        const auto& load = it->second;
+
+        if (load->mRefresh)
+        {
+            successCb();
+            return;
+        }
+
+        load->mSuccessCbs.push_back(successCb);
+        load->mErrorCbs.push_back(errorCb);
+        return;
+    }
+
+    auto load = std::make_shared<PendingLoad>();
+    load->mRefresh = cursor.isEmpty() && !mLists.contains(uri) && loadSnapshot(uri);
+    auto& entry = mLists[uri];
+    load->mList = entry.mList;
+
+    // Continue with the members loaded so far
+    if (!cursor.isEmpty())
+        load->mStore = entry.mStore;
+
+    if (!load->mRefresh)
+    {
+        load->mSuccessCbs.push_back(successCb);
+        load->mErrorCbs.push_back(errorCb);
+    }
+
+    mPendingLoads[uri] = load;
+    loadPage(uri, load, maxPages, pagesLoaded, cursor);
+
+    // Filtering can use the snapshot while the list gets refreshed.
+    if (load->mRefresh)
+        successCb();
+}
+
+bool ListStore::loadSnapshot(const QString& uri)
+{
+    if (!mSnapshotStore)
+        return false;
+
+    const auto snapshot = mSnapshotStore->load(uri);
+
+    if (!snapshot)
+        return false;
+
+    auto& entry = mLists[uri];
+    entry.mList = snapshot->mList;
+    entry.mStore.clear();
+
+    for (const auto& member : snapshot->mMembers)
+        entry.mStore.add(member.mProfile, member.mListItemUri);
+
+    return true;
+}
+
+void ListStore::saveSnapshot(const QString& uri)
+{
+    mChangedSnapshots.erase(uri);
+
+    if (!mSnapshotStore)
+        return;
+
+    const auto it = mLists.find(uri);
+
+    if (it == mLists.end() || it->second.mList.isNull())
+        return;
+
+    const ProfileListItemStore& store = it->second.mStore;
+    ListSnapshotStore::Snapshot snapshot;
+    snapshot.mList = it->second.mList;
+    snapshot.mSaved = QDateTime::currentDateTimeUtc();
+    snapshot.mMembers.reserve(store.getListItemUriDidMap().size());
+
+    for (const auto& [listItemUri, did] : store.getListItemUriDidMap())
+    {
+        const auto* profile = store.get(did);
+
+        if (profile)
+            snapshot.mMembers.push_back({ listItemUri, *profile });
+    }
+
+    mSnapshotStore->save(snapshot);
+}
+
+void ListStore::scheduleSnapshotSave(const QString& uri)
+{
+    if (!mSnapshotStore)
+        return;
+
+    mChangedSnapshots.insert(uri);
+
+    if (!mSnapshotSaveTimer.isActive())
+        mSnapshotSaveTimer.start(SNAPSHOT_SAVE_DELAY);
+}
+
+void ListStore::saveChangedSnapshots()
+{
+    mSnapshotSaveTimer.stop();
+    const auto uris = std::move(mChangedSnapshots);
+    mChangedSnapshots.clear();
+
+    for (const auto& uri : uris)
+        saveSnapshot(uri);
+}
+
+void ListStore::getListPage(const QString& uri, const QString& cursor, const GetListSuccessCb& successCb, const ErrorCb& errorCb)
+{
+    if (mGetListFun)
+        mGetListFun(uri, LIST_PAGE_SIZE, cursor, successCb, errorCb);
+    else
+        bskyClient()->getList(uri, LIST_PAGE_SIZE, Utils::makeOptionalString(cursor), successCb, errorCb);
+}
 
+void ListStore::loadPage(const QString& uri, const PendingLoadPtr& load, int maxPages, int pagesLoaded, const QString& cursor)
+{
     if (maxPages <= 0)
     {
         qWarning() << "Max pages reached";
-        const QString name = getListName(uri);
+        const QString name = load->mList.getName().isEmpty() ? uri : load->mList.getName();
 
         mSkywalker->showStatusMessage(
             tr("List %1 has more than %2 users").arg(name).arg(pagesLoaded * LIST_PAGE_SIZE),
             QEnums::STATUS_LEVEL_ERROR, 30);
+        finishLoad(uri, load);
+        return;
+    }
+
+    schedulePageRequest(load, [this, uri, load, maxPages, pagesLoaded, cursor]{
+        qDebug() << "Get page of list:" << uri << "pagesLoaded:" << pagesLoaded << "cursor:" << cursor;
+
+        getListPage(uri, cursor,
+            [this, presence=getPresence(), uri, load, maxPages, pagesLoaded](auto output){
+                if (!presence || load->mCanceled)
+                    return;
+
+                releasePageRequest(load);
+                qDebug() << "Got page of list:" << uri << output->mList->mName;
+                load->mList = ListViewBasic(output->mList);
+
+                for (const auto& item : output->mItems)
+                {
+                    const BasicProfile profile(item->mSubject);
+                    load->mStore.add(profile, item->mUri);
+                }
+
+                if (output->mCursor)
+                    loadPage(uri, load, maxPages - 1, pagesLoaded + 1, *output->mCursor);
+                else
+                    finishLoad(uri, load);
+            },
+            [this, presence=getPresence(), uri, load](const QString& error, const QString& msg){
+                if (!presence || load->mCanceled)
+                    return;
+
+                releasePageRequest(load);
+                qWarning() << "loadList failed:" << error << " - " << msg;
+                failLoad(uri, load, error, msg);
+            });
+    });
+}
+
+void ListStore::finishLoad(const QString& uri, const PendingLoadPtr& load)
+{
+    mPendingLoads.erase(uri);
+    auto& entry = mLists[uri];
+
+    if (!load->mList.isNull())
+        entry.mList = load->mList;
+
+    entry.mStore = std::move(load->mStore);
+    saveSnapshot(uri);
+
+    if (load->mRefresh)
+    {
+        qDebug() << "List refreshed:" << uri;
+        emit listRefreshed(uri);
+    }
+
+    for (const auto& successCb : load->mSuccessCbs)
         successCb();
+}
+
+void ListStore::failLoad(const QString& uri, const PendingLoadPtr& load, const QString& error, const QString& msg)
+{
+    mPendingLoads.erase(uri);
+
+    if (ATProto::ATProtoErrorMsg::isListNotFound(error))
+    {
+        removeList(uri);
+    }
+    else if (load->mRefresh)
+    {
+        qWarning() << "Failed to refresh list, keep snapshot:" << uri;
         return;
     }
+    else
+    {
+        // The list may still exist, so do not signal its removal.
+        mLists.erase(uri);
+    }
 
-    auto& profileStore = mLists[uri].mStore;
+    for (const auto& errorCb : load->mErrorCbs)
+        errorCb(error, msg);
+}
 
-    bskyClient()->getList(uri, LIST_PAGE_SIZE, Utils::makeOptionalString(cursor),
-        [this, presence=getPresence(), uri, successCb, errorCb, maxPages, pagesLoaded, &profileStore](auto output){
-            if (!presence)
-                return;
+ListStore::PendingLoadPtr ListStore::cancelLoad(const QString& uri)
+{
+    auto it = mPendingLoads.find(uri);
 
-            qDebug() << "Got page of list:" << uri << output->mList->mName;
-            mLists[uri].mList = ListViewBasic(output->mList);
+    if (it == mPendingLoads.end())
+        return nullptr;
 
-            for (const auto& item : output->mItems)
-            {
-                const BasicProfile profile(item->mSubject);
-                profileStore.add(profile, item->mUri);
-            }
+    qDebug() << "Cancel load:" << uri;
+    auto load = it->second;
+    mPendingLoads.erase(it);
+    load->mCanceled = true;
+    releasePageRequest(load);
+    return load;
+}
 
-            if (output->mCursor)
-                loadList(uri, successCb, errorCb, maxPages - 1, pagesLoaded + 1, *output->mCursor);
-            else
-                successCb();
-        },
-        [this, presence=getPresence(), uri, errorCb](const QString& error, const QString& msg){
-            if (!presence)
-                return;
+void ListStore::cancelLoads()
+{
+    // Cancel all before releasing, such that no other load of this store gets started.
+    for (const auto& [_, load] : mPendingLoads)
+        load->mCanceled = true;
+
+    for (const auto& [_, load] : mPendingLoads)
+        releasePageRequest(load);
+
+    mPendingLoads.clear();
+}
+
+ListStore::PageRequests& ListStore::getPageRequests()
+{
+    static PageRequests sPageRequests;
+    return sPageRequests;
+}
+
+void ListStore::schedulePageRequest(const PendingLoadPtr& load, const std::function<void()>& request)
+{
+    auto& pageRequests = getPageRequests();
+    pageRequests.mQueue.push_back({ load, request });
+    startPageRequests();
 
-            removeList(uri);
-            qWarning() << "loadList failed:" << error << " - " << msg;
-            errorCb(error, msg);
-        });
+    if (!pageRequests.mQueue.empty())
+        qDebug() << "Page requests queued:" << pageRequests.mQueue.size();
+}
+
+void ListStore::startPageRequests()
+{
+    auto& pageRequests = getPageRequests();
+
+    while (pageRequests.mInFlight < MAX_PAGE_REQUESTS_IN_FLIGHT && !pageRequests.mQueue.empty())
+    {
+        const auto [load, request] = std::move(pageRequests.mQueue.front());
+        pageRequests.mQueue.pop_front();
+
+        // The list store may be gone
+        if (load->mCanceled)
+            continue;
+
+        ++pageRequests.mInFlight;
+        load->mRequestInFlight = true;
+        request();
+    }
+}
+
+void ListStore::releasePageRequest(const PendingLoadPtr& load)
+{
+    if (!load->mRequestInFlight)
+        return;
+
+    load->mRequestInFlight = false;
+    --getPageRequests().mInFlight;
+    startPageRequests();
 }
 
 void ListStore::addList(const QString& uri, const SuccessCb& successCb, const ErrorCb& errorCb)
@@ -130,21 +400,47 @@ void ListStore::addList(const ListViewBasic& list, const SuccessCb& successCb, c
 void ListStore::removeList(const QString& uri)
 {
     qDebug() << "Remove list:" << uri;
+    const auto load = cancelLoad(uri);
+    mChangedSnapshots.erase(uri);
+
+    if (mSnapshotStore)
+        mSnapshotStore->remove(uri);
 
     if (mLists.erase(uri))
         emit listRemoved(uri);
+
+    // Whoever waits for the load gets the list as it is now: removed.
+    if (load)
+    {
+        for (const auto& successCb : load->mSuccessCbs)
+            successCb();
+    }
 }
 
 void ListStore::addProfile(const QString& uri, const BasicProfile& profile, const QString& listItemUri)
 {
     qDebug() << "Add profile, list:" << uri << "did:" << profile.getDid() << "item:" << listItemUri;
     mLists[uri].mStore.add(profile, listItemUri);
+
+    // The loaded pages replace the members when the load finishes.
+    auto it = mPendingLoads.find(uri);
+
+    if (it != mPendingLoads.end())
+        it->second->mStore.add(profile, listItemUri);
+
+    scheduleSnapshotSave(uri);
 }
 
 void ListStore::removeProfile(const QString& uri, const QString& listItemUri)
 {
     qDebug() << "Add profile, list:" << uri << "item:" << listItemUri;
     mLists[uri].mStore.removeByListItemUri(listItemUri);
+    auto it = mPendingLoads.find(uri);
+
+    if (it != mPendingLoads.end())
+        it->second->mStore.removeByListItemUri(listItemUri);
+
+    scheduleSnapshotSave(uri);
 }
 
 bool ListStore::hasList(const QString& uri) const
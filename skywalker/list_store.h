@@ -1,9 +1,15 @@
 // Copyright (C) 2025 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "list_snapshot_store.h"
 #include "presence.h"
 #include "profile_store.h"
 #include "wrapped_skywalker.h"
+#include <atproto/lib/lexicon/app_bsky_graph.h>
+#include <QTimer>
+#include <chrono>
+#include <deque>
+#include <unordered_set>
 
 namespace Skywalker {
 
@@ -43,9 +49,27 @@ class ListStore : public WrappedSkywalker,
     Q_OBJECT
 
 public:
+    // Maximum number of list pages being requested by all list stores together.
+    static constexpr int MAX_PAGE_REQUESTS_IN_FLIGHT = 4;
+
+    // Member changes are saved to the snapshot in one write after this delay.
+    static constexpr auto SNAPSHOT_SAVE_DELAY = std::chrono::seconds(5);
+
     static const ListStore NULL_STORE;
 
+    using GetListSuccessCb = std::function<void(ATProto::AppBskyGraph::GetListOutput::SharedPtr)>;
+    using GetListFun = std::function<void(const QString& uri, int limit, const QString& cursor,
+                                          const GetListSuccessCb& successCb, const ErrorCb& errorCb)>;
+
     explicit ListStore(QObject* parent = nullptr);
+    ~ListStore();
+
+    // Lists are saved as snapshots in this directory. A list that has a
+    // snapshot is loaded from the snapshot and refreshed in the background.
+    void setSnapshotPath(const QString& path);
+
+    // Gets the list pages with this function instead of the bsky client.
+    void setGetListFun(const GetListFun& getListFun) { mGetListFun = getListFun; }
 
     void clear() override;
     void loadList(const QString& uri, const SuccessCb& successCb, const ErrorCb& errorCb,
@@ -74,6 +98,9 @@ public:
 signals:
     void listRemoved(const QString& uri);
 
+    // A list loaded from its snapshot got refreshed from the network.
+    void listRefreshed(const QString& uri);
+
 private:
     struct ListEntry
     {
@@ -81,7 +108,50 @@ private:
         ProfileListItemStore mStore; // List members
     };
 
+    // Pages are loaded into a separate store that replaces the list members
+    // when all pages are loaded.
+    struct PendingLoad
+    {
+        ListViewBasic mList;
+        ProfileListItemStore mStore;
+        std::vector<SuccessCb> mSuccessCbs;
+        std::vector<ErrorCb> mErrorCbs;
+        bool mRefresh = false; // refresh of a list loaded from its snapshot
+        bool mRequestInFlight = false;
+        bool mCanceled = false;
+    };
+
+    using PendingLoadPtr = std::shared_ptr<PendingLoad>;
+
+    struct PageRequests
+    {
+        int mInFlight = 0;
+        std::deque<std::pair<PendingLoadPtr, std::function<void()>>> mQueue;
+    };
+
+    bool loadSnapshot(const QString& uri);
+    void saveSnapshot(const QString& uri);
+    void scheduleSnapshotSave(const QString& uri);
+    void saveChangedSnapshots();
+    void getListPage(const QString& uri, const QString& cursor, const GetListSuccessCb& successCb, const ErrorCb& errorCb);
+    void loadPage(const QString& uri, const PendingLoadPtr& load, int maxPages, int pagesLoaded, const QString& cursor);
+    void finishLoad(const QString& uri, const PendingLoadPtr& load);
+    void failLoad(const QString& uri, const PendingLoadPtr& load, const QString& error, const QString& msg);
+    PendingLoadPtr cancelLoad(const QString& uri);
+    void cancelLoads();
+
+    // Page requests of all list stores share the in-flight limit.
+    static PageRequests& getPageRequests();
+    static void schedulePageRequest(const PendingLoadPtr& load, const std::function<void()>& request);
+    static void startPageRequests();
+    static void releasePageRequest(const PendingLoadPtr& load);
+
     std::unordered_map<QString, ListEntry> mLists; // list uri -> list entry
+    std::unordered_map<QString, PendingLoadPtr> mPendingLoads; // list uri -> load
+    std::unique_ptr<ListSnapshotStore> mSnapshotStore;
+    std::unordered_set<QString> mChangedSnapshots; // list uris
+    QTimer mSnapshotSaveTimer;
+    GetListFun mGetListFun;
 };
 
 }
@@ -22,6 +22,7 @@ public:
     ListViewerState() = default;
     explicit ListViewerState(const ATProto::AppBskyGraph::ListViewerState::SharedPtr& viewerState);
 
+    bool isValid() const { return mViewerState != nullptr; }
     bool getMuted() const;
     QString getBlocked() const;
 
@@ -68,6 +69,7 @@ public:
 
     void setCid(const QString& cid) { mCid = cid; }
     void setName(const QString& name) { mName = name; }
+    void setViewer(const ListViewerState& viewer) { mViewer = viewer; }
 
     // If avatar is a "image://", then the list view takes ownership of the image
     void setAvatar(const QString& avatar);
@@ -1,6 +1,7 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #include "local_author_model_changes.h"
+#include <algorithm>
 
 namespace Skywalker {
 
@@ -15,34 +16,103 @@ void LocalAuthorModelChanges::clearLocalChanges()
     mChanges.clear();
 }
 
+void LocalAuthorModelChanges::beginLocalChangeBatch()
+{
+    ++mBatchDepth;
+}
+
+void LocalAuthorModelChanges::endLocalChangeBatch()
+{
+    if (mBatchDepth == 0)
+        return;
+
+    if (--mBatchDepth > 0)
+        return;
+
+    const auto pending = std::move(mPendingNotifications);
+    mPendingNotifications.clear();
+
+    for (const auto& [changed, dids] : pending)
+        deliver(changed, dids);
+}
+
+const LocalChangeKeys& LocalAuthorModelChanges::getChangedAuthorDids() const
+{
+    return mChangedDids ? *mChangedDids : LocalChangeKeys::all();
+}
+
+void LocalAuthorModelChanges::deliver(ChangedFun changed, const LocalChangeKeys& dids)
+{
+    const auto* prevDids = mChangedDids;
+    mChangedDids = &dids;
+    (this->*changed)();
+    mChangedDids = prevDids;
+}
+
+LocalChangeKeys& LocalAuthorModelChanges::getPendingDids(ChangedFun changed)
+{
+    auto it = std::find_if(mPendingNotifications.begin(), mPendingNotifications.end(),
+                           [changed](const auto& pending){ return pending.first == changed; });
+
+    if (it != mPendingNotifications.end())
+        return it->second;
+
+    mPendingNotifications.push_back({ changed, {} });
+    return mPendingNotifications.back().second;
+}
+
+void LocalAuthorModelChanges::notify(ChangedFun changed, const QString& did)
+{
+    if (mBatchDepth == 0)
+    {
+        LocalChangeKeys dids;
+        dids.add(did);
+        deliver(changed, dids);
+        return;
+    }
+
+    getPendingDids(changed).add(did);
+}
+
+void LocalAuthorModelChanges::notifyAll(ChangedFun changed)
+{
+    if (mBatchDepth == 0)
+    {
+        deliver(changed, LocalChangeKeys::all());
+        return;
+    }
+
+    getPendingDids(changed).setAll();
+}
+
 void LocalAuthorModelChanges::updateBlockingUri(const QString& did, const QString& blockingUri)
 {
     mChanges[did].mBlockingUri = blockingUri;
-    blockingUriChanged();
+    notify(&LocalAuthorModelChanges::blockingUriChanged, did);
 }
 
 void LocalAuthorModelChanges::updateFollowingUri(const QString& did, const QString& followingUri)
 {
     mChanges[did].mFollowingUri = followingUri;
-    followingUriChanged();
+    notify(&LocalAuthorModelChanges::followingUriChanged, did);
 }
 
 void LocalAuthorModelChanges::updateActivitySubscription(const QString& did, const ActivitySubscription& subscription)
 {
     mChanges[did].mActivitySubscription = subscription;
-    activitySubscriptionChanged();
+    notify(&LocalAuthorModelChanges::activitySubscriptionChanged, did);
 }
 
 void LocalAuthorModelChanges::updateMuted(const QString& did, bool muted)
 {
     mChanges[did].mMuted = muted;
-    mutedChanged();
+    notify(&LocalAuthorModelChanges::mutedChanged, did);
 }
 
 void LocalAuthorModelChanges::updateMutedReposts(const QString& did, bool mutedReposts)
 {
     mChanges[did].mMutedReposts = mutedReposts;
-    mutedRepostsChanged();
+    notify(&LocalAuthorModelChanges::mutedRepostsChanged, did);
 }
 
 void LocalAuthorModelChanges::updateHideFromTimeline()
@@ -50,7 +120,7 @@ void LocalAuthorModelChanges::updateHideFromTimeline()
     // No need to actual store the changed value here as the value in mTimelineHide
     // is updated. The changed() signal will trigger retrieving the new value.
     // Probably updateMutedReposts can be changed likewise.
-    hideFromTimelineChanged();
+    notifyAll(&LocalAuthorModelChanges::hideFromTimelineChanged);
 }
 
 }
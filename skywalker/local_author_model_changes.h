@@ -1,11 +1,13 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "local_change_keys.h"
 #include "profile.h"
 #include <QHashFunctions>
 #include <QString>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace Skywalker {
 
@@ -27,6 +29,10 @@ public:
     const Change* getLocalChange(const QString& did) const;
     void clearLocalChanges();
 
+    // See LocalPostModelChanges::beginLocalChangeBatch
+    void beginLocalChangeBatch();
+    void endLocalChangeBatch();
+
     void updateBlockingUri(const QString& did, const QString& blockingUri);
     void updateFollowingUri(const QString& did, const QString& followingUri);
     void updateActivitySubscription(const QString& did, const ActivitySubscription& subscription);
@@ -35,6 +41,9 @@ public:
     void updateHideFromTimeline();
 
 protected:
+    // DIDs of the changed authors, see LocalPostModelChanges::getChangedPostKeys
+    const LocalChangeKeys& getChangedAuthorDids() const;
+
     virtual void blockingUriChanged() = 0;
     virtual void followingUriChanged() = 0;
     virtual void activitySubscriptionChanged() = 0;
@@ -43,8 +52,18 @@ protected:
     virtual void hideFromTimelineChanged() = 0;
 
 private:
+    using ChangedFun = void (LocalAuthorModelChanges::*)();
+    void notify(ChangedFun changed, const QString& did);
+    void notifyAll(ChangedFun changed);
+    void deliver(ChangedFun changed, const LocalChangeKeys& dids);
+    LocalChangeKeys& getPendingDids(ChangedFun changed);
+
     // Mapping from author DID to change
     std::unordered_map<QString, Change> mChanges;
+
+    int mBatchDepth = 0;
+    std::vector<std::pair<ChangedFun, LocalChangeKeys>> mPendingNotifications;
+    const LocalChangeKeys* mChangedDids = nullptr;
 };
 
 }
@@ -0,0 +1,60 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QHashFunctions>
+#include <QString>
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+namespace Skywalker {
+
+// Keys (CID, URI or DID) of the items affected by a local change. A model uses
+// these to signal only the rows that changed.
+class LocalChangeKeys
+{
+public:
+    static const LocalChangeKeys& all()
+    {
+        static const LocalChangeKeys sAll = []{ LocalChangeKeys keys; keys.setAll(); return keys; }();
+        return sAll;
+    }
+
+    void add(const QString& key) { mKeys.insert(key); }
+    void setAll() { mAll = true; mKeys.clear(); }
+    bool isAll() const { return mAll; }
+    bool contains(const QString& key) const { return mAll || (!key.isEmpty() && mKeys.contains(key)); }
+
+private:
+    std::unordered_set<QString> mKeys;
+    bool mAll = false;
+};
+
+// Calls emitRange(first, last) for each range of consecutive rows.
+template<typename EmitRange>
+void forEachRowRange(std::vector<int> rows, EmitRange emitRange)
+{
+    if (rows.empty())
+        return;
+
+    std::sort(rows.begin(), rows.end());
+    int first = rows[0];
+    int last = rows[0];
+
+    for (std::size_t i = 1; i < rows.size(); ++i)
+    {
+        if (rows[i] <= last + 1)
+        {
+            last = std::max(last, rows[i]);
+            continue;
+        }
+
+        emitRange(first, last);
+        first = rows[i];
+        last = rows[i];
+    }
+
+    emitRange(first, last);
+}
+
+}
@@ -1,6 +1,7 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #include "local_post_model_changes.h"
+#include <algorithm>
 
 namespace Skywalker {
 
@@ -22,106 +23,177 @@ void LocalPostModelChanges::clearLocalChanges()
     mUriChanges.clear();
 }
 
+void LocalPostModelChanges::beginLocalChangeBatch()
+{
+    ++mBatchDepth;
+}
+
+void LocalPostModelChanges::endLocalChangeBatch()
+{
+    if (mBatchDepth == 0)
+        return;
+
+    if (--mBatchDepth > 0)
+        return;
+
+    // A notification may start a new batch, so take the pending list first.
+    const auto pending = std::move(mPendingNotifications);
+    mPendingNotifications.clear();
+
+    for (const auto& [changed, keys] : pending)
+        deliver(changed, keys);
+}
+
+const LocalChangeKeys& LocalPostModelChanges::getChangedPostKeys() const
+{
+    return mChangedKeys ? *mChangedKeys : LocalChangeKeys::all();
+}
+
+void LocalPostModelChanges::deliver(ChangedFun changed, const LocalChangeKeys& keys)
+{
+    // A change handler may make a new change, restore the keys afterwards.
+    const auto* prevKeys = mChangedKeys;
+    mChangedKeys = &keys;
+    (this->*changed)();
+    mChangedKeys = prevKeys;
+}
+
+LocalChangeKeys& LocalPostModelChanges::getPendingKeys(ChangedFun changed)
+{
+    auto it = std::find_if(mPendingNotifications.begin(), mPendingNotifications.end(),
+                           [changed](const auto& pending){ return pending.first == changed; });
+
+    if (it != mPendingNotifications.end())
+        return it->second;
+
+    mPendingNotifications.push_back({ changed, {} });
+    return mPendingNotifications.back().second;
+}
+
+void LocalPostModelChanges::notify(ChangedFun changed, const QString& key)
+{
+    if (mBatchDepth == 0)
+    {
+        LocalChangeKeys keys;
+        keys.add(key);
+        deliver(changed, keys);
+        return;
+    }
+
+    getPendingKeys(changed).add(key);
+}
+
+void LocalPostModelChanges::notifyAll(ChangedFun changed)
+{
+    if (mBatchDepth == 0)
+    {
+        deliver(changed, LocalChangeKeys::all());
+        return;
+    }
+
+    getPendingKeys(changed).setAll();
+}
+
 void LocalPostModelChanges::updatePostIndexedSecondsAgo()
 {
     // No real changes, just signal change to refresh
-    postIndexedSecondsAgoChanged();
+    notifyAll(&LocalPostModelChanges::postIndexedSecondsAgoChanged);
 }
 
 void LocalPostModelChanges::updateReplyCountDelta(const QString& cid, int delta)
 {
     mChanges[cid].mReplyCountDelta += delta;
-    replyCountChanged();
+    notify(&LocalPostModelChanges::replyCountChanged, cid);
 }
 
 void LocalPostModelChanges::updateRepostCountDelta(const QString& cid, int delta)
 {
     mChanges[cid].mRepostCountDelta += delta;
-    repostCountChanged();
+    notify(&LocalPostModelChanges::repostCountChanged, cid);
 }
 
 void LocalPostModelChanges::updateQuoteCountDelta(const QString& cid, int delta)
 {
     mChanges[cid].mQuoteCountDelta += delta;
-    quoteCountChanged();
+    notify(&LocalPostModelChanges::quoteCountChanged, cid);
 }
 
 void LocalPostModelChanges::updateRepostUri(const QString& cid, const QString& repostUri)
 {
     mChanges[cid].mRepostUri = repostUri;
-    repostUriChanged();
+    notify(&LocalPostModelChanges::repostUriChanged, cid);
 }
 
 void LocalPostModelChanges::updateLikeCountDelta(const QString& cid, int delta)
 {
     mChanges[cid].mLikeCountDelta += delta;
-    likeCountChanged();
+    notify(&LocalPostModelChanges::likeCountChanged, cid);
 }
 
 void LocalPostModelChanges::updateLikeUri(const QString& cid, const QString& likeUri)
 {
     mChanges[cid].mLikeUri = likeUri;
-    likeUriChanged();
+    notify(&LocalPostModelChanges::likeUriChanged, cid);
 }
 
 void LocalPostModelChanges::updateLikeTransient(const QString& cid, bool transient)
 {
     mChanges[cid].mLikeTransient = transient;
-    likeTransientChanged();
+    notify(&LocalPostModelChanges::likeTransientChanged, cid);
 }
 
 void LocalPostModelChanges::updateThreadgateUri(const QString& cid, const QString& threadgateUri)
 {
     mChanges[cid].mThreadgateUri = threadgateUri;
-    threadgateUriChanged();
+    notify(&LocalPostModelChanges::threadgateUriChanged, cid);
 }
 
 void LocalPostModelChanges::updateReplyRestriction(const QString& cid, const QEnums::ReplyRestriction replyRestricion)
 {
     mChanges[cid].mReplyRestriction = replyRestricion;
-    replyRestrictionChanged();
+    notify(&LocalPostModelChanges::replyRestrictionChanged, cid);
 }
 
 void LocalPostModelChanges::updateReplyRestrictionLists(const QString& cid, const ListViewBasicList replyRestrictionLists)
 {
     mChanges[cid].mReplyRestrictionLists = replyRestrictionLists;
-    replyRestrictionListsChanged();
+    notify(&LocalPostModelChanges::replyRestrictionListsChanged, cid);
 }
 
 void LocalPostModelChanges::updateHiddenReplies(const QString& cid, const QStringList& hiddenReplies)
 {
     mChanges[cid].mHiddenReplies = hiddenReplies;
-    hiddenRepliesChanged();
+    notify(&LocalPostModelChanges::hiddenRepliesChanged, cid);
 }
 
 void LocalPostModelChanges::updateThreadMuted(const QString& uri, bool muted)
 {
     mUriChanges[uri].mThreadMuted = muted;
-    threadMutedChanged();
+    notify(&LocalPostModelChanges::threadMutedChanged, uri);
 }
 
 void LocalPostModelChanges::updateBookmarked(const QString& cid, bool bookmarked)
 {
     mChanges[cid].mBookmarked = bookmarked;
-    bookmarkedChanged();
+    notify(&LocalPostModelChanges::bookmarkedChanged, cid);
 }
 
 void LocalPostModelChanges::updateBookmarkTransient(const QString& cid, bool transient)
 {
     mChanges[cid].mBookmarkTransient = transient;
-    bookmarkTransientChanged();
+    notify(&LocalPostModelChanges::bookmarkTransientChanged, cid);
 }
 
 void LocalPostModelChanges::updateFeedback(const QString& cid, QEnums::FeedbackType feedback)
 {
     mChanges[cid].mFeedback = feedback;
-    feedbackChanged();
+    notify(&LocalPostModelChanges::feedbackChanged, cid);
 }
 
 void LocalPostModelChanges::updateFeedbackTransient(const QString& cid, QEnums::FeedbackType transient)
 {
     mChanges[cid].mFeedbackTransient = transient;
-    feedbackTransientChanged();
+    notify(&LocalPostModelChanges::feedbackTransientChanged, cid);
 }
 
 bool LocalPostModelChanges::updateDetachedRecord(const QString& cid, const QString& postUri)
@@ -143,26 +215,26 @@ bool LocalPostModelChanges::updateDetachedRecord(const QString& cid, const QStri
         mChanges[cid].mDetachedRecord = RecordView::makeDetachedRecord(postUri);
     }
 
-    detachedRecordChanged();
+    notify(&LocalPostModelChanges::detachedRecordChanged, cid);
     return false;
 }
 
 void LocalPostModelChanges::updateReAttachedRecord(const QString& cid, RecordView::SharedPtr record)
 {
     mChanges[cid].mReAttachedRecord = record;
-    reAttachedRecordChanged();
+    notify(&LocalPostModelChanges::reAttachedRecordChanged, cid);
 }
 
 void LocalPostModelChanges::updateViewerStatePinned(const QString& cid, bool pinned)
 {
     mChanges[cid].mViewerStatePinned = pinned;
-    viewerStatePinnedChanged();
+    notify(&LocalPostModelChanges::viewerStatePinnedChanged, cid);
 }
 
 void LocalPostModelChanges::updatePostDeleted(const QString& cid)
 {
     mChanges[cid].mPostDeleted = true;
-    postDeletedChanged();
+    notify(&LocalPostModelChanges::postDeletedChanged, cid);
 }
 
 }
@@ -3,12 +3,14 @@
 #pragma once
 #include "enums.h"
 #include "list_view_include.h"
+#include "local_change_keys.h"
 #include "record_view.h"
 #include <atproto/lib/lexicon/app_bsky_feed.h>
 #include <QHashFunctions>
 #include <QString>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace Skywalker {
 
@@ -51,6 +53,16 @@ public:
     const Change* getLocalUriChange(const QString& uri) const;
     void clearLocalChanges();
 
+    // While a batch is active, change notifications are collected. At the end
+    // of the batch each type of change is signalled once, such that a bulk
+    // update does not refresh the model for every single post. The keys of
+    // the changed posts are available via getChangedPostKeys() while the
+    // change is signalled.
+    // Batches can be nested.
+    void beginLocalChangeBatch();
+    void endLocalChangeBatch();
+    bool isLocalChangeBatchActive() const { return mBatchDepth > 0; }
+
     void updatePostIndexedSecondsAgo();
     void updateReplyCountDelta(const QString& cid, int delta);
     void updateRepostCountDelta(const QString& cid, int delta);
@@ -82,6 +94,10 @@ public:
     void updatePostDeleted(const QString& cid);
 
 protected:
+    // CIDs of the changed posts, or URIs for a thread mute change. Outside the
+    // signalling of a change, all posts are considered changed.
+    const LocalChangeKeys& getChangedPostKeys() const;
+
     virtual void postIndexedSecondsAgoChanged() = 0;
     virtual void likeCountChanged() = 0;
     virtual void likeUriChanged() = 0;
@@ -105,11 +121,21 @@ protected:
     virtual void postDeletedChanged() = 0;
 
 private:
+    using ChangedFun = void (LocalPostModelChanges::*)();
+    void notify(ChangedFun changed, const QString& key);
+    void notifyAll(ChangedFun changed);
+    void deliver(ChangedFun changed, const LocalChangeKeys& keys);
+    LocalChangeKeys& getPendingKeys(ChangedFun changed);
+
     // Mapping from post CID to change
     std::unordered_map<QString, Change> mChanges;
 
     // Mapping from post URI to change
     std::unordered_map<QString, Change> mUriChanges;
+
+    int mBatchDepth = 0;
+    std::vector<std::pair<ChangedFun, LocalChangeKeys>> mPendingNotifications;
+    const LocalChangeKeys* mChangedKeys = nullptr;
 };
 
 }
@@ -16,16 +16,80 @@ void LocalProfileChanges::clearLocalProfileChanges()
     mLocallyBlocked.clear();
 }
 
+void LocalProfileChanges::beginLocalChangeBatch()
+{
+    ++mBatchDepth;
+}
+
+void LocalProfileChanges::endLocalChangeBatch()
+{
+    if (mBatchDepth == 0)
+        return;
+
+    if (--mBatchDepth > 0)
+        return;
+
+    if (mProfileChangePending)
+    {
+        mProfileChangePending = false;
+        const auto dids = std::move(mPendingProfileDids);
+        mPendingProfileDids = {};
+        deliver(&LocalProfileChanges::profileChanged, dids);
+    }
+
+    if (mLocallyBlockedChangePending)
+    {
+        mLocallyBlockedChangePending = false;
+        const auto dids = std::move(mPendingLocallyBlockedDids);
+        mPendingLocallyBlockedDids = {};
+        deliver(&LocalProfileChanges::locallyBlockedChanged, dids);
+    }
+}
+
+const LocalChangeKeys& LocalProfileChanges::getChangedProfileDids() const
+{
+    return mChangedDids ? *mChangedDids : LocalChangeKeys::all();
+}
+
+void LocalProfileChanges::deliver(ChangedFun changed, const LocalChangeKeys& dids)
+{
+    const auto* prevDids = mChangedDids;
+    mChangedDids = &dids;
+    (this->*changed)();
+    mChangedDids = prevDids;
+}
+
+void LocalProfileChanges::notify(ChangedFun changed, LocalChangeKeys& pendingKeys, const QString& did)
+{
+    if (mBatchDepth == 0)
+    {
+        LocalChangeKeys dids;
+        dids.add(did);
+        deliver(changed, dids);
+        return;
+    }
+
+    pendingKeys.add(did);
+}
+
 void LocalProfileChanges::updateProfile(const Profile& profile)
 {
     mChanges[profile.getDid()] = profile;
-    profileChanged();
+
+    if (mBatchDepth > 0)
+        mProfileChangePending = true;
+
+    notify(&LocalProfileChanges::profileChanged, mPendingProfileDids, profile.getDid());
 }
 
 void LocalProfileChanges::setLocallyBlocked(const QString& did, bool blocked)
 {
     mLocallyBlocked[did] = blocked;
-    locallyBlockedChanged();
+
+    if (mBatchDepth > 0)
+        mLocallyBlockedChangePending = true;
+
+    notify(&LocalProfileChanges::locallyBlockedChanged, mPendingLocallyBlockedDids, did);
 }
 
 bool LocalProfileChanges::getLocallyBlocked(const QString& did) const
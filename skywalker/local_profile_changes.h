@@ -1,6 +1,7 @@
 // Copyright (C) 2024 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "local_change_keys.h"
 #include "profile.h"
 #include <QHashFunctions>
 #include <QString>
@@ -22,14 +23,32 @@ public:
     void setLocallyBlocked(const QString& did, bool blocked);
     bool getLocallyBlocked(const QString& did) const;
 
+    // See LocalPostModelChanges::beginLocalChangeBatch
+    void beginLocalChangeBatch();
+    void endLocalChangeBatch();
+
 protected:
+    // DIDs of the changed profiles, see LocalPostModelChanges::getChangedPostKeys
+    const LocalChangeKeys& getChangedProfileDids() const;
+
     virtual void profileChanged() = 0;
     virtual void locallyBlockedChanged() = 0;
 
 private:
+    using ChangedFun = void (LocalProfileChanges::*)();
+    void notify(ChangedFun changed, LocalChangeKeys& pendingKeys, const QString& did);
+    void deliver(ChangedFun changed, const LocalChangeKeys& dids);
+
     // Mapping from DID to change
     std::unordered_map<QString, Profile> mChanges;
     std::unordered_map<QString, bool> mLocallyBlocked;
+
+    int mBatchDepth = 0;
+    bool mProfileChangePending = false;
+    bool mLocallyBlockedChangePending = false;
+    LocalChangeKeys mPendingProfileDids;
+    LocalChangeKeys mPendingLocallyBlockedDids;
+    const LocalChangeKeys* mChangedDids = nullptr;
 };
 
 }
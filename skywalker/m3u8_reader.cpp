@@ -3,6 +3,7 @@
 #include "m3u8_reader.h"
 #include "file_utils.h"
 #include "m3u8_parser.h"
+#include "media_cache.h"
 #include "network_utils.h"
 
 namespace Skywalker {
@@ -15,6 +16,9 @@ M3U8Reader::M3U8Reader(QObject* parent) :
 {
     mNetwork->setAutoDeleteReplies(true);
     mNetwork->setTransferTimeout(10000);
+
+    // Playlists may have been prefetched. Video segments are not cached.
+    mNetwork->setCache(new MediaNetworkCache);
 }
 
 void M3U8Reader::setVideoQuality(QEnums::VideoQuality quality)
@@ -0,0 +1,269 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "media_cache.h"
+#include <QBuffer>
+#include <QNetworkAccessManager>
+
+namespace Skywalker {
+
+MediaCache& MediaCache::instance()
+{
+    static MediaCache sInstance;
+    return sInstance;
+}
+
+MediaCache::MediaCache(qsizetype maxSize) :
+    mCache("MediaCache", maxSize,
+           [](const QUrl& url, const Entry& entry){
+               return entry.mData.size() + url.toString().size() * (qsizetype)sizeof(QChar);
+           })
+{
+}
+
+MediaCache::~MediaCache()
+{
+    if (mRegistered && MemoryBudget::exists())
+        MemoryBudget::instance().unregisterCache(this);
+}
+
+void MediaCache::registerWithMemoryBudget()
+{
+    if (mRegistered)
+        return;
+
+    MemoryBudget::instance().registerFixedCache(this, getMaxCost());
+    mRegistered = true;
+}
+
+bool MediaCache::isCacheable(const QNetworkCacheMetaData& metaData)
+{
+    bool isMedia = false;
+
+    for (const auto& [name, value] : metaData.rawHeaders())
+    {
+        const QByteArray header = name.toLower();
+
+        if (header == "content-length" && value.toLongLong() > MAX_ENTRY_SIZE)
+            return false;
+
+        if (header == "content-type")
+        {
+            const QByteArray type = value.toLower();
+            isMedia = type.startsWith("image/") || type.contains("mpegurl");
+        }
+    }
+
+    return isMedia;
+}
+
+QNetworkCacheMetaData MediaCache::getMetaData(const QUrl& url) const
+{
+    QMutexLocker locker(&mMutex);
+    const auto entry = mCache.get(url);
+    return entry ? entry->mMetaData : QNetworkCacheMetaData();
+}
+
+void MediaCache::updateMetaData(const QNetworkCacheMetaData& metaData)
+{
+    QMutexLocker locker(&mMutex);
+    auto entry = mCache.get(metaData.url());
+
+    if (entry)
+        entry->mMetaData = metaData;
+}
+
+bool MediaCache::getData(const QUrl& url, QByteArray& data) const
+{
+    QMutexLocker locker(&mMutex);
+    const auto entry = mCache.get(url);
+
+    if (!entry)
+        return false;
+
+    data = entry->mData;
+    return true;
+}
+
+void MediaCache::insert(const QNetworkCacheMetaData& metaData, const QByteArray& data)
+{
+    QMutexLocker locker(&mMutex);
+
+    if (data.size() > MAX_ENTRY_SIZE)
+    {
+        qDebug() << "Too large to cache:" << metaData.url() << "size:" << data.size();
+        mCache.remove(metaData.url());
+        return;
+    }
+
+    mCache.insert(metaData.url(), Entry{ metaData, data });
+}
+
+bool MediaCache::remove(const QUrl& url)
+{
+    QMutexLocker locker(&mMutex);
+    return mCache.remove(url);
+}
+
+bool MediaCache::contains(const QUrl& url) const
+{
+    QMutexLocker locker(&mMutex);
+    return mCache.contains(url);
+}
+
+void MediaCache::clear()
+{
+    QMutexLocker locker(&mMutex);
+    mCache.clear();
+}
+
+qsizetype MediaCache::getTotalSize() const
+{
+    QMutexLocker locker(&mMutex);
+    return mCache.getTotalCost();
+}
+
+const QString& MediaCache::getName() const
+{
+    // The name never changes
+    return mCache.getName();
+}
+
+qsizetype MediaCache::getTotalCost() const
+{
+    return getTotalSize();
+}
+
+qsizetype MediaCache::getMaxCost() const
+{
+    QMutexLocker locker(&mMutex);
+    return mCache.getMaxCost();
+}
+
+void MediaCache::setMaxCost(qsizetype maxCost)
+{
+    QMutexLocker locker(&mMutex);
+    mCache.setMaxCost(maxCost);
+}
+
+void MediaCache::trim(qsizetype maxCost)
+{
+    QMutexLocker locker(&mMutex);
+    mCache.trim(maxCost);
+}
+
+const MemoryCacheStats& MediaCache::getStats() const
+{
+    QMutexLocker locker(&mMutex);
+    mStats = mCache.getStats();
+    return mStats;
+}
+
+MediaNetworkCache::MediaNetworkCache(QObject* parent) :
+    QAbstractNetworkCache(parent)
+{
+}
+
+QNetworkCacheMetaData MediaNetworkCache::metaData(const QUrl& url)
+{
+    return MediaCache::instance().getMetaData(url);
+}
+
+void MediaNetworkCache::updateMetaData(const QNetworkCacheMetaData& metaData)
+{
+    MediaCache::instance().updateMetaData(metaData);
+}
+
+QIODevice* MediaNetworkCache::data(const QUrl& url)
+{
+    QByteArray data;
+
+    if (!MediaCache::instance().getData(url, data))
+        return nullptr;
+
+    // The caller takes ownership
+    auto* buffer = new QBuffer;
+    buffer->setData(data);
+    buffer->open(QIODevice::ReadOnly);
+    return buffer;
+}
+
+bool MediaNetworkCache::remove(const QUrl& url)
+{
+    bool removed = false;
+
+    for (auto it = mPrepared.begin(); it != mPrepared.end(); )
+    {
+        if (it->second.url() == url)
+        {
+            delete it->first;
+            it = mPrepared.erase(it);
+            removed = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return MediaCache::instance().remove(url) || removed;
+}
+
+qint64 MediaNetworkCache::cacheSize() const
+{
+    return MediaCache::instance().getTotalSize();
+}
+
+QIODevice* MediaNetworkCache::prepare(const QNetworkCacheMetaData& metaData)
+{
+    if (!metaData.isValid() || !metaData.url().isValid() || !metaData.saveToDisk())
+        return nullptr;
+
+    if (!MediaCache::isCacheable(metaData))
+        return nullptr;
+
+    auto* buffer = new QBuffer(this);
+
+    if (!buffer->open(QIODevice::ReadWrite))
+    {
+        delete buffer;
+        return nullptr;
+    }
+
+    mPrepared[buffer] = metaData;
+    return buffer;
+}
+
+void MediaNetworkCache::insert(QIODevice* device)
+{
+    auto it = mPrepared.find(device);
+
+    if (it == mPrepared.end())
+    {
+        qWarning() << "Unknown device";
+        return;
+    }
+
+    const auto* buffer = static_cast<QBuffer*>(device);
+    MediaCache::instance().insert(it->second, buffer->data());
+    mPrepared.erase(it);
+    delete device;
+}
+
+void MediaNetworkCache::clear()
+{
+    for (const auto& [device, _] : mPrepared)
+        delete device;
+
+    mPrepared.clear();
+    MediaCache::instance().clear();
+}
+
+QNetworkAccessManager* MediaNetworkAccessManagerFactory::create(QObject* parent)
+{
+    // Called from the QML loader threads
+    auto* network = new QNetworkAccessManager(parent);
+    network->setCache(new MediaNetworkCache);
+    return network;
+}
+
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include "memory_cache.h"
+#include <QAbstractNetworkCache>
+#include <QMutex>
+#include <QNetworkCacheMetaData>
+#include <QQmlNetworkAccessManagerFactory>
+#include <QUrl>
+#include <unordered_map>
+
+namespace Skywalker {
+
+// In-memory HTTP cache for media (images and video playlists). It is shared
+// by the network access managers of the QML image loader, the video stream
+// reader and the media prefetcher, such that media prefetched for rows that
+// are not shown yet, load from memory once they get shown.
+//
+// The QML image loader runs in its own thread, so access is serialized. That
+// includes the trims by the memory budget.
+class MediaCache : public IMemoryCache
+{
+public:
+    static constexpr qsizetype MAX_SIZE = 24 * 1024 * 1024;
+    static constexpr qsizetype MAX_ENTRY_SIZE = 2 * 1024 * 1024;
+
+    static MediaCache& instance();
+
+    explicit MediaCache(qsizetype maxSize = MAX_SIZE);
+    ~MediaCache();
+
+    // Registers the cache with its fixed size. Call from the GUI thread.
+    void registerWithMemoryBudget();
+
+    // Media types that are worth caching. Video segments are not.
+    static bool isCacheable(const QNetworkCacheMetaData& metaData);
+
+    QNetworkCacheMetaData getMetaData(const QUrl& url) const;
+    void updateMetaData(const QNetworkCacheMetaData& metaData);
+
+    // Returns false if the URL is not in the cache.
+    bool getData(const QUrl& url, QByteArray& data) const;
+
+    void insert(const QNetworkCacheMetaData& metaData, const QByteArray& data);
+    bool remove(const QUrl& url);
+    bool contains(const QUrl& url) const;
+    void clear();
+
+    qsizetype getTotalSize() const;
+
+    const QString& getName() const override;
+    qsizetype getTotalCost() const override;
+    qsizetype getMaxCost() const override;
+    void setMaxCost(qsizetype maxCost) override;
+    void trim(qsizetype maxCost) override;
+
+    // The stats at the time of the call. Call from the GUI thread.
+    const MemoryCacheStats& getStats() const override;
+
+private:
+    struct Entry
+    {
+        QNetworkCacheMetaData mMetaData;
+        QByteArray mData;
+    };
+
+    mutable QMutex mMutex;
+    MemoryCache<QUrl, Entry> mCache;
+    mutable MemoryCacheStats mStats;
+    bool mRegistered = false;
+};
+
+// A QNetworkAccessManager takes ownership of its cache, so each manager gets
+// its own view on the MediaCache.
+class MediaNetworkCache : public QAbstractNetworkCache
+{
+    Q_OBJECT
+
+public:
+    explicit MediaNetworkCache(QObject* parent = nullptr);
+
+    QNetworkCacheMetaData metaData(const QUrl& url) override;
+    void updateMetaData(const QNetworkCacheMetaData& metaData) override;
+    QIODevice* data(const QUrl& url) override;
+    bool remove(const QUrl& url) override;
+    qint64 cacheSize() const override;
+    QIODevice* prepare(const QNetworkCacheMetaData& metaData) override;
+    void insert(QIODevice* device) override;
+
+public slots:
+    void clear() override;
+
+private:
+    // Devices handed out by prepare, waiting for insert or remove.
+    std::unordered_map<QIODevice*, QNetworkCacheMetaData> mPrepared;
+};
+
+// Network access managers for the QML engine, which loads images through them.
+class MediaNetworkAccessManagerFactory : public QQmlNetworkAccessManagerFactory
+{
+public:
+    QNetworkAccessManager* create(QObject* parent) override;
+};
+
+}
@@ -0,0 +1,234 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "media_prefetcher.h"
+#include "abstract_post_feed_model.h"
+#include "author_cache.h"
+#include "media_cache.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Skywalker {
+
+std::vector<int> MediaPrefetcher::getPrefetchRows(int firstVisibleIndex, int lastVisibleIndex,
+                                                  double velocity, int rowCount)
+{
+    if (rowCount <= 0 || firstVisibleIndex < 0 || lastVisibleIndex < firstVisibleIndex)
+        return {};
+
+    lastVisibleIndex = std::min(lastVisibleIndex, rowCount - 1);
+    const int extraRows = std::min(int(std::abs(velocity) / VELOCITY_PER_ROW),
+                                   MAX_PREFETCH_ROWS - MIN_PREFETCH_ROWS);
+    const int rowsAhead = MIN_PREFETCH_ROWS + extraRows;
+    std::vector<int> rows;
+
+    for (int i = 1; i <= rowsAhead; ++i)
+    {
+        if (velocity >= 0.0 && lastVisibleIndex + i < rowCount)
+            rows.push_back(lastVisibleIndex + i);
+
+        if (velocity <= 0.0 && firstVisibleIndex - i >= 0)
+            rows.push_back(firstVisibleIndex - i);
+    }
+
+    return rows;
+}
+
+MediaPrefetcher::RowMedia MediaPrefetcher::getRowMedia(const Post& post)
+{
+    RowMedia media;
+
+    if (post.isPlaceHolder())
+        return media;
+
+    const auto addImage = [&media](const QString& url){
+        if (!url.isEmpty())
+            media.mImageUrls.push_back(url);
+    };
+
+    addImage(post.getAuthor().getAvatarThumbUrl());
+
+    for (const auto& image : post.getImages())
+        addImage(image.getThumbUrl());
+
+    if (const auto external = post.getExternalView())
+        addImage(external->getThumbUrl());
+
+    if (const auto video = post.getVideoView())
+    {
+        addImage(video->getThumbUrl());
+        const QString playlistUrl = video->getPlaylistUrl();
+
+        if (playlistUrl.endsWith(".m3u8"))
+            media.mPlaylistUrl = playlistUrl;
+    }
+
+    if (post.isReply() && !post.getReplyToAuthor())
+    {
+        const QString did = post.getReplyToAuthorDid();
+
+        if (!did.isEmpty() && !AuthorCache::instance().contains(did))
+            media.mAuthorDid = did;
+    }
+
+    return media;
+}
+
+MediaPrefetcher::MediaPrefetcher(QObject* parent) :
+    QObject(parent),
+    mNetwork(new QNetworkAccessManager(this)),
+    mPutAuthorFn([](const QString& did){ AuthorCache::instance().putProfile(did); })
+{
+    mNetwork->setAutoDeleteReplies(true);
+    mNetwork->setTransferTimeout(TRANSFER_TIMEOUT_MS);
+    mNetwork->setCache(new MediaNetworkCache);
+}
+
+void MediaPrefetcher::prefetch(const AbstractPostFeedModel& model, int firstVisibleIndex, int lastVisibleIndex, double velocity)
+{
+    prefetch(firstVisibleIndex, lastVisibleIndex, velocity, model.rowCount(),
+             [&model](int row){ return getRowMedia(model.getPost(row)); });
+}
+
+void MediaPrefetcher::prefetch(int firstVisibleIndex, int lastVisibleIndex, double velocity, int rowCount,
+                               const GetRowMediaFn& getRowMediaFn)
+{
+    // Called for every move of the view. Only when other rows come in range
+    // there is work to do.
+    auto rows = getPrefetchRows(firstVisibleIndex, lastVisibleIndex, velocity, rowCount);
+
+    if (rows == mLastRows && rowCount == mLastRowCount)
+        return;
+
+    mLastRows = std::move(rows);
+    mLastRowCount = rowCount;
+
+    std::vector<QString> urls;
+    std::unordered_set<QString> wanted;
+
+    const auto addUrl = [&urls, &wanted](const QString& url){
+        if (!url.isEmpty() && wanted.insert(url).second)
+            urls.push_back(url);
+    };
+
+    for (int row : mLastRows)
+    {
+        const RowMedia media = getRowMediaFn(row);
+
+        for (const auto& url : media.mImageUrls)
+            addUrl(url);
+
+        addUrl(media.mPlaylistUrl);
+
+        if (!media.mAuthorDid.isEmpty() && mPutAuthorFn && !mRequestedDids.contains(media.mAuthorDid))
+        {
+            mRequestedDids.insert(media.mAuthorDid);
+            mPutAuthorFn(media.mAuthorDid);
+        }
+    }
+
+    // Aborting a reply finishes it synchronously, so take it out first.
+    std::vector<QNetworkReply*> canceled;
+
+    for (auto it = mInFlight.begin(); it != mInFlight.end(); )
+    {
+        if (!wanted.contains(it->first))
+        {
+            canceled.push_back(it->second);
+            it = mInFlight.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto* reply : canceled)
+        reply->abort();
+
+    if (!canceled.empty())
+        qDebug() << "Canceled prefetches:" << canceled.size();
+
+    mQueue.clear();
+
+    for (const auto& url : urls)
+    {
+        if (mInFlight.contains(url) || mFailedUrls.contains(url))
+            continue;
+
+        if (MediaCache::instance().contains(QUrl(url)))
+            continue;
+
+        mQueue.push_back(url);
+    }
+
+    startRequests();
+}
+
+void MediaPrefetcher::clear()
+{
+    mQueue.clear();
+    mLastRows.clear();
+    mLastRowCount = -1;
+    mFailedUrls.clear();
+    mRequestedDids.clear();
+
+    std::unordered_map<QString, QNetworkReply*> inFlight;
+    inFlight.swap(mInFlight);
+
+    for (const auto& [_, reply] : inFlight)
+        reply->abort();
+}
+
+void MediaPrefetcher::startRequests()
+{
+    while ((int)mInFlight.size() < MAX_IN_FLIGHT && !mQueue.empty())
+    {
+        const QString url = mQueue.front();
+        mQueue.pop_front();
+
+        // May have been loaded by the view meanwhile
+        if (MediaCache::instance().contains(QUrl(url)))
+            continue;
+
+        startRequest(url);
+    }
+}
+
+void MediaPrefetcher::startRequest(const QString& url)
+{
+    QNetworkRequest request{QUrl(url)};
+    request.setPriority(QNetworkRequest::LowPriority);
+
+    // The data is not read. The network cache stores it while it comes in.
+    QNetworkReply* reply = mNetwork->get(request);
+    mInFlight[url] = reply;
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, url]{
+        requestFinished(reply, url);
+    });
+}
+
+void MediaPrefetcher::requestFinished(QNetworkReply* reply, const QString& url)
+{
+    auto it = mInFlight.find(url);
+
+    // Canceled
+    if (it == mInFlight.end() || it->second != reply)
+        return;
+
+    mInFlight.erase(it);
+
+    if (reply->error() != QNetworkReply::NoError)
+    {
+        qDebug() << "Prefetch failed:" << url << reply->errorString();
+        mFailedUrls.insert(url);
+    }
+    else
+    {
+        emit prefetched(url);
+    }
+
+    startRequests();
+}
+
+}
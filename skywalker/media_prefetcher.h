@@ -0,0 +1,87 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QUrl>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Skywalker {
+
+class AbstractPostFeedModel;
+class Post;
+
+// Loads the media of the rows that are about to scroll into view of a post
+// feed, such that the view gets them from the MediaCache instead of showing
+// placeholders. Images and video playlists are fetched with a bounded number
+// of requests in flight, closest rows first. Requests for rows that scrolled
+// out of the prefetch range are canceled. Missing reply-to authors are put in
+// the AuthorCache.
+class MediaPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MAX_IN_FLIGHT = 4;
+
+    // The cache buffer of the timeline view holds about 3 screens of delegates.
+    // Prefetching reaches beyond that, further when scrolling fast.
+    static constexpr int MIN_PREFETCH_ROWS = 10;
+    static constexpr int MAX_PREFETCH_ROWS = 40;
+    static constexpr int VELOCITY_PER_ROW = 250; // pixels/s for each extra row
+    static constexpr int TRANSFER_TIMEOUT_MS = 10000;
+
+    struct RowMedia
+    {
+        QStringList mImageUrls;
+        QString mPlaylistUrl;
+        QString mAuthorDid; // author that is missing in the AuthorCache
+    };
+
+    using GetRowMediaFn = std::function<RowMedia(int row)>;
+    using PutAuthorFn = std::function<void(const QString& did)>;
+
+    // Rows to prefetch, ordered by priority.
+    static std::vector<int> getPrefetchRows(int firstVisibleIndex, int lastVisibleIndex,
+                                            double velocity, int rowCount);
+
+    static RowMedia getRowMedia(const Post& post);
+
+    explicit MediaPrefetcher(QObject* parent = nullptr);
+
+    // The velocity is in pixels/s, positive when scrolling towards higher
+    // indices. At 0 both directions are prefetched.
+    void prefetch(const AbstractPostFeedModel& model, int firstVisibleIndex, int lastVisibleIndex, double velocity);
+    void prefetch(int firstVisibleIndex, int lastVisibleIndex, double velocity, int rowCount,
+                  const GetRowMediaFn& getRowMediaFn);
+
+    // Cancels all requests.
+    void clear();
+
+    void setPutAuthorFn(const PutAuthorFn& putAuthorFn) { mPutAuthorFn = putAuthorFn; }
+    int getInFlightCount() const { return mInFlight.size(); }
+    int getQueueSize() const { return mQueue.size(); }
+
+signals:
+    void prefetched(const QString& url);
+
+private:
+    void startRequests();
+    void startRequest(const QString& url);
+    void requestFinished(QNetworkReply* reply, const QString& url);
+
+    QNetworkAccessManager* mNetwork;
+    PutAuthorFn mPutAuthorFn;
+    std::deque<QString> mQueue; // URLs by priority
+    std::unordered_map<QString, QNetworkReply*> mInFlight; // URL -> reply
+    std::unordered_set<QString> mFailedUrls;
+    std::unordered_set<QString> mRequestedDids;
+    std::vector<int> mLastRows;
+    int mLastRowCount = -1;
+};
+
+}
@@ -0,0 +1,160 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "memory_budget.h"
+#include "jni_callback.h"
+#include <QGuiApplication>
+
+namespace Skywalker {
+
+namespace {
+
+// Android ComponentCallbacks2 trim levels
+constexpr int TRIM_MEMORY_RUNNING_LOW = 10;
+constexpr int TRIM_MEMORY_RUNNING_CRITICAL = 15;
+constexpr int TRIM_MEMORY_UI_HIDDEN = 20;
+constexpr int TRIM_MEMORY_MODERATE = 60;
+
+}
+
+Q_GLOBAL_STATIC(std::unique_ptr<MemoryBudget>, gMemoryBudget);
+
+MemoryBudget& MemoryBudget::instance()
+{
+    auto& instance = *gMemoryBudget;
+    if (!instance)
+        instance.reset(new MemoryBudget);
+
+    return *instance;
+}
+
+bool MemoryBudget::exists()
+{
+    return !gMemoryBudget.isDestroyed() && *gMemoryBudget;
+}
+
+MemoryBudget::MemoryBudget() : QObject()
+{
+    auto* app = qobject_cast<QGuiApplication*>(QCoreApplication::instance());
+
+    if (app)
+    {
+        connect(app, &QGuiApplication::applicationStateChanged, this,
+                [this](Qt::ApplicationState state){ handleAppStateChange(state); });
+    }
+
+    connect(&JNICallbackListener::getInstance(), &JNICallbackListener::trimMemory, this,
+            [this](int level){ handleTrimMemory(level); });
+}
+
+void MemoryBudget::registerCache(IMemoryCache* cache, int weight)
+{
+    Q_ASSERT(cache);
+    Q_ASSERT(weight > 0);
+    qDebug() << "Register cache:" << cache->getName() << "weight:" << weight;
+    mCaches.push_back({ cache, weight });
+    distribute();
+}
+
+void MemoryBudget::registerFixedCache(IMemoryCache* cache, qsizetype maxCost)
+{
+    Q_ASSERT(cache);
+    qDebug() << "Register cache:" << cache->getName() << "fixed max cost:" << maxCost;
+    mCaches.push_back({ cache, 0, maxCost });
+    cache->setMaxCost(maxCost);
+}
+
+void MemoryBudget::unregisterCache(IMemoryCache* cache)
+{
+    std::erase_if(mCaches, [cache](const auto& reg){ return reg.mCache == cache; });
+    distribute();
+}
+
+void MemoryBudget::setBudget(qsizetype budget)
+{
+    qDebug() << "Memory budget:" << budget;
+    mBudget = budget;
+    distribute();
+}
+
+qsizetype MemoryBudget::getTotalCost() const
+{
+    qsizetype total = 0;
+
+    for (const auto& reg : mCaches)
+        total += reg.mCache->getTotalCost();
+
+    return total;
+}
+
+void MemoryBudget::trim(int percentage)
+{
+    qDebug() << "Trim caches to:" << percentage << "% total cost:" << getTotalCost();
+
+    for (const auto& reg : mCaches)
+        reg.mCache->trim(getMaxCost(reg) * percentage / 100);
+
+    qDebug() << "Total cost after trim:" << getTotalCost();
+}
+
+void MemoryBudget::logStats() const
+{
+    for (const auto& reg : mCaches)
+    {
+        const auto* cache = reg.mCache;
+        const auto& stats = cache->getStats();
+        qDebug() << cache->getName() << "cost:" << cache->getTotalCost() << "max:" << cache->getMaxCost()
+                 << "hits:" << stats.mHits << "misses:" << stats.mMisses
+                 << "inserts:" << stats.mInserts << "evictions:" << stats.mEvictions;
+    }
+}
+
+void MemoryBudget::distribute()
+{
+    for (const auto& reg : mCaches)
+    {
+        if (reg.mWeight > 0)
+            reg.mCache->setMaxCost(getShare(reg.mWeight));
+    }
+}
+
+qsizetype MemoryBudget::getShare(int weight) const
+{
+    int totalWeight = 0;
+
+    for (const auto& reg : mCaches)
+        totalWeight += reg.mWeight;
+
+    if (totalWeight == 0)
+        return 0;
+
+    return mBudget * weight / totalWeight;
+}
+
+qsizetype MemoryBudget::getMaxCost(const Registration& reg) const
+{
+    return reg.mWeight > 0 ? getShare(reg.mWeight) : reg.mFixedCost;
+}
+
+void MemoryBudget::handleAppStateChange(Qt::ApplicationState state)
+{
+    if (state == Qt::ApplicationSuspended)
+    {
+        logStats();
+        trim(50);
+    }
+}
+
+void MemoryBudget::handleTrimMemory(int level)
+{
+    qDebug() << "Trim memory level:" << level;
+    logStats();
+
+    if (level >= TRIM_MEMORY_MODERATE || level == TRIM_MEMORY_RUNNING_CRITICAL)
+        trim(0);
+    else if (level >= TRIM_MEMORY_UI_HIDDEN || level == TRIM_MEMORY_RUNNING_LOW)
+        trim(25);
+    else
+        trim(50);
+}
+
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QObject>
+#include <QString>
+#include <vector>
+
+namespace Skywalker {
+
+struct MemoryCacheStats
+{
+    qint64 mHits = 0;
+    qint64 mMisses = 0;
+    qint64 mInserts = 0;
+    qint64 mEvictions = 0;
+};
+
+class IMemoryCache
+{
+public:
+    virtual ~IMemoryCache() = default;
+    virtual const QString& getName() const = 0;
+    virtual qsizetype getTotalCost() const = 0;
+    virtual qsizetype getMaxCost() const = 0;
+    virtual void setMaxCost(qsizetype maxCost) = 0;
+
+    // Evict least recently used entries till the total cost is at most maxCost.
+    // The max cost setting is not changed.
+    virtual void trim(qsizetype maxCost) = 0;
+
+    virtual const MemoryCacheStats& getStats() const = 0;
+};
+
+// Global memory budget (in bytes) shared by all registered caches. Each cache
+// gets a share of the budget proportional to its weight. A cache with a fixed
+// max cost comes on top of the budget, but is trimmed with the other caches.
+class MemoryBudget : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qsizetype DEFAULT_BUDGET = 8 * 1024 * 1024;
+
+    static MemoryBudget& instance();
+    static bool exists();
+
+    void registerCache(IMemoryCache* cache, int weight);
+    void registerFixedCache(IMemoryCache* cache, qsizetype maxCost);
+    void unregisterCache(IMemoryCache* cache);
+
+    qsizetype getBudget() const { return mBudget; }
+    void setBudget(qsizetype budget);
+    qsizetype getTotalCost() const;
+
+    // Trim all caches to a percentage of their share of the budget.
+    void trim(int percentage);
+
+    void logStats() const;
+
+private:
+    struct Registration
+    {
+        IMemoryCache* mCache;
+        int mWeight; // 0 for a fixed max cost
+        qsizetype mFixedCost = 0;
+    };
+
+    MemoryBudget();
+
+    void distribute();
+    qsizetype getShare(int weight) const;
+    qsizetype getMaxCost(const Registration& reg) const;
+    void handleAppStateChange(Qt::ApplicationState state);
+    void handleTrimMemory(int level);
+
+    qsizetype mBudget = DEFAULT_BUDGET;
+    std::vector<Registration> mCaches;
+};
+
+}
@@ -0,0 +1,195 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include "memory_budget.h"
+#include <QHash>
+#include <QList>
+#include <functional>
+#include <list>
+#include <memory>
+#include <utility>
+
+namespace Skywalker {
+
+namespace CacheCost {
+
+inline qsizetype string(const QString& str)
+{
+    return sizeof(QString) + str.size() * sizeof(QChar);
+}
+
+}
+
+// LRU cache with a cost in bytes per entry. When a weight is given, the cache
+// registers itself with the global memory budget, which sets the max cost.
+// get() returns an owning handle. An evicted value stays alive till the last
+// handle to it is released, so the budget can trim the cache at any time.
+template<typename Key, typename T>
+class MemoryCache : public IMemoryCache
+{
+public:
+    // Entry overhead for the list node, hash entry and shared value
+    static constexpr qsizetype ENTRY_OVERHEAD = sizeof(Key) + sizeof(T) + 96;
+
+    using CostFunction = std::function<qsizetype(const Key&, const T&)>;
+    using EvictedCallback = std::function<void(const Key&, const T&)>;
+
+    // Without cost function, every entry has cost 1.
+    MemoryCache(const QString& name, qsizetype maxCost, const CostFunction& costFun = {}, int weight = 0) :
+        mName(name),
+        mMaxCost(maxCost),
+        mCostFun(costFun)
+    {
+        if (weight > 0)
+        {
+            MemoryBudget::instance().registerCache(this, weight);
+            mRegistered = true;
+        }
+    }
+
+    ~MemoryCache()
+    {
+        if (mRegistered && MemoryBudget::exists())
+            MemoryBudget::instance().unregisterCache(this);
+    }
+
+    MemoryCache(const MemoryCache&) = delete;
+    MemoryCache& operator=(const MemoryCache&) = delete;
+
+    void setEvictedCallback(const EvictedCallback& evictedCb) { mEvictedCb = evictedCb; }
+
+    // Returns false if the cost exceeds the max cost. The value is not stored,
+    // nor moved from, then.
+    template<typename V>
+    bool insert(const Key& key, V&& value)
+    {
+        const qsizetype cost = mCostFun ? mCostFun(key, value) + ENTRY_OVERHEAD : 1;
+        remove(key, false);
+
+        if (cost > mMaxCost)
+            return false;
+
+        mEntries.push_front(Entry{ key, std::make_shared<T>(std::forward<V>(value)), cost });
+        mIndex.insert(key, mEntries.begin());
+        mTotalCost += cost;
+        ++mStats.mInserts;
+        trim(mMaxCost);
+        return true;
+    }
+
+    std::shared_ptr<const T> get(const Key& key) const
+    {
+        auto it = mIndex.find(key);
+
+        if (it == mIndex.end())
+        {
+            ++mStats.mMisses;
+            return nullptr;
+        }
+
+        ++mStats.mHits;
+        mEntries.splice(mEntries.begin(), mEntries, *it);
+        return (*it)->mValue;
+    }
+
+    std::shared_ptr<T> get(const Key& key)
+    {
+        return std::const_pointer_cast<T>(std::as_const(*this).get(key));
+    }
+
+    // Does not count as a hit or change the LRU order.
+    bool contains(const Key& key) const { return mIndex.contains(key); }
+
+    bool remove(const Key& key) { return remove(key, true); }
+
+    void clear()
+    {
+        mIndex.clear();
+        mEntries.clear();
+        mTotalCost = 0;
+    }
+
+    qsizetype size() const { return mEntries.size(); }
+
+    // Returns keys from least to most recently used.
+    QList<Key> keys() const
+    {
+        QList<Key> result;
+        result.reserve(mEntries.size());
+
+        for (auto it = mEntries.rbegin(); it != mEntries.rend(); ++it)
+            result.push_back(it->mKey);
+
+        return result;
+    }
+
+    const QString& getName() const override { return mName; }
+    qsizetype getTotalCost() const override { return mTotalCost; }
+    qsizetype getMaxCost() const override { return mMaxCost; }
+
+    void setMaxCost(qsizetype maxCost) override
+    {
+        mMaxCost = maxCost;
+        trim(mMaxCost);
+    }
+
+    void trim(qsizetype maxCost) override
+    {
+        while (mTotalCost > maxCost && !mEntries.empty())
+        {
+            const Entry& entry = mEntries.back();
+            ++mStats.mEvictions;
+
+            if (mEvictedCb)
+                mEvictedCb(entry.mKey, *entry.mValue);
+
+            mTotalCost -= entry.mCost;
+            mIndex.remove(entry.mKey);
+            mEntries.pop_back();
+        }
+    }
+
+    const MemoryCacheStats& getStats() const override { return mStats; }
+
+private:
+    struct Entry
+    {
+        Key mKey;
+        std::shared_ptr<T> mValue;
+        qsizetype mCost;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    bool remove(const Key& key, bool notify)
+    {
+        auto it = mIndex.find(key);
+
+        if (it == mIndex.end())
+            return false;
+
+        auto entryIt = *it;
+
+        if (notify && mEvictedCb)
+            mEvictedCb(entryIt->mKey, *entryIt->mValue);
+
+        mTotalCost -= entryIt->mCost;
+        mIndex.erase(it);
+        mEntries.erase(entryIt);
+        return true;
+    }
+
+    QString mName;
+    qsizetype mMaxCost;
+    CostFunction mCostFun;
+    EvictedCallback mEvictedCb;
+    bool mRegistered = false;
+
+    // Most recently used entry at the front
+    mutable EntryList mEntries;
+    QHash<Key, typename EntryList::iterator> mIndex;
+    qsizetype mTotalCost = 0;
+    mutable MemoryCacheStats mStats;
+};
+
+}
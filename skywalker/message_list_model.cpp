@@ -6,6 +6,17 @@ namespace Skywalker {
 
 using namespace std::chrono_literals;
 
+static std::pair<QString, QString> getIdAndRev(const ATProto::ChatBskyConvo::GetMessagesOutput::MessageType& msg)
+{
+    if (const auto* view = std::get_if<ATProto::ChatBskyConvo::MessageView::SharedPtr>(&msg))
+        return { (*view)->mId, (*view)->mRev };
+
+    if (const auto* deleted = std::get_if<ATProto::ChatBskyConvo::DeletedMessageView::SharedPtr>(&msg))
+        return { (*deleted)->mId, (*deleted)->mRev };
+
+    return {};
+}
+
 MessageListModel::MessageListModel(const QString& userDid, const ChatBasicProfileList& members, FollowsActivityStore& followsActivityStore, QObject* parent) :
     QAbstractListModel(parent),
     mUserDid(userDid),
@@ -67,6 +78,7 @@ void MessageListModel::clear()
         beginRemoveRows({}, 0, mMessages.size() - 1);
         mMessages.clear();
         mMessageIdToPosIndex.clear();
+        mFrontPos = 0;
         endRemoveRows();
     }
 
@@ -96,51 +108,115 @@ void MessageListModel::addMessages(const ATProto::ChatBskyConvo::GetMessagesOutp
         }
 
         mMessages.emplace_front(message);
+        indexFrontMessage();
         reportActivity(mMessages.front());
     }
 
-    rebuildIndex();
-
     endInsertRows();
     qDebug() << "New messages size:" << mMessages.size();
 }
 
 void MessageListModel::updateMessages(const ATProto::ChatBskyConvo::GetMessagesOutput::MessageList& messages, const QString& cursor)
 {
-    if (mMessages.empty())
+    if (mMessages.empty() || messages.empty())
     {
         clear();
         addMessages(messages, cursor);
         return;
     }
 
-    if (messages.empty())
+    // The older messages that were loaded stay, hence the cursor does not
+    // change on a merge.
+    if (!mergeNewMessages(messages))
     {
         clear();
         addMessages(messages, cursor);
-        return;
     }
+}
 
-    const MessageView& firstStoredMsg = mMessages.back();
-    const MessageView firstNewMsg(messages.front());
-    qDebug() << "First stored msg id:" << firstStoredMsg.getId() << "new msg id:" << firstNewMsg.getId();
+// Messages are ordered from newest to oldest. Appends the messages newer than
+// the newest stored message and patches the updated messages. Returns false if
+// the messages do not overlap with the stored messages.
+bool MessageListModel::mergeNewMessages(const ATProto::ChatBskyConvo::GetMessagesOutput::MessageList& messages)
+{
+    const QString& lastStoredId = mMessages.back().getId();
+    int overlap = -1;
 
-    if (firstStoredMsg.getId() != firstNewMsg.getId())
+    for (int i = 0; i < (int)messages.size(); ++i)
     {
-        clear();
-        addMessages(messages, cursor);
-        return;
+        const QString id = getIdAndRev(messages[i]).first;
+
+        if (id.isEmpty())
+            continue;
+
+        if (getMessageIndexById(id) >= 0)
+        {
+            overlap = i;
+
+            if (id != lastStoredId)
+            {
+                qDebug() << "Newest stored message missing:" << lastStoredId << "found:" << id;
+                return false;
+            }
+
+            break;
+        }
     }
 
-    // No new messages, but existing messages could be updated, e.g. reactions
-    for (const auto& msg : messages)
+    if (overlap < 0)
     {
-        const auto* messageView = std::get_if<ATProto::ChatBskyConvo::MessageView::SharedPtr>(&msg);
+        qDebug() << "No overlap with stored messages, last:" << lastStoredId;
+        return false;
+    }
 
-        if (!messageView)
+    int newCount = 0;
+
+    for (int i = 0; i < overlap; ++i)
+    {
+        if (!ATProto::isNullVariant(messages[i]))
+            ++newCount;
+    }
+
+    if (newCount > 0)
+    {
+        qDebug() << "New messages:" << newCount;
+        const int oldLast = (int)mMessages.size() - 1;
+        beginInsertRows({}, oldLast + 1, oldLast + newCount);
+
+        for (int i = overlap - 1; i >= 0; --i)
+        {
+            if (ATProto::isNullVariant(messages[i]))
+            {
+                qWarning() << "Unknown message";
+                continue;
+            }
+
+            mMessages.emplace_back(messages[i]);
+            indexBackMessage();
+            reportActivity(mMessages.back());
+        }
+
+        endInsertRows();
+
+        // These roles depend on the next message
+        changeData({ int(Role::SameSenderAsNext), int(Role::SameTimeAsNext) }, oldLast, oldLast);
+    }
+
+    // Existing messages could be updated, e.g. reactions
+    patchMessages(messages, overlap);
+    return true;
+}
+
+void MessageListModel::patchMessages(const ATProto::ChatBskyConvo::GetMessagesOutput::MessageList& messages, int start)
+{
+    for (int i = start; i < (int)messages.size(); ++i)
+    {
+        const auto& msg = messages[i];
+        const auto [msgId, msgRev] = getIdAndRev(msg);
+
+        if (msgId.isEmpty())
             continue;
 
-        const QString& msgId = (*messageView)->mId;
         const int index = getMessageIndexById(msgId);
 
         if (index < 0)
@@ -151,14 +227,11 @@ void MessageListModel::updateMessages(const ATProto::ChatBskyConvo::GetMessagesO
         if (storedMsg.isDeleted())
             continue;
 
-        const QString& msgRev = (*messageView)->mRev;
-
         if (msgRev <= storedMsg.getRev())
             continue;
 
         qDebug() << "Update existing message:" << storedMsg.getId() << "oldRev:" << storedMsg.getRev() << "newRev:" << msgRev;
-        const MessageView updatedMsg(**messageView);
-        storedMsg = updatedMsg;
+        storedMsg = MessageView(msg);
         reportActivity(storedMsg);
         changeData({}, index, index);
     }
@@ -211,7 +284,7 @@ int MessageListModel::getMessageIndexById(const QString& id) const
     if (it == mMessageIdToPosIndex.end())
         return -1;
 
-    const int index = it->second;
+    const int index = it->second - mFrontPos;
 
     if (index < 0 || index >= (int)mMessages.size())
     {
@@ -222,15 +295,15 @@ int MessageListModel::getMessageIndexById(const QString& id) const
     return index;
 }
 
-void MessageListModel::rebuildIndex()
+void MessageListModel::indexFrontMessage()
 {
-    mMessageIdToPosIndex.clear();
+    --mFrontPos;
+    mMessageIdToPosIndex[mMessages.front().getId()] = mFrontPos;
+}
 
-    for (int i = 0; i < (int)mMessages.size(); ++i)
-    {
-        const auto& msg = mMessages[i];
-        mMessageIdToPosIndex[msg.getId()] = i;
-    }
+void MessageListModel::indexBackMessage()
+{
+    mMessageIdToPosIndex[mMessages.back().getId()] = mFrontPos + (int)mMessages.size() - 1;
 }
 
 void MessageListModel::changeData(const QList<int>& roles, int begin, int end)
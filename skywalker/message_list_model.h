@@ -44,7 +44,10 @@ protected:
 
 private:
     int getMessageIndexById(const QString& id) const;
-    void rebuildIndex();
+    void indexFrontMessage();
+    void indexBackMessage();
+    bool mergeNewMessages(const ATProto::ChatBskyConvo::GetMessagesOutput::MessageList& messages);
+    void patchMessages(const ATProto::ChatBskyConvo::GetMessagesOutput::MessageList& messages, int start);
     void changeData(const QList<int>& roles, int begin = 0, int end = -1);
     void reportActivity(const MessageView& message);
     void reportActivity(const ReactionView& reaction);
@@ -54,7 +57,10 @@ private:
 
     // Ordered from oldest to newest
     std::deque<MessageView> mMessages;
-    std::unordered_map<QString, int> mMessageIdToPosIndex; // to position in mMessages
+    // Position of a message is its index in mMessages plus mFrontPos, such
+    // that adding older messages at the front does not invalidate the index.
+    std::unordered_map<QString, int> mMessageIdToPosIndex;
+    int mFrontPos = 0;
     QString mCursor;
     std::unordered_map<QString, ChatBasicProfile> mDidMemberMap; // other than user
 };
@@ -34,11 +34,17 @@ MutedWordEntry::MutedWordEntry(const IMatchEntry* entry)
 }
 
 
-MutedWords::MutedWords(QObject* parent) :
-    QObject(parent)
+MutedWords::MutedWords(QObject* parent, ExpiryScheduler* expiryScheduler) :
+    QObject(parent),
+    mExpiryScheduler(expiryScheduler)
 {
 }
 
+MutedWords::~MutedWords()
+{
+    cancelExpiries();
+}
+
 MutedWordEntry::List MutedWords::getEntries() const
 {
     MutedWordEntry::List sortedEntries;
@@ -56,6 +62,7 @@ void MutedWords::clear()
     if (mEntries.empty())
         return;
 
+    cancelExpiries();
     mEntries.clear();
     mSingleWordIndex.clear();
     mFirstWordIndex.clear();
@@ -179,16 +186,28 @@ void MutedWords::addEntry(const QString& word, const QJsonObject& bskyJson, cons
 
     const auto& entry = *it;
 
-    if (entry.isHashtag())
-        addWordToIndex(&entry, mHashTagIndex);
-    else if (entry.isCashtag())
-        addWordToIndex(SearchUtils::normalizeText(entry.mRaw), &entry, mCashTagIndex);
-    else if (entry.isDomain())
-        addWordToIndex(&entry, mDomainIndex);
-    else if (entry.mNormalizedWords.size() == 1)
-        addWordToIndex(&entry, mSingleWordIndex);
-    else if (entry.mNormalizedWords.size() > 1)
-        addWordToIndex(&entry, mFirstWordIndex);
+    if (entry.mExpiresAt.isValid())
+    {
+        // An expired entry is kept in the preferences, but does not get matched.
+        if (entry.mExpiresAt <= QDateTime::currentDateTimeUtc())
+        {
+            qDebug() << "Expired entry:" << entry.mRaw << entry.mExpiresAt;
+        }
+        else
+        {
+            addToIndex(entry);
+
+            if (mExpiryScheduler)
+            {
+                mExpiryIds[&entry] = mExpiryScheduler->schedule(entry.mExpiresAt,
+                    [this, entryPtr=&entry]{ expireEntry(entryPtr); });
+            }
+        }
+    }
+    else
+    {
+        addToIndex(entry);
+    }
 
     mDirty = true;
     emit entriesChanged();
@@ -206,7 +225,41 @@ void MutedWords::removeEntry(const QString& word)
     }
 
     const Entry& entry = *it;
+    removeFromIndex(entry);
+
+    if (auto expiryIt = mExpiryIds.find(&entry); expiryIt != mExpiryIds.end())
+    {
+        mExpiryScheduler->cancel(expiryIt->second);
+        mExpiryIds.erase(expiryIt);
+    }
+
+    mEntries.erase(it);
+    mDirty = true;
+    emit entriesChanged();
+}
+
+bool MutedWords::containsEntry(const QString& word)
+{
+    const Entry searchEntry{ word, {}, {}, {} };
+    return mEntries.count(searchEntry);
+}
+
+void MutedWords::addToIndex(const Entry& entry)
+{
+    if (entry.isHashtag())
+        addWordToIndex(&entry, mHashTagIndex);
+    else if (entry.isCashtag())
+        addWordToIndex(SearchUtils::normalizeText(entry.mRaw), &entry, mCashTagIndex);
+    else if (entry.isDomain())
+        addWordToIndex(&entry, mDomainIndex);
+    else if (entry.mNormalizedWords.size() == 1)
+        addWordToIndex(&entry, mSingleWordIndex);
+    else if (entry.mNormalizedWords.size() > 1)
+        addWordToIndex(&entry, mFirstWordIndex);
+}
 
+void MutedWords::removeFromIndex(const Entry& entry)
+{
     if (entry.isHashtag())
         removeWordFromIndex(&entry, mHashTagIndex);
     else if (entry.isCashtag())
@@ -217,16 +270,22 @@ void MutedWords::removeEntry(const QString& word)
         removeWordFromIndex(&entry, mSingleWordIndex);
     else if (entry.mNormalizedWords.size() > 1)
         removeWordFromIndex(&entry, mFirstWordIndex);
+}
 
-    mEntries.erase(it);
-    mDirty = true;
-    emit entriesChanged();
+void MutedWords::expireEntry(const Entry* entry)
+{
+    Q_ASSERT(entry);
+    qDebug() << "Expired entry:" << entry->mRaw << entry->mExpiresAt;
+    mExpiryIds.erase(entry);
+    removeFromIndex(*entry);
 }
 
-bool MutedWords::containsEntry(const QString& word)
+void MutedWords::cancelExpiries()
 {
-    const Entry searchEntry{ word, {}, {}, {} };
-    return mEntries.count(searchEntry);
+    for (const auto& [_, id] : mExpiryIds)
+        mExpiryScheduler->cancel(id);
+
+    mExpiryIds.clear();
 }
 
 void MutedWords::addWordToIndex(const Entry* entry, WordIndexType& wordIndex)
@@ -265,9 +324,10 @@ void MutedWords::removeWordFromIndex(const QString& word, const Entry* entry, Wo
         wordIndex.erase(word);
 }
 
-bool MutedWords::mustSkip(const Entry& entry, const BasicProfile& author, QDateTime now) const
+bool MutedWords::mustSkip(const Entry& entry, const BasicProfile& author) const
 {
-    if (entry.mExpiresAt.isValid() && now >= entry.mExpiresAt)
+    // Without scheduler, an entry stays in the indexes after it expires.
+    if (!mExpiryScheduler && entry.mExpiresAt.isValid() && entry.mExpiresAt <= QDateTime::currentDateTimeUtc())
     {
         qDebug() << "Expired entry:" << entry.mRaw << entry.mExpiresAt;
         return true;
@@ -288,22 +348,21 @@ std::pair<bool, const IMatchEntry*> MutedWords::match(const NormalizedWordIndex&
     if (mEntries.empty())
         return { false, nullptr };
 
-    const auto now = QDateTime::currentDateTimeUtc();
     const BasicProfile author = post.getAuthor();
 
-    if (auto match = matchDomain(post, now, author); match.first)
+    if (auto match = matchDomain(post, author); match.first)
         return match;
 
-    if (auto match = matchHashtag(post, now, author); match.first)
+    if (auto match = matchHashtag(post, author); match.first)
         return match;
 
-    if (auto match = matchCashtag(post, now, author); match.first)
+    if (auto match = matchCashtag(post, author); match.first)
         return match;
 
-    return matchWords(post, now, author);
+    return matchWords(post, author);
 }
 
-std::pair<bool, const IMatchEntry*> MutedWords::matchDomain(const NormalizedWordIndex& post, QDateTime now, const BasicProfile& author) const
+std::pair<bool, const IMatchEntry*> MutedWords::matchDomain(const NormalizedWordIndex& post, const BasicProfile& author) const
 {
     if (mDomainIndex.empty())
         return { false, nullptr };
@@ -315,7 +374,7 @@ std::pair<bool, const IMatchEntry*> MutedWords::matchDomain(const NormalizedWord
         Q_ASSERT(entries.size() == 1);
         const auto* entry = *entries.begin();
 
-        if (mustSkip(*entry, author, now))
+        if (mustSkip(*entry, author))
             continue;
 
         // NOTE: the number of domains should be small, typically 1
@@ -337,7 +396,7 @@ std::pair<bool, const IMatchEntry*> MutedWords::matchDomain(const NormalizedWord
     return { false, nullptr };
 }
 
-std::pair<bool, const IMatchEntry*> MutedWords::matchHashtag(const NormalizedWordIndex& post, QDateTime now, const BasicProfile& author) const
+std::pair<bool, const IMatchEntry*> MutedWords::matchHashtag(const NormalizedWordIndex& post, const BasicProfile& author) const
 {
     if (mHashTagIndex.empty())
         return { false, nullptr };
@@ -349,7 +408,7 @@ std::pair<bool, const IMatchEntry*> MutedWords::matchHashtag(const NormalizedWor
         Q_ASSERT(entries.size() == 1);
         const auto* entry = *entries.begin();
 
-        if (!mustSkip(*entry, author, now) && postHashtags.count(word))
+        if (!mustSkip(*entry, author) && postHashtags.count(word))
         {
             qDebug() << "Match on hashtag:" << word;
             return { true, entry };
@@ -359,7 +418,7 @@ std::pair<bool, const IMatchEntry*> MutedWords::matchHashtag(const NormalizedWor
     return { false, nullptr };
 }
 
-std::pair<bool, const IMatchEntry*> MutedWords::matchCashtag(const NormalizedWordIndex& post, QDateTime now, const BasicProfile& author) const
+std::pair<bool, const IMatchEntry*> MutedWords::matchCashtag(const NormalizedWordIndex& post, const BasicProfile& author) const
 {
     if (mCashTagIndex.empty())
         return { false, nullptr };
@@ -372,7 +431,7 @@ std::pair<bool, const IMatchEntry*> MutedWords::matchCashtag(const NormalizedWor
         Q_ASSERT(entries.size() == 1);
         const auto* entry = *entries.begin();
 
-        if (!mustSkip(*entry, author, now) && postCashtags.count(word))
+        if (!mustSkip(*entry, author) && postCashtags.count(word))
         {
             qDebug() << "Match on cashtag:" << word;
             return { true, entry };
@@ -382,7 +441,7 @@ std::pair<bool, const IMatchEntry*> MutedWords::matchCashtag(const NormalizedWor
     return { false, nullptr };
 }
 
-std::pair<bool, const IMatchEntry*> MutedWords::matchWords(const NormalizedWordIndex& post, QDateTime now, const BasicProfile& author) const
+std::pair<bool, const IMatchEntry*> MutedWords::matchWords(const NormalizedWordIndex& post, const BasicProfile& author) const
 {
     const auto& uniquePostWords = post.getUniqueNormalizedWords();
 
@@ -391,7 +450,7 @@ std::pair<bool, const IMatchEntry*> MutedWords::matchWords(const NormalizedWordI
         Q_ASSERT(entries.size() == 1);
         const auto* entry = *entries.begin();
 
-        if (!mustSkip(*entry, author, now) && uniquePostWords.count(word))
+        if (!mustSkip(*entry, author) && uniquePostWords.count(word))
         {
             qDebug() << "Match on single word entry:" << word;
             return { true, entry };
@@ -414,7 +473,7 @@ std::pair<bool, const IMatchEntry*> MutedWords::matchWords(const NormalizedWordI
             Q_ASSERT(mutedEntry);
             qDebug() << "Multi-word entry:" << mutedEntry->mRaw;
 
-            if (mustSkip(*mutedEntry, author, now))
+            if (mustSkip(*mutedEntry, author))
                 continue;
 
             for (int postWordIndex : uniqueWordIt->second)
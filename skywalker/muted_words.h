@@ -1,6 +1,7 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "expiry_scheduler.h"
 #include "user_settings.h"
 #include "normalized_word_index.h"
 #include "unicode_fonts.h"
@@ -58,7 +59,11 @@ class MutedWords : public QObject, public IMatchWords
 public:
     static constexpr size_t MAX_ENTRIES = 100;
 
-    explicit MutedWords(QObject* parent = nullptr);
+    // The scheduler removes entries from the indexes when they expire. It is
+    // GUI thread only, so pass nullptr when used from another thread. The
+    // expiry is then checked at match time.
+    explicit MutedWords(QObject* parent = nullptr, ExpiryScheduler* expiryScheduler = &ExpiryScheduler::instance());
+    ~MutedWords();
 
     MutedWordEntry::List getEntries() const;
     void clear();
@@ -108,16 +113,20 @@ private:
 
     using WordIndexType = std::unordered_map<QString, std::set<const Entry*>>;
 
+    void addToIndex(const Entry& entry);
+    void removeFromIndex(const Entry& entry);
+    void expireEntry(const Entry* entry);
+    void cancelExpiries();
     void addWordToIndex(const Entry* entry, WordIndexType& wordIndex);
     void addWordToIndex(const QString& word, const Entry* entry, WordIndexType& wordIndex);
     void removeWordFromIndex(const Entry* entry, WordIndexType& wordIndex);
     void removeWordFromIndex(const QString& word, const Entry* entry, WordIndexType& wordIndex);
     bool preAdd(const Entry& entry);
-    bool mustSkip(const Entry& entry, const BasicProfile& author, QDateTime now) const;
-    std::pair<bool, const IMatchEntry*> matchDomain(const NormalizedWordIndex& post, QDateTime now, const BasicProfile& author) const;
-    std::pair<bool, const IMatchEntry*> matchHashtag(const NormalizedWordIndex& post, QDateTime now, const BasicProfile& author) const;
-    std::pair<bool, const IMatchEntry*> matchCashtag(const NormalizedWordIndex& post, QDateTime now, const BasicProfile& author) const;
-    std::pair<bool, const IMatchEntry*> matchWords(const NormalizedWordIndex& post, QDateTime now, const BasicProfile& author) const;
+    bool mustSkip(const Entry& entry, const BasicProfile& author) const;
+    std::pair<bool, const IMatchEntry*> matchDomain(const NormalizedWordIndex& post, const BasicProfile& author) const;
+    std::pair<bool, const IMatchEntry*> matchHashtag(const NormalizedWordIndex& post, const BasicProfile& author) const;
+    std::pair<bool, const IMatchEntry*> matchCashtag(const NormalizedWordIndex& post, const BasicProfile& author) const;
+    std::pair<bool, const IMatchEntry*> matchWords(const NormalizedWordIndex& post, const BasicProfile& author) const;
 
     std::set<Entry> mEntries;
 
@@ -131,6 +140,11 @@ private:
     WordIndexType mCashTagIndex;
     WordIndexType mDomainIndex;
 
+    // Entries get removed from the indexes when they expire, such that
+    // matching does not need to check expiry.
+    ExpiryScheduler* mExpiryScheduler;
+    std::unordered_map<const Entry*, ExpiryScheduler::Id> mExpiryIds;
+
     bool mDirty = false;
 
     friend class MutedWordEntry;
@@ -5,41 +5,55 @@
 
 namespace Skywalker {
 
+NormalizedWordIndex::Index& NormalizedWordIndex::getIndex() const
+{
+    if (!mIndex)
+        const_cast<NormalizedWordIndex*>(this)->mIndex = std::make_shared<Index>();
+
+    return *mIndex;
+}
+
 const std::unordered_set<QString>& NormalizedWordIndex::getUniqueHashtags() const
 {
-    if (mHashtags.empty())
+    auto& hashtags = getIndex().mHashtags;
+
+    if (hashtags.empty())
     {
         const auto& hashtagList = getHashtags();
 
         for (const auto& tag : hashtagList)
         {
             const auto normalizedTag = SearchUtils::normalizeText(tag);
-            const_cast<NormalizedWordIndex*>(this)->mHashtags.insert(normalizedTag);
+            hashtags.insert(normalizedTag);
         }
     }
 
-    return mHashtags;
+    return hashtags;
 }
 
 const std::unordered_set<QString>& NormalizedWordIndex::getUniqueCashtags() const
 {
-    if (mCashtags.empty())
+    auto& cashtags = getIndex().mCashtags;
+
+    if (cashtags.empty())
     {
         const auto& cashtagList = getCashtags();
 
         for (const auto& tag : cashtagList)
         {
             const auto normalizedTag = SearchUtils::normalizeText(tag);
-            const_cast<NormalizedWordIndex*>(this)->mCashtags.insert(normalizedTag);
+            cashtags.insert(normalizedTag);
         }
     }
 
-    return mCashtags;
+    return cashtags;
 }
 
 const std::vector<QString>& NormalizedWordIndex::getUniqueDomains() const
 {
-    if (mDomains.empty())
+    auto& domains = getIndex().mDomains;
+
+    if (domains.empty())
     {
         std::unordered_set<QString> uniqueDomains;
         const auto linkList = getWebLinks();
@@ -52,17 +66,18 @@ const std::vector<QString>& NormalizedWordIndex::getUniqueDomains() const
                 uniqueDomains.insert(url.host());
         }
 
-        const_cast<NormalizedWordIndex*>(this)->mDomains.assign(uniqueDomains.begin(), uniqueDomains.end());
+        domains.assign(uniqueDomains.begin(), uniqueDomains.end());
     }
 
-    return mDomains;
+    return domains;
 }
 
 const std::vector<QString>& NormalizedWordIndex::getNormalizedWords() const
 {
-    if (mNormalizedWords.empty())
+    auto& normalizeWords = getIndex().mNormalizedWords;
+
+    if (normalizeWords.empty())
     {
-        auto& normalizeWords = const_cast<NormalizedWordIndex*>(this)->mNormalizedWords;
         normalizeWords = SearchUtils::getNormalizedWords(getText());
 
         const auto& imageViews = getImages();
@@ -92,23 +107,25 @@ const std::vector<QString>& NormalizedWordIndex::getNormalizedWords() const
         }
     }
 
-    return mNormalizedWords;
+    return normalizeWords;
 }
 
 const std::unordered_map<QString, std::vector<int>>& NormalizedWordIndex::getUniqueNormalizedWords() const
 {
-    if (mUniqueNormalizedWords.empty())
+    auto& uniqueNormalizedWords = getIndex().mUniqueNormalizedWords;
+
+    if (uniqueNormalizedWords.empty())
     {
         const auto& normalizedWords = getNormalizedWords();
 
         for (int i = 0; i < (int)normalizedWords.size(); ++i)
         {
             const QString& word = normalizedWords[i];
-            const_cast<NormalizedWordIndex*>(this)->mUniqueNormalizedWords[word].push_back(i);
+            uniqueNormalizedWords[word].push_back(i);
         }
     }
 
-    return mUniqueNormalizedWords;
+    return uniqueNormalizedWords;
 }
 
 }
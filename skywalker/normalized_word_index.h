@@ -7,6 +7,7 @@
 #include "video_view.h"
 #include <QHashFunctions>
 #include <QString>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -33,14 +34,27 @@ public:
     const std::vector<QString>& getNormalizedWords() const;
     const std::unordered_map<QString, std::vector<int>>& getUniqueNormalizedWords() const;
 
+protected:
+    // To be called when the content changes.
+    void clearNormalizedWordIndex() { mIndex = nullptr; }
+
 private:
-    std::unordered_set<QString> mHashtags; // normalized
-    std::unordered_set<QString> mCashtags; // normalized
-    std::vector<QString> mDomains; // unique, normalized
-    std::vector<QString> mNormalizedWords;
+    // Built on first use and shared by copies. Most entries of a feed never
+    // get matched against words, so they do not carry the containers.
+    struct Index
+    {
+        std::unordered_set<QString> mHashtags; // normalized
+        std::unordered_set<QString> mCashtags; // normalized
+        std::vector<QString> mDomains; // unique, normalized
+        std::vector<QString> mNormalizedWords;
+
+        // normalized word -> indices into mNormalizedWords
+        std::unordered_map<QString, std::vector<int>> mUniqueNormalizedWords;
+    };
+
+    Index& getIndex() const;
 
-    // normalized word -> indices into mNormalizedWords
-    std::unordered_map<QString, std::vector<int>> mUniqueNormalizedWords;
+    std::shared_ptr<Index> mIndex;
 };
 
 class IMatchEntry
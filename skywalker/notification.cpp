@@ -3,6 +3,7 @@
 #include "notification.h"
 #include "content_filter.h"
 #include "post_cache.h"
+#include <algorithm>
 
 namespace Skywalker {
 
@@ -209,7 +210,7 @@ Post Notification::getPost(const PostCache& cache, const QString& uri) const
     if (uri.isEmpty())
         return Post::createNotFound();
 
-    const Post* post = cache.get(uri);
+    const auto post = cache.get(uri);
     return post ? *post : Post::createNotFound();
 }
 
@@ -262,11 +263,30 @@ QString Notification::getPostUri() const
     return {};
 }
 
+bool Notification::hasAuthor(const QString& did) const
+{
+    if (getAuthor().getDid() == did)
+        return true;
+
+    return std::ranges::any_of(mOtherAuthors, [&did](const BasicProfile& author){ return author.getDid() == did; });
+}
+
 void Notification::addOtherAuthor(const BasicProfile& author)
 {
+    // Aggregated notifications may overlap, e.g. when a user likes, unlikes
+    // and likes a post again.
+    if (hasAuthor(author.getDid()))
+        return;
+
     mOtherAuthors.push_back(author);
 }
 
+void Notification::addOtherAuthors(const BasicProfileList& authors)
+{
+    for (const auto& author : authors)
+        addOtherAuthor(author);
+}
+
 bool Notification::updateNewLabels(const ContentFilter* contentFilter)
 {
     Q_ASSERT(contentFilter);
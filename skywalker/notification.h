@@ -56,7 +56,9 @@ public:
     // Get the URI of the post to be displayed, e.g. the uri or subjectReasonUri
     QString getPostUri() const;
 
+    // Authors that are already in this notification are skipped.
     void addOtherAuthor(const BasicProfile& author);
+    void addOtherAuthors(const BasicProfileList& authors);
     const MessageView& getDirectMessage() const { return mDirectMessage; }
     const MessageAndReactionView& getDirectMessageAndReaction() const { return mDirectMessageAndRection; }
 
@@ -66,6 +68,7 @@ public:
 
 private:
     Post getPost(const PostCache& cache, const QString& uri) const;
+    bool hasAuthor(const QString& did) const;
 
     ATProto::AppBskyNotification::Notification::SharedPtr mNotification;
     BasicProfileList mOtherAuthors;
@@ -6,6 +6,7 @@
 #include "content_filter.h"
 #include "enums.h"
 #include <atproto/lib/at_uri.h>
+#include <set>
 #include <unordered_map>
 
 namespace Skywalker {
@@ -55,6 +56,7 @@ void NotificationListModel::clearRows()
     {
         beginRemoveRows({}, 0, mList.size() - 1);
         mList.clear();
+        mAggregateIndex.clear();
         endRemoveRows();
     }
 }
@@ -150,7 +152,7 @@ bool NotificationListModel::addNotifications(ATProto::AppBskyNotification::ListN
 
     auto notificationList = createNotificationList(notifications->mNotifications);
 
-    getPosts(*bsky, notificationList, [this, notificationList, clearFirst, doneCb]{
+    getPosts(bsky, notificationList, [this, notificationList, clearFirst, doneCb]{
         auto list = std::move(notificationList);
         filterNotificationList(list);
         addNotificationList(list, clearFirst);
@@ -308,19 +310,90 @@ void NotificationListModel::addNotificationList(const NotificationList& list, bo
         addNewLabelsNotificationRows();
     }
 
-    const size_t newRowCount = mList.size() + list.size();
+    // Notifications that aggregate with a notification from a previous page
+    // are merged into the existing row.
+    NotificationList newRows;
+    std::set<int> changedRows;
 
-    beginInsertRows({}, mList.size(), newRowCount - 1);
-    mList.insert(mList.end(), list.begin(), list.cend());
+    for (const auto& notification : list)
+    {
+        if (notification.isAggregatable())
+        {
+            const int row = findAggregate(notification);
 
-    if (isEndOfList())
-        mList.back().setEndOfList(true);
+            if (row >= 0)
+            {
+                mList[row].addOtherAuthors(notification.getAllAuthors());
+                changedRows.insert(row);
+                continue;
+            }
 
-    endInsertRows();
+            addToAggregateIndex(notification, mList.size() + newRows.size());
+        }
+
+        newRows.push_back(notification);
+    }
+
+    for (int row : changedRows)
+    {
+        const auto index = createIndex(row, 0);
+        emit dataChanged(index, index, { int(Role::NotificationOtherAuthors), int(Role::NotificationAllAuthors) });
+    }
+
+    qDebug() << "Merged rows:" << changedRows.size() << "new rows:" << newRows.size();
+
+    if (!newRows.empty())
+    {
+        const size_t newRowCount = mList.size() + newRows.size();
+
+        beginInsertRows({}, mList.size(), newRowCount - 1);
+        mList.insert(mList.end(), newRows.begin(), newRows.end());
+
+        if (isEndOfList())
+            mList.back().setEndOfList(true);
+
+        endInsertRows();
+    }
+    else if (isEndOfList() && !mList.empty())
+    {
+        mList.back().setEndOfList(true);
+        const auto index = createIndex(mList.size() - 1, 0);
+        emit dataChanged(index, index, { int(Role::EndOfList) });
+    }
 
     qDebug() << "New list size:" << mList.size();
 }
 
+int NotificationListModel::findAggregate(const Notification& notification) const
+{
+    auto reasonIt = mAggregateIndex.find(notification.getReason());
+
+    if (reasonIt == mAggregateIndex.end())
+        return -1;
+
+    const auto& uriMap = reasonIt->second;
+    auto it = uriMap.find(notification.getReasonSubjectUri());
+    return it != uriMap.end() ? it->second : -1;
+}
+
+void NotificationListModel::addToAggregateIndex(const Notification& notification, int row)
+{
+    mAggregateIndex[notification.getReason()][notification.getReasonSubjectUri()] = row;
+}
+
+void NotificationListModel::rebuildAggregateIndex()
+{
+    mAggregateIndex.clear();
+
+    for (int row = 0; row < (int)mList.size(); ++row)
+    {
+        const auto& notification = mList[row];
+
+        if (notification.isAggregatable())
+            addToAggregateIndex(notification, row);
+    }
+}
+
 void NotificationListModel::reportActivity(const Notification& notification) const
 {
     if (!mFollowsActivityStore)
@@ -341,6 +414,8 @@ void NotificationListModel::reportActivity(const Notification& notification) con
 
 NotificationListModel::NotificationList NotificationListModel::createNotificationList(const ATProto::AppBskyNotification::Notification::List& rawList) const
 {
+    // Aggregation within a page. Aggregation with notifications from previous
+    // pages happens when the page gets added to the list.
     NotificationList notifications;
     std::unordered_map<Notification::Reason, std::unordered_map<QString, int>> aggregate;
 
@@ -349,16 +424,7 @@ NotificationListModel::NotificationList NotificationListModel::createNotificatio
         Notification notification(rawNotification);
         reportActivity(notification);
 
-        switch (notification.getReason())
-        {
-        case Notification::Reason::NOTIFICATION_REASON_LIKE:
-        case Notification::Reason::NOTIFICATION_REASON_LIKE_VIA_REPOST:
-        case Notification::Reason::NOTIFICATION_REASON_FOLLOW:
-        case Notification::Reason::NOTIFICATION_REASON_REPOST:
-        case Notification::Reason::NOTIFICATION_REASON_REPOST_VIA_REPOST:
-        case Notification::Reason::NOTIFICATION_REASON_VERIFIED:
-        case Notification::Reason::NOTIFICATION_REASON_UNVERIFIED:
-        case Notification::Reason::NOTIFICATION_REASON_UNKNOWN:
+        if (notification.isAggregatable())
         {
             const auto& uri = notification.getReasonSubjectUri();
             auto& aggregateMap = aggregate[notification.getReason()];
@@ -374,22 +440,22 @@ NotificationListModel::NotificationList NotificationListModel::createNotificatio
                 notifications.push_back(notification);
                 aggregateMap[uri] = notifications.size() - 1;
             }
-
-            break;
         }
-        default:
+        else
+        {
             notifications.push_back(notification);
-            break;
         }
 
+        // Notifications may be for a non-active user, so the viewer state
+        // belongs to the owner of the filter.
         const BasicProfile author(rawNotification->mAuthor);
-        AuthorCache::instance().put(author);
+        AuthorCache::instance().put(author, mContentFilter.getUserDid());
     }
 
     return notifications;
 }
 
-void NotificationListModel::getPosts(ATProto::Client& bsky, const NotificationList& list, const std::function<void()>& cb)
+void NotificationListModel::getPosts(ATProto::Client::SharedPtr bsky, const NotificationList& list, const std::function<void()>& cb)
 {
     std::unordered_set<QString> uris;
 
@@ -430,9 +496,9 @@ void NotificationListModel::getPosts(ATProto::Client& bsky, const NotificationLi
     getPosts(bsky, uris, cb);
 }
 
-void NotificationListModel::getPosts(ATProto::Client& bsky, std::unordered_set<QString> uris, const std::function<void()>& cb)
+void NotificationListModel::getPosts(ATProto::Client::SharedPtr bsky, std::unordered_set<QString> uris, const std::function<void()>& cb)
 {
-    if (uris.empty())
+    if (uris.empty() || !bsky)
     {
         if (cb)
             cb();
@@ -442,9 +508,9 @@ void NotificationListModel::getPosts(ATProto::Client& bsky, std::unordered_set<Q
 
     std::vector<QString> uriList(uris.begin(), uris.end());
 
-    if (uriList.size() > bsky.MAX_URIS_GET_POSTS)
+    if (uriList.size() > bsky->MAX_URIS_GET_POSTS)
     {
-        uriList.resize(bsky.MAX_URIS_GET_POSTS);
+        uriList.resize(bsky->MAX_URIS_GET_POSTS);
 
         for (const auto& uri : uriList)
             uris.erase(uri);
@@ -454,8 +520,8 @@ void NotificationListModel::getPosts(ATProto::Client& bsky, std::unordered_set<Q
         uris.clear();
     }
 
-    bsky.getPosts(uriList,
-        [this, &bsky, uris, cb](auto postViewList)
+    bsky->getPosts(uriList,
+        [this, bsky, uris, cb](auto postViewList)
         {
             for (auto& postView : postViewList)
             {
@@ -521,6 +587,7 @@ void NotificationListModel::dismissInviteCodeUsageNotification(int index)
 
     beginRemoveRows({}, index, index);
     mList.erase(mList.begin() + index);
+    rebuildAggregateIndex();
     endRemoveRows();
 }
 
@@ -543,6 +610,7 @@ void NotificationListModel::dismissNewLabelNotification(int index)
 
     beginRemoveRows({}, index, index);
     mList.erase(mList.begin() + index);
+    rebuildAggregateIndex();
     endRemoveRows();
 }
 
@@ -1150,102 +1218,102 @@ QHash<int, QByteArray> NotificationListModel::roleNames() const
 
 void NotificationListModel::postIndexedSecondsAgoChanged()
 {
-    changeData({ int(Role::NotificationSecondsAgo) });
+    changePostData({ int(Role::NotificationSecondsAgo) });
 }
 
 void NotificationListModel::likeCountChanged()
 {
-    changeData({ int(Role::NotificationPostLikeCount) });
+    changePostData({ int(Role::NotificationPostLikeCount) });
 }
 
 void NotificationListModel::likeUriChanged()
 {
-    changeData({ int(Role::NotificationPostLikeUri) });
+    changePostData({ int(Role::NotificationPostLikeUri) });
 }
 
 void NotificationListModel::likeTransientChanged()
 {
-    changeData({ int(Role::NotificationPostLikeTransient) });
+    changePostData({ int(Role::NotificationPostLikeTransient) });
 }
 
 void NotificationListModel::replyCountChanged()
 {
-    changeData({ int(Role::NotificationPostReplyCount) });
+    changePostData({ int(Role::NotificationPostReplyCount) });
 }
 
 void NotificationListModel::repostCountChanged()
 {
-    changeData({ int(Role::NotificationPostRepostCount) });
+    changePostData({ int(Role::NotificationPostRepostCount) });
 }
 
 void NotificationListModel::quoteCountChanged()
 {
-    changeData({ int(Role::NotificationPostQuoteCount) });
+    changePostData({ int(Role::NotificationPostQuoteCount) });
 }
 
 void NotificationListModel::repostUriChanged()
 {
-    changeData({ int(Role::NotificationPostRepostUri) });
+    changePostData({ int(Role::NotificationPostRepostUri) });
 }
 
 void NotificationListModel::threadgateUriChanged()
 {
-    changeData({ int(Role::NotificationPostThreadgateUri) });
+    changePostData({ int(Role::NotificationPostThreadgateUri) });
 }
 
 void NotificationListModel::replyRestrictionChanged()
 {
-    changeData({ int(Role::NotificationPostReplyRestriction) });
+    changePostData({ int(Role::NotificationPostReplyRestriction) });
 }
 
 void NotificationListModel::replyRestrictionListsChanged()
 {
-    changeData({ int(Role::NotificationPostReplyRestrictionLists) });
+    changePostData({ int(Role::NotificationPostReplyRestrictionLists) });
 }
 
 void NotificationListModel::hiddenRepliesChanged()
 {
-    changeData({ int(Role::NotificationPostHiddenReplies), int(Role::NotificationPostIsHiddenReply) });
+    changePostData({ int(Role::NotificationPostHiddenReplies), int(Role::NotificationPostIsHiddenReply) });
 }
 
 void NotificationListModel::threadMutedChanged()
 {
-    changeData({ int(Role::NotificationPostThreadMuted) });
+    changePostData({ int(Role::NotificationPostThreadMuted) });
 }
 
 void NotificationListModel::detachedRecordChanged()
 {
-    changeData({ int(Role::NotificationPostRecord), int(Role::NotificationPostRecordWithMedia) });
+    changePostData({ int(Role::NotificationPostRecord), int(Role::NotificationPostRecordWithMedia) });
 }
 
 void NotificationListModel::reAttachedRecordChanged()
 {
-    changeData({ int(Role::NotificationPostRecord), int(Role::NotificationPostRecordWithMedia) });
+    changePostData({ int(Role::NotificationPostRecord), int(Role::NotificationPostRecordWithMedia) });
 }
 
 void NotificationListModel::viewerStatePinnedChanged()
 {
-    changeData({ int(Role::NotificationPostViewerStatePinned) });
+    changePostData({ int(Role::NotificationPostViewerStatePinned) });
 }
 
 void NotificationListModel::postDeletedChanged()
 {
-    changeData({ int(Role::NotificationReasonPostLocallyDeleted) });
+    changePostData({ int(Role::NotificationReasonPostLocallyDeleted) });
 }
 
 void NotificationListModel::locallyBlockedChanged()
 {
-    changeData({ int(Role::NotificationPostBlocked) });
+    changePostData({ int(Role::NotificationPostBlocked) });
 }
 
 void NotificationListModel::bookmarkedChanged()
 {
-    changeData({ int(Role::NotificationPostBookmarked) });
+    changePostData({ int(Role::NotificationPostBookmarked) });
 }
 
 void NotificationListModel::bookmarkTransientChanged()
 {
-    changeData({ int(Role::NotificationPostBookmarkTransient) });
+    changePostData({ int(Role::NotificationPostBookmarkTransient) });
 }
 
 void NotificationListModel::changeData(const QList<int>& roles)
@@ -1253,6 +1321,37 @@ void NotificationListModel::changeData(const QList<int>& roles)
     emit dataChanged(createIndex(0, 0), createIndex(mList.size() - 1, 0), roles);
 }
 
+void NotificationListModel::changePostData(const QList<int>& roles)
+{
+    const auto& keys = getChangedPostKeys();
+
+    if (keys.isAll())
+    {
+        changeData(roles);
+        return;
+    }
+
+    std::vector<int> rows;
+
+    for (int i = 0; i < (int)mList.size(); ++i)
+    {
+        const auto& notification = mList[i];
+        const auto post = notification.getNotificationPost(mPostCache);
+
+        if (keys.contains(notification.getCid()) ||
+            keys.contains(notification.getReasonPost(mReasonPostCache).getCid()) ||
+            keys.contains(post.getUri()) || keys.contains(post.getReplyRootCid()) ||
+            keys.contains(post.getReplyRootUri()))
+        {
+            rows.push_back(i);
+        }
+    }
+
+    forEachRowRange(rows, [this, &roles](int first, int last){
+        emit dataChanged(createIndex(first, 0), createIndex(last, 0), roles);
+    });
+}
+
 
 BasicProfile NotificationListModel::getContentLabeler(QEnums::ContentVisibility visibility,
                                                       const ContentLabelList& labels,
@@ -1269,7 +1368,7 @@ BasicProfile NotificationListModel::getContentLabeler(QEnums::ContentVisibility
     if (labelerDid.isEmpty())
         return {};
 
-    const BasicProfile* profile = AuthorCache::instance().get(labelerDid);
+    const auto profile = AuthorCache::instance().get(labelerDid);
 
     if (profile)
         return *profile;
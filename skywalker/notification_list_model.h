@@ -190,14 +190,18 @@ private:
     NotificationList createNotificationList(const ATProto::AppBskyNotification::Notification::List& rawList) const;
     void filterNotificationList(NotificationList& list) const;
     void addNotificationList(const NotificationList& list, bool clearFirst);
+    int findAggregate(const Notification& notification) const;
+    void addToAggregateIndex(const Notification& notification, int row);
+    void rebuildAggregateIndex();
     void addConvoLastMessage(const ATProto::ChatBskyConvo::ConvoView& convo, const QString& lastRev, const QString& userDid);
     void addConvoLastReaction(const ATProto::ChatBskyConvo::ConvoView& convo, const QString& lastRev, const QString& userDid);
 
     // Get the posts for LIKE, FOLLOW and REPOST notifications
-    void getPosts(ATProto::Client& bsky, const NotificationList& list, const std::function<void()>& cb);
-    void getPosts(ATProto::Client& bsky, std::unordered_set<QString> uris, const std::function<void()>& cb);
+    void getPosts(ATProto::Client::SharedPtr bsky, const NotificationList& list, const std::function<void()>& cb);
+    void getPosts(ATProto::Client::SharedPtr bsky, std::unordered_set<QString> uris, const std::function<void()>& cb);
 
     void changeData(const QList<int>& roles) override;
+    void changePostData(const QList<int>& roles);
     void clearLocalState();
     void clearRows();
     void addInviteCodeUsageNotificationRows();
@@ -214,6 +218,11 @@ private:
     FollowsActivityStore* mFollowsActivityStore;
 
     NotificationList mList;
+
+    // Aggregated notifications across all pages in mList.
+    // reason -> reason subject uri -> row index in mList
+    std::unordered_map<Notification::Reason, std::unordered_map<QString, int>> mAggregateIndex;
+
     QString mCursor;
     bool mPriority = false;
 
@@ -145,9 +145,11 @@ OffLineMessageChecker::OffLineMessageChecker(const QString& settingsFileName, QC
     mNetwork(new QNetworkAccessManager(this)),
     mBackgroundApp(backgroundApp),
     mUserSettings(settingsFileName),
+    mAvatarStore(AvatarStore::getShared(AvatarStore::getStorePath(settingsFileName))),
     mImageReader(mNetwork),
     mContentFilterPolicies(this),
     mContentFilter(mUserDid, mContentFilterPolicies, mUserPreferences, &mUserSettings),
+    mMutedWords(nullptr, nullptr),
     mNotificationListModel(mContentFilter, mMutedWords, nullptr)
 {
     initNetwork();
@@ -158,9 +160,11 @@ OffLineMessageChecker::OffLineMessageChecker(const QString& settingsFileName, QE
     mNetwork(new QNetworkAccessManager(this)),
     mEventLoop(eventLoop),
     mUserSettings(settingsFileName),
+    mAvatarStore(AvatarStore::getShared(AvatarStore::getStorePath(settingsFileName))),
     mImageReader(mNetwork),
     mContentFilterPolicies(this),
     mContentFilter(mUserDid, mContentFilterPolicies, mUserPreferences, &mUserSettings),
+    mMutedWords(nullptr, nullptr),
     mNotificationListModel(mContentFilter, mMutedWords, nullptr)
 {
     initNetwork();
@@ -173,6 +177,7 @@ void OffLineMessageChecker::initNetwork()
     Q_ASSERT(mNetwork);
     mNetwork->setAutoDeleteReplies(true);
     mNetwork->setTransferTimeout(30000);
+    mImageReader.setAvatarStore(mAvatarStore);
 }
 
 void OffLineMessageChecker::reset()
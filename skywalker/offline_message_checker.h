@@ -1,6 +1,7 @@
 // Copyright (C) 2024 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "avatar_store.h"
 #include "content_filter.h"
 #include "image_reader.h"
 #include "list_store.h"
@@ -87,6 +88,7 @@ private:
     QCoreApplication* mBackgroundApp = nullptr;
     QEventLoop* mEventLoop = nullptr;
     UserSettings mUserSettings;
+    std::shared_ptr<AvatarStore> mAvatarStore;
     ATProto::Client::SharedPtr mBsky;
     QString mUserDid;
     ImageReader mImageReader;
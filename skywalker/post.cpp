@@ -4,6 +4,7 @@
 #include "post_utils.h"
 #include "author_cache.h"
 #include "content_filter.h"
+#include "language_identifier.h"
 #include "post_thread_cache.h"
 #include "unicode_fonts.h"
 #include "user_settings.h"
@@ -21,7 +22,7 @@ int Post::sNextGapId = 1;
 Post Post::createGapPlaceHolder(const QString& gapCursor)
 {
     Post post;
-    post.mGapCursor = gapCursor;
+    post.mutableColdData().mGapCursor = gapCursor;
     post.mGapId = sNextGapId++;
     return post;
 }
@@ -37,8 +38,14 @@ Post Post::createNotFound(const QString uri, const QString cid)
 {
     Post post;
     post.mNotFound = true;
-    post.mUri = uri;
-    post.mCid = cid;
+
+    if (!uri.isEmpty() || !cid.isEmpty())
+    {
+        auto& coldData = post.mutableColdData();
+        coldData.mUri = uri;
+        coldData.mCid = cid;
+    }
+
     return post;
 }
 
@@ -46,9 +53,10 @@ Post Post::createBlocked(const QString uri, const QString cid, const BlockedAuth
 {
     Post post;
     post.mBlocked = true;
-    post.mUri = uri;
-    post.mCid = cid;
-    post.mBlockedAuthor = blockedAuthor;
+    auto& coldData = post.mutableColdData();
+    coldData.mUri = uri;
+    coldData.mCid = cid;
+    coldData.mBlockedAuthor = blockedAuthor;
     return post;
 }
 
@@ -56,7 +64,7 @@ Post Post::createNotSupported(const QString& unsupportedType)
 {
     Post post;
     post.mNotSupported = true;
-    post.mUnsupportedType = unsupportedType;
+    post.mutableColdData().mUnsupportedType = unsupportedType;
     return post;
 }
 
@@ -70,7 +78,10 @@ Post Post::createPost(const ATProto::AppBskyFeed::ThreadElement& threadElement,
         Q_ASSERT(threadPost);
         Q_ASSERT(threadPost->mPost);
         Post post(threadPost->mPost);
-        post.mThreadgateView = threadgateView;
+
+        if (threadgateView)
+            post.setThreadgateView(threadgateView);
+
         return post;
     }
     case ATProto::AppBskyFeed::PostElementType::NOT_FOUND_POST:
@@ -151,28 +162,68 @@ Post::Post(const ATProto::AppBskyFeed::PostView::SharedPtr postView) :
         AuthorCache::instance().put(profile);
 }
 
+const Post::ColdData& Post::getColdData() const
+{
+    static const ColdData NO_COLD_DATA;
+    return mColdData ? *mColdData : NO_COLD_DATA;
+}
+
+Post::ColdData& Post::mutableColdData()
+{
+    if (!mColdData)
+        mColdData = std::make_shared<ColdData>();
+    else if (mColdData.use_count() > 1)
+        mColdData = std::make_shared<ColdData>(*mColdData);
+
+    return *mColdData;
+}
+
+Post::DerivedData& Post::getDerivedData() const
+{
+    if (!mDerivedData)
+        const_cast<Post*>(this)->mDerivedData = std::make_shared<DerivedData>();
+
+    return *mDerivedData;
+}
+
 const QString& Post::getCid() const
 {
-    if (!mOverrideCid.isEmpty())
-        return mOverrideCid;
+    const auto& coldData = getColdData();
+
+    if (!coldData.mOverrideCid.isEmpty())
+        return coldData.mOverrideCid;
 
-    return mPost ? mPost->mCid : mCid;
+    return mPost ? mPost->mCid : coldData.mCid;
 }
 
 const QString& Post::getUri() const
 {
-    if (!mOverrideUri.isEmpty())
-        return mOverrideUri;
+    const auto& coldData = getColdData();
+
+    if (!coldData.mOverrideUri.isEmpty())
+        return coldData.mOverrideUri;
+
+    return mPost ? mPost->mUri : coldData.mUri;
+}
+
+void Post::setOverrideText(const QString& text)
+{
+    mutableColdData().mOverrideText = text;
 
-    return mPost ? mPost->mUri : mUri;
+    // The identified language and word index depend on the text. Other copies
+    // keep theirs.
+    mDerivedData = nullptr;
+    clearNormalizedWordIndex();
 }
 
 QString Post::getText() const
 {
     static const QString NO_STRING;
 
-    if (!mOverrideText.isEmpty())
-        return mOverrideText;
+    const auto& overrideText = getColdData().mOverrideText;
+
+    if (!overrideText.isEmpty())
+        return overrideText;
 
     if (!mPost)
         return NO_STRING;
@@ -195,8 +246,10 @@ QString Post::getFormattedText(const std::set<QString>& emphasizeHashtags, const
 {
     static const QString NO_STRING;
 
-    if (!mOverrideFormattedText.isEmpty())
-        return mOverrideFormattedText;
+    const auto& overrideFormattedText = getColdData().mOverrideFormattedText;
+
+    if (!overrideFormattedText.isEmpty())
+        return overrideFormattedText;
 
     if (!mPost)
         return NO_STRING;
@@ -263,8 +316,10 @@ BasicProfile Post::getAuthor() const
 
 QDateTime Post::getIndexedAt() const
 {
-    if (mOverrideIndexedAt.isValid())
-        return mOverrideIndexedAt;
+    const auto& overrideIndexedAt = getColdData().mOverrideIndexedAt;
+
+    if (overrideIndexedAt.isValid())
+        return overrideIndexedAt;
 
     if (!mPost)
         return {};
@@ -276,8 +331,10 @@ QDateTime Post::getIndexedAt() const
 
 QDateTime Post::getTimelineTimestamp() const
 {
-    if (!mReplyRefTimestamp.isNull())
-        return mReplyRefTimestamp;
+    const auto& replyRefTimestamp = getColdData().mReplyRefTimestamp;
+
+    if (!replyRefTimestamp.isNull())
+        return replyRefTimestamp;
 
     if (isRepost())
         return getRepostTimestamp();
@@ -324,8 +381,10 @@ QString Post::getReasonRepostCid() const
 
 bool Post::isReply() const
 {
-    if (mOverrideIsReply)
-        return *mOverrideIsReply;
+    const auto& overrideIsReply = getColdData().mOverrideIsReply;
+
+    if (overrideIsReply)
+        return *overrideIsReply;
 
     if (mFeedViewPost && mFeedViewPost->mReply)
         return true;
@@ -353,16 +412,19 @@ std::optional<PostReplyRef> Post::getViewPostReplyRef() const
 
     // Set the reference timestamp to the timestap of this reply post.
     // They show up together with this reply post.
-    replyRef.mRoot.mReplyRefTimestamp = getTimelineTimestamp();
-    replyRef.mParent.mReplyRefTimestamp = getTimelineTimestamp();
+    const QDateTime timestamp = getTimelineTimestamp();
+    replyRef.mRoot.setReplyRefTimestamp(timestamp);
+    replyRef.mParent.setReplyRefTimestamp(timestamp);
 
     return replyRef;
 }
 
 std::optional<BasicProfile> Post::getReplyToAuthor() const
 {
-    if (mReplyToAuthor)
-        return mReplyToAuthor;
+    const auto& replyToAuthor = getColdData().mReplyToAuthor;
+
+    if (replyToAuthor)
+        return replyToAuthor;
 
     if (mFeedViewPost && mFeedViewPost->mReply)
     {
@@ -382,12 +444,12 @@ std::optional<BasicProfile> Post::getReplyToAuthor() const
     if (did.isEmpty())
         return {};
 
-    auto* author = AuthorCache::instance().get(did);
+    const auto author = AuthorCache::instance().get(did);
     if (!author)
         return {};
 
     const_cast<Post*>(this)->setReplyToAuthor(*author);
-    return mReplyToAuthor;
+    return *author;
 }
 
 ATProto::ComATProtoRepo::StrongRef::SharedPtr Post::getReplyToRef() const
@@ -733,40 +795,50 @@ bool Post::isQuotePost() const
 
 int Post::getReplyCount() const
 {
-    if (mOverrideReplyCount)
-        return *mOverrideReplyCount;
+    const auto& overrideReplyCount = getColdData().mOverrideReplyCount;
+
+    if (overrideReplyCount)
+        return *overrideReplyCount;
 
     return mPost ? mPost->mReplyCount : 0;
 }
 
 int Post::getRepostCount() const
 {
-    if (mOverrideRepostCount)
-        return *mOverrideRepostCount;
+    const auto& overrideRepostCount = getColdData().mOverrideRepostCount;
+
+    if (overrideRepostCount)
+        return *overrideRepostCount;
 
     return mPost ? mPost->mRepostCount : 0;
 }
 
 int Post::getLikeCount() const
 {
-    if (mOverrideLikeCount)
-        return *mOverrideLikeCount;
+    const auto& overrideLikeCount = getColdData().mOverrideLikeCount;
+
+    if (overrideLikeCount)
+        return *overrideLikeCount;
 
     return mPost ? mPost->mLikeCount : 0;
 }
 
 int Post::getQuoteCount() const
 {
-    if (mOverrideQuoteCount)
-        return *mOverrideQuoteCount;
+    const auto& overrideQuoteCount = getColdData().mOverrideQuoteCount;
+
+    if (overrideQuoteCount)
+        return *overrideQuoteCount;
 
     return mPost ? mPost->mQuoteCount : 0;
 }
 
 QString Post::getRepostUri() const
 {
-    if (!mOverrideRepostUri.isEmpty())
-        return mOverrideRepostUri;
+    const auto& overrideRepostUri = getColdData().mOverrideRepostUri;
+
+    if (!overrideRepostUri.isEmpty())
+        return overrideRepostUri;
 
     if (!mPost || !mPost->mViewer)
         return {};
@@ -777,8 +849,10 @@ QString Post::getRepostUri() const
 
 QString Post::getLikeUri() const
 {
-    if (!mOverrideLikeUri.isEmpty())
-        return mOverrideLikeUri;
+    const auto& overrideLikeUri = getColdData().mOverrideLikeUri;
+
+    if (!overrideLikeUri.isEmpty())
+        return overrideLikeUri;
 
     if (!mPost || !mPost->mViewer)
         return {};
@@ -789,8 +863,10 @@ QString Post::getLikeUri() const
 
 bool Post::isBookmarked() const
 {
-    if (mOverrideIsBookmarked)
-        return *mOverrideIsBookmarked;
+    const auto& overrideIsBookmarked = getColdData().mOverrideIsBookmarked;
+
+    if (overrideIsBookmarked)
+        return *overrideIsBookmarked;
 
     if (!mPost || !mPost->mViewer)
         return mIsBookmarked;
@@ -800,8 +876,10 @@ bool Post::isBookmarked() const
 
 bool Post::isThreadMuted() const
 {
-    if (mOverrideThreadMuted)
-        return *mOverrideThreadMuted;
+    const auto& overrideThreadMuted = getColdData().mOverrideThreadMuted;
+
+    if (overrideThreadMuted)
+        return *overrideThreadMuted;
 
     if (!mPost || !mPost->mViewer)
         return false;
@@ -811,8 +889,10 @@ bool Post::isThreadMuted() const
 
 bool Post::isReplyDisabled() const
 {
-    if (mOverrideReplyDisabled)
-        return *mOverrideReplyDisabled;
+    const auto& overrideReplyDisabled = getColdData().mOverrideReplyDisabled;
+
+    if (overrideReplyDisabled)
+        return *overrideReplyDisabled;
 
     if (!mPost || !mPost->mViewer)
         return false;
@@ -822,8 +902,10 @@ bool Post::isReplyDisabled() const
 
 bool Post::isEmbeddingDisabled() const
 {
-    if (mOverrideEmbeddingDisabled)
-        return *mOverrideEmbeddingDisabled;
+    const auto& overrideEmbeddingDisabled = getColdData().mOverrideEmbeddingDisabled;
+
+    if (overrideEmbeddingDisabled)
+        return *overrideEmbeddingDisabled;
 
     if (!mPost || !mPost->mViewer)
         return false;
@@ -841,8 +923,10 @@ bool Post::isViewerStatePinned() const
 
 ATProto::AppBskyFeed::ThreadgateView::SharedPtr Post::getThreadgateView() const
 {
-    if (mThreadgateView)
-        return mThreadgateView;
+    const auto& threadgateView = getColdData().mThreadgateView;
+
+    if (threadgateView)
+        return threadgateView;
 
     if (mPost && mPost->mThreadgate)
         return mPost->mThreadgate;
@@ -955,30 +1039,37 @@ const std::vector<ATProto::ComATProtoLabel::Label::SharedPtr>& Post::getLabels()
 
 const ContentLabelList& Post::getLabelsIncludingAuthorLabels() const
 {
-    if (mLabelsIncludingAuthorLabels)
-        return *mLabelsIncludingAuthorLabels;
+    auto& labels = getDerivedData().mLabelsIncludingAuthorLabels;
+
+    if (labels)
+        return *labels;
 
     const auto& author = getAuthor();
     ContentLabelList contentLabels = author.getContentLabels();
     ContentFilter::addContentLabels(contentLabels, getLabels());
-    const_cast<Post*>(this)->mLabelsIncludingAuthorLabels = contentLabels;
-    return *mLabelsIncludingAuthorLabels;
+    labels = contentLabels;
+    return *labels;
 }
 
 const LanguageList& Post::getLanguages() const
 {
-    if (!mLanguages.empty())
-        return mLanguages;
+    static const LanguageList NO_LANGUAGES;
 
     if (!mPost)
-        return mLanguages;
+        return NO_LANGUAGES;
 
     if (mPost->mRecordType != ATProto::RecordType::APP_BSKY_FEED_POST)
-        return mLanguages;
+        return NO_LANGUAGES;
 
-    const auto& record = std::get<ATProto::AppBskyFeed::Record::Post::SharedPtr>(mPost->mRecord);
-    const_cast<Post*>(this)->mLanguages = LanguageUtils::getLanguages(record->mLanguages);
-    return mLanguages;
+    auto& languages = getDerivedData().mLanguages;
+
+    if (!languages)
+    {
+        const auto& record = std::get<ATProto::AppBskyFeed::Record::Post::SharedPtr>(mPost->mRecord);
+        languages = LanguageUtils::getLanguages(record->mLanguages);
+    }
+
+    return *languages;
 }
 
 bool Post::hasLanguage() const
@@ -986,6 +1077,19 @@ bool Post::hasLanguage() const
     return !getLanguages().empty();
 }
 
+const QString& Post::getIdentifiedLanguage() const
+{
+    auto& identifiedLanguage = getDerivedData().mIdentifiedLanguage;
+
+    if (!identifiedLanguage)
+    {
+        const QString lang = hasLanguage() ? QString{} : LanguageIdentifier::instance().identify(getText()).mLanguageCode;
+        identifiedLanguage = lang;
+    }
+
+    return *identifiedLanguage;
+}
+
 QStringList Post::getMentionDids() const
 {
     if (!mPost)
@@ -1090,9 +1194,9 @@ QEnums::TripleBool Post::isThread() const
     if (getReplyCount() == 0)
         return QEnums::TRIPLE_BOOL_NO;
 
-    const bool* isThread = PostThreadCache::instance().getIsThread(getUri());
+    const auto isThread = PostThreadCache::instance().getIsThread(getUri());
 
-    if (isThread == nullptr)
+    if (!isThread)
     {
         const QString text = getText();
         if (text.contains(UnicodeFonts::THREAD_SYMBOL))
@@ -1128,10 +1232,12 @@ QJsonObject Post::toJson() const
     else if (mPost)
         json.insert("post", mPost->toJson());
 
+    const auto& coldData = getColdData();
+
     if (mGapId)
         json.insert("gapId", mGapId);
-    if (!mGapCursor.isEmpty())
-        json.insert("gapCursor", mGapCursor);
+    if (!coldData.mGapCursor.isEmpty())
+        json.insert("gapCursor", coldData.mGapCursor);
     if (mEndOfFeed)
         json.insert("endOfFeed", mEndOfFeed);
     if (mPostType != QEnums::POST_STANDALONE)
@@ -1140,10 +1246,10 @@ QJsonObject Post::toJson() const
         json.insert("foldedPostType", QEnums::foldedPostTypeToString(mFoldedPostType));
     if (mThreadIndentLevel)
         json.insert("threadIndentLevel", mThreadIndentLevel);
-    if (!mReplyRefTimestamp.isNull())
-        json.insert("replyRefTimestamp", mReplyRefTimestamp.toString(Qt::ISODateWithMs));
-    if (mReplyToAuthor && mReplyToAuthor->getProfileBasicView())
-        json.insert("replyToAuthor", mReplyToAuthor->getProfileBasicView()->toJson());
+    if (!coldData.mReplyRefTimestamp.isNull())
+        json.insert("replyRefTimestamp", coldData.mReplyRefTimestamp.toString(Qt::ISODateWithMs));
+    if (coldData.mReplyToAuthor && coldData.mReplyToAuthor->getProfileBasicView())
+        json.insert("replyToAuthor", coldData.mReplyToAuthor->getProfileBasicView()->toJson());
     if (mParentInThread)
         json.insert("parentInThread", mParentInThread);
     if (mBlocked)
@@ -1152,9 +1258,9 @@ QJsonObject Post::toJson() const
         json.insert("notFound", mNotFound);
     if (mNotSupported)
         json.insert("notSupported", mNotSupported);
-    if (!mUnsupportedType.isEmpty())
-        json.insert("unsupportedType", mUnsupportedType);
-    ATProto::XJsonObject::insertOptionalJsonObject<ATProto::AppBskyFeed::ThreadgateView>(json, "threadgateView", mThreadgateView);
+    if (!coldData.mUnsupportedType.isEmpty())
+        json.insert("unsupportedType", coldData.mUnsupportedType);
+    ATProto::XJsonObject::insertOptionalJsonObject<ATProto::AppBskyFeed::ThreadgateView>(json, "threadgateView", coldData.mThreadgateView);
 
     return json;
 }
@@ -1179,23 +1285,38 @@ Post Post::fromJson(const QJsonObject& json)
     }
 
     post.mGapId = xjson.getOptionalInt("gapId", 0);
-    post.mGapCursor = xjson.getOptionalString("gapCursor", {});
+    const QString gapCursor = xjson.getOptionalString("gapCursor", {});
+
+    if (!gapCursor.isEmpty())
+        post.mutableColdData().mGapCursor = gapCursor;
+
     post.mEndOfFeed = xjson.getOptionalBool("endOfFeed", false);
     post.mPostType = QEnums::stringToPostType(xjson.getOptionalString("postType", "standalone"));
     post.mFoldedPostType = QEnums::stringToFoldedPostType(xjson.getOptionalString("foldedPostType", "none"));
     post.mThreadIndentLevel = xjson.getOptionalInt("threadIndentLevel", 0);
-    post.mReplyRefTimestamp = xjson.getOptionalDateTime("replyRefTImestamp", {});
+    const QDateTime replyRefTimestamp = xjson.getOptionalDateTime("replyRefTImestamp", {});
+
+    if (!replyRefTimestamp.isNull())
+        post.setReplyRefTimestamp(replyRefTimestamp);
+
     auto profileBasicView = xjson.getOptionalObject<ATProto::AppBskyActor::ProfileViewBasic>("replyToAuthor");
 
     if (profileBasicView)
-        post.mReplyToAuthor = BasicProfile(profileBasicView);
+        post.setReplyToAuthor(BasicProfile(profileBasicView));
 
     post.mParentInThread = xjson.getOptionalBool("parentInThread", false);
     post.mBlocked = xjson.getOptionalBool("blocked", false);
     post.mNotFound = xjson.getOptionalBool("notFound", false);
     post.mNotSupported = xjson.getOptionalBool("notSupported", false);
-    post.mUnsupportedType = xjson.getOptionalString("unsupportedType", {});
-    post.mThreadgateView = xjson.getOptionalObject<ATProto::AppBskyFeed::ThreadgateView>("threadgateView");
+    const QString unsupportedType = xjson.getOptionalString("unsupportedType", {});
+
+    if (!unsupportedType.isEmpty())
+        post.mutableColdData().mUnsupportedType = unsupportedType;
+
+    auto threadgateView = xjson.getOptionalObject<ATProto::AppBskyFeed::ThreadgateView>("threadgateView");
+
+    if (threadgateView)
+        post.setThreadgateView(std::move(threadgateView));
 
     return post;
 }
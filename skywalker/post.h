@@ -43,24 +43,24 @@ public:
     bool isGap() const { return !mPost && mGapId > 0; }
     bool isEndOfFeed() const { return mEndOfFeed; }
     int getGapId() const { return mGapId; }
-    const QString& getGapCursor() const { return mGapCursor; }
+    const QString& getGapCursor() const { return getColdData().mGapCursor; }
     QEnums::PostType getPostType() const { return mPostType; }
     bool isParentInThread() const { return mParentInThread; }
 
     const QString& getCid() const;
     const QString& getUri() const;
 
-    void setOverrideCid(const QString& cid) { mOverrideCid = cid; }
-    void setOverrideUri(const QString& uri) { mOverrideUri = uri; }
+    void setOverrideCid(const QString& cid) { mutableColdData().mOverrideCid = cid; }
+    void setOverrideUri(const QString& uri) { mutableColdData().mOverrideUri = uri; }
 
     // The indexedAt of a post or repost
     QDateTime getTimelineTimestamp() const;
     QDateTime getRepostTimestamp() const;
 
-    void setReplyRefTimestamp(const QDateTime& timestamp) { mReplyRefTimestamp = timestamp; }
+    void setReplyRefTimestamp(const QDateTime& timestamp) { mutableColdData().mReplyRefTimestamp = timestamp; }
 
-    void setOverrideText(const QString& text) { mOverrideText = text; }
-    void setOverrideFormattedText(const QString& formattedText) { mOverrideFormattedText = formattedText; }
+    void setOverrideText(const QString& text);
+    void setOverrideFormattedText(const QString& formattedText) { mutableColdData().mOverrideFormattedText = formattedText; }
 
     QString getText() const override;
     QString getFormattedText(const std::set<QString>& emphasizeHashtags = {}, const QString& linkColor = {}) const;
@@ -71,13 +71,13 @@ public:
     BasicProfile getAuthor() const override;
     QString getAuthorDid() const { return getAuthor().getDid(); }
     QDateTime getIndexedAt() const;
-    void setOverrideIndexedAt(QDateTime dateTime) { mOverrideIndexedAt = dateTime; }
+    void setOverrideIndexedAt(QDateTime dateTime) { mutableColdData().mOverrideIndexedAt = dateTime; }
     bool isRepost() const;
     std::optional<BasicProfile> getRepostedBy() const;
     QString getReasonRepostUri() const;
     QString getReasonRepostCid() const;
     bool isReply() const;
-    void setOverrideIsReply(bool isReply) { mOverrideIsReply = isReply; }
+    void setOverrideIsReply(bool isReply) { mutableColdData().mOverrideIsReply = isReply; }
     std::optional<PostReplyRef> getViewPostReplyRef() const;
     std::optional<BasicProfile> getReplyToAuthor() const;
     ATProto::ComATProtoRepo::StrongRef::SharedPtr getReplyToRef() const;
@@ -106,30 +106,30 @@ public:
     bool isQuotePost() const;
 
     int getReplyCount() const;
-    void setOverrideReplyCount(int count) { mOverrideReplyCount = count; }
+    void setOverrideReplyCount(int count) { mutableColdData().mOverrideReplyCount = count; }
     int getRepostCount() const;
-    void setOverrideRepostCount(int count) { mOverrideRepostCount = count; }
+    void setOverrideRepostCount(int count) { mutableColdData().mOverrideRepostCount = count; }
     int getLikeCount() const;
-    void setOverrideLikeCount(int count) { mOverrideLikeCount = count; }
+    void setOverrideLikeCount(int count) { mutableColdData().mOverrideLikeCount = count; }
     int getQuoteCount() const;
-    void setOverrideQuoteCount(int count) { mOverrideQuoteCount = count; }
+    void setOverrideQuoteCount(int count) { mutableColdData().mOverrideQuoteCount = count; }
     QString getRepostUri() const;
-    void setOverrideRepostUri(const QString& uri) { mOverrideRepostUri = uri; }
+    void setOverrideRepostUri(const QString& uri) { mutableColdData().mOverrideRepostUri = uri; }
     QString getLikeUri() const;
-    void setOverrideLikeUri(const QString& uri) { mOverrideLikeUri = uri; }
+    void setOverrideLikeUri(const QString& uri) { mutableColdData().mOverrideLikeUri = uri; }
     void setBookmarked(bool bookmarked) { mIsBookmarked = bookmarked; }
     bool isBookmarked() const;
-    void setOverrideBookmarked(bool bookmarked) { mOverrideIsBookmarked = bookmarked; }
+    void setOverrideBookmarked(bool bookmarked) { mutableColdData().mOverrideIsBookmarked = bookmarked; }
     bool isThreadMuted() const;
-    void setOverrideThreadMuted(bool muted) { mOverrideThreadMuted = muted; }
+    void setOverrideThreadMuted(bool muted) { mutableColdData().mOverrideThreadMuted = muted; }
     bool isReplyDisabled() const;
-    void setOverrideReplyDisabled(bool disabled) { mOverrideReplyDisabled = disabled; }
+    void setOverrideReplyDisabled(bool disabled) { mutableColdData().mOverrideReplyDisabled = disabled; }
     bool isEmbeddingDisabled() const;
-    void setOverrideEmbeddingDisabled(bool disabled) { mOverrideEmbeddingDisabled = disabled; }
+    void setOverrideEmbeddingDisabled(bool disabled) { mutableColdData().mOverrideEmbeddingDisabled = disabled; }
     bool isViewerStatePinned() const;
 
     ATProto::AppBskyFeed::ThreadgateView::SharedPtr getThreadgateView() const;
-    void setThreadgateView(const ATProto::AppBskyFeed::ThreadgateView::SharedPtr& threadgate) { mThreadgateView = threadgate; }
+    void setThreadgateView(const ATProto::AppBskyFeed::ThreadgateView::SharedPtr& threadgate) { mutableColdData().mThreadgateView = threadgate; }
     QString getThreadgateUri() const;
     static QEnums::ReplyRestriction makeReplyRestriction(bool allowMention, bool allowFollower, bool allowFollowing, bool allowList, bool allowNobody);
     QEnums::ReplyRestriction getReplyRestriction() const;
@@ -140,7 +140,7 @@ public:
     void setEndOfFeed(bool end) { mEndOfFeed = end; }
     void setPostType(QEnums::PostType postType) { mPostType = postType; }
     void setParentInThread(bool parentInThread) { mParentInThread = parentInThread; }
-    void setReplyToAuthor(const BasicProfile& profile) { mReplyToAuthor = profile; }
+    void setReplyToAuthor(const BasicProfile& profile) { mutableColdData().mReplyToAuthor = profile; }
 
     QEnums::FoldedPostType getFoldedPostType() const { return mFoldedPostType; }
     void setFoldedPostType(QEnums::FoldedPostType foldedPostType) { mFoldedPostType = foldedPostType; }
@@ -155,9 +155,9 @@ public:
     bool isHiddenPosts() const { return mHiddenPosts; }
     bool isNotFound() const { return mNotFound; }
     bool isBlocked() const { return mBlocked; }
-    const BlockedAuthor& getBlockedAuthor() const { return mBlockedAuthor; }
+    const BlockedAuthor& getBlockedAuthor() const { return getColdData().mBlockedAuthor; }
     bool isNotSupported() const { return mNotSupported; }
-    const QString& getUnsupportedType() const { return mUnsupportedType; }
+    const QString& getUnsupportedType() const { return getColdData().mUnsupportedType; }
 
     const std::vector<ATProto::ComATProtoLabel::Label::SharedPtr>& getLabels() const;
     const ContentLabelList& getLabelsIncludingAuthorLabels() const;
@@ -165,6 +165,10 @@ public:
     const LanguageList& getLanguages() const;
     bool hasLanguage() const;
 
+    // Language identified from the text when the post has no languages.
+    // Empty if the language could not be identified.
+    const QString& getIdentifiedLanguage() const;
+
     QStringList getMentionDids() const;
     std::vector<QString> getHashtags() const override;
     std::vector<QString> getCashtags() const override;
@@ -180,69 +184,87 @@ public:
     QJsonObject toJson() const;
 
 private:
-    // null is place holder for more posts (gap)
-    ATProto::AppBskyFeed::PostView::SharedPtr mPost;
+    // Fields that are set for few posts only, e.g. overrides after user
+    // actions and place holder details. Copies of a post share them till
+    // one of the copies gets modified.
+    struct ColdData
+    {
+        BlockedAuthor mBlockedAuthor;
 
-    // null if the post represents a reply ref.
-    ATProto::AppBskyFeed::FeedViewPost::SharedPtr mFeedViewPost;
+        QString mUri;
+        QString mCid;
 
-    BlockedAuthor mBlockedAuthor;
+        QString mOverrideUri;
+        QString mOverrideCid;
 
-    QString mUri;
-    QString mCid;
+        QString mOverrideText;
+        QString mOverrideFormattedText;
 
-    QString mOverrideUri;
-    QString mOverrideCid;
+        QDateTime mOverrideIndexedAt;
+        std::optional<bool> mOverrideIsReply;
 
-    QString mOverrideText;
-    QString mOverrideFormattedText;
+        // cursor to get more posts to fill the gap
+        QString mGapCursor;
 
-    QDateTime mOverrideIndexedAt;
-    std::optional<bool> mOverrideIsReply;
+        // Timestamp to keep reply references in time sequence for the timeline
+        QDateTime mReplyRefTimestamp;
 
-    int mGapId = 0;
+        // For posts not having all parent informations, the reply-to-author may
+        // inferred from through other posts.
+        std::optional<BasicProfile> mReplyToAuthor;
 
-    // cursor to get more posts to fill the gap
-    QString mGapCursor;
+        QString mUnsupportedType;
 
-    bool mEndOfFeed = false;
-    QEnums::PostType mPostType = QEnums::POST_STANDALONE;
-    QEnums::FoldedPostType mFoldedPostType = QEnums::FOLDED_POST_NONE;
+        QString mOverrideRepostUri;
+        QString mOverrideLikeUri;
+        std::optional<bool> mOverrideIsBookmarked;
+        std::optional<bool> mOverrideThreadMuted;
+        std::optional<bool> mOverrideEmbeddingDisabled;
+        std::optional<bool> mOverrideReplyDisabled;
+
+        std::optional<int> mOverrideReplyCount;
+        std::optional<int> mOverrideRepostCount;
+        std::optional<int> mOverrideLikeCount;
+        std::optional<int> mOverrideQuoteCount;
+
+        ATProto::AppBskyFeed::ThreadgateView::SharedPtr mThreadgateView;
+    };
+
+    // Values computed from the post on first use, shared by copies.
+    struct DerivedData
+    {
+        std::optional<LanguageList> mLanguages;
+        std::optional<ContentLabelList> mLabelsIncludingAuthorLabels;
+        std::optional<QString> mIdentifiedLanguage;
+    };
+
+    const ColdData& getColdData() const;
+    ColdData& mutableColdData();
+    DerivedData& getDerivedData() const;
+
+    // null is place holder for more posts (gap)
+    ATProto::AppBskyFeed::PostView::SharedPtr mPost;
+
+    // null if the post represents a reply ref.
+    ATProto::AppBskyFeed::FeedViewPost::SharedPtr mFeedViewPost;
+
+    std::shared_ptr<ColdData> mColdData; // null if nothing set
+    std::shared_ptr<DerivedData> mDerivedData; // null if nothing computed yet
+
+    int mGapId = 0;
     int mThreadType = QEnums::THREAD_NONE;
     int mThreadIndentLevel = 0;
+    QEnums::PostType mPostType = QEnums::POST_STANDALONE;
+    QEnums::FoldedPostType mFoldedPostType = QEnums::FOLDED_POST_NONE;
 
-    // Timestamp to keep reply references in time sequence for the timeline
-    QDateTime mReplyRefTimestamp;
-
-    // For posts not having all parent informations, the reply-to-author may
-    // inferred from through other posts.
-    std::optional<BasicProfile> mReplyToAuthor;
+    bool mEndOfFeed = false;
     bool mParentInThread = false;
-
     bool mHiddenPosts = false; // placeholder for hidden replies in thread view
     bool mBlocked = false;
     bool mNotFound = false;
     bool mNotSupported = false;
-    QString mUnsupportedType;
     bool mIsBookmarked = false;
-
-    QString mOverrideRepostUri;
-    QString mOverrideLikeUri;
-    std::optional<bool> mOverrideIsBookmarked;
-    std::optional<bool> mOverrideThreadMuted;
-    std::optional<bool> mOverrideEmbeddingDisabled;
-    std::optional<bool> mOverrideReplyDisabled;
-
-    std::optional<int> mOverrideReplyCount;
-    std::optional<int> mOverrideRepostCount;
-    std::optional<int> mOverrideLikeCount;
-    std::optional<int> mOverrideQuoteCount;
-
-    LanguageList mLanguages;
-    ATProto::AppBskyFeed::ThreadgateView::SharedPtr mThreadgateView;
-
     bool mPinned = false;
-    std::optional<ContentLabelList> mLabelsIncludingAuthorLabels;
 
     static int sNextGapId;
 };
@@ -4,15 +4,27 @@
 
 namespace Skywalker {
 
-PostCache::Entry::Entry(const Post& post) :
-    mPost(post)
-{
-}
-
 PostCache::PostCache() :
-    mCache(500)
+    mCache("PostCache", 0, &PostCache::getCost, BUDGET_WEIGHT)
 {}
 
+qsizetype PostCache::getCost(const QString& uri, const Post& post)
+{
+    // The post view is shared with the models. Estimate the size of the
+    // content that is not shared.
+    qsizetype cost = sizeof(ATProto::AppBskyFeed::PostView) + CacheCost::string(uri) +
+            CacheCost::string(post.getCid()) + CacheCost::string(post.getText());
+
+    const auto author = post.getAuthor();
+    cost += CacheCost::string(author.getDid()) + CacheCost::string(author.getHandle()) +
+            CacheCost::string(author.getDisplayName()) + CacheCost::string(author.getAvatarUrl());
+
+    for (const auto& image : post.getImages())
+        cost += CacheCost::string(image.getFullSizeUrl()) + CacheCost::string(image.getThumbUrl()) + CacheCost::string(image.getAlt());
+
+    return cost;
+}
+
 void PostCache::clear()
 {
     mCache.clear();
@@ -20,15 +32,13 @@ void PostCache::clear()
 
 void PostCache::put(const Post& post)
 {
-    auto* entry = new Entry(post);
-    mCache.insert(post.getUri(), entry);
-    qDebug() << "Cached:" << post.getUri() << "size:" << mCache.size();
+    mCache.insert(post.getUri(), post);
+    qDebug() << "Cached:" << post.getUri() << "size:" << mCache.size() << "cost:" << mCache.getTotalCost();
 }
 
-const Post* PostCache::get(const QString& uri) const
+std::shared_ptr<const Post> PostCache::get(const QString& uri) const
 {
-    auto* entry = mCache[uri];
-    return entry ? &entry->getPost() : nullptr;
+    return mCache.get(uri);
 }
 
 bool PostCache::contains(const QString& uri) const
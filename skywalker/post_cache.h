@@ -1,37 +1,28 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "memory_cache.h"
 #include "post.h"
-#include <QCache>
-#include <QObject>
 
 namespace Skywalker {
 
 class PostCache
 {
 public:
-    class Entry : public QObject
-    {
-    public:
-        Entry() = default;
-        explicit Entry(const Post& post);
-
-        const Post& getPost() const { return mPost; }
-
-    private:
-        Post mPost;
-    };
+    static constexpr int BUDGET_WEIGHT = 40;
 
     PostCache();
 
     void clear();
     void put(const Post& post);
-    const Post* get(const QString& uri) const;
+    std::shared_ptr<const Post> get(const QString& uri) const;
     bool contains(const QString& uri) const;
     std::vector<QString> getNonCachedUris(const std::vector<QString>& uris) const;
 
 private:
-    QCache<QString, Entry> mCache; // key is at-uri
+    static qsizetype getCost(const QString& uri, const Post& post);
+
+    MemoryCache<QString, Post> mCache; // key is at-uri
 };
 
 }
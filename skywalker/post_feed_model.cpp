@@ -143,7 +143,7 @@ bool PostFeedModel::showPostWithMissingLanguage() const
     return mUserSettings.getShowUnknownContentLanguage(mUserDid);
 }
 
-void PostFeedModel::setFeed(const std::deque<Post>& filteredPosts,
+void PostFeedModel::setFeed(const ContentFilterStats::PostList& filteredPosts,
                             const ContentFilterStats::PostHideInfoMap* postHideInfoMap,
                             ContentFilterStats::Details& hideDetails)
 {
@@ -236,36 +236,72 @@ void PostFeedModel::insertPage(const TimelineFeed::iterator& feedInsertIt, const
     cleanupStoredCids();
 }
 
+PostFilterEvaluator PostFeedModel::evaluateFilters(const TimelineFeed& posts, int startIndex, size_t numPosts) const
+{
+    std::vector<const IPostFilter*> filters;
+    filters.reserve(mFilteredPostFeedModels.size());
+
+    for (const auto& model : mFilteredPostFeedModels)
+        filters.push_back(&model->getPostFilter());
+
+    PostFilterEvaluator evaluator(filters);
+    evaluator.evaluate(posts, startIndex, numPosts);
+    return evaluator;
+}
+
 void PostFeedModel::addPageToFilteredPostModels(const Page& page, int pageSize)
 {
-    for (auto& model : mFilteredPostFeedModels)
-        model->addPosts(page.mFeed, pageSize);
+    if (mFilteredPostFeedModels.empty())
+        return;
+
+    const auto evaluator = evaluateFilters(page.mFeed, 0, pageSize);
+
+    for (int i = 0; i < (int)mFilteredPostFeedModels.size(); ++i)
+        mFilteredPostFeedModels[i]->addPosts(page.mFeed, pageSize, evaluator.getMatchedIndices(i));
 }
 
 void PostFeedModel::prependPageToFilteredPostModels(const Page& page, int pageSize)
 {
-    for (auto& model : mFilteredPostFeedModels)
-        model->prependPosts(page.mFeed, pageSize);
+    if (mFilteredPostFeedModels.empty())
+        return;
+
+    const auto evaluator = evaluateFilters(page.mFeed, 0, pageSize);
+
+    for (int i = 0; i < (int)mFilteredPostFeedModels.size(); ++i)
+        mFilteredPostFeedModels[i]->prependPosts(page.mFeed, pageSize, evaluator.getMatchedIndices(i));
 }
 
 void PostFeedModel::gapFillFilteredPostModels(const Page& page, int pageSize, int gapId)
 {
-    for (auto& model : mFilteredPostFeedModels)
-        model->gapFill(page.mFeed, pageSize, gapId);
+    if (mFilteredPostFeedModels.empty())
+        return;
+
+    const auto evaluator = evaluateFilters(page.mFeed, 0, pageSize);
+
+    for (int i = 0; i < (int)mFilteredPostFeedModels.size(); ++i)
+        mFilteredPostFeedModels[i]->gapFill(page.mFeed, pageSize, gapId, evaluator.getMatchedIndices(i));
 }
 
 void PostFeedModel::removeHeadFromFilteredPostModels(size_t headSize)
 {
-    for (auto& model : mFilteredPostFeedModels)
-        model->removeHeadPosts(mFeed, headSize);
+    if (mFilteredPostFeedModels.empty())
+        return;
+
+    const auto evaluator = evaluateFilters(mFeed, 0, headSize);
+
+    for (int i = 0; i < (int)mFilteredPostFeedModels.size(); ++i)
+        mFilteredPostFeedModels[i]->removeHeadPosts(mFeed, headSize, evaluator.getMatchedIndices(i));
 }
 
 void PostFeedModel::removeTailFromFilteredPostModels(size_t tailSize)
 {
-    for (auto& model : mFilteredPostFeedModels)
-    {
-        model->removeTailPosts(mFeed, tailSize);
-    }
+    if (mFilteredPostFeedModels.empty())
+        return;
+
+    const auto evaluator = evaluateFilters(mFeed, mFeed.size() - tailSize, tailSize);
+
+    for (int i = 0; i < (int)mFilteredPostFeedModels.size(); ++i)
+        mFilteredPostFeedModels[i]->removeTailPosts(mFeed, tailSize, evaluator.getMatchedIndices(i));
 }
 
 void PostFeedModel::clearFilteredPostModels()
@@ -1071,7 +1107,11 @@ std::pair<QEnums::HideReasonType, ContentFilterStats::Details> PostFeedModel::mu
     if (!passLanguageFilter(post))
     {
         auto& languages = post.getLanguages();
-        const QString lang = languages.empty() ? tr("no language") : languages.first().getShortCode();
+        QString lang = languages.empty() ? post.getIdentifiedLanguage() : languages.first().getShortCode();
+
+        if (lang.isEmpty())
+            lang = tr("no language");
+
         return { QEnums::HIDE_REASON_LANGUAGE, lang };
     }
 
@@ -1090,6 +1130,21 @@ bool PostFeedModel::passLanguageFilter(const Post& post) const
         if (mUserSettings.getShowUnknownContentLanguage(mUserDid))
             return true;
 
+        // The language identified from the text can only let a post through.
+        // Otherwise the post has an unknown language.
+        const QStringList sortedContentLangs = mUserSettings.getContentLanguages(mUserDid);
+
+        if (!sortedContentLangs.empty())
+        {
+            const QString& identifiedLang = post.getIdentifiedLanguage();
+
+            if (!identifiedLang.isEmpty() &&
+                std::binary_search(sortedContentLangs.cbegin(), sortedContentLangs.cend(), identifiedLang))
+            {
+                return true;
+            }
+        }
+
         qDebug() << "Unknown language:" << post.getText();
         return false;
     }
@@ -1342,7 +1397,7 @@ PostFeedModel::Page::Ptr PostFeedModel::createPage(ATProto::AppBskyFeed::OutputF
 
             if (auto reason = mustHideContent(post); reason.first != QEnums::HIDE_REASON_NONE)
             {
-                mContentFilterStats.report(post, reason.first, reason.second);
+                mContentFilterStats.report(std::move(post), reason.first, reason.second);
                 continue;
             }
 
@@ -1370,11 +1425,10 @@ PostFeedModel::Page::Ptr PostFeedModel::createPage(ATProto::AppBskyFeed::OutputF
 
                 if (auto reason = mustHideReply(post, replyRef); reason != QEnums::HIDE_REASON_NONE)
                 {
-                    mContentFilterStats.report(post, reason, nullptr);
-
                     // Preprocess replies when they are not shown. Those can help
                     // identify threads.
                     preprocess(post);
+                    mContentFilterStats.report(std::move(post), reason, nullptr);
                     continue;
                 }
 
@@ -1436,7 +1490,7 @@ PostFeedModel::Page::Ptr PostFeedModel::createPage(ATProto::AppBskyFeed::OutputF
                 // The reference may be missing due to blocked posts.
                 if (auto reason = mustHideReply(post, {}); reason != QEnums::HIDE_REASON_NONE)
                 {
-                    mContentFilterStats.report(post, reason, nullptr);
+                    mContentFilterStats.report(std::move(post), reason, nullptr);
                     continue;
                 }
             }
@@ -1531,7 +1585,7 @@ PostFeedModel::Page::Ptr PostFeedModel::createPageQuoteChain(TimelineFeed&& feed
 }
 
 PostFeedModel::Page::Ptr PostFeedModel::createPageFilteredPosts(
-    const std::deque<Post>& posts, const ContentFilterStats::Details& hideDetails)
+    const ContentFilterStats::PostList& posts, const ContentFilterStats::Details& hideDetails)
 {
     auto page = std::make_unique<Page>();
 
@@ -1547,10 +1601,10 @@ PostFeedModel::Page::Ptr PostFeedModel::createPageFilteredPosts(
 
     for (const auto& post : posts)
     {
-        if (!mustHideFilteredPost(post, hideDetails))
+        if (!mustHideFilteredPost(*post, hideDetails))
         {
-            preprocess(post);
-            page->addPost(post);
+            preprocess(*post);
+            page->addPost(*post);
         }
     }
 
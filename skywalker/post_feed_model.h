@@ -8,6 +8,7 @@
 #include "generator_view.h"
 #include "interaction_sender.h"
 #include "post_filter.h"
+#include "post_filter_evaluator.h"
 #include <atproto/lib/user_preferences.h>
 #include <map>
 #include <unordered_map>
@@ -84,7 +85,7 @@ public:
     LanguageList getFilterdLanguages() const;
     bool showPostWithMissingLanguage() const;
 
-    void setFeed(const std::deque<Post>& filteredPosts,
+    void setFeed(const ContentFilterStats::PostList& filteredPosts,
                  const ContentFilterStats::PostHideInfoMap* postHideInfoMap,
                  ContentFilterStats::Details& hideDetails);
 
@@ -185,6 +186,7 @@ private:
     void insertPage(const TimelineFeed::iterator& feedInsertIt, const Page& page, int pageSize, int fillGapId = 0);
     void addPage(Page::Ptr page);
 
+    PostFilterEvaluator evaluateFilters(const TimelineFeed& posts, int startIndex, size_t numPosts) const;
     void addPageToFilteredPostModels(const Page& page, int pageSize);
     void prependPageToFilteredPostModels(const Page& page, int pageSize);
     void gapFillFilteredPostModels(const Page& page, int pageSize, int gapId);
@@ -213,7 +215,7 @@ private:
     Page::Ptr createPage(ATProto::AppBskyFeed::OutputFeed::SharedPtr&& feed);
     Page::Ptr createPage(ATProto::AppBskyFeed::GetQuotesOutput::SharedPtr&& feed);
     Page::Ptr createPageQuoteChain(TimelineFeed&& feed);
-    Page::Ptr createPageFilteredPosts(const std::deque<Post>& posts, const ContentFilterStats::Details& hideDetails);
+    Page::Ptr createPageFilteredPosts(const ContentFilterStats::PostList& posts, const ContentFilterStats::Details& hideDetails);
     bool mustHideFilteredPost(const Post& post, const ContentFilterStats::Details& hideDetails) const;
 
     // Returns gap id if insertion created a gap in the feed.
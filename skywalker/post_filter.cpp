@@ -2,6 +2,7 @@
 // License: GPLv3
 #include "post_filter.h"
 #include "author_cache.h"
+#include "post_filter_evaluator.h"
 
 namespace Skywalker {
 
@@ -29,6 +30,11 @@ IPostFilter::Ptr IPostFilter::fromJson(const QJsonObject& json, const UpdatedCb&
     return nullptr;
 }
 
+void IPostFilter::compile(PostFilterEvaluator& evaluator, int filterIndex) const
+{
+    evaluator.addGenericFilter(filterIndex, this);
+}
+
 HashtagPostFilter::HashtagPostFilter(const QString& hashtag)
 {
     if (hashtag.startsWith('#'))
@@ -55,6 +61,11 @@ bool HashtagPostFilter::match(const Post& post) const
     return mFocusHashtags.match(post).first;
 }
 
+void HashtagPostFilter::compile(PostFilterEvaluator& evaluator, int filterIndex) const
+{
+    evaluator.addHashtagFilter(filterIndex, mFocusHashtags.getNormalizedHashtags());
+}
+
 QJsonObject HashtagPostFilter::toJson() const
 {
     QJsonObject json;
@@ -162,6 +173,11 @@ bool FocusHashtagsPostFilter::match(const Post& post) const
     return mFocusHashtags.match(post).first;
 }
 
+void FocusHashtagsPostFilter::compile(PostFilterEvaluator& evaluator, int filterIndex) const
+{
+    evaluator.addHashtagFilter(filterIndex, mFocusHashtags.getNormalizedHashtags());
+}
+
 AuthorPostFilter::AuthorPostFilter(const BasicProfile& profile) :
     mProfile(profile)
 {
@@ -185,6 +201,11 @@ bool AuthorPostFilter::match(const Post& post) const
     return post.getAuthor().getDid() == mProfile.getDid();
 }
 
+void AuthorPostFilter::compile(PostFilterEvaluator& evaluator, int filterIndex) const
+{
+    evaluator.addAuthorFilter(filterIndex, mProfile.getDid());
+}
+
 QJsonObject AuthorPostFilter::toJson() const
 {
     QJsonObject json;
@@ -199,7 +220,7 @@ AuthorPostFilter::Ptr AuthorPostFilter::fromJson(const QJsonObject& json, const
 {
     const ATProto::XJsonObject xjson(json);
     const QString did = xjson.getRequiredString("did");
-    const auto* profile = AuthorCache::instance().get(did);
+    const auto profile = AuthorCache::instance().get(did);
 
     if (profile)
         return std::make_unique<AuthorPostFilter>(BasicProfile(*profile));
@@ -213,7 +234,7 @@ AuthorPostFilter::Ptr AuthorPostFilter::fromJson(const QJsonObject& json, const
             if (!presence)
                 return;
 
-            const auto* p = AuthorCache::instance().get(did);
+            const auto p = AuthorCache::instance().get(did);
 
             if (p)
             {
@@ -244,6 +265,11 @@ bool VideoPostFilter::match(const Post& post) const
     return post.hasVideo(true);
 }
 
+void VideoPostFilter::compile(PostFilterEvaluator& evaluator, int filterIndex) const
+{
+    evaluator.addVideoFilter(filterIndex);
+}
+
 QJsonObject VideoPostFilter::toJson() const
 {
     QJsonObject json;
@@ -271,6 +297,11 @@ bool MediaPostFilter::match(const Post& post) const
     return post.hasImages(true) || post.hasVideo(true);
 }
 
+void MediaPostFilter::compile(PostFilterEvaluator& evaluator, int filterIndex) const
+{
+    evaluator.addMediaFilter(filterIndex);
+}
+
 QJsonObject MediaPostFilter::toJson() const
 {
     QJsonObject json;
@@ -7,6 +7,8 @@
 
 namespace Skywalker {
 
+class PostFilterEvaluator;
+
 class IPostFilter
 {
 public:
@@ -23,6 +25,10 @@ public:
     virtual bool mustAddThread() const { return true; }
     virtual bool match(const Post& post) const = 0;
     virtual QJsonObject toJson() const = 0;
+
+    // Adds this filter to an evaluator that matches many filters in one pass.
+    // By default the evaluator calls match().
+    virtual void compile(PostFilterEvaluator& evaluator, int filterIndex) const;
 };
 
 class HashtagPostFilter : public IPostFilter
@@ -36,6 +42,7 @@ public:
     QString getName() const override;
     bool match(const Post& post) const override;
     QJsonObject toJson() const override;
+    void compile(PostFilterEvaluator& evaluator, int filterIndex) const override;
 
 private:
     const QString& getHashtag() const;
@@ -54,6 +61,7 @@ public:
     QColor getBackgroundColor() const override;
     bool match(const Post& post) const override;
     QJsonObject toJson() const override;
+    void compile(PostFilterEvaluator& evaluator, int filterIndex) const override;
 
 private:
     const FocusHashtagEntry* getFocusHashtagEntry() const;
@@ -73,6 +81,7 @@ public:
     BasicProfile getAuthor() const override;
     bool match(const Post& post) const override;
     QJsonObject toJson() const override;
+    void compile(PostFilterEvaluator& evaluator, int filterIndex) const override;
 
 private:
     BasicProfile mProfile;
@@ -90,6 +99,7 @@ public:
     bool mustAddThread() const override { return false; }
     bool match(const Post& post) const override;
     QJsonObject toJson() const override;
+    void compile(PostFilterEvaluator& evaluator, int filterIndex) const override;
 };
 
 class MediaPostFilter : public IPostFilter
@@ -104,6 +114,7 @@ public:
     bool mustAddThread() const override { return false; }
     bool match(const Post& post) const override;
     QJsonObject toJson() const override;
+    void compile(PostFilterEvaluator& evaluator, int filterIndex) const override;
 };
 
 }
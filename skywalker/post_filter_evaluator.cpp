@@ -0,0 +1,161 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "post_filter_evaluator.h"
+#include "post_filter.h"
+#include "search_utils.h"
+#include <bit>
+
+namespace Skywalker {
+
+static constexpr int MASK_WORD_BITS = 64;
+
+PostFilterEvaluator::PostFilterEvaluator(const std::vector<const IPostFilter*>& filters) :
+    mNumFilters(filters.size()),
+    mMaskWords((filters.size() + MASK_WORD_BITS - 1) / MASK_WORD_BITS),
+    mVideoMask(mMaskWords, 0),
+    mMediaMask(mMaskWords, 0),
+    mMatchedIndices(filters.size())
+{
+    for (int i = 0; i < mNumFilters; ++i)
+        filters[i]->compile(*this, i);
+}
+
+void PostFilterEvaluator::addGenericFilter(int filterIndex, const IPostFilter* filter)
+{
+    mGenericFilters.push_back({ filterIndex, filter });
+}
+
+void PostFilterEvaluator::addHashtagFilter(int filterIndex, const std::vector<QString>& normalizedHashtags)
+{
+    for (const auto& hashtag : normalizedHashtags)
+        setBit(getKeyMask(mHashtagMasks, hashtag), filterIndex);
+}
+
+void PostFilterEvaluator::addAuthorFilter(int filterIndex, const QString& did)
+{
+    setBit(getKeyMask(mAuthorMasks, did), filterIndex);
+}
+
+void PostFilterEvaluator::addVideoFilter(int filterIndex)
+{
+    setBit(mVideoMask, filterIndex);
+    mHasVideoFilter = true;
+}
+
+void PostFilterEvaluator::addMediaFilter(int filterIndex)
+{
+    setBit(mMediaMask, filterIndex);
+    mHasMediaFilter = true;
+}
+
+void PostFilterEvaluator::evaluate(const PostList& posts, int startIndex, size_t numPosts)
+{
+    Q_ASSERT(startIndex >= 0);
+    Q_ASSERT(startIndex + numPosts <= posts.size());
+
+    for (auto& indices : mMatchedIndices)
+        indices.clear();
+
+    if (mNumFilters == 0)
+        return;
+
+    Mask mask(mMaskWords);
+
+    for (int i = startIndex; i < startIndex + (int)numPosts; ++i)
+    {
+        const Post& post = posts[i];
+
+        if (post.isGap())
+        {
+            for (auto& indices : mMatchedIndices)
+                indices.push_back(i);
+
+            continue;
+        }
+
+        if (post.isPlaceHolder())
+            continue;
+
+        std::fill(mask.begin(), mask.end(), 0);
+
+        if (!mAuthorMasks.empty())
+        {
+            const auto it = mAuthorMasks.find(post.getAuthor().getDid());
+
+            if (it != mAuthorMasks.end())
+                orMask(mask, it->second);
+        }
+
+        if (!mHashtagMasks.empty())
+        {
+            for (const auto& tag : post.getAllTags())
+            {
+                const auto it = mHashtagMasks.find(SearchUtils::normalizeText(tag));
+
+                if (it != mHashtagMasks.end())
+                    orMask(mask, it->second);
+            }
+        }
+
+        if (mHasVideoFilter || mHasMediaFilter)
+        {
+            const bool hasVideo = post.hasVideo(true);
+
+            if (hasVideo)
+                orMask(mask, mVideoMask);
+
+            if (mHasMediaFilter && (hasVideo || post.hasImages(true)))
+                orMask(mask, mMediaMask);
+        }
+
+        for (const auto& [filterIndex, filter] : mGenericFilters)
+        {
+            if (filter->match(post))
+                setBit(mask, filterIndex);
+        }
+
+        addMatches(i, mask);
+    }
+}
+
+const std::vector<int>& PostFilterEvaluator::getMatchedIndices(int filterIndex) const
+{
+    Q_ASSERT(filterIndex >= 0 && filterIndex < mNumFilters);
+    return mMatchedIndices[filterIndex];
+}
+
+void PostFilterEvaluator::setBit(Mask& mask, int filterIndex) const
+{
+    Q_ASSERT(filterIndex >= 0 && filterIndex < mNumFilters);
+    mask[filterIndex / MASK_WORD_BITS] |= quint64(1) << (filterIndex % MASK_WORD_BITS);
+}
+
+void PostFilterEvaluator::orMask(Mask& mask, const Mask& other) const
+{
+    for (size_t i = 0; i < mMaskWords; ++i)
+        mask[i] |= other[i];
+}
+
+PostFilterEvaluator::Mask& PostFilterEvaluator::getKeyMask(std::unordered_map<QString, Mask>& masks, const QString& key) const
+{
+    auto it = masks.find(key);
+
+    if (it == masks.end())
+        it = masks.insert({ key, Mask(mMaskWords, 0) }).first;
+
+    return it->second;
+}
+
+void PostFilterEvaluator::addMatches(int postIndex, const Mask& mask)
+{
+    for (size_t word = 0; word < mMaskWords; ++word)
+    {
+        for (quint64 bits = mask[word]; bits != 0; bits &= bits - 1)
+        {
+            const int filterIndex = word * MASK_WORD_BITS + std::countr_zero(bits);
+            mMatchedIndices[filterIndex].push_back(postIndex);
+        }
+    }
+}
+
+}
@@ -0,0 +1,63 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include "post.h"
+#include <deque>
+#include <unordered_map>
+
+namespace Skywalker {
+
+class IPostFilter;
+
+// Matches a set of post filters against posts in a single pass. Each filter
+// compiles itself into lookup tables, e.g. a table of all hashtags of all
+// filters. Each post is then checked once, giving a bitmask with a bit per
+// filter. Filters that cannot be compiled are matched with IPostFilter::match.
+//
+// The result is a list of matching post indices per filter. Gaps are part of
+// every list as filtered feeds copy all gaps from the full feed.
+class PostFilterEvaluator
+{
+public:
+    using PostList = std::deque<Post>;
+
+    explicit PostFilterEvaluator(const std::vector<const IPostFilter*>& filters);
+
+    // Called by IPostFilter::compile
+    void addGenericFilter(int filterIndex, const IPostFilter* filter);
+    void addHashtagFilter(int filterIndex, const std::vector<QString>& normalizedHashtags);
+    void addAuthorFilter(int filterIndex, const QString& did);
+    void addVideoFilter(int filterIndex);
+    void addMediaFilter(int filterIndex);
+
+    // Matches all filters against posts[startIndex, startIndex + numPosts)
+    void evaluate(const PostList& posts, int startIndex, size_t numPosts);
+
+    int getNumFilters() const { return mNumFilters; }
+
+    // Indices in posts, of the last evaluation, matching the filter in ascending order.
+    const std::vector<int>& getMatchedIndices(int filterIndex) const;
+
+private:
+    using Mask = std::vector<quint64>;
+
+    void setBit(Mask& mask, int filterIndex) const;
+    void orMask(Mask& mask, const Mask& other) const;
+    Mask& getKeyMask(std::unordered_map<QString, Mask>& masks, const QString& key) const;
+    void addMatches(int postIndex, const Mask& mask);
+
+    int mNumFilters = 0;
+    size_t mMaskWords = 0;
+
+    std::unordered_map<QString, Mask> mHashtagMasks; // normalized hashtag -> filters
+    std::unordered_map<QString, Mask> mAuthorMasks; // did -> filters
+    Mask mVideoMask;
+    Mask mMediaMask;
+    bool mHasVideoFilter = false;
+    bool mHasMediaFilter = false;
+    std::vector<std::pair<int, const IPostFilter*>> mGenericFilters;
+
+    std::vector<std::vector<int>> mMatchedIndices; // per filter
+};
+
+}
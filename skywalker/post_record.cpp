@@ -86,7 +86,7 @@ BasicProfile PostRecord::getReplyToAuthor() const
     if (did.isEmpty())
         return {};
 
-    auto* author = AuthorCache::instance().get(did);
+    const auto author = AuthorCache::instance().get(did);
 
     if (!author)
         return {};
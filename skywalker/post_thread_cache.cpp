@@ -7,7 +7,8 @@ namespace Skywalker {
 std::unique_ptr<PostThreadCache> PostThreadCache::sInstance;
 
 PostThreadCache::PostThreadCache(QObject* parent) :
-    WrappedSkywalker(parent)
+    WrappedSkywalker(parent),
+    mCache("PostThreadCache", 0, [](const QString& uri, bool){ return CacheCost::string(uri); }, BUDGET_WEIGHT)
 {
 }
 
@@ -25,8 +26,8 @@ void PostThreadCache::put(const QString& postUri, bool isThread)
     if (postUri.isEmpty())
         return;
 
-    mCache.insert(postUri, new bool(isThread));
-    qDebug() << "Cache size:" << mCache.size();
+    mCache.insert(postUri, isThread);
+    qDebug() << "Cache size:" << mCache.size() << "cost:" << mCache.getTotalCost();
 }
 
 void PostThreadCache::putPost(const QString& uri)
@@ -97,14 +98,19 @@ bool PostThreadCache::putThread(const ATProto::AppBskyFeed::ThreadElement::Share
     return true;
 }
 
-const bool* PostThreadCache::getIsThread(const QString& postUri) const
+std::optional<bool> PostThreadCache::getIsThread(const QString& postUri) const
 {
-    return mCache[postUri];
+    const auto isThread = mCache.get(postUri);
+
+    if (!isThread)
+        return {};
+
+    return *isThread;
 }
 
 bool PostThreadCache::contains(const QString& postUri) const
 {
-    return getIsThread(postUri) != nullptr;
+    return getIsThread(postUri).has_value();
 }
 
 }
@@ -1,9 +1,10 @@
 // Copyright (C) 2025 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "memory_cache.h"
 #include "wrapped_skywalker.h"
 #include <atproto/lib/lexicon/app_bsky_feed.h>
-#include <QCache>
+#include <optional>
 
 namespace Skywalker {
 
@@ -13,11 +14,13 @@ class PostThreadCache : public WrappedSkywalker
     Q_OBJECT
 
 public:
+    static constexpr int BUDGET_WEIGHT = 5;
+
     static PostThreadCache& instance();
 
     void put(const QString& postUri, bool isThread);
     void putPost(const QString& uri);
-    const bool* getIsThread(const QString& postUri) const;
+    std::optional<bool> getIsThread(const QString& postUri) const;
     bool contains(const QString& postUri) const;
 
 signals:
@@ -27,7 +30,7 @@ private:
     explicit PostThreadCache(QObject* parent = nullptr);
     bool putThread(const ATProto::AppBskyFeed::ThreadElement::SharedPtr& thread);
 
-    QCache<QString, bool> mCache{1000}; // post-uri -> isThread
+    MemoryCache<QString, bool> mCache; // post-uri -> isThread
     std::unordered_set<QString> mFetchingUris;
     std::unordered_set<QString> mFailedUris;
 
@@ -1,6 +1,7 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #include "post_utils.h"
+#include "dag_cbor.h"
 #include "file_utils.h"
 #include "jni_callback.h"
 #include "language_utils.h"
@@ -8,13 +9,19 @@
 #include "shared_image_provider.h"
 #include "skywalker.h"
 #include "temp_file_holder.h"
+#include "tid.h"
 #include <atproto/lib/rich_text_master.h>
 #include <QImageReader>
 #include <QMimeDatabase>
 #include <QMimeType>
+#include <QTimer>
+#include <algorithm>
 
 namespace Skywalker {
 
+static constexpr char const* COLLECTION_FEED_THREADGATE = "app.bsky.feed.threadgate";
+static constexpr char const* COLLECTION_FEED_POSTGATE = "app.bsky.feed.postgate";
+
 PostUtils::PostUtils(QObject* parent) :
     WrappedSkywalker(parent),
     Presence(),
@@ -46,6 +53,12 @@ PostUtils::PostUtils(QObject* parent) :
     });
 }
 
+PostUtils::~PostUtils()
+{
+    if (mImageUploadPipeline)
+        mImageUploadPipeline->cancel();
+}
+
 PostFeedContext PostUtils::makePostFeedContext(
     const QString& replyFeedDid, const QString& replyFeedContext,
     const QString& quoteFeedDid, const QString& quoteFeedContext)
@@ -72,8 +85,18 @@ ATProto::PostMaster* PostUtils::postMaster()
 ImageReader* PostUtils::imageReader()
 {
     if (!mImageReader)
+    {
         mImageReader = std::make_unique<ImageReader>(mNetwork, this);
 
+        // Saved and shared avatars come from the store the offline message
+        // checker uses.
+        if (mSkywalker)
+        {
+            const QString settingsFileName = mSkywalker->getUserSettings()->getFileName();
+            mImageReader->setAvatarStore(AvatarStore::getShared(AvatarStore::getStorePath(settingsFileName)));
+        }
+    }
+
     return mImageReader.get();
 }
 
@@ -290,6 +313,12 @@ void PostUtils::addThreadgate(const QString& uri, const QString& cid, bool allow
 {
     qDebug() << "Add threadgate uri:" << uri << "mention:" << allowMention << "follower:" << allowFollower << "following:" << allowFollowing << "nobody:" << allowNobody << "hiddenReplies:" << hiddenReplies.size();
 
+    if (isInThreadBatch(uri))
+    {
+        addThreadgateToThreadBatch(uri, cid, allowMention, allowFollower, allowFollowing, allowList, allowNobody, hiddenReplies);
+        return;
+    }
+
     if (!postMaster())
         return;
 
@@ -326,6 +355,12 @@ void PostUtils::addPostgate(const QString& uri, bool disableEmbedding, const QSt
 {
     qDebug() << "Add postgate uri:" << uri << "disableEmbedding:" << disableEmbedding;
 
+    if (isInThreadBatch(uri))
+    {
+        addPostgateToThreadBatch(uri, disableEmbedding, detachedEmbeddingUris);
+        return;
+    }
+
     if (!postMaster())
         return;
 
@@ -576,46 +611,65 @@ void PostUtils::continuePost(const PostAttachment& attachment, ATProto::AppBskyF
 }
 
 void PostUtils::continuePost(const PostAttachmentImages& images, ATProto::AppBskyFeed::Record::Post::SharedPtr post,
-                             const PostFeedContext& postFeedContext, int imgIndex)
+                             const PostFeedContext& postFeedContext)
 {
-    if (imgIndex >= images.mFileNames.size())
+    if (images.mFileNames.empty())
     {
         continuePost(post, postFeedContext);
         return;
     }
 
-    emit postProgress(tr("Uploading image #%1").arg(imgIndex + 1));
+    // The images are loaded by the pipeline workers.
+    std::vector<ImageUploadPipeline::Image> pipelineImages;
+    pipelineImages.reserve(images.mFileNames.size());
 
-    const auto& fileName = images.mFileNames[imgIndex];
-    QByteArray blob;
-    const auto [mimeType, imgSize] = PhotoPicker::createBlob(blob, fileName);
+    for (const auto& fileName : images.mFileNames)
+        pipelineImages.push_back({ {}, fileName });
 
-    if (blob.isEmpty())
-    {
-        emit postFailed(tr("Could not load image #%1").arg(imgIndex + 1));
-        return;
-    }
+    const int imgCount = images.mFileNames.size();
+    emit postProgress(tr("Uploading images: %1/%2").arg(0).arg(imgCount));
 
-    if (!bskyClient())
-        return;
+    if (mImageUploadPipeline)
+        mImageUploadPipeline->cancel();
 
-    bskyClient()->uploadBlob(blob, mimeType,
-        [this, presence=getPresence(), imgSize, images, post, postFeedContext, imgIndex](auto blob){
+    mImageUploadPipeline = ImageUploadPipeline::create(makeBlobUploader());
+    mImageUploadPipeline->setProgressCb(
+        [this, presence=getPresence()](int uploaded, int total){
+            if (!presence)
+                return;
+
+            emit postProgress(tr("Uploading images: %1/%2").arg(uploaded).arg(total));
+        });
+
+    mImageUploadPipeline->start(std::move(pipelineImages),
+        [this, presence=getPresence(), images, post, postFeedContext](auto uploadedImages){
             if (!presence)
                 return;
 
+            mImageUploadPipeline = nullptr;
+
             if (!postMaster())
                 return;
 
-            postMaster()->addImageToPost(*post, std::move(blob), imgSize.width(), imgSize.height(), images.mAltTexts[imgIndex]);
-            continuePost(images, post, postFeedContext, imgIndex + 1);
+            for (int i = 0; i < (int)uploadedImages.size(); ++i)
+            {
+                auto& img = uploadedImages[i];
+                postMaster()->addImageToPost(*post, std::move(img.mBlob), img.mSize.width(), img.mSize.height(), images.mAltTexts[i]);
+            }
+
+            continuePost(post, postFeedContext);
         },
-        [this, presence=getPresence()](const QString& error, const QString& msg){
+        [this, presence=getPresence()](int imgIndex, const QString& error, const QString& msg){
             if (!presence)
                 return;
 
+            mImageUploadPipeline = nullptr;
             qDebug() << "Post failed:" << error << " - " << msg;
-            emit postFailed(msg);
+
+            if (error == ImageUploadPipeline::ERROR_ENCODE_FAILED)
+                emit postFailed(tr("Could not load image #%1").arg(imgIndex + 1));
+            else
+                emit postFailed(msg);
         });
 }
 
@@ -770,6 +824,12 @@ void PostUtils::continuePost(const PostAttachmentVideo& video, ATProto::AppBskyF
 void PostUtils::continuePost(ATProto::AppBskyFeed::Record::Post::SharedPtr post,
                              const PostFeedContext& postFeedContext)
 {
+    if (mThreadBatchActive)
+    {
+        addToThreadBatch(post, postFeedContext);
+        return;
+    }
+
     if (!postMaster())
         return;
 
@@ -780,74 +840,330 @@ void PostUtils::continuePost(ATProto::AppBskyFeed::Record::Post::SharedPtr post,
             if (!presence)
                 return;
 
-            if (post->mReply && post->mReply->mParent)
+            postCreated(post, postFeedContext);
+            emit postOk(uri, cid);
+        },
+        [this, presence=getPresence()](const QString& error, const QString& msg){
+            if (!presence)
+                return;
+
+            qDebug() << "Post failed:" << error << " - " << msg;
+            emit postFailed(msg);
+        });
+}
+
+void PostUtils::postCreated(ATProto::AppBskyFeed::Record::Post::SharedPtr post,
+                            const PostFeedContext& postFeedContext)
+{
+    if (post->mReply && post->mReply->mParent)
+    {
+        mSkywalker->makeLocalModelChange(
+            [post](LocalPostModelChanges* model){
+                model->updateReplyCountDelta(post->mReply->mParent->mCid, 1);
+            });
+
+        mSkywalker->addFeedInteraction(
+            postFeedContext.getReplyFeedDid(),
+            ATProto::AppBskyFeed::Interaction::EventType::InteractionReply,
+            post->mReply->mParent->mUri, postFeedContext.getReplyFeedContext());
+    }
+
+    if (post->mEmbed)
+    {
+        if (post->mEmbed->mType == ATProto::AppBskyEmbed::EmbedType::RECORD)
+        {
+            const auto& record = std::get<ATProto::AppBskyEmbed::Record::SharedPtr>(post->mEmbed->mEmbed);
+            Q_ASSERT(record);
+            Q_ASSERT(record->mRecord);
+
+            if (record && record->mRecord)
             {
                 mSkywalker->makeLocalModelChange(
-                    [post](LocalPostModelChanges* model){
-                        model->updateReplyCountDelta(post->mReply->mParent->mCid, 1);
+                    [record](LocalPostModelChanges* model){
+                        model->updateQuoteCountDelta(record->mRecord->mCid, 1);
                     });
 
                 mSkywalker->addFeedInteraction(
-                    postFeedContext.getReplyFeedDid(),
-                    ATProto::AppBskyFeed::Interaction::EventType::InteractionReply,
-                    post->mReply->mParent->mUri, postFeedContext.getReplyFeedContext());
+                    postFeedContext.getQuoteFeedDid(),
+                    ATProto::AppBskyFeed::Interaction::EventType::InteractionQuote,
+                    record->mRecord->mUri, postFeedContext.getQuoteFeedContext());
             }
+        }
+        else if (post->mEmbed->mType == ATProto::AppBskyEmbed::EmbedType::RECORD_WITH_MEDIA)
+        {
+            const auto& recordWithMedia = std::get<ATProto::AppBskyEmbed::RecordWithMedia::SharedPtr>(post->mEmbed->mEmbed);
+            Q_ASSERT(recordWithMedia);
+            Q_ASSERT(recordWithMedia->mRecord);
+            Q_ASSERT(recordWithMedia->mRecord->mRecord);
 
-            if (post->mEmbed)
+            if (recordWithMedia && recordWithMedia->mRecord && recordWithMedia->mRecord->mRecord)
             {
-                if (post->mEmbed->mType == ATProto::AppBskyEmbed::EmbedType::RECORD)
-                {
-                    const auto& record = std::get<ATProto::AppBskyEmbed::Record::SharedPtr>(post->mEmbed->mEmbed);
-                    Q_ASSERT(record);
-                    Q_ASSERT(record->mRecord);
-
-                    if (record && record->mRecord)
-                    {
-                        mSkywalker->makeLocalModelChange(
-                            [record](LocalPostModelChanges* model){
-                                model->updateQuoteCountDelta(record->mRecord->mCid, 1);
-                            });
-
-                        mSkywalker->addFeedInteraction(
-                            postFeedContext.getQuoteFeedDid(),
-                            ATProto::AppBskyFeed::Interaction::EventType::InteractionQuote,
-                            record->mRecord->mUri, postFeedContext.getQuoteFeedContext());
-                    }
-                }
-                else if (post->mEmbed->mType == ATProto::AppBskyEmbed::EmbedType::RECORD_WITH_MEDIA)
-                {
-                    const auto& recordWithMedia = std::get<ATProto::AppBskyEmbed::RecordWithMedia::SharedPtr>(post->mEmbed->mEmbed);
-                    Q_ASSERT(recordWithMedia);
-                    Q_ASSERT(recordWithMedia->mRecord);
-                    Q_ASSERT(recordWithMedia->mRecord->mRecord);
+                mSkywalker->makeLocalModelChange(
+                    [recordWithMedia](LocalPostModelChanges* model){
+                        model->updateQuoteCountDelta(recordWithMedia->mRecord->mRecord->mCid, 1);
+                    });
 
-                    if (recordWithMedia && recordWithMedia->mRecord && recordWithMedia->mRecord->mRecord)
-                    {
-                        mSkywalker->makeLocalModelChange(
-                            [recordWithMedia](LocalPostModelChanges* model){
-                                model->updateQuoteCountDelta(recordWithMedia->mRecord->mRecord->mCid, 1);
-                            });
-
-                        mSkywalker->addFeedInteraction(
-                            postFeedContext.getQuoteFeedDid(),
-                            ATProto::AppBskyFeed::Interaction::EventType::InteractionQuote,
-                            recordWithMedia->mRecord->mRecord->mUri,
-                            postFeedContext.getQuoteFeedContext());
-                    }
-                }
+                mSkywalker->addFeedInteraction(
+                    postFeedContext.getQuoteFeedDid(),
+                    ATProto::AppBskyFeed::Interaction::EventType::InteractionQuote,
+                    recordWithMedia->mRecord->mRecord->mUri,
+                    postFeedContext.getQuoteFeedContext());
             }
+        }
+    }
+}
 
-            emit postOk(uri, cid);
+void PostUtils::startThreadBatch()
+{
+    qDebug() << "Start thread batch";
+
+    if (mSkywalker->getUserSettings()->getThreadBatchDisabled())
+    {
+        qWarning() << "Thread batch disabled, post one by one";
+        return;
+    }
+
+    if (mThreadBatchActive)
+        qWarning() << "Thread batch already active, records:" << mThreadBatch.size();
+
+    mThreadBatchActive = true;
+    mThreadBatch.clear();
+}
+
+void PostUtils::cancelThreadBatch()
+{
+    qDebug() << "Cancel thread batch, records:" << mThreadBatch.size();
+    mThreadBatchActive = false;
+    mThreadBatch.clear();
+}
+
+bool PostUtils::isInThreadBatch(const QString& uri) const
+{
+    if (!mThreadBatchActive)
+        return false;
+
+    return std::any_of(mThreadBatch.begin(), mThreadBatch.end(),
+                       [&uri](const auto& record){ return record.mUri == uri; });
+}
+
+const PostUtils::ThreadBatchRecord& PostUtils::addRecordToThreadBatch(
+    const QString& collection, const QString& rkey, const QJsonObject& record, const std::function<void()>& committedCb)
+{
+    // The CID is computed the same way as the PDS does.
+    const QString cid = DagCbor::recordCid(record);
+    const QString uri = QString("at://%1/%2/%3").arg(mSkywalker->getUserDid(), collection, rkey);
+
+    auto write = std::make_shared<ATProto::ComATProtoRepo::ApplyWritesCreate>();
+    write->mCollection = collection;
+    write->mRKey = rkey;
+    write->mValue = record;
+
+    qDebug() << "Add to thread batch:" << uri << "cid:" << cid;
+    mThreadBatch.push_back({ uri, cid, write, committedCb });
+    return mThreadBatch.back();
+}
+
+void PostUtils::addToThreadBatch(ATProto::AppBskyFeed::Record::Post::SharedPtr post,
+                                 const PostFeedContext& postFeedContext)
+{
+    // The reply references of the next post can be set without a round trip to the PDS.
+    const auto& record = addRecordToThreadBatch(
+        ATProto::ATUri::COLLECTION_FEED_POST, Tid::next(), post->toJson(),
+        [this, post, postFeedContext]{ postCreated(post, postFeedContext); });
+
+    // Signal asynchronously like a network reply.
+    QTimer::singleShot(0, this, [this, presence=getPresence(), uri=record.mUri, cid=record.mCid]{
+        if (!presence)
+            return;
+
+        emit postOk(uri, cid);
+    });
+}
+
+void PostUtils::addThreadgateToThreadBatch(const QString& uri, const QString& cid, bool allowMention, bool allowFollower, bool allowFollowing,
+                                           const ListViewBasicList& allowList, bool allowNobody, const QStringList& hiddenReplies)
+{
+    QStringList allowListUris;
+
+    for (const auto& list : allowList)
+        allowListUris.push_back(list.getUri());
+
+    // A gate has the same record key as its post.
+    const ATProto::ATUri atUri(uri);
+    auto threadgate = ATProto::PostMaster::createThreadgate(
+        uri, allowMention, allowFollower, allowFollowing, allowListUris, allowNobody, hiddenReplies);
+    const auto& record = addRecordToThreadBatch(COLLECTION_FEED_THREADGATE, atUri.getRkey(), threadgate->toJson(),
+        [this, cid, threadgateUri=QString("at://%1/%2/%3").arg(mSkywalker->getUserDid(), COLLECTION_FEED_THREADGATE, atUri.getRkey()),
+         allowMention, allowFollower, allowFollowing, allowList, allowNobody, hiddenReplies]{
+            mSkywalker->makeLocalModelChange(
+                [cid, threadgateUri, allowMention, allowFollower, allowFollowing, allowList, allowNobody, hiddenReplies](LocalPostModelChanges* model){
+                    model->updateThreadgateUri(cid, threadgateUri);
+                    model->updateReplyRestriction(cid, Post::makeReplyRestriction(allowMention, allowFollower, allowFollowing, !allowList.empty(), allowNobody));
+                    model->updateReplyRestrictionLists(cid, allowList);
+                    model->updateHiddenReplies(cid, hiddenReplies);
+                });
+        });
+
+    qDebug() << "Threadgate added to thread batch:" << record.mUri;
+
+    QTimer::singleShot(0, this, [this, presence=getPresence()]{
+        if (presence)
+            emit threadgateOk();
+    });
+}
+
+void PostUtils::addPostgateToThreadBatch(const QString& uri, bool disableEmbedding, const QStringList& detachedEmbeddingUris)
+{
+    ATProto::AppBskyFeed::Postgate postgate;
+    postgate.mPost = uri;
+    postgate.mCreatedAt = QDateTime::currentDateTimeUtc();
+    postgate.mDisableEmbedding = disableEmbedding;
+    postgate.mDetachedEmbeddingUris = { detachedEmbeddingUris.begin(), detachedEmbeddingUris.end() };
+
+    // A gate has the same record key as its post.
+    const ATProto::ATUri atUri(uri);
+    const auto& record = addRecordToThreadBatch(COLLECTION_FEED_POSTGATE, atUri.getRkey(), postgate.toJson(), {});
+    qDebug() << "Postgate added to thread batch:" << record.mUri;
+
+    QTimer::singleShot(0, this, [this, presence=getPresence()]{
+        if (presence)
+            emit postgateOk();
+    });
+}
+
+void PostUtils::commitThreadBatch()
+{
+    if (!mThreadBatchActive)
+    {
+        qWarning() << "No thread batch active";
+        return;
+    }
+
+    qDebug() << "Commit thread batch, records:" << mThreadBatch.size();
+    mThreadBatchActive = false;
+    emit postProgress(tr("Posting thread"));
+    commitThreadBatch(0, {});
+}
+
+void PostUtils::commitThreadBatch(int startIndex, const QStringList& committedUris)
+{
+    if (startIndex >= (int)mThreadBatch.size())
+    {
+        for (const auto& record : mThreadBatch)
+        {
+            if (record.mCommittedCb)
+                record.mCommittedCb();
+        }
+
+        mThreadBatch.clear();
+        emit threadBatchOk();
+        return;
+    }
+
+    if (!bskyClient())
+        return;
+
+    // The writes are atomic per applyWrites call. The first call writes only the
+    // first post, such that the CID computation is verified before any reply
+    // refers to it. A thread longer than the max writes per call needs multiple
+    // calls.
+    const int maxWrites = startIndex == 0 ? 1 : MAX_WRITES_PER_APPLY;
+    const int endIndex = std::min(startIndex + maxWrites, (int)mThreadBatch.size());
+    ATProto::ComATProtoRepo::ApplyWritesList writes;
+    QStringList uris = committedUris;
+
+    for (int i = startIndex; i < endIndex; ++i)
+    {
+        writes.push_back(mThreadBatch[i].mWrite);
+        uris.push_back(mThreadBatch[i].mUri);
+    }
+
+    const QString& repo = mSkywalker->getUserDid();
+
+    bskyClient()->applyWrites(repo, writes, true,
+        [this, presence=getPresence(), startIndex, endIndex, uris]{
+            if (!presence)
+                return;
+
+            qDebug() << "Thread batch written:" << uris.size();
+            verifyThreadBatchCids(startIndex, endIndex, uris);
         },
-        [this, presence=getPresence()](const QString& error, const QString& msg){
+        [this, presence=getPresence(), committedUris](const QString& error, const QString& msg){
             if (!presence)
                 return;
 
-            qDebug() << "Post failed:" << error << " - " << msg;
-            emit postFailed(msg);
+            qWarning() << "Thread batch failed:" << error << "-" << msg;
+
+            // Roll back the part of the thread that got written, gates included.
+            if (!committedUris.empty())
+                batchDeletePosts(committedUris);
+
+            mThreadBatch.clear();
+            emit threadBatchFailed(msg);
         });
 }
 
+void PostUtils::verifyThreadBatchCids(int startIndex, int endIndex, const QStringList& committedUris)
+{
+    // The applyWrites reply does not give the CIDs of the created records, so
+    // check the written posts with the PDS. The next posts refer to them with the
+    // CIDs we computed. The next part is only written when all CIDs match.
+    std::vector<int> postIndexes;
+
+    for (int i = startIndex; i < endIndex; ++i)
+    {
+        if (mThreadBatch[i].mWrite->mCollection == ATProto::ATUri::COLLECTION_FEED_POST)
+            postIndexes.push_back(i);
+    }
+
+    if (postIndexes.empty() || !postMaster())
+    {
+        commitThreadBatch(endIndex, committedUris);
+        return;
+    }
+
+    auto pending = std::make_shared<int>(postIndexes.size());
+    auto failed = std::make_shared<bool>(false);
+
+    for (const int i : postIndexes)
+    {
+        const auto& record = mThreadBatch[i];
+
+        postMaster()->checkRecordExists(record.mUri, record.mCid,
+            [this, presence=getPresence(), pending, failed, endIndex, committedUris]{
+                if (!presence || *failed)
+                    return;
+
+                if (--*pending == 0)
+                    commitThreadBatch(endIndex, committedUris);
+            },
+            [this, presence=getPresence(), failed, uri=record.mUri, cid=record.mCid, committedUris](const QString& error, const QString& msg){
+                if (!presence || *failed)
+                    return;
+
+                *failed = true;
+                qWarning() << "Thread batch CID not verified:" << uri << "cid:" << cid << "error:" << error << "-" << msg;
+                const bool cidMismatch = ATProto::ATProtoErrorMsg::isRecordNotFound(error);
+                fallBackFromThreadBatch(committedUris, cidMismatch);
+            });
+    }
+}
+
+void PostUtils::fallBackFromThreadBatch(const QStringList& committedUris, bool cidMismatch)
+{
+    // The written part may have wrong reply references. Remove it and let the
+    // caller post the thread one post at a time.
+    if (cidMismatch)
+    {
+        qWarning() << "PDS computed other CIDs, disable thread batches";
+        mSkywalker->getUserSettings()->setThreadBatchDisabled(true);
+    }
+
+    batchDeletePosts(committedUris);
+    mThreadBatch.clear();
+    emit threadBatchFallback();
+}
+
 void PostUtils::repost(const QString& uri, const QString& cid,
                        const QString& viaUri, const QString& viaCid,
                        const QString& feedDid, const QString& feedContext)
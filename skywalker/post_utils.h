@@ -3,6 +3,7 @@
 #pragma once
 #include "generator_view.h"
 #include "image_reader.h"
+#include "image_upload_pipeline.h"
 #include "link_card.h"
 #include "list_view.h"
 #include "post_attachment.h"
@@ -32,6 +33,7 @@ public:
     static constexpr int MAX_POST_GRAPHEMES = ATProto::AppBskyFeed::Record::Post::MAX_TEXT_GRAPHEMES;
 
     explicit PostUtils(QObject* parent = nullptr);
+    ~PostUtils();
 
     Q_INVOKABLE static PostFeedContext makePostFeedContext(
         const QString& replyFeedDid = {}, const QString& replyFeedContext = {},
@@ -84,6 +86,19 @@ public:
     Q_INVOKABLE void unmuteThread(const QString& uri);
     Q_INVOKABLE void deletePost(const QString& postUri, const QString& cid);
     Q_INVOKABLE void batchDeletePosts(const QStringList& postUris);
+
+    // In thread batch mode, posts get a client-side record key and CID, such that
+    // the next post in the thread can reply without waiting for the PDS. Thread
+    // and post gates for posts in the batch are added to the batch too. postOk,
+    // threadgateOk and postgateOk are signalled when a record is added to the
+    // batch. commitThreadBatch writes all records with applyWrites and signals
+    // threadBatchOk when they are written. If the PDS does not confirm the
+    // computed CIDs, the written records are deleted and threadBatchFallback is
+    // signalled. The caller must then post the thread one post at a time.
+    Q_INVOKABLE void startThreadBatch();
+    Q_INVOKABLE void commitThreadBatch();
+    Q_INVOKABLE void cancelThreadBatch();
+    Q_INVOKABLE bool isThreadBatchActive() const { return mThreadBatchActive; }
     Q_INVOKABLE bool pickPhoto(bool pickVideo, int maxItems);
     Q_INVOKABLE void savePhoto(const QString& sourceUrl);
     Q_INVOKABLE void sharePhotoToApp(const QString& sourceUrl);
@@ -113,6 +128,9 @@ signals:
     void canQuotePostFailed(QString uri, QString error);
     void postOk(QString uri, QString cid);
     void postFailed(QString error);
+    void threadBatchOk();
+    void threadBatchFailed(QString error);
+    void threadBatchFallback();
     void threadgateOk();
     void threadgateFailed(QString error);
     void undoThreadgateOk();
@@ -169,7 +187,7 @@ private:
     void continuePost(const PostAttachment& attachment, ATProto::AppBskyFeed::Record::Post::SharedPtr post,
                       const PostFeedContext& postFeedContext);
     void continuePost(const PostAttachmentImages& images, ATProto::AppBskyFeed::Record::Post::SharedPtr post,
-                      const PostFeedContext& postFeedContext, int imgIndex = 0);
+                      const PostFeedContext& postFeedContext);
     void continuePost(const PostAttachmentLinkCard& card, ATProto::AppBskyFeed::Record::Post::SharedPtr post,
                       const PostFeedContext& postFeedContext);
     void continuePost(const PostAttachmentLinkCard& card, QImage thumb, ATProto::AppBskyFeed::Record::Post::SharedPtr post,
@@ -177,6 +195,17 @@ private:
     void continuePost(const PostAttachmentVideo& video, ATProto::AppBskyFeed::Record::Post::SharedPtr post,
                       const PostFeedContext& postFeedContext);
     void continuePost(ATProto::AppBskyFeed::Record::Post::SharedPtr post, const PostFeedContext& postFeedContext);
+    void postCreated(ATProto::AppBskyFeed::Record::Post::SharedPtr post, const PostFeedContext& postFeedContext);
+    void addToThreadBatch(ATProto::AppBskyFeed::Record::Post::SharedPtr post, const PostFeedContext& postFeedContext);
+    bool isInThreadBatch(const QString& uri) const;
+    const ThreadBatchRecord& addRecordToThreadBatch(const QString& collection, const QString& rkey,
+                                                    const QJsonObject& record, const std::function<void()>& committedCb);
+    void addThreadgateToThreadBatch(const QString& uri, const QString& cid, bool allowMention, bool allowFollower, bool allowFollowing,
+                                    const ListViewBasicList& allowList, bool allowNobody, const QStringList& hiddenReplies);
+    void addPostgateToThreadBatch(const QString& uri, bool disableEmbedding, const QStringList& detachedEmbeddingUris);
+    void commitThreadBatch(int startIndex, const QStringList& committedUris);
+    void verifyThreadBatchCids(int startIndex, int endIndex, const QStringList& committedUris);
+    void fallBackFromThreadBatch(const QStringList& committedUris, bool cidMismatch);
 
     void continueRepost(const QString& uri, const QString& cid,
                         const QString& viaUri = {}, const QString& viaCid = {},
@@ -199,6 +228,19 @@ private:
     QNetworkAccessManager* mNetwork;
     std::unique_ptr<ATProto::PostMaster> mPostMaster;
     std::unique_ptr<ImageReader> mImageReader;
+    ImageUploadPipeline::SharedPtr mImageUploadPipeline;
+
+    struct ThreadBatchRecord
+    {
+        QString mUri;
+        QString mCid;
+        ATProto::ComATProtoRepo::ApplyWritesCreate::SharedPtr mWrite;
+        std::function<void()> mCommittedCb; // local model changes once written
+    };
+
+    static constexpr int MAX_WRITES_PER_APPLY = 200;
+    bool mThreadBatchActive = false;
+    std::vector<ThreadBatchRecord> mThreadBatch;
     bool mPickingPhoto = false;
     std::unique_ptr<LanguageUtils> mLanguageUtils;
     std::unordered_map<int, int> mIndexLanguageIdentificationRequestIdMap;
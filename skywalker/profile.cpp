@@ -505,6 +505,28 @@ void BasicProfile::setViewer(const QString& followingUri)
     mPrivate->mViewer = ProfileViewerState{viewerState};
 }
 
+BasicProfile BasicProfile::withViewer(const ProfileViewerState& viewer) const
+{
+    BasicProfile profile(*this);
+    profile.mPrivate = mPrivate ? std::make_shared<PrivateData>(*mPrivate) : std::make_shared<PrivateData>();
+    profile.mPrivate->mViewer = viewer;
+    return profile;
+}
+
+qsizetype BasicProfile::getWithViewerCost() const
+{
+    const ProfileViewerState& viewer = getViewer();
+    qsizetype cost = sizeof(BasicProfile) + sizeof(PrivateData);
+
+    if (viewer.isValid())
+    {
+        cost += sizeof(ATProto::AppBskyActor::ViewerState) + CacheCost::string(viewer.getBlocking()) +
+                CacheCost::string(viewer.getFollowing()) + CacheCost::string(viewer.getFollowedBy());
+    }
+
+    return cost;
+}
+
 ProfileViewerState& BasicProfile::getViewer()
 {
     if (mPrivate)
@@ -890,7 +912,7 @@ BasicProfile BlockedAuthor::getAuthor() const
     if (did.isEmpty())
         return {};
 
-    auto* profile = AuthorCache::instance().get(did);
+    const auto profile = AuthorCache::instance().get(did);
     return profile ? *profile : BasicProfile();
 }
 
@@ -941,7 +963,7 @@ ListViewBasic BlockedAuthor::getBlockingByList() const
     if (uri.getCollection() != ATProto::ATUri::COLLECTION_GRAPH_LIST)
         return {};
 
-    auto* list = ListCache::instance().get(*mBlockedAuthor->mViewer->mBlocking);
+    const auto list = ListCache::instance().get(*mBlockedAuthor->mViewer->mBlocking);
     return list ? *list : ListViewBasic();
 }
 
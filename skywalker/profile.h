@@ -319,6 +319,14 @@ public:
 
     ATProto::AppBskyActor::ProfileViewBasic::SharedPtr getProfileBasicView() const;
 
+    // Returns a copy with the viewer state replaced. The copy has its own
+    // private data, the (implicitly shared) strings and views in it are shared
+    // with this profile.
+    BasicProfile withViewer(const ProfileViewerState& viewer) const;
+
+    // Bytes that a copy made by withViewer() adds to this profile.
+    qsizetype getWithViewerCost() const;
+
     // For testing only
     void setViewer(const QString& followingUri);
 
@@ -45,6 +45,7 @@ public:
     void removeByListItemUri(const QString& listItemUri);
     const QString* getListItemUri(const QString& did) const;
     const QString* getDidByListItemUri(const QString& listItemUri) const;
+    const std::unordered_map<QString, QString>& getListItemUriDidMap() const { return mListItemUriDidMap; }
 
     const QString& getListUri() const { return mListUri; }
     void setListUri(const QString& uri) { mListUri = uri; }
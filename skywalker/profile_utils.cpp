@@ -71,7 +71,7 @@ ImageReader* ProfileUtils::imageReader()
 
 void ProfileUtils::getBasicProfile(const QString& did)
 {
-    const auto* profile = AuthorCache::instance().get(did);
+    const auto profile = AuthorCache::instance().get(did);
 
     if (profile)
     {
@@ -172,6 +172,8 @@ SkyPage {
                                    replyRootPostUri, replyRootPostCid, 0, 1)
                 }
                 else {
+                    // Post the whole thread in one go when all parts are ready.
+                    postUtils.startThreadBatch()
                     sendThreadPosts(0, replyToPostUri, replyToPostCid,
                                     replyRootPostUri, replyRootPostCid)
                 }
@@ -1600,6 +1602,23 @@ SkyPage {
 
         onPostFailed: (error) => page.postFailed(error)
 
+        onThreadBatchOk: {
+            console.debug("Done posting thread")
+            postDone()
+        }
+
+        onThreadBatchFailed: (error) => {
+            // The posts in the batch have been rolled back already.
+            postedUris = []
+            page.postFailed(error)
+        }
+
+        onThreadBatchFallback: {
+            // The posts in the batch have been rolled back already.
+            console.debug("Thread batch not verified, post one by one")
+            page.resendThreadPosts()
+        }
+
         onThreadgateOk: {
             threadGateCreated = true
 
@@ -2046,8 +2065,14 @@ SkyPage {
         busyIndicator.running = false
         skywalker.showStatusMessage(error, QEnums.STATUS_LEVEL_ERROR)
 
-        // Delete posts already posted (in a thread, or on failed thread gate creation)
-        postUtils.batchDeletePosts(postedUris)
+        if (postUtils.isThreadBatchActive()) {
+            // Posts in a thread batch that is not yet committed do not exist.
+            postUtils.cancelThreadBatch()
+        }
+        else {
+            // Delete posts already posted (in a thread, or on failed thread gate creation)
+            postUtils.batchDeletePosts(postedUris)
+        }
 
         // Clear all state so user can try to post again
         sendingThreadPost = -1
@@ -2445,8 +2470,25 @@ SkyPage {
         languageUtils.addUsedPostLanguage(postItem.language)
     }
 
+    function resendThreadPosts() {
+        sendingThreadPost = -1
+        threadRootUri = ""
+        threadRootCid = ""
+        threadFirstPostUri = ""
+        threadFirstPostCid = ""
+        threadGateCreated = false
+        postedUris = []
+        sendThreadPosts(0, replyToPostUri, replyToPostCid, replyRootPostUri, replyRootPostCid)
+    }
+
     function sendThreadPosts(postIndex, parentUri, parentCid, rootUri, rootCid) {
         if (postIndex >= threadPosts.postList.length) {
+            if (postUtils.isThreadBatchActive()) {
+                console.debug("Commit thread batch")
+                postUtils.commitThreadBatch()
+                return
+            }
+
             console.debug("Done posting thread")
             postDone()
             return
@@ -368,8 +368,6 @@ ApplicationWindow {
 
         onPostThreadOk: (did, modelId, postEntryIndex) => viewPostThread(did, modelId, postEntryIndex)
 
-        onGetUserProfileOK: () => skywalker.getUserPreferences()
-
         onGetUserProfileFailed: (error) => {
             console.warn("FAILED TO LOAD USER PROFILE:", error)
             closeStartupStatus()
@@ -378,7 +376,15 @@ ApplicationWindow {
             signIn()
         }
 
-        onGetUserPreferencesOK: () => skywalker.dataMigration();
+        onStartUpStatus: (status) => setStartupStatus(status)
+
+        onStartUpFailed: (error) => {
+            console.warn("FAILED TO START UP:", error)
+            closeStartupStatus()
+            statusPopup.show(getUserDid(), error, QEnums.STATUS_LEVEL_ERROR)
+            signOutCurrentUser()
+            signIn()
+        }
 
         onDataMigrationStatus: (status) => setStartupStatus(status)
 
@@ -387,12 +393,6 @@ ApplicationWindow {
             let userSettings = skywalker.getUserSettings()
             const lastSignIn = userSettings.getLastSignInTimestamp(did)
             // inviteCodeStore.load(lastSignIn)
-            skywalker.loadMutedWords()
-            skywalker.loadHashtags()
-            skywalker.focusHashtags.load(skywalker.getUserDid(), skywalker.getUserSettings())
-            skywalker.chat.getAllConvos()
-            setStartupStatus(qsTr("Rewinding timeline"))
-            skywalker.syncTimeline()
             userSettings.updateLastSignInTimestamp(did)
         }
 
@@ -575,7 +575,7 @@ ApplicationWindow {
 
         function start() {
             setStartupStatus(qsTr("Loading user profile"))
-            skywalker.getUserProfileAndFollows()
+            skywalker.startUp()
         }
     }
 
@@ -1217,6 +1217,7 @@ ApplicationWindow {
     VideoUtils {
         id: videoUtils
 
+        onCopyVideoProgress: (progress) => skywalker.showStatusMessage(qsTr(`Saving video ${Math.round(progress * 100)}%`), QEnums.STATUS_LEVEL_INFO, 60)
         onCopyVideoOk: skywalker.showStatusMessage(qsTr("Video saved"), QEnums.STATUS_LEVEL_INFO)
         onCopyVideoFailed: (error) => skywalker.showStatusMessage(error, QEnums.STATUS_LEVEL_ERROR)
 
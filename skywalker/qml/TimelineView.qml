@@ -11,6 +11,8 @@ SkyListView {
     readonly property bool reverseFeed: skywalker.timelineModel.reverseFeed
     property int newLastVisibleIndex: -1
     property int newLastVisibleOffsetY: 0
+    property int movedFirstVisibleIndex: -1
+    property int movedLastVisibleIndex: -1
     property var userSettings: skywalker.getUserSettings()
     readonly property int visibleHeaderHeight: headerItem ? Math.max(headerItem.height - headerMargin - (contentY - headerItem.y), 0) : 0
     readonly property int favoritesY : getFavoritesY()
@@ -130,6 +132,13 @@ SkyListView {
         const lastVisibleIndex = getLastVisibleIndex()
         const remaining = model.reverseFeed ? firstVisibleIndex : count - lastVisibleIndex
 
+        // Only a new visible range changes the rows to prefetch.
+        if (!isView && (firstVisibleIndex !== movedFirstVisibleIndex || lastVisibleIndex !== movedLastVisibleIndex)) {
+            movedFirstVisibleIndex = firstVisibleIndex
+            movedLastVisibleIndex = lastVisibleIndex
+            skywalker.timelineMoved(firstVisibleIndex, lastVisibleIndex, verticalVelocity)
+        }
+
         if (remaining < skywalker.TIMELINE_NEXT_PAGE_THRESHOLD && !skywalker.getTimelineInProgress) {
             console.debug("Get next timeline page")
             //skywalker.getTimelineNextPage()
@@ -389,9 +389,9 @@ QEnums::TripleBool RecordView::isThread() const
     if (uri.isEmpty())
         return QEnums::TRIPLE_BOOL_NO;
 
-    const bool* postIsThread = PostThreadCache::instance().getIsThread(uri);
+    const auto postIsThread = PostThreadCache::instance().getIsThread(uri);
 
-    if (postIsThread == nullptr)
+    if (!postIsThread)
         return QEnums::TRIPLE_BOOL_UNKNOWN;
 
     return *postIsThread ? QEnums::TRIPLE_BOOL_YES : QEnums::TRIPLE_BOOL_NO;
@@ -436,7 +436,7 @@ BasicProfile RecordView::getReplyToAuthor() const
     if (did.isEmpty())
         return {};
 
-    auto* profile = AuthorCache::instance().get(did);
+    const auto profile = AuthorCache::instance().get(did);
     return profile ? *profile : BasicProfile();
 }
 
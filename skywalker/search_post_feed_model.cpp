@@ -210,7 +210,7 @@ SearchPostFeedModel::Page::Ptr SearchPostFeedModel::createPage(ATProto::AppBskyF
 
             if (auto reason = mustHideContent(post); reason.first != QEnums::HIDE_REASON_NONE)
             {
-                mContentFilterStats.report(post, reason.first, reason.second);
+                mContentFilterStats.report(std::move(post), reason.first, reason.second);
                 continue;
             }
 
@@ -1,6 +1,7 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #include "search_utils.h"
+#include "ascii_text.h"
 #include "author_cache.h"
 #include "skywalker.h"
 #include "utils.h"
@@ -44,6 +45,13 @@ std::vector<QString> SearchUtils::combineSingleCharsToWords(const std::vector<QS
 
 QString SearchUtils::normalizeText(const QString& text)
 {
+    // ASCII has no diacritics or compatibility characters, folding the case
+    // is all normalization there is.
+    QString lower;
+
+    if (AsciiText::toLower(text, lower))
+        return lower;
+
     return ATProto::RichTextMaster::normalizeText(text);
 }
 
@@ -74,6 +82,26 @@ std::vector<QString> SearchUtils::getNormalizedWords(const QString& text)
 }
 
 std::vector<QString> SearchUtils::getWords(const QString& text)
+{
+    if (text.isEmpty())
+        return {};
+
+    // Reused between calls to avoid allocations
+    thread_local std::vector<QStringView> wordViews;
+
+    if (!AsciiText::getWords(text, wordViews))
+        return getUnicodeWords(text);
+
+    std::vector<QString> words;
+    words.reserve(wordViews.size());
+
+    for (const auto word : wordViews)
+        words.push_back(word.toString());
+
+    return words;
+}
+
+std::vector<QString> SearchUtils::getUnicodeWords(const QString& text)
 {
     if (text.isEmpty())
         return {};
@@ -893,7 +921,7 @@ void SearchUtils::initLastSearchedProfiles(bool resolveDids)
 
     for (const auto& did : lastDids)
     {
-        auto* profile = AuthorCache::instance().get(did);
+        const auto profile = AuthorCache::instance().get(did);
 
         if (profile)
         {
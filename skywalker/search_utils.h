@@ -26,10 +26,15 @@ class SearchUtils : public WrappedSkywalker, public Presence
     QML_ELEMENT
 
 public:
+    // ASCII text takes a fast path. Other text is normalized by NFKD and
+    // removing diacritics.
     static QString normalizeText(const QString& text);
     static int normalizedCompare(const QString& lhs, const QString& rhs);
     static std::vector<QString> getNormalizedWords(const QString& text);
     static std::vector<QString> getWords(const QString& text);
+
+    // Word breaking by QTextBoundaryFinder for text without fast path.
+    static std::vector<QString> getUnicodeWords(const QString& text);
     static std::vector<QString> combineSingleCharsToWords(const std::vector<QString>& words);
 
     explicit SearchUtils(QObject* parent = nullptr);
@@ -0,0 +1,27 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "shared_network.h"
+#include <QCoreApplication>
+#include <QPointer>
+#include <QThread>
+
+namespace Skywalker {
+
+QNetworkAccessManager* SharedNetwork::get()
+{
+    static QPointer<QNetworkAccessManager> sNetwork;
+    Q_ASSERT(QCoreApplication::instance());
+    Q_ASSERT(QThread::currentThread() == QCoreApplication::instance()->thread());
+
+    if (!sNetwork)
+    {
+        qDebug() << "Create shared network";
+        sNetwork = new QNetworkAccessManager(QCoreApplication::instance());
+        sNetwork->setAutoDeleteReplies(true);
+        sNetwork->setTransferTimeout(TRANSFER_TIMEOUT_MS);
+    }
+
+    return sNetwork;
+}
+
+}
@@ -0,0 +1,21 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QNetworkAccessManager>
+
+namespace Skywalker {
+
+// Network access manager shared by all accounts. A QNetworkAccessManager keeps
+// a pool of connections per host. By sharing it, requests of different
+// accounts reuse warm (TLS) connections instead of setting up their own.
+//
+// The manager lives in the GUI thread and is owned by the application.
+class SharedNetwork
+{
+public:
+    static constexpr int TRANSFER_TIMEOUT_MS = 10000;
+
+    static QNetworkAccessManager* get();
+};
+
+}
@@ -10,11 +10,15 @@
 #include "font_downloader.h"
 #include "jni_callback.h"
 #include "list_cache.h"
+#include "network_utils.h"
 #include "offline_message_checker.h"
 #include "photo_picker.h"
 #include "post_thread_cache.h"
 #include "search_utils.h"
 #include "shared_image_provider.h"
+#include "shared_network.h"
+#include "startup_tracer.h"
+#include "task_graph.h"
 #include "temp_file_holder.h"
 #include "utils.h"
 #include <atproto/lib/at_uri.h>
@@ -31,10 +35,6 @@ namespace Skywalker {
 
 using namespace std::chrono_literals;
 
-// There is a trade off: short timeout is fast updating timeline, long timeout
-// allows for better reply thread construction as we receive more posts per update.
-static constexpr auto TIMELINE_UPDATE_INTERVAL = 91s;
-
 static constexpr int TIMELINE_ADD_PAGE_SIZE = 100;
 static constexpr int TIMELINE_GAP_FILL_SIZE = 100;
 static constexpr int TIMELINE_SYNC_PAGE_SIZE = 100;
@@ -46,10 +46,20 @@ static constexpr int AUTHOR_LIKES_ADD_PAGE_SIZE = 25;
 static constexpr int AUTHOR_LIST_ADD_PAGE_SIZE = 50;
 static constexpr int USER_HASHTAG_INDEX_SIZE = 100;
 static constexpr int SEEN_HASHTAG_INDEX_SIZE = 500;
+static constexpr char const* LIST_SNAPSHOTS_DIR = "lists";
+static constexpr char const* TIMELINE_HIDE_LISTS_DIR = "hide";
+static constexpr char const* CONTENT_FILTER_POLICY_LISTS_DIR = "policies";
+
+// The shared caches show the viewer state of the active user.
+static void setSharedCacheViewer(const QString& did)
+{
+    AuthorCache::instance().setViewer(did);
+    ListCache::instance().setViewer(did);
+}
 
 Skywalker::Skywalker(QObject* parent) :
     IFeedPager(parent),
-    mNetwork(new QNetworkAccessManager(this)),
+    mNetwork(SharedNetwork::get()),
     mFollowing(this),
     mFollowsActivityStore(mFollowing, this),
     mTimelineHide(this),
@@ -71,8 +81,6 @@ Skywalker::Skywalker(QObject* parent) :
                    mContentFilter, mMutedWords, *mFocusHashtags, mSeenHashtags,
                    mUserPreferences, mUserSettings, mFollowsActivityStore, mBsky, this)
 {
-    mNetwork->setAutoDeleteReplies(true);
-    mNetwork->setTransferTimeout(10000);
     mPlcDirectory = new ATProto::PlcDirectoryClient(mNetwork, ATProto::PlcDirectoryClient::PLC_DIRECTORY_HOST, this);
     mGraphUtils.setSkywalker(this);
     mTimelineHide.setSkywalker(this);
@@ -80,7 +88,7 @@ Skywalker::Skywalker(QObject* parent) :
     mTimelineModel.setIsHomeFeed(true);
 
     connect(mChat.get(), &Chat::settingsFailed, this, [this](QString error){ showStatusMessage(error, QEnums::STATUS_LEVEL_ERROR); });
-    connect(&mTimelineUpdateTimer, &QTimer::timeout, this, [this]{ updateTimeline(5, TIMELINE_PREPEND_PAGE_SIZE); });
+    connect(&mTimelineUpdateTimer, &QTimer::timeout, this, [this]{ probeTimelineHead(); });
 
     connect(&mSessionManager, &SessionManager::activeSessionExpired, this,
         [this](const QString& msg){
@@ -98,6 +106,28 @@ Skywalker::Skywalker(QObject* parent) :
     connect(&mContentFilterPolicies, &ListStore::listRemoved, this,
             [this](const QString& uri){ mUserSettings.removeContentLabelPrefList(mUserDid, uri); });
 
+    // A hide list is removed when it got deleted, e.g. when found missing on
+    // the refresh of its snapshot. Failing to load a list does not remove it.
+    connect(&mTimelineHide, &ListStore::listRemoved, this,
+            [this](const QString& uri){
+                QStringList listUris = mUserSettings.getHideLists(mUserDid);
+
+                if (listUris.removeOne(uri))
+                    mUserSettings.setHideLists(mUserDid, listUris);
+            });
+
+    // The author lists show the refreshed members. Posts already in the
+    // timeline are not filtered again, as when the user hides a list: the
+    // timeline filters posts when a page is added and has no pass to filter
+    // them again. Pages added after the refresh use the new members.
+    connect(&mTimelineHide, &ListStore::listRefreshed, this,
+            [this]{
+                makeLocalModelChange(
+                    [](LocalAuthorModelChanges* model){
+                        model->updateHideFromTimeline();
+                    });
+            });
+
     AuthorCache::instance().setSkywalker(this);
     ListCache::instance().setSkywalker(this);
     PostThreadCache::instance().setSkywalker(this);
@@ -137,7 +167,7 @@ Skywalker::Skywalker(QObject* parent) :
 
 Skywalker::Skywalker(const QString& did, ATProto::Client::SharedPtr bsky, QObject* parent) :
     IFeedPager(parent),
-    mNetwork(new QNetworkAccessManager(this)),
+    mNetwork(SharedNetwork::get()),
     mBsky(bsky),
     mUserDid(did),
     mIsActiveUser(false),
@@ -162,8 +192,6 @@ Skywalker::Skywalker(const QString& did, ATProto::Client::SharedPtr bsky, QObjec
                    mUserPreferences, mUserSettings, mFollowsActivityStore, mBsky, this)
 {
     Q_ASSERT(!mUserSettings.getUser(did).isNull());
-    mNetwork->setAutoDeleteReplies(true);
-    mNetwork->setTransferTimeout(10000);
     mPlcDirectory = new ATProto::PlcDirectoryClient(mNetwork, ATProto::PlcDirectoryClient::PLC_DIRECTORY_HOST, this);
     mGraphUtils.setSkywalker(this);
     mTimelineHide.setSkywalker(this);
@@ -175,10 +203,10 @@ Skywalker::Skywalker(const QString& did, ATProto::Client::SharedPtr bsky, QObjec
     connect(&mUserSettings, &UserSettings::serviceVideoDidChanged, this, &Skywalker::updateServiceVideoDid);
 
     // The author and post caches are global. When multiple sessions are used
-    // this will be mostly fine. The profiles and post content is good. Only
-    // labels may be different as different accounts may have different labeler
-    // subscriptions.
-    // If we want to change this, we need caches per skywalker instance.
+    // this will be mostly fine. The profiles and post content is good. The
+    // viewer state of profiles and lists is kept per account by the caches.
+    // Only labels may be different as different accounts may have different
+    // labeler subscriptions.
 }
 
 Skywalker::~Skywalker()
@@ -244,11 +272,13 @@ void Skywalker::login(const QString host, const QString user, QString password,
     auto xrpc = std::make_unique<Xrpc::Client>(host);
     xrpc->setUserAgent(Skywalker::getUserAgentString());
     mBsky = std::make_shared<ATProto::Client>(std::move(xrpc), this);
+    StartupTracer::beginPhase("login");
 
     mBsky->createSession(user, password, Utils::makeOptionalString(authFactorToken),
         [this, host, user, password, rememberPassword, setAdvancedSettings,
          serviceAppView, serviceChat, serviceVideoHost, serviceVideoDid]{
             qDebug() << "Login" << user << "succeeded";
+            StartupTracer::endPhase("login");
             const auto* session = mBsky->getSession();
             const QString& did = session->mDid;
             updateUser(did, host);
@@ -340,11 +370,14 @@ bool Skywalker::resumeAndRefreshSession()
 
     // User DID must be set before inserting sessions in the session manager
     mUserDid = session->mDid;
+    setSharedCacheViewer(mUserDid);
     mSessionManager.insertSession(session->mDid, mBsky.get());
+    StartupTracer::beginPhase("resumeSession");
 
     mSessionManager.resumeAndRefreshSession(mBsky.get(), *session, 0,
         [this]{
             qDebug() << "Session resumed";
+            StartupTracer::endPhase("resumeSession");
             startRefreshTimers();
             mSessionManager.resumeAndRefreshNonActiveUsers();
             emit resumeSessionOk();
@@ -371,6 +404,8 @@ void Skywalker::deleteSession()
     }
 
     const QString did = session->mDid;
+    AuthorCache::instance().removeViewer(did);
+    ListCache::instance().removeViewer(did);
 
     mBsky->deleteSession(
         [this, did]{
@@ -391,12 +426,14 @@ void Skywalker::switchUser(const QString& did)
     qDebug() << "Switch to user:" << did;
     mUserDid = did;
     mUserSettings.setActiveUserDid(did);
+    setSharedCacheViewer(did);
 }
 
 void Skywalker::startTimelineAutoUpdate()
 {
     qDebug() << "Start timeline auto update";
-    mTimelineUpdateTimer.start(TIMELINE_UPDATE_INTERVAL);
+    mTimelineUpdateScheduler.setMetered(!NetworkUtils::isUnmetered());
+    mTimelineUpdateTimer.start(mTimelineUpdateScheduler.getInterval());
 }
 
 void Skywalker::stopTimelineAutoUpdate()
@@ -405,20 +442,103 @@ void Skywalker::stopTimelineAutoUpdate()
     mTimelineUpdateTimer.stop();
 }
 
+void Skywalker::rescheduleTimelineAutoUpdate()
+{
+    if (!mTimelineUpdateTimer.isActive())
+        return;
+
+    mTimelineUpdateScheduler.setMetered(!NetworkUtils::isUnmetered());
+    const auto interval = mTimelineUpdateScheduler.getInterval();
+    const auto& stats = mTimelineUpdateScheduler.getStats();
+    qDebug() << "Next timeline update:" << interval << "probes:" << stats.mProbes
+             << "empty:" << stats.mEmptyProbes << "prepends:" << stats.mPrepends;
+    mTimelineUpdateTimer.start(interval);
+}
+
+static QString getFeedHeadKey(const ATProto::AppBskyFeed::OutputFeed& feed)
+{
+    if (feed.mFeed.empty())
+        return {};
+
+    // A repost of a post already in the timeline is a new timeline entry.
+    const Post post(feed.mFeed.front());
+    return post.isRepost() ? post.getReasonRepostUri() + post.getCid() : post.getCid();
+}
+
+void Skywalker::setTimelineHeadKey(const ATProto::AppBskyFeed::OutputFeed& feed)
+{
+    const QString headKey = getFeedHeadKey(feed);
+
+    if (!headKey.isEmpty())
+        mTimelineHeadKey = headKey;
+}
+
+void Skywalker::probeTimelineHead()
+{
+    Q_ASSERT(mBsky);
+
+    if (mGetTimelineInProgress)
+    {
+        qDebug() << "Get timeline still in progress";
+        return;
+    }
+
+    if (mTimelineHeadKey.isEmpty())
+    {
+        // Nothing to compare with, get a full page.
+        autoUpdateTimeline();
+        return;
+    }
+
+    // Fetch the newest post only. The prepend of a full page is only needed
+    // when this post is new.
+    mBsky->getTimeline(1, {},
+        [this](auto feed){
+            const QString headKey = getFeedHeadKey(*feed);
+            const bool newPosts = !headKey.isEmpty() && headKey != mTimelineHeadKey;
+            mTimelineUpdateScheduler.probeDone(newPosts);
+            qDebug() << "Timeline head probe, new posts:" << newPosts;
+
+            if (newPosts)
+            {
+                autoUpdateTimeline();
+            }
+            else
+            {
+                updatePostIndexedSecondsAgo();
+                rescheduleTimelineAutoUpdate();
+            }
+        },
+        [](const QString& error, const QString& msg){
+            qWarning() << "probeTimelineHead FAILED:" << error << " - " << msg;
+        });
+}
+
+void Skywalker::autoUpdateTimeline()
+{
+    const int oldRowCount = mTimelineModel.rowCount();
+
+    updateTimeline(5, TIMELINE_PREPEND_PAGE_SIZE,
+        [this, oldRowCount](bool){
+            mTimelineUpdateScheduler.prependDone(mTimelineModel.rowCount() - oldRowCount);
+            rescheduleTimelineAutoUpdate();
+        });
+}
+
 void Skywalker::startRefreshTimers()
 {
     qDebug() << "Refresh timers started";
 
     Q_ASSERT(mBsky);
     mSessionManager.startRefreshTimers();
-    mGraphUtils.startExpiryCheckTimer();
+    mGraphUtils.startExpiryCheck();
 }
 
 void Skywalker::stopRefreshTimers()
 {
     qDebug() << "Refresh timers stopped";
     mSessionManager.stopRefreshTimers();
-    mGraphUtils.stopExpiryCheckTimer();
+    mGraphUtils.stopExpiryCheck();
 }
 
 void Skywalker::initUserProfile()
@@ -441,7 +561,74 @@ void Skywalker::initUserProfile()
         });
 }
 
+TaskGraph* Skywalker::createStartupTasks()
+{
+    if (mStartupTasks)
+    {
+        mStartupTasks->cancel();
+        mStartupTasks->deleteLater();
+    }
+
+    mStartupTasks = new TaskGraph(this);
+    return mStartupTasks;
+}
+
+void Skywalker::startUp()
+{
+    Q_ASSERT(mBsky);
+    qDebug() << "Start up:" << mUserDid;
+    auto* tasks = createStartupTasks();
+    tasks->enableTracing({ "login", "resumeSession" });
+
+    tasks->addTask("getUserProfile", {},
+        [this](const auto& done, const auto& fail){ getUserProfile(done, fail); });
+
+    addPreferencesTasks(*tasks);
+
+    tasks->addTask("loadMutedWords", { "getUserPreferences" },
+        [this](const auto& done, const auto&){ loadMutedWords(); done(); });
+    tasks->addTask("loadHashtags", {},
+        [this](const auto& done, const auto&){ loadHashtags(); done(); });
+    tasks->addTask("loadFocusHashtags", {},
+        [this](const auto& done, const auto&){ mFocusHashtags->load(mUserDid, &mUserSettings); done(); });
+    tasks->addTask("dataMigration", { "getUserProfile", "getUserPreferences" },
+        [this](const auto& done, const auto&){ dataMigration(); done(); });
+    tasks->addTask("getAllConvos", { "dataMigration" },
+        [this](const auto& done, const auto&){
+            if (mChat)
+                mChat->getAllConvos();
+
+            done();
+        });
+
+    // The timeline needs the filter state and the focus hashtags only. It
+    // reports the sync result to the GUI itself.
+    tasks->addTask("syncTimeline", { "getUserPreferences", "loadMutedWords", "loadFocusHashtags",
+                                     "loadContentFilterPolicies", "loadMutedReposts", "loadTimelineHide" },
+        [this, tasks](const auto& done, const auto&){
+            connect(this, &Skywalker::timelineSyncOK, tasks, [done]{ done(); }, Qt::SingleShotConnection);
+            connect(this, &Skywalker::timelineSyncFailed, tasks, [done]{ done(); }, Qt::SingleShotConnection);
+            emit startUpStatus(tr("Rewinding timeline"));
+            syncTimeline();
+        });
+
+    tasks->run(
+        []{ qDebug() << "Startup tasks done"; },
+        [this](const char* task, const QString& error){
+            if (qstrcmp(task, "getUserProfile") == 0)
+                emit getUserProfileFailed(error);
+            else
+                emit startUpFailed(error);
+        });
+}
+
 void Skywalker::getUserProfileAndFollows()
+{
+    getUserProfile([]{},
+        [this](const QString& error){ emit getUserProfileFailed(error); });
+}
+
+void Skywalker::getUserProfile(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb)
 {
     Q_ASSERT(mBsky);
     const auto* session = mBsky->getSession();
@@ -449,12 +636,13 @@ void Skywalker::getUserProfileAndFollows()
     qDebug() << "Get user profile, handle:" << session->mHandle << "did:" << session->mDid;
 
     mBsky->getProfile(session->mDid,
-        [this](auto profile){
+        [this, doneCb](auto profile){
             signalGetUserProfileOk(profile);
+            doneCb();
         },
-        [this](const QString& error, const QString& msg){
+        [failCb](const QString& error, const QString& msg){
             qWarning() << error << " - " << msg;
-            emit getUserProfileFailed(msg);
+            failCb(msg);
         });
 }
 
@@ -474,24 +662,59 @@ void Skywalker::signalGetUserProfileOk(ATProto::AppBskyActor::ProfileViewDetaile
 }
 
 void Skywalker::getUserPreferences()
+{
+    auto* tasks = createStartupTasks();
+    addPreferencesTasks(*tasks);
+
+    tasks->run(
+        [this]{ emit getUserPreferencesOK(); },
+        [this](const char*, const QString& error){ emit getUserPreferencesFailed(error); });
+}
+
+void Skywalker::addPreferencesTasks(TaskGraph& tasks)
+{
+    tasks.addTask("getUserPreferences", {},
+        [this](const auto& done, const auto& fail){ getUserPreferences(done, fail); });
+    tasks.addTask("loadLabelSettings", { "getUserPreferences" },
+        [this](const auto& done, const auto& fail){ loadLabelSettings(done, fail); });
+
+    // The list policies refer to the content groups of the labelers.
+    tasks.addTask("loadContentFilterPolicies", { "loadLabelSettings" },
+        [this](const auto& done, const auto& fail){ loadContentFilterPolicies(done, fail); });
+
+    if (!mIsActiveUser)
+    {
+        qDebug() << "Do not load muted reposts and timeline hide lists for other users than the active user";
+        return;
+    }
+
+    // These lists only depend on the user settings.
+    tasks.addTask("loadMutedReposts", {},
+        [this](const auto& done, const auto& fail){ loadMutedReposts(done, fail); });
+    tasks.addTask("loadTimelineHide", {},
+        [this](const auto& done, const auto& fail){ loadTimelineHide(done, fail); });
+}
+
+void Skywalker::getUserPreferences(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb)
 {
     Q_ASSERT(mBsky);
     qDebug() << "Get user preferences:" << mUserDid;
 
     mBsky->getPreferences(
-        [this](auto prefs){
+        [this, doneCb](auto prefs){
             mUserPreferences = prefs;
             emit hideVerificationBadgesChanged();
             updateFavoriteFeeds();
             initLabelers();
-            loadLabelSettings();
 
             if (mChat)
                 mChat->initSettings();
+
+            doneCb();
         },
-        [this](const QString& error, const QString& msg){
+        [failCb](const QString& error, const QString& msg){
             qWarning() << error << " - " << msg;
-            emit getUserPreferencesFailed(msg);
+            failCb(msg);
         });
 }
 
@@ -593,112 +816,112 @@ void Skywalker::saveUserPreferences(const ATProto::UserPreferences& prefs, std::
         });
 }
 
-void Skywalker::loadTimelineHide()
+void Skywalker::loadTimelineHide(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb)
 {
     qDebug() << "Load timeline hide lists";
     const QStringList listUris = mUserSettings.getHideLists(mUserDid);
-    loadTimelineHide(listUris);
-}
-
-void Skywalker::loadTimelineHide(QStringList uris)
-{
-    Q_ASSERT(mBsky);
-    if (uris.empty())
-    {
-        loadContentFilterPolicies();
-        return;
-    }
+    mTimelineHide.setSnapshotPath(getListSnapshotPath(TIMELINE_HIDE_LISTS_DIR));
 
-    const QString uri = uris.back();
-    uris.pop_back();
+    loadLists(mTimelineHide, listUris,
+        [this](const QString& uri){
+            qDebug() << "Hide list not found:" << uri;
 
-    mTimelineHide.loadList(uri,
-        [this, uri, uris]{
-            qDebug() << "Loaded:" << uri;
-            loadTimelineHide(uris);
+            // The list is probbaly deleted through another interface. Remove from settings.
+            QStringList listUris = mUserSettings.getHideLists(mUserDid);
+            listUris.removeOne(uri);
+            mUserSettings.setHideLists(mUserDid, listUris);
         },
-        [this, uri, uris](const QString& error, const QString& msg){
-            if (ATProto::ATProtoErrorMsg::isListNotFound(error))
-            {
-                qDebug() << "Hide list not found:" << uri << error << " - " << msg;
-
-                // The list is probbaly deleted through another interface. Remove from settings.
-                QStringList listUris = mUserSettings.getHideLists(mUserDid);
-                listUris.removeOne(uri);
-                mUserSettings.setHideLists(mUserDid, listUris);
-
-                loadTimelineHide(uris);
-            }
-            else
-            {
-                qWarning() << "Failed:" << error << " - " << msg;
-                emit getUserPreferencesFailed(tr("Failed to load hide list %1 : %2").arg(uri, msg));
-            }
-        });
+        doneCb, failCb);
 }
 
-void Skywalker::loadContentFilterPolicies()
+void Skywalker::loadContentFilterPolicies(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb)
 {
     qDebug() << "Load content filter policy lists";
-    const QStringList listUris = mUserSettings.getContentLabelPrefListUris(mUserDid);
-    loadContentFilterPolicies(listUris);
+    QStringList listUris = mUserSettings.getContentLabelPrefListUris(mUserDid);
+
+    if (listUris.removeAll(FOLLOWING_LIST_URI) > 0)
+        qDebug() << "Skip following list";
+
+    mContentFilterPolicies.setSnapshotPath(getListSnapshotPath(CONTENT_FILTER_POLICY_LISTS_DIR));
+
+    loadLists(mContentFilterPolicies, listUris,
+        [this](const QString& uri){
+            qDebug() << "Content filter policy list not found:" << uri;
+
+            // The list is probbaly deleted through another interface. Remove from settings.
+            mUserSettings.removeContentLabelPrefList(mUserDid, uri);
+        },
+        [this, doneCb]{
+            qDebug() << "All lists for content filter policies loaded";
+            mContentFilter.initListPrefs();
+            doneCb();
+        },
+        failCb);
 }
 
-void Skywalker::loadContentFilterPolicies(QStringList uris)
+void Skywalker::loadLists(ListStore& listStore, const QStringList& uris, const std::function<void(const QString& uri)>& listNotFoundCb,
+                          const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb)
 {
     Q_ASSERT(mBsky);
+
     if (uris.empty())
     {
-        qDebug() << "All lists for content filter policies loaded";
-        mContentFilter.initListPrefs();
-        emit getUserPreferencesOK();
+        doneCb();
         return;
     }
 
-    const QString uri = uris.back();
-    uris.pop_back();
+    // All lists load at the same time. The list store limits the number of
+    // requests in flight. Lists with a snapshot are done right away.
+    auto remaining = std::make_shared<int>(uris.size());
+    auto failed = std::make_shared<bool>(false);
 
-    if (uri == FOLLOWING_LIST_URI)
+    const auto listDone = [remaining, failed, doneCb]{
+        if (--(*remaining) == 0 && !*failed)
+            doneCb();
+    };
+
+    for (const auto& uri : uris)
     {
-        qDebug() << "Skip following list";
-        loadContentFilterPolicies(uris);
-        return;
+        listStore.loadList(uri,
+            [uri, listDone]{
+                qDebug() << "Loaded:" << uri;
+                listDone();
+            },
+            [uri, listDone, failed, listNotFoundCb, failCb](const QString& error, const QString& msg){
+                if (ATProto::ATProtoErrorMsg::isListNotFound(error))
+                {
+                    qDebug() << "List not found:" << uri << error << " - " << msg;
+                    listNotFoundCb(uri);
+                    listDone();
+                    return;
+                }
+
+                qWarning() << "Failed:" << error << " - " << msg;
+
+                if (!*failed)
+                {
+                    *failed = true;
+                    failCb(tr("Failed to load list %1 : %2").arg(uri, msg));
+                }
+            });
     }
+}
 
-    mContentFilterPolicies.loadList(uri,
-        [this, uri, uris]{
-            qDebug() << "Loaded:" << uri;
-            loadContentFilterPolicies(uris);
-        },
-        [this, uri, uris](const QString& error, const QString& msg){
-            if (ATProto::ATProtoErrorMsg::isListNotFound(error))
-            {
-                qDebug() << "Content filter policy list not found:" << uri << error << " - " << msg;
+QString Skywalker::getListSnapshotPath(const QString& subDir) const
+{
+    const auto path = QString("%1/%2/%3").arg(mUserDid, LIST_SNAPSHOTS_DIR, subDir);
+    const QString snapshotPath = FileUtils::getAppDataPath(path);
 
-                // The list is probbaly deleted through another interface. Remove from settings.
-                mUserSettings.removeContentLabelPrefList(mUserDid, uri);
+    if (snapshotPath.isEmpty())
+        qWarning() << "Failed to get path:" << path;
 
-                loadContentFilterPolicies(uris);
-            }
-            else
-            {
-                qWarning() << "Failed:" << error << " - " << msg;
-                emit getUserPreferencesFailed(tr("Failed to load hide list %1 : %2").arg(uri, msg));
-            }
-        });
+    return snapshotPath;
 }
 
-void Skywalker::loadMutedReposts(int maxPages, const QString& cursor)
+void Skywalker::loadMutedReposts(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb, int maxPages, const QString& cursor)
 {
     Q_ASSERT(mBsky);
-
-    if (!mIsActiveUser)
-    {
-        qDebug() << "Do not load muted repost, not timelineHide lists for other users than the active user";
-        loadContentFilterPolicies();
-        return;
-    }
-
+    Q_ASSERT(mIsActiveUser);
     qDebug() << "Load muted reposts, maxPages:" << maxPages << "cursor:" << cursor;
 
     const QString uri = mUserSettings.getMutedRepostsListUri(mUserDid);
@@ -713,12 +936,12 @@ void Skywalker::loadMutedReposts(int maxPages, const QString& cursor)
         // Either their are too many muted reposts, or the cursor got in a loop.
         // We signal OK as there is no way out of this situation without starting
         // up the app.
-        loadTimelineHide();
+        doneCb();
         return;
     }
 
     mBsky->getList(uri, 100, Utils::makeOptionalString(cursor),
-        [this, maxPages](auto output){
+        [this, doneCb, failCb, maxPages](auto output){
             mMutedReposts.setListCreated(true);
 
             for (const auto& item : output->mItems)
@@ -728,22 +951,22 @@ void Skywalker::loadMutedReposts(int maxPages, const QString& cursor)
             }
 
             if (output->mCursor)
-                loadMutedReposts(maxPages - 1, *output->mCursor);
+                loadMutedReposts(doneCb, failCb, maxPages - 1, *output->mCursor);
             else
-                loadTimelineHide();
+                doneCb();
         },
-        [this](const QString& error, const QString& msg){
+        [this, doneCb, failCb](const QString& error, const QString& msg){
             mMutedReposts.setListCreated(false);
 
             if (ATProto::ATProtoErrorMsg::isListNotFound(error))
             {
                 qDebug() << "No muted reposts list:" << error << " - " << msg;
-                loadTimelineHide();
+                doneCb();
             }
             else
             {
                 qWarning() << "loadMutedReposts failed:" << error << " - " << msg;
-                emit getUserPreferencesFailed(tr("Failed to load muted reposts: %1").arg(msg));
+                failCb(tr("Failed to load muted reposts: %1").arg(msg));
             }
         });
 }
@@ -757,7 +980,7 @@ void Skywalker::initLabelers()
         emit mContentFilter.subscribedLabelersChanged();
 }
 
-void Skywalker::loadLabelSettings()
+void Skywalker::loadLabelSettings(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb)
 {
     Q_ASSERT(mBsky);
     qDebug() << "Load label settings";
@@ -770,12 +993,12 @@ void Skywalker::loadLabelSettings()
     if (dids.empty())
     {
         qDebug() << "No labelers";
-        loadMutedReposts();
+        doneCb();
         return;
     }
 
     mBsky->getServices(dids, true,
-        [this, labelerDids](auto output){
+        [this, labelerDids, doneCb, failCb](auto output){
             auto remainingDids = labelerDids;
             std::unordered_map<QString, BasicProfile> labelerProfiles;
 
@@ -784,7 +1007,7 @@ void Skywalker::loadLabelSettings()
                 if (v->mViewType != ATProto::AppBskyLabeler::GetServicesOutputView::ViewType::VIEW_DETAILED)
                 {
                     qWarning() << "Invalid view type:" << (int)v->mViewType;
-                    emit getUserPreferencesFailed(tr("Failed to get labelers: %1").arg("invalid view type"));
+                    failCb(tr("Failed to get labelers: %1").arg("invalid view type"));
                     return;
                 }
 
@@ -815,11 +1038,11 @@ void Skywalker::loadLabelSettings()
                 mContentFilter.saveAllNewLabelIdsToSettings();
             }
 
-            loadMutedReposts();
+            doneCb();
         },
-        [this](const QString& error, const QString& msg){
+        [failCb](const QString& error, const QString& msg){
             qWarning() << "initLabelSettings failed:" << error << " - " << msg;
-            emit getUserPreferencesFailed(tr("Failed to get labelers: %1").arg(error));
+            failCb(tr("Failed to get labelers: %1").arg(error));
         });
 }
 
@@ -1048,6 +1271,7 @@ void Skywalker::finishTimelineSync(int index)
     // This will show the timeline to the user.
     const int offsetY = mUserSettings.getSyncOffsetY(mUserDid);
     emit timelineSyncOK(index, offsetY);
+    StartupTracer::finishStartup();
     OffLineMessageChecker::checkNotificationPermission();
 
     // Now we can handle pending intent (content share).
@@ -1062,6 +1286,7 @@ void Skywalker::finishTimelineSyncFailed()
 {
     qWarning() << "Timeline sync failed";
     emit timelineSyncFailed();
+    StartupTracer::finishStartup();
     OffLineMessageChecker::checkNotificationPermission();
     JNICallbackListener::handlePendingIntent();
 }
@@ -1169,6 +1394,7 @@ void Skywalker::getTimeline(int limit, int maxPages, int minEntries, const QStri
 
             if (cursor.isEmpty())
             {
+                setTimelineHeadKey(*feed);
                 mTimelineModel.setFeed(std::move(feed));
                 addedPosts = mTimelineModel.rowCount();
             }
@@ -1214,6 +1440,7 @@ void Skywalker::getTimelinePrepend(int autoGapFill, int pageSize, const updateTi
 
     mBsky->getTimeline(pageSize, {},
         [this, autoGapFill, cb](auto feed){
+            setTimelineHeadKey(*feed);
             const int gapId = mTimelineModel.prependFeed(std::move(feed));
             setGetTimelineInProgress(false);
             setAutoUpdateTimelineInProgress(false);
@@ -1821,6 +2048,7 @@ void Skywalker::timelineMovementEnded(int firstVisibleIndex, int lastVisibleInde
         return;
 
     saveSyncTimestamp(lastVisibleIndex, lastVisibleOffsetY);
+    mMediaPrefetcher.prefetch(mTimelineModel, firstVisibleIndex, lastVisibleIndex, 0.0);
 
     const int maxTailSize = mTimelineModel.hasFilters() ? PostFeedModel::MAX_TIMELINE_SIZE * 0.6 : TIMELINE_DELETE_SIZE * 2;
     const int remainsSize = mTimelineModel.isReverseFeed() ? firstVisibleIndex : mTimelineModel.rowCount() - lastVisibleIndex;
@@ -1832,6 +2060,15 @@ void Skywalker::timelineMovementEnded(int firstVisibleIndex, int lastVisibleInde
         getTimelineNextPage();
 }
 
+// NOTE: indices can be -1 if the UI cannot determine the index
+void Skywalker::timelineMoved(int firstVisibleIndex, int lastVisibleIndex, double velocity)
+{
+    if (mSignOutInProgress)
+        return;
+
+    mMediaPrefetcher.prefetch(mTimelineModel, firstVisibleIndex, lastVisibleIndex, velocity);
+}
+
 void Skywalker::feedMovementEnded(int modelId, int lastVisibleIndex, int lastVisibleOffsetY)
 {
     auto* model = getPostFeedModel(modelId);
@@ -2090,7 +2327,46 @@ void Skywalker::refreshAllModels()
         model->refreshAllData();
 }
 
+void Skywalker::startLocalModelChangeBatch()
+{
+    if (mLocalModelChangeBatchActive)
+        return;
+
+    // All local changes made during this event loop turn are collected, such
+    // that each model signals each type of change only once.
+    mLocalModelChangeBatchActive = true;
+    applyLocalModelChange([](LocalProfileChanges* model){ model->beginLocalChangeBatch(); });
+    applyLocalModelChange([](LocalPostModelChanges* model){ model->beginLocalChangeBatch(); });
+    applyLocalModelChange([](LocalAuthorModelChanges* model){ model->beginLocalChangeBatch(); });
+    QTimer::singleShot(0, this, [this]{ endLocalModelChangeBatch(); });
+}
+
+void Skywalker::endLocalModelChangeBatch()
+{
+    if (!mLocalModelChangeBatchActive)
+        return;
+
+    // Models created during the batch did not start a batch. Ending a batch
+    // on those is a no-op.
+    mLocalModelChangeBatchActive = false;
+    applyLocalModelChange([](LocalProfileChanges* model){ model->endLocalChangeBatch(); });
+    applyLocalModelChange([](LocalPostModelChanges* model){ model->endLocalChangeBatch(); });
+    applyLocalModelChange([](LocalAuthorModelChanges* model){ model->endLocalChangeBatch(); });
+}
+
 void Skywalker::makeLocalModelChange(const std::function<void(LocalProfileChanges*)>& update)
+{
+    startLocalModelChangeBatch();
+    applyLocalModelChange(update);
+}
+
+void Skywalker::makeLocalModelChange(const std::function<void(LocalPostModelChanges*)>& update)
+{
+    startLocalModelChangeBatch();
+    applyLocalModelChange(update);
+}
+
+void Skywalker::applyLocalModelChange(const std::function<void(LocalProfileChanges*)>& update)
 {
     // Apply change to all active models. When a model gets refreshed (after clear)
     // or deleted, then the local changes will disapper.
@@ -2131,7 +2407,7 @@ void Skywalker::makeLocalModelChange(const std::function<void(LocalProfileChange
         update(model.get());
 }
 
-void Skywalker::makeLocalModelChange(const std::function<void(LocalPostModelChanges*)>& update)
+void Skywalker::applyLocalModelChange(const std::function<void(LocalPostModelChanges*)>& update)
 {
     // Apply change to all active models. When a model gets refreshed (after clear)
     // or deleted, then the local changes will disapper.
@@ -2167,6 +2443,12 @@ void Skywalker::makeLocalModelChange(const std::function<void(LocalPostModelChan
 }
 
 void Skywalker::makeLocalModelChange(const std::function<void(LocalAuthorModelChanges*)>& update)
+{
+    startLocalModelChangeBatch();
+    applyLocalModelChange(update);
+}
+
+void Skywalker::applyLocalModelChange(const std::function<void(LocalAuthorModelChanges*)>& update)
 {
     for (auto& [_, model] : mAuthorListModels.items())
         update(model.get());
@@ -4192,6 +4474,7 @@ void Skywalker::updateUser(const QString& did, const QString& host)
     mUserDid = did;
     mUserSettings.addUser(did, host);
     mUserSettings.setActiveUserDid(did);
+    setSharedCacheViewer(did);
 }
 
 std::optional<ATProto::ComATProtoServer::Session> Skywalker::getSavedSession() const
@@ -4323,8 +4606,12 @@ void Skywalker::handleAppStateChange(Qt::ApplicationState state)
         pauseApp();
         break;
     case Qt::ApplicationActive:
+        mTimelineUpdateScheduler.setAppActive(true);
         resumeApp();
         break;
+    case Qt::ApplicationInactive:
+        mTimelineUpdateScheduler.setAppActive(false);
+        break;
     default:
         break;
     };
@@ -4528,6 +4815,8 @@ void Skywalker::signOut()
     stopRefreshTimers();
     mSessionManager.clear();
     mTimelineUpdatePaused = {};
+    mTimelineUpdateScheduler.reset();
+    mTimelineHeadKey.clear();
     mPostThreadModels.clear();
     mAuthorFeedModels.clear();
     mSearchPostFeedModels.clear();
@@ -4546,6 +4835,7 @@ void Skywalker::signOut()
     mEditUserPreferences = nullptr;
     mGlobalContentGroupListModel = nullptr;
     mTimelineModel.reset();
+    mMediaPrefetcher.clear();
     mUserDid.clear();
     mUserProfile = {};
     mAnniversary.setFirstAppearance({});
@@ -20,6 +20,7 @@
 #include "labeler.h"
 #include "list_list_model.h"
 #include "list_store.h"
+#include "media_prefetcher.h"
 #include "muted_words.h"
 #include "notification_list_model.h"
 #include "post_feed_model.h"
@@ -28,6 +29,8 @@
 #include "search_post_feed_model.h"
 #include "session_manager.h"
 #include "starter_pack_list_model.h"
+#include "task_graph.h"
+#include "timeline_update_scheduler.h"
 #include "user_settings.h"
 #include <atproto/lib/client.h>
 #include <atproto/lib/plc_directory_client.h>
@@ -92,6 +95,13 @@ public:
     Q_INVOKABLE void deleteSession();
     Q_INVOKABLE void switchUser(const QString& did);
     void initUserProfile();
+
+    // Loads the user profile, preferences and filter lists, and syncs the
+    // timeline as soon as the filter state is loaded. A failure to load the
+    // profile is signalled by getUserProfileFailed, any other failure by
+    // startUpFailed.
+    Q_INVOKABLE void startUp();
+
     Q_INVOKABLE void getUserProfileAndFollows();
     Q_INVOKABLE void getUserPreferences();
     Q_INVOKABLE void dataMigration();
@@ -104,6 +114,7 @@ public:
     Q_INVOKABLE void getTimelineNextPage(int maxPages = 20, int minEntries = 10) override;
     Q_INVOKABLE void updateTimeline(int autoGapFill, int pageSize, const updateTimelineCb& cb = {}) override;
     Q_INVOKABLE void timelineMovementEnded(int firstVisibleIndex, int lastVisibleIndex, int lastVisibleOffsetY);
+    Q_INVOKABLE void timelineMoved(int firstVisibleIndex, int lastVisibleIndex, double velocity);
     Q_INVOKABLE void syncListFeed(int modelId, int maxPages = 20) override;
     Q_INVOKABLE void feedMovementEnded(int modelId, int lastVisibleIndex, int lastVisibleOffsetY);
 
@@ -226,6 +237,9 @@ public:
     Q_INVOKABLE void signOut();
 
     Q_INVOKABLE void refreshAllModels();
+
+    // Profile and post changes are batched per event loop turn. The change is
+    // applied immediately, the models signal the change at the end of the turn.
     void makeLocalModelChange(const std::function<void(LocalProfileChanges*)>& update);
     void makeLocalModelChange(const std::function<void(LocalPostModelChanges*)>& update);
     void makeLocalModelChange(const std::function<void(LocalAuthorModelChanges*)>& update);
@@ -292,6 +306,8 @@ signals:
     void getUserProfileFailed(QString error);
     void getUserPreferencesOK();
     void getUserPreferencesFailed(QString error);
+    void startUpStatus(QString status);
+    void startUpFailed(QString error);
     void dataMigrationStatus(QString status);
     void dataMigrationDone();
     void autoUpdateTimeLineInProgressChanged();
@@ -356,21 +372,35 @@ private:
     void updatePostIndexedSecondsAgo();
     void startRefreshTimers();
     void stopRefreshTimers();
+    void probeTimelineHead();
+    void autoUpdateTimeline();
+    void rescheduleTimelineAutoUpdate();
+    void setTimelineHeadKey(const ATProto::AppBskyFeed::OutputFeed& feed);
     void updateUser(const QString& did, const QString& host);
     ATProto::ProfileMaster& getProfileMaster();
     std::optional<ATProto::ComATProtoServer::Session> getSavedSession() const;
     void saveSyncTimestamp(int postIndex, int offsetY);
+    void startLocalModelChangeBatch();
+    void endLocalModelChangeBatch();
+    void applyLocalModelChange(const std::function<void(LocalProfileChanges*)>& update);
+    void applyLocalModelChange(const std::function<void(LocalPostModelChanges*)>& update);
+    void applyLocalModelChange(const std::function<void(LocalAuthorModelChanges*)>& update);
     void saveFeedSyncTimestamp(PostFeedModel& model, int postIndex, int offsetY);
     void shareImage(const QString& contentUri, const QString& text);
     void shareVideo(const QString& contentUri, const QString& text);
     void updateFavoriteFeeds();
-    void loadTimelineHide();
-    void loadTimelineHide(QStringList uris);
-    void loadContentFilterPolicies();
-    void loadContentFilterPolicies(QStringList uris);
-    void loadMutedReposts(int maxPages = 10, const QString& cursor = {});
+    TaskGraph* createStartupTasks();
+    void addPreferencesTasks(TaskGraph& tasks);
+    void getUserProfile(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb);
+    void getUserPreferences(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb);
+    void loadTimelineHide(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb);
+    void loadContentFilterPolicies(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb);
+    void loadLists(ListStore& listStore, const QStringList& uris, const std::function<void(const QString& uri)>& listNotFoundCb,
+                   const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb);
+    QString getListSnapshotPath(const QString& subDir) const;
+    void loadMutedReposts(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb, int maxPages = 10, const QString& cursor = {});
     void initLabelers();
-    void loadLabelSettings();
+    void loadLabelSettings(const TaskGraph::DoneCb& doneCb, const TaskGraph::FailCb& failCb);
     void removeLabelerSubscriptions(const std::unordered_set<QString>& dids);
     void handleAppStateChange(Qt::ApplicationState state);
     void pauseApp();
@@ -394,6 +424,7 @@ private:
     QString mUserDid;
     Profile mUserProfile;
     bool mIsActiveUser = true;
+    TaskGraph* mStartupTasks = nullptr;
 
     bool mLoggedOutVisibility = true;
     Following mFollowing;
@@ -420,11 +451,14 @@ private:
     bool mGetTimelineInProgress = false;
     bool mGetPostThreadInProgress = false;
     bool mSignOutInProgress = false;
+    bool mLocalModelChangeBatchActive = false;
 
     QTimer mTimelineUpdateTimer;
     QDateTime mTimelineUpdatePaused;
+    TimelineUpdateScheduler mTimelineUpdateScheduler;
+    QString mTimelineHeadKey; // identifies the newest post in the timeline feed
 
-    // NOTE: update makeLocalModelChange() when you add models
+    // NOTE: update applyLocalModelChange() and makeLocalModelChange() when you add models
     ItemStore<PostThreadModel::Ptr> mPostThreadModels;
     ItemStore<AuthorFeedModel::Ptr> mAuthorFeedModels;
     ItemStore<SearchPostFeedModel::Ptr> mSearchPostFeedModels;
@@ -448,6 +482,7 @@ private:
     FavoriteFeeds mFavoriteFeeds;
     Anniversary mAnniversary;
     PostFeedModel mTimelineModel;
+    MediaPrefetcher mMediaPrefetcher;
     bool mTimelineSynced = false;
     bool mDebugLogging = false;
 };
@@ -100,7 +100,7 @@ void Songlink::getLinks(const QString& musicLink)
     if (!isMusicLink(musicLink))
         return;
 
-    const SonglinkLinks* links = SonglinkCache::instance().get(QUrl(musicLink));
+    const auto links = SonglinkCache::instance().get(QUrl(musicLink));
 
     if (links)
     {
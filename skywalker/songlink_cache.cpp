@@ -6,22 +6,31 @@ namespace Skywalker {
 
 std::unique_ptr<SonglinkCache> SonglinkCache::sInstance;
 
-SonglinkCache::Entry::Entry(const SonglinkLinks& links) :
-    mLinks(links)
+SonglinkCache::SonglinkCache() :
+    mCache("SonglinkCache", 0, &SonglinkCache::getCost, BUDGET_WEIGHT)
 {
 }
 
+qsizetype SonglinkCache::getCost(const QUrl& url, const SonglinkLinks& links)
+{
+    qsizetype cost = CacheCost::string(url.toString());
+
+    for (const auto& info : links.getLinkInfoList())
+        cost += sizeof(SonglinkInfo) + CacheCost::string(info.getLink());
+
+    return cost;
+}
+
 void SonglinkCache::put(const QUrl& url, const SonglinkLinks& links)
 {
     qDebug() << "Put:" << url;
-    mCache.insert(url, new Entry(links));
+    mCache.insert(url, links);
 }
 
-const SonglinkLinks* SonglinkCache::get(const QUrl& url) const
+std::shared_ptr<const SonglinkLinks> SonglinkCache::get(const QUrl& url) const
 {
     qDebug() << "Get:" << url;
-    auto* entry = mCache[url];
-    return entry ? &entry->getLinks() : nullptr;
+    return mCache.get(url);
 }
 
 bool SonglinkCache::contains(const QUrl& url) const
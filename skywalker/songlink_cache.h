@@ -1,8 +1,8 @@
 // Copyright (C) 2025 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "memory_cache.h"
 #include "songlink_links.h"
-#include <QCache>
 #include <QUrl>
 
 namespace Skywalker {
@@ -10,26 +10,20 @@ namespace Skywalker {
 class SonglinkCache
 {
 public:
-    class Entry : public QObject
-    {
-    public:
-        Entry() = default;
-        Entry(const SonglinkLinks& links);
+    static constexpr int BUDGET_WEIGHT = 2;
 
-        const SonglinkLinks& getLinks() const { return mLinks; }
-
-    private:
-        SonglinkLinks mLinks;
-    };
+    SonglinkCache();
 
     static SonglinkCache& instance();
 
     void put(const QUrl& url, const SonglinkLinks& links);
-    const SonglinkLinks* get(const QUrl& url) const;
+    std::shared_ptr<const SonglinkLinks> get(const QUrl& url) const;
     bool contains(const QUrl& url) const;
 
 private:
-    QCache<QUrl, Entry> mCache{50};
+    static qsizetype getCost(const QUrl& url, const SonglinkLinks& links);
+
+    MemoryCache<QUrl, SonglinkLinks> mCache;
 
     static std::unique_ptr<SonglinkCache> sInstance;
 };
@@ -22,6 +22,7 @@ public:
     SonglinkInfo(const QString& jsonKey, const QString& link);
 
     const QString& getName() const;
+    const QString& getLink() const { return mLink; }
     const QString& getLogo() const;
     int getPrio() const;
 
@@ -55,6 +56,7 @@ public:
     static SharedPtr fromJson(const QJsonObject& json);
 
     Q_INVOKABLE bool isNull() const;
+    const SonglinkInfo::List& getLinkInfoList() const { return mLinkInfoList; }
 
 private:
     static QString getLink(const ATProto::XJsonObject& xjson, const QString& platform);
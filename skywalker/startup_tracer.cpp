@@ -0,0 +1,283 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "startup_tracer.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <algorithm>
+#include <set>
+
+namespace Skywalker {
+
+std::atomic_bool StartupTracer::sEnabled = false;
+
+StartupTracer& StartupTracer::instance()
+{
+    static StartupTracer sInstance;
+    return sInstance;
+}
+
+void StartupTracer::initFromEnvironment()
+{
+    const QString fileName = qEnvironmentVariable(ENV_TRACE_FILE);
+
+    if (fileName.isEmpty())
+        return;
+
+    qDebug() << "Startup trace:" << fileName;
+    auto& tracer = instance();
+    tracer.setEnabled(true);
+
+    QMutexLocker locker(&tracer.mMutex);
+    tracer.mTraceFileName = fileName;
+}
+
+void StartupTracer::finishStartup()
+{
+    if (!isEnabled())
+        return;
+
+    auto& tracer = instance();
+    QString fileName;
+
+    {
+        QMutexLocker locker(&tracer.mMutex);
+        fileName = tracer.mTraceFileName;
+    }
+
+    qDebug() << "Startup critical path:" << tracer.getCriticalPath();
+
+    if (!fileName.isEmpty())
+        tracer.save(fileName);
+
+    tracer.setEnabled(false);
+}
+
+void StartupTracer::setEnabled(bool enabled)
+{
+    QMutexLocker locker(&mMutex);
+
+    if (enabled && !isEnabled())
+    {
+        mPhases.clear();
+        mTimer.start();
+    }
+
+    sEnabled = enabled;
+}
+
+void StartupTracer::begin(const char* phase, const std::vector<const char*>& dependsOn)
+{
+    Q_ASSERT(phase);
+    QMutexLocker locker(&mMutex);
+
+    if (!mTimer.isValid() || findPhase(phase))
+        return;
+
+    Phase newPhase{ phase, {}, mTimer.nsecsElapsed() };
+
+    for (const char* dep : dependsOn)
+    {
+        if (findPhase(dep))
+            newPhase.mDependsOn.push_back(dep);
+    }
+
+    newPhase.mLane = getFreeLane(newPhase.mStartNs);
+    mPhases.push_back(std::move(newPhase));
+}
+
+void StartupTracer::end(const char* phase)
+{
+    Q_ASSERT(phase);
+    QMutexLocker locker(&mMutex);
+    Phase* p = findPhase(phase);
+
+    if (!p || p->isFinished())
+        return;
+
+    p->mEndNs = mTimer.nsecsElapsed();
+    qDebug() << "Startup phase:" << phase << "ms:" << (p->mEndNs - p->mStartNs) / 1000000.0;
+}
+
+void StartupTracer::clear()
+{
+    QMutexLocker locker(&mMutex);
+    mPhases.clear();
+
+    if (mTimer.isValid())
+        mTimer.restart();
+}
+
+std::vector<StartupTracer::Phase> StartupTracer::getPhases() const
+{
+    QMutexLocker locker(&mMutex);
+    return mPhases;
+}
+
+QStringList StartupTracer::getCriticalPath(const char* phase) const
+{
+    QMutexLocker locker(&mMutex);
+    const Phase* p = nullptr;
+
+    if (phase)
+    {
+        p = findPhase(phase);
+    }
+    else
+    {
+        for (const auto& other : mPhases)
+        {
+            if (other.isFinished() && (!p || other.mEndNs > p->mEndNs))
+                p = &other;
+        }
+    }
+
+    QStringList path;
+
+    while (p)
+    {
+        path.push_front(p->mName);
+        const Phase* critical = nullptr;
+
+        // The dependency that finished last held up the phase.
+        for (const char* dep : p->mDependsOn)
+        {
+            const Phase* depPhase = findPhase(dep);
+
+            if (depPhase && depPhase->isFinished() && (!critical || depPhase->mEndNs > critical->mEndNs))
+                critical = depPhase;
+        }
+
+        p = critical;
+    }
+
+    return path;
+}
+
+QByteArray StartupTracer::toChromeTrace() const
+{
+    QMutexLocker locker(&mMutex);
+    const qint64 nowNs = mTimer.isValid() ? mTimer.nsecsElapsed() : 0;
+    QJsonArray events;
+    int flowId = 0;
+
+    for (const auto& phase : mPhases)
+    {
+        const qint64 endNs = phase.isFinished() ? phase.mEndNs : nowNs;
+        QJsonArray dependsOn;
+
+        for (const char* dep : phase.mDependsOn)
+            dependsOn.append(QString::fromLatin1(dep));
+
+        QJsonObject args;
+        args.insert("dependsOn", dependsOn);
+
+        if (!phase.isFinished())
+            args.insert("unfinished", true);
+
+        QJsonObject event;
+        event.insert("name", QString::fromLatin1(phase.mName));
+        event.insert("cat", "startup");
+        event.insert("ph", "X");
+        event.insert("ts", phase.mStartNs / 1000.0);
+        event.insert("dur", (endNs - phase.mStartNs) / 1000.0);
+        event.insert("pid", 1);
+        event.insert("tid", phase.mLane + 1);
+        event.insert("args", args);
+        events.append(event);
+
+        // Arrow from the end of each dependency to the start of the phase.
+        for (const char* dep : phase.mDependsOn)
+        {
+            const Phase* depPhase = findPhase(dep);
+
+            if (!depPhase || !depPhase->isFinished())
+                continue;
+
+            ++flowId;
+            QJsonObject flowStart;
+            flowStart.insert("name", "dependency");
+            flowStart.insert("cat", "startup");
+            flowStart.insert("ph", "s");
+            flowStart.insert("id", flowId);
+            flowStart.insert("ts", depPhase->mEndNs / 1000.0 - 0.001);
+            flowStart.insert("pid", 1);
+            flowStart.insert("tid", depPhase->mLane + 1);
+            events.append(flowStart);
+
+            QJsonObject flowEnd;
+            flowEnd.insert("name", "dependency");
+            flowEnd.insert("cat", "startup");
+            flowEnd.insert("ph", "f");
+            flowEnd.insert("bp", "e");
+            flowEnd.insert("id", flowId);
+            flowEnd.insert("ts", phase.mStartNs / 1000.0);
+            flowEnd.insert("pid", 1);
+            flowEnd.insert("tid", phase.mLane + 1);
+            events.append(flowEnd);
+        }
+    }
+
+    QJsonObject json;
+    json.insert("traceEvents", events);
+    json.insert("displayTimeUnit", "ms");
+    return QJsonDocument(json).toJson(QJsonDocument::Compact);
+}
+
+bool StartupTracer::save(const QString& fileName) const
+{
+    QSaveFile file(fileName);
+
+    if (!file.open(QFile::WriteOnly))
+    {
+        qWarning() << "Cannot write startup trace:" << fileName << file.errorString();
+        return false;
+    }
+
+    file.write(toChromeTrace());
+
+    if (!file.commit())
+    {
+        qWarning() << "Cannot save startup trace:" << fileName << file.errorString();
+        return false;
+    }
+
+    qDebug() << "Startup trace saved:" << fileName;
+    return true;
+}
+
+const StartupTracer::Phase* StartupTracer::findPhase(const char* phase) const
+{
+    auto it = std::find_if(mPhases.begin(), mPhases.end(),
+        [phase](const Phase& p){ return qstrcmp(p.mName, phase) == 0; });
+
+    return it != mPhases.end() ? &*it : nullptr;
+}
+
+StartupTracer::Phase* StartupTracer::findPhase(const char* phase)
+{
+    return const_cast<Phase*>(std::as_const(*this).findPhase(phase));
+}
+
+int StartupTracer::getFreeLane(qint64 startNs) const
+{
+    // Concurrent phases are put on different lanes (threads in the trace viewer)
+    // as phases on the same lane must nest.
+    std::set<int> busyLanes;
+
+    for (const auto& phase : mPhases)
+    {
+        if (!phase.isFinished() || phase.mEndNs > startNs)
+            busyLanes.insert(phase.mLane);
+    }
+
+    int lane = 0;
+
+    while (busyLanes.contains(lane))
+        ++lane;
+
+    return lane;
+}
+
+}
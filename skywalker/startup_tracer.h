@@ -0,0 +1,92 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QStringList>
+#include <atomic>
+#include <initializer_list>
+#include <vector>
+
+namespace Skywalker {
+
+// Records the phases of the startup sequence with monotonic timestamps and the
+// phases each phase waited for. The trace can be exported as Chrome trace JSON
+// (chrome://tracing, https://ui.perfetto.dev).
+//
+// Phase names must be string literals. When tracing is disabled, the static
+// functions only load an atomic flag.
+//
+// Tracing is enabled at startup by setting SKYWALKER_STARTUP_TRACE to the name
+// of the file to write the trace to when the timeline is shown.
+class StartupTracer
+{
+public:
+    static constexpr char const* ENV_TRACE_FILE = "SKYWALKER_STARTUP_TRACE";
+
+    struct Phase
+    {
+        const char* mName;
+        std::vector<const char*> mDependsOn;
+        qint64 mStartNs;
+        qint64 mEndNs = -1; // -1 while in progress
+        int mLane = 0;
+
+        bool isFinished() const { return mEndNs >= 0; }
+    };
+
+    static StartupTracer& instance();
+    static bool isEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    // A phase is recorded once, repeated begins of the same phase are ignored.
+    // Dependencies that have not been recorded are ignored.
+    static void beginPhase(const char* phase, std::initializer_list<const char*> dependsOn = {})
+    {
+        if (isEnabled())
+            instance().begin(phase, dependsOn);
+    }
+
+    static void endPhase(const char* phase)
+    {
+        if (isEnabled())
+            instance().end(phase);
+    }
+
+    // Enables tracing if the environment variable is set.
+    static void initFromEnvironment();
+
+    // Writes the trace to the file from the environment and stops tracing.
+    static void finishStartup();
+
+    // Enabling starts a new trace.
+    void setEnabled(bool enabled);
+
+    void begin(const char* phase, const std::vector<const char*>& dependsOn = {});
+    void end(const char* phase);
+    void clear();
+
+    std::vector<Phase> getPhases() const;
+
+    // Returns the chain of phases that determined the end time of the phase,
+    // starting with the first phase. By default the phase that finished last.
+    QStringList getCriticalPath(const char* phase = nullptr) const;
+
+    QByteArray toChromeTrace() const;
+    bool save(const QString& fileName) const;
+
+private:
+    StartupTracer() = default;
+
+    const Phase* findPhase(const char* phase) const;
+    Phase* findPhase(const char* phase);
+    int getFreeLane(qint64 startNs) const;
+
+    static std::atomic_bool sEnabled;
+
+    mutable QMutex mMutex;
+    QElapsedTimer mTimer;
+    std::vector<Phase> mPhases;
+    QString mTraceFileName;
+};
+
+}
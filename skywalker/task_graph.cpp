@@ -0,0 +1,192 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "task_graph.h"
+#include "startup_tracer.h"
+#include <QDebug>
+#include <QPointer>
+
+namespace Skywalker {
+
+TaskGraph::TaskGraph(QObject* parent) :
+    QObject(parent)
+{
+}
+
+void TaskGraph::addTask(const char* name, const std::vector<const char*>& prerequisites, const TaskFn& fn)
+{
+    Q_ASSERT(name);
+    Q_ASSERT(fn);
+    Q_ASSERT(!mRunning);
+    Q_ASSERT(findTask(name) < 0);
+
+    Task task{ name, {}, fn };
+
+    for (const char* prerequisite : prerequisites)
+    {
+        const int index = findTask(prerequisite);
+
+        if (index >= 0)
+            task.mPrerequisites.push_back(index);
+        else
+            qDebug() << "Task:" << name << "ignore prerequisite:" << prerequisite;
+    }
+
+    mTasks.push_back(std::move(task));
+}
+
+void TaskGraph::enableTracing(const std::vector<const char*>& rootPhases)
+{
+    mTracing = true;
+    mRootPhases = rootPhases;
+}
+
+void TaskGraph::run(const FinishedCb& finishedCb, const FailedCb& failedCb)
+{
+    Q_ASSERT(!mRunning);
+    qDebug() << "Run tasks:" << mTasks.size();
+    mRunning = true;
+    mFinishedCb = finishedCb;
+    mFailedCb = failedCb;
+
+    if (isFinished())
+    {
+        if (mFinishedCb)
+            mFinishedCb();
+
+        return;
+    }
+
+    startReadyTasks();
+}
+
+void TaskGraph::cancel()
+{
+    qDebug() << "Cancel tasks";
+    mCanceled = true;
+    mFinishedCb = nullptr;
+    mFailedCb = nullptr;
+}
+
+bool TaskGraph::isDone(const char* name) const
+{
+    const int index = findTask(name);
+    return index >= 0 && mTasks[index].mState == State::DONE;
+}
+
+int TaskGraph::findTask(const char* name) const
+{
+    for (int i = 0; i < (int)mTasks.size(); ++i)
+    {
+        if (qstrcmp(mTasks[i].mName, name) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+bool TaskGraph::isReady(const Task& task) const
+{
+    for (int index : task.mPrerequisites)
+    {
+        if (mTasks[index].mState != State::DONE)
+            return false;
+    }
+
+    return true;
+}
+
+void TaskGraph::startReadyTasks()
+{
+    // A synchronous task finishes inside startTask, which starts the tasks
+    // depending on it. The state check prevents starting a task twice.
+    // The graph may be deleted by the finished or failed callback.
+    QPointer<TaskGraph> graph(this);
+
+    for (int i = 0; i < (int)mTasks.size() && !mFailed && !mCanceled; ++i)
+    {
+        if (mTasks[i].mState == State::WAITING && isReady(mTasks[i]))
+        {
+            startTask(i);
+
+            if (!graph)
+                return;
+        }
+    }
+}
+
+void TaskGraph::startTask(int index)
+{
+    Task& task = mTasks[index];
+    qDebug() << "Start task:" << task.mName;
+    task.mState = State::RUNNING;
+
+    if (mTracing && StartupTracer::isEnabled())
+    {
+        std::vector<const char*> dependsOn;
+
+        for (int prerequisite : task.mPrerequisites)
+            dependsOn.push_back(mTasks[prerequisite].mName);
+
+        StartupTracer::instance().begin(task.mName, dependsOn.empty() ? mRootPhases : dependsOn);
+    }
+
+    // The graph may be deleted when the task finishes synchronously.
+    const TaskFn fn = task.mFn;
+    QPointer<TaskGraph> graph(this);
+
+    fn(
+        [graph, index]{
+            if (graph)
+                graph->taskDone(index);
+        },
+        [graph, index](const QString& error){
+            if (graph)
+                graph->taskFailed(index, error);
+        });
+}
+
+void TaskGraph::taskDone(int index)
+{
+    Task& task = mTasks[index];
+
+    if (mFailed || mCanceled || task.mState != State::RUNNING)
+        return;
+
+    qDebug() << "Task done:" << task.mName;
+    task.mState = State::DONE;
+    ++mDoneCount;
+
+    if (mTracing)
+        StartupTracer::endPhase(task.mName);
+
+    if (isFinished())
+    {
+        qDebug() << "All tasks done";
+
+        if (mFinishedCb)
+            mFinishedCb();
+
+        return;
+    }
+
+    startReadyTasks();
+}
+
+void TaskGraph::taskFailed(int index, const QString& error)
+{
+    Task& task = mTasks[index];
+
+    if (mFailed || mCanceled || task.mState != State::RUNNING)
+        return;
+
+    qWarning() << "Task failed:" << task.mName << error;
+    mFailed = true;
+
+    if (mTracing)
+        StartupTracer::endPhase(task.mName);
+
+    if (mFailedCb)
+        mFailedCb(task.mName, error);
+}
+
+}
@@ -0,0 +1,78 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QObject>
+#include <QString>
+#include <functional>
+#include <vector>
+
+namespace Skywalker {
+
+// Runs asynchronous tasks as soon as their prerequisites are done. Tasks
+// without a dependency on each other run concurrently.
+//
+// A task gets a done and a fail callback and must call one of them. After a
+// failure no new tasks are started and the results of running tasks are
+// ignored. Callbacks called after the graph is deleted are ignored.
+//
+// Task names must be string literals.
+class TaskGraph : public QObject
+{
+public:
+    using DoneCb = std::function<void()>;
+    using FailCb = std::function<void(const QString& error)>;
+    using TaskFn = std::function<void(const DoneCb& done, const FailCb& fail)>;
+    using FinishedCb = std::function<void()>;
+    using FailedCb = std::function<void(const char* task, const QString& error)>;
+
+    explicit TaskGraph(QObject* parent = nullptr);
+
+    // Prerequisites must be added before the task. Prerequisites that are not
+    // in the graph are ignored, such that optional tasks can be left out.
+    void addTask(const char* name, const std::vector<const char*>& prerequisites, const TaskFn& fn);
+
+    // Report the tasks as phases to the StartupTracer. Tasks without
+    // prerequisites are reported as depending on the rootPhases.
+    void enableTracing(const std::vector<const char*>& rootPhases = {});
+
+    void run(const FinishedCb& finishedCb, const FailedCb& failedCb);
+
+    // Stops starting tasks and ignores the results of running tasks.
+    void cancel();
+
+    bool isDone(const char* name) const;
+    bool isFinished() const { return mDoneCount == (int)mTasks.size(); }
+    bool isFailed() const { return mFailed; }
+    bool isCanceled() const { return mCanceled; }
+    int size() const { return (int)mTasks.size(); }
+
+private:
+    enum class State { WAITING, RUNNING, DONE };
+
+    struct Task
+    {
+        const char* mName;
+        std::vector<int> mPrerequisites; // task indices
+        TaskFn mFn;
+        State mState = State::WAITING;
+    };
+
+    int findTask(const char* name) const;
+    bool isReady(const Task& task) const;
+    void startReadyTasks();
+    void startTask(int index);
+    void taskDone(int index);
+    void taskFailed(int index, const QString& error);
+
+    std::vector<Task> mTasks;
+    int mDoneCount = 0;
+    bool mRunning = false;
+    bool mFailed = false;
+    bool mCanceled = false;
+    bool mTracing = false;
+    std::vector<const char*> mRootPhases;
+    FinishedCb mFinishedCb;
+    FailedCb mFailedCb;
+};
+
+}
@@ -1,81 +1,204 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #include "tenor_gif_overview_model.h"
+#include <QCoreApplication>
+#include <QPointer>
+#include <QThreadPool>
+#include <algorithm>
 
 namespace Skywalker {
 
 TenorOverviewModel::TenorOverviewModel(int maxRowWidth, int spacing, QObject* parent) :
     QAbstractListModel(parent),
     mMaxRowWidth(maxRowWidth),
-    mSpacing(spacing)
+    mSpacing(spacing),
+    mLayout(maxRowWidth, spacing)
 {
 }
 
+void TenorOverviewModel::setMaxRowWidth(int width)
+{
+    if (width == mMaxRowWidth)
+        return;
+
+    mMaxRowWidth = width;
+    startReflow();
+}
+
+void TenorOverviewModel::setSpacing(int spacing)
+{
+    if (spacing == mSpacing)
+        return;
+
+    mSpacing = spacing;
+    startReflow();
+}
+
 void TenorOverviewModel::clear()
 {
-    if (mOverview.empty())
+    ++mReflowGeneration;
+    mReflowing = false;
+
+    if (mGifs.empty())
+    {
+        mLayout = TenorRowLayout(mMaxRowWidth, mSpacing);
         return;
+    }
 
-    beginRemoveRows({}, 0, mOverview.size() - 1);
-    mOverview.clear();
+    beginRemoveRows({}, 0, rowCount() - 1);
+    mGifs.clear();
+    mLayout = TenorRowLayout(mMaxRowWidth, mSpacing);
     endRemoveRows();
 }
 
 void TenorOverviewModel::addGifs(const TenorGifList& gifs)
 {
-    TenorPreviewRow nextRow(mMaxRowWidth, mSpacing);
+    if (gifs.empty())
+        return;
+
+    std::vector<QSize> sizes;
+    sizes.reserve(gifs.size());
+
+    for (const auto& gif : gifs)
+        sizes.push_back(gif.getSmallSize());
+
+    // Only the last row, if it was not full yet, changes. New rows get added.
+    auto append = mLayout.prepareAppend(sizes);
+    const int oldRowCount = rowCount();
+    const int newRowCount = append.mFirstRow + (int)append.mRows.size();
+    const int changedRow = append.mFirstRow < oldRowCount ? append.mFirstRow : -1;
+    qDebug() << "Adding GIFs:" << gifs.size() << "rows:" << oldRowCount << "->" << newRowCount;
+
+    if (newRowCount > oldRowCount)
+        beginInsertRows({}, oldRowCount, newRowCount - 1);
+
+    mGifs.append(gifs);
+    mLayout.commitAppend(sizes, std::move(append));
+
+    if (newRowCount > oldRowCount)
+        endInsertRows();
+
+    if (changedRow >= 0)
+        emit dataChanged(index(changedRow), index(changedRow));
+}
+
+void TenorOverviewModel::startReflow()
+{
+    const int generation = ++mReflowGeneration;
 
-    if (!mOverview.empty() && !mOverview.back().isFull())
+    if (mGifs.empty())
     {
-        const auto newSize = mOverview.size() - 1;
-        nextRow = mOverview.back();
-        beginRemoveRows({}, newSize, newSize);
-        mOverview.erase(mOverview.begin() + mOverview.size() - 1);
-        endRemoveRows();
+        mLayout = TenorRowLayout(mMaxRowWidth, mSpacing);
+        mReflowing = false;
+        return;
     }
 
-    for (const auto& gif : gifs)
+    qDebug() << "Reflow GIFs:" << mGifs.size() << "width:" << mMaxRowWidth << "spacing:" << mSpacing;
+    mReflowing = true;
+    auto layout = std::make_shared<TenorRowLayout>(mMaxRowWidth, mSpacing);
+    QPointer<TenorOverviewModel> model(this);
+
+    // The current layout stays till the reflow is done. GIFs added meanwhile
+    // get appended to the new layout when it is taken over.
+    QThreadPool::globalInstance()->start(
+        [model, generation, layout, sizes=mLayout.getSizes()]{
+            layout->addGifs(sizes);
+
+            QMetaObject::invokeMethod(QCoreApplication::instance(),
+                [model, generation, layout]{
+                    if (model)
+                        model->reflowDone(generation, std::move(*layout));
+                },
+                Qt::QueuedConnection);
+        });
+}
+
+void TenorOverviewModel::reflowDone(int generation, TenorRowLayout layout)
+{
+    if (generation != mReflowGeneration)
     {
-        qDebug() << "Adding GIF:" << gif.getDescription();
-        nextRow.addGif(gif);
+        qDebug() << "Discard outdated reflow:" << generation << "current:" << mReflowGeneration;
+        return;
+    }
 
-        if (nextRow.isFull())
-        {
-            addRow(nextRow);
-            nextRow = TenorPreviewRow(mMaxRowWidth, mSpacing);
-        }
+    mReflowing = false;
+
+    if (layout.getGifCount() < mGifs.size())
+    {
+        std::vector<QSize> sizes;
+        sizes.reserve(mGifs.size() - layout.getGifCount());
+
+        for (int i = layout.getGifCount(); i < mGifs.size(); ++i)
+            sizes.push_back(mGifs[i].getSmallSize());
+
+        layout.addGifs(sizes);
     }
 
-    if (!nextRow.isEmpty())
-        addRow(nextRow);
+    setLayout(std::move(layout));
+    emit reflowed();
 }
 
-void TenorOverviewModel::addRow(const TenorPreviewRow& row)
+void TenorOverviewModel::setLayout(TenorRowLayout layout)
 {
-    qDebug() << "Adding row:" << row.getRow().size();
-    beginInsertRows({}, mOverview.size(), mOverview.size());
-    mOverview.push_back(row);
-    endInsertRows();
+    // Update the rows in place instead of resetting the model, such that the
+    // list view keeps its position.
+    const int oldRowCount = rowCount();
+    const int newRowCount = layout.getRows().size();
+
+    if (newRowCount < oldRowCount)
+    {
+        beginRemoveRows({}, newRowCount, oldRowCount - 1);
+        mLayout = std::move(layout);
+        endRemoveRows();
+    }
+    else if (newRowCount > oldRowCount)
+    {
+        beginInsertRows({}, oldRowCount, newRowCount - 1);
+        mLayout = std::move(layout);
+        endInsertRows();
+    }
+    else
+    {
+        mLayout = std::move(layout);
+    }
+
+    const int changedRowCount = std::min(oldRowCount, newRowCount);
+
+    if (changedRowCount > 0)
+        emit dataChanged(index(0), index(changedRowCount - 1));
 }
 
 int TenorOverviewModel::rowCount(const QModelIndex&) const
 {
-    return mOverview.size();
+    return mLayout.getRows().size();
 }
 
 QVariant TenorOverviewModel::data(const QModelIndex& index, int role) const
 {
-    if (index.row() < 0 || index.row() >= (int)mOverview.size())
+    if (index.row() < 0 || index.row() >= rowCount())
         return {};
 
-    const auto& previewRow = mOverview[index.row()];
-
     switch (Role(role))
     {
     case Role::PreviewRow:
-        return QVariant::fromValue(previewRow.getRow());
+    {
+        // The GIF sizes of a row are only computed when the row gets shown.
+        const auto& row = mLayout.getRows()[index.row()];
+        const auto sizes = mLayout.getGifSizes(index.row());
+        TenorGifList previewRow;
+        previewRow.reserve(row.mGifCount);
+
+        for (int i = 0; i < row.mGifCount; ++i)
+        {
+            TenorGif gif = mGifs[row.mFirstGif + i];
+            gif.setOverviewSize(sizes[i]);
+            previewRow.append(gif);
+        }
+
+        return QVariant::fromValue(previewRow);
+    }
     case Role::PreviewRowSpacing:
-        return previewRow.getSpacing();
+        return mLayout.getSpacing();
     }
 
     qWarning() << "Uknown role requested:" << role;
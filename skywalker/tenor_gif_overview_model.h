@@ -1,7 +1,8 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #pragma once
-#include "tenor_preview_row.h"
+#include "tenor_gif.h"
+#include "tenor_row_layout.h"
 #include <QAbstractListModel>
 
 namespace Skywalker {
@@ -18,8 +19,11 @@ public:
 
     TenorOverviewModel(int maxRowWidth, int spacing, QObject* parent = nullptr);
 
-    void setMaxRowWidth(int width) { mMaxRowWidth = width; }
-    void setSpacing(int spacing) { mSpacing = spacing; }
+    // A change of width or spacing reflows the GIFs in a background thread.
+    // Till then the current layout is kept.
+    void setMaxRowWidth(int width);
+    void setSpacing(int spacing);
+    bool isReflowing() const { return mReflowing; }
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
@@ -27,15 +31,23 @@ public:
     void clear();
     void addGifs(const TenorGifList& gifs);
 
+signals:
+    void reflowed();
+
 protected:
     QHash<int, QByteArray> roleNames() const override;
 
 private:
-    void addRow(const TenorPreviewRow& row);
+    void startReflow();
+    void reflowDone(int generation, TenorRowLayout layout);
+    void setLayout(TenorRowLayout layout);
 
     int mMaxRowWidth;
     int mSpacing;
-    std::vector<TenorPreviewRow> mOverview;
+    TenorGifList mGifs;
+    TenorRowLayout mLayout;
+    int mReflowGeneration = 0;
+    bool mReflowing = false;
 };
 
 }
@@ -0,0 +1,125 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "tenor_row_layout.h"
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+namespace Skywalker {
+
+namespace {
+
+double aspectRatio(QSize size)
+{
+    return double(std::max(size.width(), 1)) / std::max(size.height(), 1);
+}
+
+}
+
+TenorRowLayout::TenorRowLayout(int maxRowWidth, int spacing) :
+    mMaxRowWidth(maxRowWidth),
+    mSpacing(spacing)
+{
+}
+
+TenorRowLayout::Append TenorRowLayout::prepareAppend(const std::vector<QSize>& sizes) const
+{
+    Append append;
+    append.mFirstRow = mRows.size();
+    Row row;
+    row.mFirstGif = mSizes.size();
+
+    if (!mRows.empty() && !mRows.back().mFull)
+    {
+        --append.mFirstRow;
+        row = mRows.back();
+    }
+
+    for (const QSize size : sizes)
+    {
+        addToRow(row, size);
+
+        if (row.mFull)
+        {
+            const int nextGif = row.mFirstGif + row.mGifCount;
+            append.mRows.push_back(row);
+            row = Row();
+            row.mFirstGif = nextGif;
+        }
+    }
+
+    if (row.mGifCount > 0)
+        append.mRows.push_back(row);
+
+    return append;
+}
+
+void TenorRowLayout::commitAppend(const std::vector<QSize>& sizes, Append append)
+{
+    Q_ASSERT(append.mFirstRow <= (int)mRows.size());
+    Q_ASSERT(append.mRows.empty() || append.mRows.front().mFirstGif <= (int)mSizes.size());
+    mSizes.insert(mSizes.end(), sizes.begin(), sizes.end());
+    mRows.resize(append.mFirstRow);
+    mRows.insert(mRows.end(), std::make_move_iterator(append.mRows.begin()),
+                 std::make_move_iterator(append.mRows.end()));
+}
+
+void TenorRowLayout::addGifs(const std::vector<QSize>& sizes)
+{
+    commitAppend(sizes, prepareAppend(sizes));
+}
+
+void TenorRowLayout::addToRow(Row& row, QSize size) const
+{
+    Q_ASSERT(!row.mFull);
+    row.mAspectSum += aspectRatio(size);
+    row.mMinHeight = std::min(row.mMinHeight, std::max(size.height(), 1));
+    ++row.mGifCount;
+    row.mFull = row.mAspectSum * row.mMinHeight + getTotalSpacing(row) >= mMaxRowWidth;
+}
+
+int TenorRowLayout::getTotalSpacing(const Row& row) const
+{
+    return std::max(row.mGifCount - 1, 0) * mSpacing;
+}
+
+int TenorRowLayout::getRowHeight(int rowIndex) const
+{
+    Q_ASSERT(rowIndex >= 0 && rowIndex < (int)mRows.size());
+    const Row& row = mRows[rowIndex];
+
+    if (!row.mFull)
+        return row.mMinHeight;
+
+    const int width = mMaxRowWidth - getTotalSpacing(row);
+    return std::max((int)std::lround(width / row.mAspectSum), 1);
+}
+
+std::vector<QSize> TenorRowLayout::getGifSizes(int rowIndex) const
+{
+    Q_ASSERT(rowIndex >= 0 && rowIndex < (int)mRows.size());
+    const Row& row = mRows[rowIndex];
+    const int height = getRowHeight(rowIndex);
+    std::vector<QSize> sizes;
+    sizes.reserve(row.mGifCount);
+    double aspectSum = 0.0;
+    int x = 0;
+
+    // Round the GIF edges instead of the widths, such that rounding errors
+    // do not add up.
+    for (int i = 0; i < row.mGifCount; ++i)
+    {
+        aspectSum += aspectRatio(mSizes[row.mFirstGif + i]);
+        int right = std::lround(aspectSum * height);
+
+        if (row.mFull && i == row.mGifCount - 1)
+            right = mMaxRowWidth - getTotalSpacing(row);
+
+        sizes.emplace_back(std::max(right - x, 1), height);
+        x = right;
+    }
+
+    return sizes;
+}
+
+}
@@ -0,0 +1,66 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QSize>
+#include <vector>
+
+namespace Skywalker {
+
+// Justified layout of GIFs in rows of a fixed width. GIFs are added to the
+// last row till its width at the height of the lowest GIF reaches the
+// maximum row width. Then the row is closed and scaled to fill the width
+// exactly. A row only stores the sum of the aspect ratios of its GIFs. The
+// sizes of the GIFs are computed when needed, i.e. when a row gets shown.
+//
+// The layout does not refer to TenorGif objects, so it can be computed in a
+// background thread.
+class TenorRowLayout
+{
+public:
+    static constexpr int MAX_ROW_HEIGHT = 1000;
+
+    struct Row
+    {
+        int mFirstGif = 0;
+        int mGifCount = 0;
+        double mAspectSum = 0.0; // sum of width/height
+        int mMinHeight = MAX_ROW_HEIGHT;
+        bool mFull = false;
+    };
+
+    // Rows for new GIFs. The first row replaces the last row of the layout
+    // if that row was not full.
+    struct Append
+    {
+        int mFirstRow = 0;
+        std::vector<Row> mRows;
+    };
+
+    TenorRowLayout(int maxRowWidth, int spacing);
+
+    int getMaxRowWidth() const { return mMaxRowWidth; }
+    int getSpacing() const { return mSpacing; }
+    const std::vector<QSize>& getSizes() const { return mSizes; }
+    const std::vector<Row>& getRows() const { return mRows; }
+    int getGifCount() const { return mSizes.size(); }
+
+    // Adding GIFs is split in prepare and commit, such that a model can tell
+    // which rows change before they do. Earlier rows never change.
+    Append prepareAppend(const std::vector<QSize>& sizes) const;
+    void commitAppend(const std::vector<QSize>& sizes, Append append);
+    void addGifs(const std::vector<QSize>& sizes);
+
+    int getRowHeight(int rowIndex) const;
+    std::vector<QSize> getGifSizes(int rowIndex) const;
+
+private:
+    void addToRow(Row& row, QSize size) const;
+    int getTotalSpacing(const Row& row) const;
+
+    int mMaxRowWidth;
+    int mSpacing;
+    std::vector<QSize> mSizes;
+    std::vector<Row> mRows;
+};
+
+}
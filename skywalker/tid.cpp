@@ -0,0 +1,58 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "tid.h"
+#include <QDateTime>
+#include <QRandomGenerator>
+
+namespace Skywalker {
+
+static constexpr char const* BASE32_SORTABLE = "234567abcdefghijklmnopqrstuvwxyz";
+
+qint64 Tid::sLastTimestamp = 0;
+int Tid::sClockId = -1;
+
+QString Tid::next()
+{
+    if (sClockId < 0)
+        sClockId = QRandomGenerator::global()->bounded(1024);
+
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch() * 1000;
+
+    // Multiple TIDs within the same millisecond must still be unique.
+    if (timestamp <= sLastTimestamp)
+        timestamp = sLastTimestamp + 1;
+
+    sLastTimestamp = timestamp;
+    return encode(timestamp, sClockId);
+}
+
+QString Tid::encode(qint64 microSecondsSinceEpoch, int clockId)
+{
+    const quint64 value = ((quint64(microSecondsSinceEpoch) & 0x1fffffffffffff) << 10) | (quint64(clockId) & 0x3ff);
+    QString tid(LENGTH, '2');
+
+    for (int i = 0; i < LENGTH; ++i)
+        tid[LENGTH - 1 - i] = QChar(BASE32_SORTABLE[(value >> (i * 5)) & 0x1f]);
+
+    return tid;
+}
+
+bool Tid::isValid(const QString& tid)
+{
+    if (tid.size() != LENGTH)
+        return false;
+
+    // The top bit must be 0
+    if (!QString("234567abcdefghij").contains(tid[0]))
+        return false;
+
+    for (const QChar c : tid)
+    {
+        if (!QString(BASE32_SORTABLE).contains(c))
+            return false;
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,27 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QString>
+
+namespace Skywalker {
+
+// Timestamp identifier as used for ATProto record keys.
+// 53 bits of microseconds since the epoch plus a 10 bit clock id, encoded in
+// 13 characters base32-sortable.
+class Tid
+{
+public:
+    static constexpr int LENGTH = 13;
+
+    // Returns a new TID, strictly greater than the previous one.
+    static QString next();
+
+    static QString encode(qint64 microSecondsSinceEpoch, int clockId);
+    static bool isValid(const QString& tid);
+
+private:
+    static qint64 sLastTimestamp;
+    static int sClockId;
+};
+
+}
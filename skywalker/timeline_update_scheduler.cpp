@@ -0,0 +1,103 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#include "timeline_update_scheduler.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace Skywalker {
+
+// Weight of a new post rate sample in the moving average
+static constexpr double RATE_SMOOTHING = 0.3;
+
+// Interval increase per probe that found no new posts
+static constexpr double EMPTY_PROBE_BACKOFF = 1.5;
+
+static constexpr double INACTIVE_FACTOR = 2.0;
+static constexpr double METERED_FACTOR = 1.5;
+
+void TimelineUpdateScheduler::reset()
+{
+    mPostsPerMinute = -1.0;
+    mLastPrepend = {};
+    mEmptyProbeStreak = 0;
+    mStats = {};
+}
+
+void TimelineUpdateScheduler::probeDone(bool newPosts, const QDateTime& now)
+{
+    ++mStats.mProbes;
+
+    if (newPosts)
+    {
+        mEmptyProbeStreak = 0;
+        return;
+    }
+
+    ++mStats.mEmptyProbes;
+    ++mEmptyProbeStreak;
+
+    // Without a prepend the rate cannot be measured. Set the reference
+    // point, such that the first prepend gives a rate.
+    if (!mLastPrepend.isValid())
+        mLastPrepend = now;
+}
+
+void TimelineUpdateScheduler::prependDone(int addedPosts, const QDateTime& now)
+{
+    ++mStats.mPrepends;
+    mEmptyProbeStreak = 0;
+
+    if (mLastPrepend.isValid())
+    {
+        const double minutes = mLastPrepend.secsTo(now) / 60.0;
+
+        if (minutes > 0.0)
+        {
+            const double rate = std::max(addedPosts, 0) / minutes;
+
+            if (mPostsPerMinute < 0.0)
+                mPostsPerMinute = rate;
+            else
+                mPostsPerMinute = RATE_SMOOTHING * rate + (1.0 - RATE_SMOOTHING) * mPostsPerMinute;
+
+            qDebug() << "Added posts:" << addedPosts << "minutes:" << minutes << "posts/min:" << mPostsPerMinute;
+        }
+    }
+
+    mLastPrepend = now;
+}
+
+std::chrono::seconds TimelineUpdateScheduler::getBaseInterval() const
+{
+    if (mPostsPerMinute < 0.0)
+        return DEFAULT_INTERVAL;
+
+    if (mPostsPerMinute == 0.0)
+        return MAX_INTERVAL;
+
+    const auto seconds = std::chrono::seconds((long)std::lround(TARGET_POSTS_PER_UPDATE / mPostsPerMinute * 60.0));
+    return std::clamp(seconds, MIN_INTERVAL, MAX_INTERVAL);
+}
+
+std::chrono::seconds TimelineUpdateScheduler::getInterval() const
+{
+    double seconds = getBaseInterval().count();
+    seconds *= std::pow(EMPTY_PROBE_BACKOFF, mEmptyProbeStreak);
+
+    if (!mAppActive)
+        seconds *= INACTIVE_FACTOR;
+
+    auto minInterval = MIN_INTERVAL;
+
+    if (mMetered)
+    {
+        seconds *= METERED_FACTOR;
+        minInterval = METERED_MIN_INTERVAL;
+    }
+
+    const auto interval = std::chrono::seconds((long)std::lround(std::min(seconds, (double)MAX_INTERVAL.count())));
+    return std::clamp(interval, minInterval, MAX_INTERVAL);
+}
+
+}
@@ -0,0 +1,60 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <QDateTime>
+#include <chrono>
+
+namespace Skywalker {
+
+using namespace std::chrono_literals;
+
+// Determines the interval for the next timeline auto update. Each update
+// starts with a cheap head probe. Only when the probe finds new posts, a full
+// prepend is done. The interval adapts to the observed post rate, app state
+// and network type.
+class TimelineUpdateScheduler
+{
+public:
+    static constexpr std::chrono::seconds MIN_INTERVAL = 31s;
+    static constexpr std::chrono::seconds DEFAULT_INTERVAL = 91s;
+    static constexpr std::chrono::seconds MAX_INTERVAL = 301s;
+    static constexpr std::chrono::seconds METERED_MIN_INTERVAL = 91s;
+
+    // There is a trade off: short interval is fast updating timeline, long interval
+    // allows for better reply thread construction as we receive more posts per update.
+    // Aim for this number of new posts per update.
+    static constexpr double TARGET_POSTS_PER_UPDATE = 15.0;
+
+    struct Stats
+    {
+        int mProbes = 0;
+        int mPrepends = 0;
+        int mEmptyProbes = 0;
+    };
+
+    void reset();
+    void setAppActive(bool active) { mAppActive = active; }
+    void setMetered(bool metered) { mMetered = metered; }
+
+    // Result of a head probe.
+    void probeDone(bool newPosts, const QDateTime& now = QDateTime::currentDateTimeUtc());
+
+    // Number of posts added by a prepend after a successful probe.
+    void prependDone(int addedPosts, const QDateTime& now = QDateTime::currentDateTimeUtc());
+
+    std::chrono::seconds getInterval() const;
+    double getPostsPerMinute() const { return mPostsPerMinute; }
+    const Stats& getStats() const { return mStats; }
+
+private:
+    std::chrono::seconds getBaseInterval() const;
+
+    double mPostsPerMinute = -1.0; // negative means unknown
+    QDateTime mLastPrepend;
+    int mEmptyProbeStreak = 0;
+    bool mAppActive = true;
+    bool mMetered = false;
+    Stats mStats;
+};
+
+}
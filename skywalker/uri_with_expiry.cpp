@@ -40,10 +40,16 @@ UriWithExpirySet::UriWithExpirySet(QObject* parent) : QObject(parent)
 {
 }
 
+UriWithExpirySet::~UriWithExpirySet()
+{
+    ExpiryScheduler::instance().cancel(mExpiryId);
+}
+
 void UriWithExpirySet::clear()
 {
     mUriMap.clear();
     mUrisByExpiry.clear();
+    scheduleExpiry();
 }
 
 void UriWithExpirySet::insert(const UriWithExpiry& uriWithExpiry)
@@ -51,6 +57,7 @@ void UriWithExpirySet::insert(const UriWithExpiry& uriWithExpiry)
     remove(uriWithExpiry.getUri());
     auto result = mUrisByExpiry.insert(uriWithExpiry);
     mUriMap[uriWithExpiry.getUri()] = result.first;
+    scheduleExpiry();
 }
 
 bool UriWithExpirySet::remove(const QString& uri)
@@ -60,12 +67,60 @@ bool UriWithExpirySet::remove(const QString& uri)
         auto it = mUriMap[uri];
         mUriMap.erase(uri);
         mUrisByExpiry.erase(it);
+        scheduleExpiry();
         return true;
     }
 
     return false;
 }
 
+void UriWithExpirySet::setActive(bool active)
+{
+    mActive = active;
+    ExpiryScheduler::instance().cancel(mExpiryId);
+    mExpiryId = ExpiryScheduler::NULL_ID;
+    mScheduledExpiry = {};
+    scheduleExpiry();
+}
+
+void UriWithExpirySet::scheduleExpiry()
+{
+    if (!mActive)
+        return;
+
+    const auto* first = getFirstExpiry();
+    const QDateTime expiry = first ? first->getExpiry() : QDateTime{};
+
+    if (expiry == mScheduledExpiry)
+        return;
+
+    auto& scheduler = ExpiryScheduler::instance();
+    scheduler.cancel(mExpiryId);
+    mExpiryId = ExpiryScheduler::NULL_ID;
+    mScheduledExpiry = expiry;
+
+    if (expiry.isValid())
+        mExpiryId = scheduler.schedule(expiry, [this]{ handleExpiry(); });
+}
+
+void UriWithExpirySet::handleExpiry()
+{
+    mExpiryId = ExpiryScheduler::NULL_ID;
+    const auto* first = getFirstExpiry();
+
+    if (!first)
+        return;
+
+    const QString uri = first->getUri();
+    qDebug() << "Expired:" << uri << first->getExpiry();
+
+    // Retry later if the entry does not get removed.
+    mScheduledExpiry = QDateTime::currentDateTimeUtc().addDuration(RETRY_INTERVAL);
+    mExpiryId = ExpiryScheduler::instance().schedule(mScheduledExpiry, [this]{ handleExpiry(); });
+
+    emit expired(uri);
+}
+
 QDateTime UriWithExpirySet::getExpiry(const QString& uri) const
 {
     auto it = mUriMap.find(uri);
@@ -1,6 +1,7 @@
 // Copyright (C) 2025 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "expiry_scheduler.h"
 #include <QDateTime>
 #include <QJsonArray>
 #include <QJsonObject>
@@ -41,7 +42,12 @@ class UriWithExpirySet : public QObject
     Q_OBJECT
 
 public:
+    // When an expired entry does not get removed, expired is emitted again
+    // after this interval.
+    static constexpr auto RETRY_INTERVAL = std::chrono::seconds(59);
+
     explicit UriWithExpirySet(QObject* parent = nullptr);
+    ~UriWithExpirySet();
 
     void clear();
     void insert(const UriWithExpiry& uriWithExpiry);
@@ -52,10 +58,25 @@ public:
     QJsonArray toJson() const;
     void fromJson(const QJsonArray& jsonArray);
 
+    // While not active, e.g. when the app is paused, no expiry is scheduled.
+    // Activation schedules the first entry again, such that expired is emitted
+    // for an entry that expired meanwhile.
+    bool isActive() const { return mActive; }
+    void setActive(bool active);
+
+signals:
+    // The first entry has expired.
+    void expired(const QString& uri);
 
 private:
+    void scheduleExpiry();
+    void handleExpiry();
+
     std::set<UriWithExpiry> mUrisByExpiry;
     std::unordered_map<QString, std::set<UriWithExpiry>::iterator> mUriMap;
+    ExpiryScheduler::Id mExpiryId = ExpiryScheduler::NULL_ID;
+    QDateTime mScheduledExpiry;
+    bool mActive = true;
 };
 
 }
@@ -1622,6 +1622,16 @@ bool UserSettings::getThreadAutoSplit() const
     return mSettings.value("threadAutoSplit", false).toBool();
 }
 
+void UserSettings::setThreadBatchDisabled(bool disabled)
+{
+    mSettings.setValue("threadBatchDisabled", disabled);
+}
+
+bool UserSettings::getThreadBatchDisabled() const
+{
+    return mSettings.value("threadBatchDisabled", false).toBool();
+}
+
 void UserSettings::setUserHashtags(const QString& did, const QStringList& hashtags)
 {
     qDebug() << "Save user hashtags:" << did;
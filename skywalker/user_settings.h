@@ -116,6 +116,8 @@ public:
     explicit UserSettings(QObject* parent = nullptr);
     explicit UserSettings(const QString& fileName, QObject* parent = nullptr);
 
+    QString getFileName() const { return mSettings.fileName(); }
+
     Q_INVOKABLE QList<BasicProfile> getUserList() const;
 
     // Get the user list with a surrogate profile added for adding a new user account
@@ -373,6 +375,10 @@ public:
     Q_INVOKABLE void setThreadAutoSplit(bool autoSplit);
     Q_INVOKABLE bool getThreadAutoSplit() const;
 
+    // Set when the PDS computed other CIDs for a thread batch than we did.
+    void setThreadBatchDisabled(bool disabled);
+    bool getThreadBatchDisabled() const;
+
     Q_INVOKABLE QString getMutedRepostsListUri(const QString& did) const;
 
     void setUserHashtags(const QString& did, const QStringList& hashtags);
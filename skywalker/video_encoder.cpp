@@ -2,13 +2,24 @@
 // License: GPLv3
 #include "video_encoder.h"
 #include <QDebug>
+#include <QStandardPaths>
 
 namespace Skywalker {
 
-bool VideoEncoder::open(const QString& fileName, int width, int height, int fps, int bitRate)
+VideoEncoder::Ptr VideoEncoder::create()
 {
-    qDebug() << "file:" << fileName << "width:" << width << "height:" << height << "fps:" << fps << "bitRate:" << bitRate;
 #if defined(Q_OS_ANDROID)
+    return std::make_unique<JniVideoEncoder>();
+#else
+    return std::make_unique<FfmpegVideoEncoder>();
+#endif
+}
+
+#if defined(Q_OS_ANDROID)
+
+bool JniVideoEncoder::open(const QString& fileName, int width, int height, int fps, int bitRate)
+{
+    qDebug() << "file:" << fileName << "width:" << width << "height:" << height << "fps:" << fps << "bitRate:" << bitRate;
     Q_ASSERT(!mEncoder);
     // Dimension must be even numbers for the H.264 encoder
     Q_ASSERT((width & 1) == 0);
@@ -22,20 +33,10 @@ bool VideoEncoder::open(const QString& fileName, int width, int height, int fps,
                                                            (jint)width, (jint)height, (jint)fps,
                                                            (jint)bitRate);
     return (bool)result;
-#else
-    Q_UNUSED(fileName);
-    Q_UNUSED(width);
-    Q_UNUSED(height);
-    Q_UNUSED(fps);
-    Q_UNUSED(bitRate);
-    qWarning() << "Video encoding not supported!";
-    return false;
-#endif
 }
 
-bool VideoEncoder::close()
+bool JniVideoEncoder::close()
 {
-#if defined(Q_OS_ANDROID)
     if (mEncoder)
     {
         mEncoder->callMethod<void>("release", "()V");
@@ -43,15 +44,10 @@ bool VideoEncoder::close()
     }
 
     return true;
-#else
-    qWarning() << "Video encoding not supported!";
-    return false;
-#endif
 }
 
-bool VideoEncoder::push(const QImage& frame)
+bool JniVideoEncoder::push(const QImage& frame)
 {
-#if defined(Q_OS_ANDROID)
     Q_ASSERT(mWidth == frame.width());
     Q_ASSERT(mHeight == frame.height());
     QJniEnvironment env;
@@ -62,11 +58,131 @@ bool VideoEncoder::push(const QImage& frame)
     auto added = mEncoder->callMethod<jboolean>("addFrame", "([B)Z", jsFrame);
     env->DeleteLocalRef(jsFrame);
     return (bool)added;
+}
+
 #else
-    Q_UNUSED(frame);
-    qWarning() << "Video encoding not supported!";
-    return false;
-#endif
+
+QString FfmpegVideoEncoder::findFfmpeg()
+{
+    return QStandardPaths::findExecutable("ffmpeg");
+}
+
+bool FfmpegVideoEncoder::open(const QString& fileName, int width, int height, int fps, int bitRate)
+{
+    qDebug() << "file:" << fileName << "width:" << width << "height:" << height << "fps:" << fps << "bitRate:" << bitRate;
+    Q_ASSERT(!mProcess);
+    // Dimension must be even numbers for the H.264 encoder
+    Q_ASSERT((width & 1) == 0);
+    Q_ASSERT((height & 1) == 0);
+
+    mFfmpeg = findFfmpeg();
+
+    if (mFfmpeg.isEmpty())
+    {
+        qWarning() << "Video encoding not supported, ffmpeg not found";
+        return false;
+    }
+
+    mFileName = fileName;
+    mWidth = width;
+    mHeight = height;
+    mFps = fps;
+    mBitRate = bitRate;
+    mFailed = false;
+    return true;
+}
+
+bool FfmpegVideoEncoder::start()
+{
+    const QStringList arguments = {
+        "-hide_banner", "-loglevel", "error", "-y",
+        "-f", "rawvideo", "-pix_fmt", "rgba",
+        "-s", QString("%1x%2").arg(mWidth).arg(mHeight),
+        "-r", QString::number(mFps),
+        "-i", "-",
+        "-c:v", "libx264", "-pix_fmt", "yuv420p",
+        "-b:v", QString::number(mBitRate),
+        "-movflags", "+faststart",
+        mFileName
+    };
+
+    mProcess = std::make_unique<QProcess>();
+    mProcess->setStandardOutputFile(QProcess::nullDevice());
+    mProcess->start(mFfmpeg, arguments);
+
+    if (!mProcess->waitForStarted())
+    {
+        qWarning() << "Failed to start:" << mFfmpeg << mProcess->errorString();
+        mProcess = nullptr;
+        return false;
+    }
+
+    return true;
 }
 
+bool FfmpegVideoEncoder::push(const QImage& frame)
+{
+    Q_ASSERT(mWidth == frame.width());
+    Q_ASSERT(mHeight == frame.height());
+    Q_ASSERT(frame.format() == QImage::Format_RGBA8888);
+
+    if (mFailed || mFileName.isEmpty())
+        return false;
+
+    if (!mProcess && !start())
+    {
+        mFailed = true;
+        return false;
+    }
+
+    // RGBA8888 scan lines are never padded as each pixel takes 4 bytes.
+    const qint64 size = qint64(frame.width()) * frame.height() * 4;
+
+    if (mProcess->write((const char*)frame.constBits(), size) != size)
+    {
+        qWarning() << "Failed to write frame:" << mProcess->errorString();
+        mFailed = true;
+        return false;
+    }
+
+    // Wait for ffmpeg to take the frame to keep the pipe buffer bounded.
+    while (mProcess->bytesToWrite() > 0)
+    {
+        if (!mProcess->waitForBytesWritten(WRITE_TIMEOUT_MS))
+        {
+            qWarning() << "Failed to write frame:" << mProcess->errorString() << mProcess->readAllStandardError();
+            mFailed = true;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FfmpegVideoEncoder::close()
+{
+    if (!mProcess)
+        return !mFailed;
+
+    mProcess->closeWriteChannel();
+
+    if (!mProcess->waitForFinished(CLOSE_TIMEOUT_MS))
+    {
+        qWarning() << "ffmpeg did not finish:" << mProcess->errorString();
+        mProcess->kill();
+        mProcess->waitForFinished();
+        mFailed = true;
+    }
+    else if (mProcess->exitStatus() != QProcess::NormalExit || mProcess->exitCode() != 0)
+    {
+        qWarning() << "ffmpeg failed:" << mProcess->exitCode() << mProcess->readAllStandardError();
+        mFailed = true;
+    }
+
+    mProcess = nullptr;
+    return !mFailed;
+}
+
+#endif
+
 }
@@ -6,23 +6,75 @@
 
 #if defined(Q_OS_ANDROID)
 #include <QJniObject>
+#else
+#include <QProcess>
 #endif
 
 namespace Skywalker {
 
+// Encodes frames to an H.264 MP4 video file. Frames must be pushed in
+// QImage::Format_RGBA8888 with the size passed to open().
 class VideoEncoder
 {
 public:
-    bool open(const QString& fileName, int width, int height, int fps, int bitRate);
-    bool close();
-    bool push(const QImage& frame);
+    using Ptr = std::unique_ptr<VideoEncoder>;
+
+    // Creates the encoder for this platform.
+    static Ptr create();
+
+    virtual ~VideoEncoder() = default;
+    virtual bool open(const QString& fileName, int width, int height, int fps, int bitRate) = 0;
+    virtual bool close() = 0;
+    virtual bool push(const QImage& frame) = 0;
+};
 
-private:
 #if defined(Q_OS_ANDROID)
+
+// Encodes with the Android MediaCodec via QVideoEncoder.java
+class JniVideoEncoder : public VideoEncoder
+{
+public:
+    bool open(const QString& fileName, int width, int height, int fps, int bitRate) override;
+    bool close() override;
+    bool push(const QImage& frame) override;
+
+private:
     std::unique_ptr<QJniObject> mEncoder;
-#endif
     int mWidth = 0;
     int mHeight = 0;
 };
 
+#else
+
+// Encodes by piping raw frames to an ffmpeg process, for desktop platforms.
+// The process is started on the first push, such that push() and close()
+// can run on a different thread than open().
+class FfmpegVideoEncoder : public VideoEncoder
+{
+public:
+    static constexpr int WRITE_TIMEOUT_MS = 30000;
+    static constexpr int CLOSE_TIMEOUT_MS = 120000;
+
+    // Returns an empty string if ffmpeg is not installed.
+    static QString findFfmpeg();
+
+    bool open(const QString& fileName, int width, int height, int fps, int bitRate) override;
+    bool close() override;
+    bool push(const QImage& frame) override;
+
+private:
+    bool start();
+
+    std::unique_ptr<QProcess> mProcess;
+    QString mFfmpeg;
+    QString mFileName;
+    int mWidth = 0;
+    int mHeight = 0;
+    int mFps = 0;
+    int mBitRate = 0;
+    bool mFailed = false;
+};
+
+#endif
+
 }
@@ -1,6 +1,7 @@
 // Copyright (C) 2024 Michel de Boer
 // License: GPLv3
 #include "video_utils.h"
+#include "file_copier.h"
 #include "file_utils.h"
 #include "jni_callback.h"
 #include "post_utils.h"
@@ -9,7 +10,8 @@
 namespace Skywalker {
 
 VideoUtils::VideoUtils(QObject* parent) :
-    QObject(parent)
+    QObject(parent),
+    Presence()
 {
     auto& jniCallbackListener = JNICallbackListener::getInstance();
 
@@ -155,30 +157,24 @@ void VideoUtils::copyVideoToGallery(const QString& fileName)
 
     qDebug() << "Copy" << fileName << "to" << outputFileName;
 
-    QFile inputFile(fileName);
-    if (!inputFile.open(QFile::ReadOnly))
-    {
-        emit copyVideoFailed(tr("Failed read video"));
-        return;
-    }
-
-    QFile outputFile(outputFileName);
-    if (!outputFile.open(QFile::WriteOnly))
-    {
-        emit copyVideoFailed(tr("Failed write video"));
-        return;
-    }
-
-    if (outputFile.write(inputFile.readAll()) < 0)
-    {
-        emit copyVideoFailed(tr("Failed to copy video to gallery"));
-        return;
-    }
-
-    outputFile.flush();
-    outputFile.close();
-    indexGalleryFile(outputFileName);
-    emit copyVideoOk();
+    FileCopier::copyAsync(fileName, outputFileName,
+        [this, presence=getPresence()](qint64 bytesCopied, qint64 bytesTotal){
+            if (presence)
+                emit copyVideoProgress((double)bytesCopied / bytesTotal);
+        },
+        [this, presence=getPresence(), outputFileName]{
+            if (!presence)
+                return;
+
+            indexGalleryFile(outputFileName);
+            emit copyVideoOk();
+        },
+        [this, presence=getPresence()](const QString& error){
+            qWarning() << "Failed to copy video:" << error;
+
+            if (presence)
+                emit copyVideoFailed(tr("Failed to copy video to gallery"));
+        });
 }
 
 void VideoUtils::indexGalleryFile(const QString& fileName)
@@ -2,13 +2,14 @@
 // License: GPLv3
 #pragma once
 #include "video_cache.h"
+#include "presence.h"
 #include "signal_object.h"
 #include <QObject>
 #include <QtQmlIntegration>
 
 namespace Skywalker {
 
-class VideoUtils : public QObject
+class VideoUtils : public QObject, public Presence
 {
     Q_OBJECT
     Q_PROPERTY(bool transcoding READ isTranscoding NOTIFY transcodingChanged FINAL)
@@ -34,6 +35,7 @@ signals:
     void transcodingOk(QString inputFileName, QString outputFileName, int outputWidth, int outputHeight);
     void transcodingFailed(QString inputFileName, QString error);
     void transcodingChanged();
+    void copyVideoProgress(double progress);
     void copyVideoOk();
     void copyVideoFailed(QString error);
 
@@ -0,0 +1,161 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include "memory_cache.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace Skywalker {
+
+// Cache shared by all accounts. A value is stored once without viewer state,
+// e.g. follow or mute state, as this is the same for every account. The viewer
+// state of each account is kept in an overlay. get() returns the value as seen
+// by the active viewer as an owning handle, see MemoryCache.
+//
+// An overlay entry is a copy of the value with viewer state. Its cost, given
+// by the owner, is what the copy adds to the shared entry. When an overlay
+// entry is evicted, the shared entry is evicted too, so get() never returns a
+// value without the viewer state that the active viewer had.
+template<typename T>
+class ViewerCache
+{
+public:
+    using CostFunction = typename MemoryCache<QString, T>::CostFunction;
+
+    // Bytes that an overlay entry adds to the shared entry.
+    using ViewerCostFunction = std::function<qsizetype(const T& value)>;
+
+    // Returns value with the viewer state of viewerSource. With a default
+    // constructed viewerSource, the viewer state is removed.
+    using WithViewerFunction = std::function<T(const T& value, const T& viewerSource)>;
+    using HasViewerFunction = std::function<bool(const T& value)>;
+
+    // The overlay weighs less as its entries are small.
+    static constexpr int OVERLAY_WEIGHT_DIVISOR = 5;
+
+    ViewerCache(const QString& name, qsizetype maxCost, const CostFunction& costFun,
+                const ViewerCostFunction& viewerCostFun,
+                const WithViewerFunction& withViewerFun, const HasViewerFunction& hasViewerFun,
+                int weight = 0) :
+        mShared(name, maxCost, costFun, weight),
+        mOverlay(name + "Viewer", maxCost,
+                 [viewerCostFun](const QString& overlayKey, const T& value){
+                     return CacheCost::string(overlayKey) + viewerCostFun(value); },
+                 weight > 0 ? std::max(1, weight / OVERLAY_WEIGHT_DIVISOR) : 0),
+        mWithViewer(withViewerFun),
+        mHasViewer(hasViewerFun)
+    {
+        Q_ASSERT(viewerCostFun);
+        Q_ASSERT(mWithViewer);
+        Q_ASSERT(mHasViewer);
+        mOverlay.setEvictedCallback([this](const QString& overlayKey, const T&){ evictShared(overlayKey); });
+    }
+
+    const QString& getViewer() const { return mViewerDid; }
+    void setViewer(const QString& viewerDid) { mViewerDid = viewerDid; }
+
+    // The viewer state in value belongs to viewerDid, by default the active viewer.
+    void put(const QString& key, const T& value, const QString& viewerDid = {})
+    {
+        const QString& viewer = viewerDid.isEmpty() ? mViewerDid : viewerDid;
+        const bool hasViewer = mHasViewer(value);
+
+        if (hasViewer && !viewer.isEmpty())
+        {
+            mOverlay.insert(getOverlayKey(viewer, key), value);
+            mViewerDids.insert(viewer);
+        }
+
+        // Keep the overlays of the other viewers in sync with the new data.
+        for (const auto& did : mViewerDids)
+        {
+            if (hasViewer && did == viewer)
+                continue;
+
+            const QString overlayKey = getOverlayKey(did, key);
+            const auto old = mOverlay.get(overlayKey);
+
+            if (old)
+                mOverlay.insert(overlayKey, mWithViewer(value, *old));
+        }
+
+        mShared.insert(key, mWithViewer(value, T{}));
+    }
+
+    std::shared_ptr<const T> get(const QString& key) const
+    {
+        if (!mViewerDid.isEmpty())
+        {
+            auto value = mOverlay.get(getOverlayKey(mViewerDid, key));
+
+            if (value)
+                return value;
+        }
+
+        return mShared.get(key);
+    }
+
+    bool contains(const QString& key) const
+    {
+        return mShared.contains(key) ||
+               (!mViewerDid.isEmpty() && mOverlay.contains(getOverlayKey(mViewerDid, key)));
+    }
+
+    // Removes the viewer state of an account, e.g. when it signs out.
+    void removeViewer(const QString& viewerDid)
+    {
+        if (!mViewerDids.contains(viewerDid))
+            return;
+
+        const QString prefix = getOverlayKey(viewerDid, "");
+        mRemovingViewer = true;
+
+        for (const auto& overlayKey : mOverlay.keys())
+        {
+            if (overlayKey.startsWith(prefix))
+                mOverlay.remove(overlayKey);
+        }
+
+        mRemovingViewer = false;
+        mViewerDids.erase(viewerDid);
+    }
+
+    void clear()
+    {
+        mShared.clear();
+        mOverlay.clear();
+        mViewerDids.clear();
+    }
+
+    qsizetype size() const { return mShared.size(); }
+    qsizetype overlaySize() const { return mOverlay.size(); }
+
+private:
+    static QString getOverlayKey(const QString& viewerDid, const QString& key)
+    {
+        return viewerDid + '|' + key;
+    }
+
+    // Without its overlay entry, the shared entry would be returned to the
+    // viewer as if it has no viewer state.
+    void evictShared(const QString& overlayKey)
+    {
+        if (mRemovingViewer)
+            return;
+
+        const int separator = overlayKey.indexOf('|');
+
+        if (separator >= 0)
+            mShared.remove(overlayKey.sliced(separator + 1));
+    }
+
+    MemoryCache<QString, T> mShared; // key -> value without viewer state
+    MemoryCache<QString, T> mOverlay; // viewer did|key -> value with viewer state
+    std::unordered_set<QString> mViewerDids;
+    QString mViewerDid;
+    WithViewerFunction mWithViewer;
+    HasViewerFunction mHasViewer;
+    bool mRemovingViewer = false;
+};
+
+}
@@ -2,6 +2,7 @@
 // License: GPLv3
 #include "wrapped_skywalker.h"
 #include "skywalker.h"
+#include <QPointer>
 
 namespace Skywalker {
 
@@ -76,4 +77,21 @@ ATProto::PlcDirectoryClient& WrappedSkywalker::plcDirectory()
     return mSkywalker->getPlcDirectory();
 }
 
+ImageUploadPipeline::UploadFun WrappedSkywalker::makeBlobUploader()
+{
+    return [self=QPointer<WrappedSkywalker>(this)](const QByteArray& blob, const QString& mimeType,
+                                                   const ImageUploadPipeline::BlobSuccessCb& successCb,
+                                                   const ImageUploadPipeline::BlobErrorCb& errorCb){
+        if (!self || !self->bskyClient())
+        {
+            errorCb("NoClient", tr("Not signed in"));
+            return;
+        }
+
+        self->bskyClient()->uploadBlob(blob, mimeType,
+            [successCb](auto blob){ successCb(std::move(blob)); },
+            [errorCb](const QString& error, const QString& msg){ errorCb(error, msg); });
+    };
+}
+
 }
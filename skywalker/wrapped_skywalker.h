@@ -1,6 +1,7 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #pragma once
+#include "image_upload_pipeline.h"
 #include <atproto/lib/client.h>
 #include <atproto/lib/plc_directory_client.h>
 #include <QObject>
@@ -34,6 +35,10 @@ signals:
 protected:
     ATProto::Client* bskyClient();
     ATProto::PlcDirectoryClient& plcDirectory();
+
+    // Uploads blobs with the bsky client of this object.
+    ImageUploadPipeline::UploadFun makeBlobUploader();
+
     Skywalker* mSkywalker = nullptr;
 
     // If this DID is set, then the bsky session (client) for this user
@@ -1,21 +1,48 @@
 // Copyright (C) 2024 Michel de Boer
 // License: GPLv3
 #include "test_anniversary.h"
+#include "test_avatar_store.h"
 #include "test_content_filter.h"
+#include "test_content_filter_stats.h"
+#include "test_dag_cbor.h"
+#include "test_expiry_scheduler.h"
+#include "test_facet_index.h"
+#include "test_file_copier.h"
 #include "test_filtered_post_feed_model.h"
 #include "test_focus_hashtags.h"
+#include "test_gif_to_video_converter.h"
 #include "test_hashtag_index.h"
+#include "test_image_upload_pipeline.h"
+#include "test_language_identifier.h"
+#include "test_list_snapshot_store.h"
+#include "test_list_store.h"
+#include "test_local_post_model_changes.h"
+#include "test_media_prefetcher.h"
+#include "test_memory_cache.h"
+#include "test_message_list_model.h"
 #include "test_muted_words.h"
+#include "test_notification_list_model.h"
+#include "test_post.h"
 #include "test_post_feed_model.h"
+#include "test_post_filter_evaluator.h"
 #include "test_search_utils.h"
+#include "test_startup_tracer.h"
+#include "test_task_graph.h"
+#include "test_tenor_row_layout.h"
 #include "test_text_differ.h"
 #include "test_text_splitter.h"
+#include "test_timeline_update_scheduler.h"
 #include "test_unicode_fonts.h"
 #include "test_uri_with_expiry.h"
+#include "test_viewer_cache.h"
+#include <QCoreApplication>
 #include <QtTest/QTest>
 
 int main(int argc, char *argv[])
 {
+    // Event loop for tests with asynchronous callbacks
+    QCoreApplication app(argc, argv);
+
     TestAnniversary testAnniversary;
     QTest::qExec(&testAnniversary, argc, argv);
 
@@ -28,6 +55,9 @@ int main(int argc, char *argv[])
     TestHashTagIndex testHastTagIndex;
     QTest::qExec(&testHastTagIndex, argc, argv);
 
+    TestMemoryCache testMemoryCache;
+    QTest::qExec(&testMemoryCache, argc, argv);
+
     TestMutedWords testMutedWords;
     QTest::qExec(&testMutedWords, argc, argv);
 
@@ -52,5 +82,71 @@ int main(int argc, char *argv[])
     TestUriWithExpiry testUriWithExpiry;
     QTest::qExec(&testUriWithExpiry, argc, argv);
 
+    TestTimelineUpdateScheduler testTimelineUpdateScheduler;
+    QTest::qExec(&testTimelineUpdateScheduler, argc, argv);
+
+    TestLocalPostModelChanges testLocalPostModelChanges;
+    QTest::qExec(&testLocalPostModelChanges, argc, argv);
+
+    TestImageUploadPipeline testImageUploadPipeline;
+    QTest::qExec(&testImageUploadPipeline, argc, argv);
+
+    TestDagCbor testDagCbor;
+    QTest::qExec(&testDagCbor, argc, argv);
+
+    TestFacetIndex testFacetIndex;
+    QTest::qExec(&testFacetIndex, argc, argv);
+
+    TestFileCopier testFileCopier;
+    QTest::qExec(&testFileCopier, argc, argv);
+
+    TestLanguageIdentifier testLanguageIdentifier;
+    QTest::qExec(&testLanguageIdentifier, argc, argv);
+
+    TestAvatarStore testAvatarStore;
+    QTest::qExec(&testAvatarStore, argc, argv);
+
+    TestStartupTracer testStartupTracer;
+    QTest::qExec(&testStartupTracer, argc, argv);
+
+    TestTaskGraph testTaskGraph;
+    QTest::qExec(&testTaskGraph, argc, argv);
+
+    TestViewerCache testViewerCache;
+    QTest::qExec(&testViewerCache, argc, argv);
+
+    TestMessageListModel testMessageListModel;
+    QTest::qExec(&testMessageListModel, argc, argv);
+
+    TestPostFilterEvaluator testPostFilterEvaluator;
+    QTest::qExec(&testPostFilterEvaluator, argc, argv);
+
+    TestContentFilterStats testContentFilterStats;
+    QTest::qExec(&testContentFilterStats, argc, argv);
+
+    TestGifToVideoConverter testGifToVideoConverter;
+    QTest::qExec(&testGifToVideoConverter, argc, argv);
+
+    TestTenorRowLayout testTenorRowLayout;
+    QTest::qExec(&testTenorRowLayout, argc, argv);
+
+    TestMediaPrefetcher testMediaPrefetcher;
+    QTest::qExec(&testMediaPrefetcher, argc, argv);
+
+    TestPost testPost;
+    QTest::qExec(&testPost, argc, argv);
+
+    TestExpiryScheduler testExpiryScheduler;
+    QTest::qExec(&testExpiryScheduler, argc, argv);
+
+    TestListSnapshotStore testListSnapshotStore;
+    QTest::qExec(&testListSnapshotStore, argc, argv);
+
+    TestNotificationListModel testNotificationListModel;
+    QTest::qExec(&testNotificationListModel, argc, argv);
+
+    TestListStore testListStore;
+    QTest::qExec(&testListStore, argc, argv);
+
     return 0;
 }
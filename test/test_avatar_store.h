@@ -0,0 +1,300 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <avatar_store.h>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+// Minimal HTTP server serving an image per path with an ETag.
+class AvatarServer : public QTcpServer
+{
+public:
+    AvatarServer()
+    {
+        connect(this, &QTcpServer::newConnection, this, [this]{
+            while (QTcpSocket* socket = nextPendingConnection())
+            {
+                connect(socket, &QTcpSocket::readyRead, socket, [this, socket]{ handleRequest(socket); });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+    }
+
+    void setImage(const QString& path, const QByteArray& data, const QByteArray& etag)
+    {
+        mImages[path] = { data, etag };
+    }
+
+    void removeImage(const QString& path) { mImages.remove(path); }
+
+    QString url(const QString& path) const
+    {
+        return QString("http://127.0.0.1:%1%2").arg(serverPort()).arg(path);
+    }
+
+    int mRequests = 0;
+    int mConditionalRequests = 0;
+
+private:
+    void handleRequest(QTcpSocket* socket)
+    {
+        mBuffer[socket] += socket->readAll();
+
+        if (!mBuffer[socket].contains("\r\n\r\n"))
+            return;
+
+        const QByteArray request = mBuffer.take(socket);
+        const QList<QByteArray> lines = request.split('\n');
+        const QString path = QString::fromLatin1(lines.front().split(' ').value(1));
+        QByteArray ifNoneMatch;
+
+        for (const auto& line : lines)
+        {
+            if (line.toLower().startsWith("if-none-match:"))
+                ifNoneMatch = line.mid(line.indexOf(':') + 1).trimmed();
+        }
+
+        ++mRequests;
+
+        if (!ifNoneMatch.isEmpty())
+            ++mConditionalRequests;
+
+        QByteArray response;
+
+        if (!mImages.contains(path))
+        {
+            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+        }
+        else if (ifNoneMatch == mImages[path].second)
+        {
+            response = "HTTP/1.1 304 Not Modified\r\nETag: " + mImages[path].second + "\r\n\r\n";
+        }
+        else
+        {
+            const auto& [data, etag] = mImages[path];
+            response = "HTTP/1.1 200 OK\r\nContent-Type: image/png\r\nETag: " + etag +
+                       "\r\nContent-Length: " + QByteArray::number(data.size()) + "\r\n\r\n" + data;
+        }
+
+        socket->write(response);
+    }
+
+    QHash<QString, std::pair<QByteArray, QByteArray>> mImages;
+    QHash<QTcpSocket*, QByteArray> mBuffer;
+};
+
+class TestAvatarStore : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase()
+    {
+        QVERIFY(mServer.listen(QHostAddress::LocalHost));
+        mNetwork.setAutoDeleteReplies(true);
+    }
+
+    void init()
+    {
+        mDir = std::make_unique<QTemporaryDir>();
+        QVERIFY(mDir->isValid());
+        mServer.mRequests = 0;
+        mServer.mConditionalRequests = 0;
+    }
+
+    void storePath()
+    {
+        QCOMPARE(AvatarStore::getStorePath("/data/files/settings.conf"), QString("/data/files/avatars"));
+    }
+
+    void immutable()
+    {
+        QVERIFY(AvatarStore::isImmutable("https://cdn.bsky.app/img/avatar_thumbnail/plain/did:plc:foo/bafkreiabc@jpeg"));
+        QVERIFY(!AvatarStore::isImmutable("https://example.com/avatar.jpg"));
+    }
+
+    void avatar()
+    {
+        QVERIFY(AvatarStore::isAvatar("https://cdn.bsky.app/img/avatar/plain/did:plc:foo/bafkreiabc@jpeg"));
+        QVERIFY(!AvatarStore::isAvatar("https://cdn.bsky.app/img/feed_fullsize/plain/did:plc:foo/bafkreiabc@jpeg"));
+    }
+
+    void shared()
+    {
+        auto store = AvatarStore::getShared(mDir->path());
+        QCOMPARE(AvatarStore::getShared(mDir->path()), store);
+
+        QTemporaryDir otherDir;
+        QVERIFY(AvatarStore::getShared(otherDir.path()) != store);
+    }
+
+    void downloadAndRevalidate()
+    {
+        mServer.setImage("/a.png", "image-a", "\"a1\"");
+        AvatarStore store(mDir->path(), &mNetwork);
+
+        QCOMPARE(get(store, mServer.url("/a.png")), QByteArray("image-a"));
+        QCOMPARE(mServer.mRequests, 1);
+        QCOMPARE(store.getStats().mDownloads, 1);
+        QVERIFY(store.contains(mServer.url("/a.png")));
+
+        // Still fresh, no request
+        QCOMPARE(get(store, mServer.url("/a.png")), QByteArray("image-a"));
+        QCOMPARE(mServer.mRequests, 1);
+        QCOMPARE(store.getStats().mHits, 1);
+    }
+
+    void notModified()
+    {
+        mServer.setImage("/b.png", "image-b", "\"b1\"");
+        const QString url = mServer.url("/b.png");
+
+        {
+            AvatarStore store(mDir->path(), &mNetwork);
+            QCOMPARE(get(store, url), QByteArray("image-b"));
+        }
+
+        ageIndex();
+        AvatarStore store(mDir->path(), &mNetwork);
+        QCOMPARE(get(store, url), QByteArray("image-b"));
+        QCOMPARE(mServer.mRequests, 2);
+        QCOMPARE(mServer.mConditionalRequests, 1);
+        QCOMPARE(store.getStats().mNotModified, 1);
+        QCOMPARE(store.getStats().mDownloads, 0);
+    }
+
+    void modified()
+    {
+        mServer.setImage("/c.png", "image-c", "\"c1\"");
+        const QString url = mServer.url("/c.png");
+
+        {
+            AvatarStore store(mDir->path(), &mNetwork);
+            QCOMPARE(get(store, url), QByteArray("image-c"));
+        }
+
+        ageIndex();
+        mServer.setImage("/c.png", "image-c2", "\"c2\"");
+        AvatarStore store(mDir->path(), &mNetwork);
+        QCOMPARE(get(store, url), QByteArray("image-c2"));
+        QCOMPARE(store.getStats().mDownloads, 1);
+        QCOMPARE(store.getBlobCount(), 1);
+        QCOMPARE(blobFileCount(), 1);
+    }
+
+    void deduplicate()
+    {
+        mServer.setImage("/d1.png", "same-image", "\"d1\"");
+        mServer.setImage("/d2.png", "same-image", "\"d2\"");
+        AvatarStore store(mDir->path(), &mNetwork);
+
+        QCOMPARE(get(store, mServer.url("/d1.png")), QByteArray("same-image"));
+        QCOMPARE(get(store, mServer.url("/d2.png")), QByteArray("same-image"));
+        QCOMPARE(store.size(), 2);
+        QCOMPARE(store.getBlobCount(), 1);
+        QCOMPARE(blobFileCount(), 1);
+    }
+
+    void persistence()
+    {
+        mServer.setImage("/e.png", "image-e", "\"e1\"");
+        const QString url = mServer.url("/e.png");
+
+        {
+            AvatarStore store(mDir->path(), &mNetwork);
+            QCOMPARE(get(store, url), QByteArray("image-e"));
+        }
+
+        AvatarStore store(mDir->path(), &mNetwork);
+        QVERIFY(store.contains(url));
+        QCOMPARE(get(store, url), QByteArray("image-e"));
+        QCOMPARE(mServer.mRequests, 1);
+        QCOMPARE(store.getStats().mHits, 1);
+    }
+
+    void staleOnError()
+    {
+        mServer.setImage("/f.png", "image-f", "\"f1\"");
+        const QString url = mServer.url("/f.png");
+
+        {
+            AvatarStore store(mDir->path(), &mNetwork);
+            QCOMPARE(get(store, url), QByteArray("image-f"));
+        }
+
+        ageIndex();
+        mServer.removeImage("/f.png");
+        AvatarStore store(mDir->path(), &mNetwork);
+        QCOMPARE(get(store, url), QByteArray("image-f"));
+        QCOMPARE(mServer.mConditionalRequests, 1);
+    }
+
+    void notFound()
+    {
+        AvatarStore store(mDir->path(), &mNetwork);
+        QString error;
+        bool done = false;
+
+        store.get(mServer.url("/none.png"),
+            [](const QByteArray&){ QFAIL("Image should not exist"); },
+            [&error, &done](const QString& err){ error = err; done = true; });
+
+        QTRY_VERIFY(done);
+        QVERIFY(!error.isEmpty());
+        QVERIFY(!store.contains(mServer.url("/none.png")));
+    }
+
+private:
+    QByteArray get(AvatarStore& store, const QString& url)
+    {
+        QByteArray result;
+        bool done = false;
+
+        store.get(url,
+            [&result, &done](const QByteArray& data){ result = data; done = true; },
+            [&done](const QString& error){ qWarning() << error; done = true; });
+
+        if (!QTest::qWaitFor([&done]{ return done; }))
+            qWarning() << "Timeout:" << url;
+
+        return result;
+    }
+
+    // Make all entries older than MAX_AGE
+    void ageIndex()
+    {
+        QFile file(mDir->filePath("index.json"));
+        QVERIFY(file.open(QFile::ReadOnly));
+        QJsonObject json = QJsonDocument::fromJson(file.readAll()).object();
+        file.close();
+        QJsonArray entries = json["entries"].toArray();
+        const QString validated = QDateTime::currentDateTimeUtc().addDays(-2).toString(Qt::ISODate);
+
+        for (int i = 0; i < entries.size(); ++i)
+        {
+            QJsonObject entryJson = entries[i].toObject();
+            entryJson["validated"] = validated;
+            entries[i] = entryJson;
+        }
+
+        json["entries"] = entries;
+        QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+        file.write(QJsonDocument(json).toJson());
+    }
+
+    int blobFileCount() const
+    {
+        return (int)QDir(mDir->path()).entryList({ "*" }, QDir::Files).size() - 1; // minus index
+    }
+
+    AvatarServer mServer;
+    QNetworkAccessManager mNetwork;
+    std::unique_ptr<QTemporaryDir> mDir;
+};
@@ -235,6 +235,82 @@ private slots:
         QCOMPARE(visibility, QEnums::CONTENT_VISIBILITY_SHOW);
     }
 
+    void labelDecisionCache()
+    {
+        const ContentLabelList labels{ mLabelFoo, mLabelBar };
+
+        {
+            const auto [visibility, warning, index] = mContentFilter.getVisibilityAndWarning(mErnaux, labels);
+            QCOMPARE(visibility, QEnums::CONTENT_VISIBILITY_HIDE_POST);
+            QCOMPARE(index, 0);
+        }
+
+        // Following the author changes the decision key
+        mErnaux.setViewer("at://following");
+        mContentFilter.setListPref(FOLLOWING_LIST_URI, FOO_LABELER_DID, "foo", QEnums::CONTENT_PREF_VISIBILITY_SHOW);
+        {
+            const auto [visibility, warning, index] = mContentFilter.getVisibilityAndWarning(mErnaux, labels);
+            QCOMPARE(visibility, QEnums::CONTENT_VISIBILITY_WARN_POST);
+            QCOMPARE(warning, "bar title");
+            QCOMPARE(index, 1);
+        }
+
+        // Membership of a list with prefs changes the decision key
+        mContentFilter.setListPref(mListPhilosophers.getUri(), FOO_LABELER_DID, "bar", QEnums::CONTENT_PREF_VISIBILITY_SHOW);
+        {
+            const auto [visibility, warning, index] = mContentFilter.getVisibilityAndWarning(mErnaux, labels);
+            QCOMPARE(visibility, QEnums::CONTENT_VISIBILITY_WARN_POST);
+        }
+
+        mLabelPrefLists.addProfile(mListPhilosophers.getUri(), mErnaux, "at:item-ernaux");
+        {
+            const auto [visibility, warning, index] = mContentFilter.getVisibilityAndWarning(mErnaux, labels);
+            QCOMPARE(visibility, QEnums::CONTENT_VISIBILITY_SHOW);
+            QCOMPARE(index, -1);
+        }
+    }
+
+    void benchmarkVisibility()
+    {
+        // 20 subscribed labelers with 10 labels each
+        static constexpr int NUM_LABELERS = 20;
+        static constexpr int NUM_LABELS = 10;
+        ContentLabelList labels;
+
+        for (int i = 0; i < NUM_LABELERS; ++i)
+        {
+            const QString did = QString("did:labeler%1").arg(i);
+            ContentGroupMap groupMap;
+
+            for (int j = 0; j < NUM_LABELS; ++j)
+            {
+                const QString labelId = QString("label%1").arg(j);
+                groupMap[labelId] = { labelId, labelId + " title", labelId + " description", {}, false,
+                                      QEnums::CONTENT_VISIBILITY_WARN_POST, QEnums::LABEL_TARGET_CONTENT,
+                                      QEnums::LABEL_SEVERITY_INFO, did };
+            }
+
+            mContentFilter.addContentGroupMap(did, groupMap);
+            labels.push_back(ContentLabel{ did, "at:post", "cid-post", QString("label%1").arg(i % NUM_LABELS), {} });
+        }
+
+        std::vector<BasicProfile> authors;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const QString did = QString("did:author%1").arg(i);
+            authors.push_back(BasicProfile{ did, did + ".bsky.social", "", "" });
+        }
+
+        QBENCHMARK {
+            for (const auto& author : authors)
+            {
+                const auto [visibility, warning, index] = mContentFilter.getVisibilityAndWarning(author, labels);
+                QCOMPARE(visibility, QEnums::CONTENT_VISIBILITY_WARN_POST);
+            }
+        }
+    }
+
     void initUserSettings()
     {
         const ContentLabelList labels{ mLabelFoo };
@@ -0,0 +1,140 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <content_filter_stats.h>
+#include <list_store.h>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+using namespace std::chrono_literals;
+
+class TestContentFilterStats : public QObject
+{
+    Q_OBJECT
+private slots:
+    void cleanup()
+    {
+        mNextPostId = 1;
+    }
+
+    void timelineOrder()
+    {
+        ContentFilterStats stats(ListStore::NULL_STORE);
+
+        // Older page, newer post, post in between
+        for (int offset : { 10, 9, 8, 20, 2, 1, 15, 30, 9 })
+            stats.report(createPost(TEST_DATE + offset * 1s), QEnums::HIDE_REASON_REPLY, nullptr);
+
+        QCOMPARE(stats.total(), 9);
+        const auto& posts = stats.posts();
+
+        for (size_t i = 1; i < posts.size(); ++i)
+            QVERIFY(posts[i - 1]->getTimelineTimestamp() >= posts[i]->getTimelineTimestamp());
+
+        QCOMPARE(posts.front()->getTimelineTimestamp(), TEST_DATE + 30s);
+        QCOMPARE(posts.back()->getTimelineTimestamp(), TEST_DATE + 1s);
+    }
+
+    void counters()
+    {
+        ContentFilterStats stats(ListStore::NULL_STORE);
+        const BasicProfile author("did:plc:bar", "bar.bsky.social", "", "");
+        stats.report(createPost(TEST_DATE), QEnums::HIDE_REASON_MUTED_AUTHOR, author);
+        stats.report(createPost(TEST_DATE), QEnums::HIDE_REASON_MUTED_AUTHOR, author);
+        stats.report(createPost(TEST_DATE), QEnums::HIDE_REASON_REPOST, nullptr);
+        stats.report(createPost(TEST_DATE), QEnums::HIDE_REASON_LANGUAGE, QString("nl"));
+
+        QCOMPARE(stats.total(), 4);
+        QCOMPARE(stats.mutedAuthor(), 2);
+        QCOMPARE(stats.count(QEnums::HIDE_REASON_MUTED_AUTHOR), 2);
+        QCOMPARE(stats.reposts(), 1);
+        QCOMPARE(stats.language(), 1);
+        QCOMPARE(stats.entriesLanguage().at("nl"), 1);
+        QCOMPARE(stats.replies(), 0);
+
+        const auto authors = stats.authorsMutedAuthor();
+        QCOMPARE((int)authors.size(), 1);
+        QCOMPARE(authors[0].second, 2);
+
+        // Reporting the same post again is ignored
+        stats.report(createPost(TEST_DATE, 1), QEnums::HIDE_REASON_REPLY, nullptr);
+        QCOMPARE(stats.total(), 4);
+        QCOMPARE(stats.replies(), 0);
+
+        stats.clear();
+        QCOMPARE(stats.total(), 0);
+        QCOMPARE(stats.mutedAuthor(), 0);
+        QVERIFY(stats.authorsMutedAuthor().empty());
+    }
+
+    void evictOldest()
+    {
+        ContentFilterStats stats(ListStore::NULL_STORE);
+        const BasicProfile author("did:plc:bar", "bar.bsky.social", "", "");
+
+        // The oldest post is the only muted author post
+        stats.report(createPost(TEST_DATE), QEnums::HIDE_REASON_MUTED_AUTHOR, author);
+
+        for (int i = 1; i < MAX_POSTS; ++i)
+            stats.report(createPost(TEST_DATE + i * 1s), QEnums::HIDE_REASON_REPLY, nullptr);
+
+        QCOMPARE(stats.total(), MAX_POSTS);
+        QCOMPARE(stats.mutedAuthor(), 1);
+
+        stats.report(createPost(TEST_DATE + MAX_POSTS * 1s), QEnums::HIDE_REASON_REPLY, nullptr);
+        QCOMPARE(stats.total(), MAX_POSTS);
+        QCOMPARE(stats.mutedAuthor(), 0);
+        QVERIFY(stats.authorsMutedAuthor().empty());
+        QCOMPARE(stats.replies(), MAX_POSTS);
+        QCOMPARE(stats.posts().back()->getTimelineTimestamp(), TEST_DATE + 1s);
+    }
+
+    void copiesSharePosts()
+    {
+        ContentFilterStats stats(ListStore::NULL_STORE);
+        stats.report(createPost(TEST_DATE), QEnums::HIDE_REASON_REPLY, nullptr);
+
+        const ContentFilterStats copy = stats;
+        QCOMPARE(copy.total(), 1);
+        QCOMPARE(copy.replies(), 1);
+        QCOMPARE(copy.posts().front().get(), stats.posts().front().get());
+
+        stats.clear();
+        QCOMPARE(copy.total(), 1);
+        QCOMPARE(copy.posts().front()->getCid(), QString("cid1"));
+    }
+
+private:
+    static constexpr int MAX_POSTS = 2000;
+
+    static constexpr char const* POST_TEMPLATE = R"##({
+        "post": {
+            "uri": "at://did:plc:foo/app.bsky.feed.post/r%1",
+            "cid": "cid%1",
+            "author": {
+                "did": "did:plc:foo",
+                "handle": "foo.bsky.social"
+            },
+            "record": {
+                "$type": "app.bsky.feed.post",
+                "text": "Hello world!",
+                "createdAt": "%2"
+            },
+            "indexedAt": "%2"
+        }
+    })##";
+
+    const QDateTime TEST_DATE = QDateTime::fromString("2023-11-20T18:46:00.000Z", Qt::ISODateWithMs);
+
+    Post createPost(const QDateTime& timestamp, int postId = 0)
+    {
+        const QString id = QString::number(postId > 0 ? postId : mNextPostId++);
+        const QString data = QString(R"###({ "feed": [%1]})###").arg(
+            QString(POST_TEMPLATE).arg(id, timestamp.toString(Qt::ISODateWithMs)));
+        const auto json = QJsonDocument::fromJson(data.toUtf8());
+        const auto feed = ATProto::AppBskyFeed::OutputFeed::fromJson(json.object());
+        return Post(feed->mFeed.front());
+    }
+
+    int mNextPostId = 1;
+};
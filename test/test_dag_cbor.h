@@ -0,0 +1,87 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <dag_cbor.h>
+#include <tid.h>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestDagCbor : public QObject
+{
+    Q_OBJECT
+private slots:
+    void encode_data()
+    {
+        QTest::addColumn<QString>("json");
+        QTest::addColumn<QByteArray>("cbor");
+
+        // Test vectors from RFC 8949 appendix A
+        QTest::newRow("zero") << "0" << QByteArray::fromHex("00");
+        QTest::newRow("23") << "23" << QByteArray::fromHex("17");
+        QTest::newRow("24") << "24" << QByteArray::fromHex("1818");
+        QTest::newRow("1000") << "1000" << QByteArray::fromHex("1903e8");
+        QTest::newRow("1000000") << "1000000" << QByteArray::fromHex("1a000f4240");
+        QTest::newRow("-1") << "-1" << QByteArray::fromHex("20");
+        QTest::newRow("-1000") << "-1000" << QByteArray::fromHex("3903e7");
+        QTest::newRow("false") << "false" << QByteArray::fromHex("f4");
+        QTest::newRow("true") << "true" << QByteArray::fromHex("f5");
+        QTest::newRow("null") << "null" << QByteArray::fromHex("f6");
+        QTest::newRow("string") << "\"IETF\"" << QByteArray::fromHex("6449455446");
+        QTest::newRow("unicode") << "\"ü\"" << QByteArray::fromHex("62c3bc");
+        QTest::newRow("array") << "[1,[2,3],[4,5]]" << QByteArray::fromHex("8301820203820405");
+        QTest::newRow("map") << "{\"a\":1,\"b\":[2,3]}" << QByteArray::fromHex("a26161016162820203");
+        QTest::newRow("key order") << "{\"bb\":1,\"c\":2,\"a\":3}" << QByteArray::fromHex("a361610361630262626201");
+        QTest::newRow("bytes") << "{\"$bytes\":\"AQIDBA==\"}" << QByteArray::fromHex("4401020304");
+    }
+
+    void encode()
+    {
+        QFETCH(QString, json);
+        QFETCH(QByteArray, cbor);
+        const auto doc = QJsonDocument::fromJson(QString("[%1]").arg(json).toUtf8());
+        QCOMPARE(DagCbor::encode(doc.array().first()).toHex(), cbor.toHex());
+    }
+
+    void emptyRecordCid()
+    {
+        QCOMPARE(DagCbor::recordCid({}), "bafyreigbtj4x7ip5legnfznufuopl4sg4knzc2cof6duas4b3q2fy6swua");
+    }
+
+    void cidLink()
+    {
+        const QString cid = "bafyreigbtj4x7ip5legnfznufuopl4sg4knzc2cof6duas4b3q2fy6swua";
+        const QByteArray bytes = DagCbor::cidToBytes(cid);
+        QCOMPARE(bytes.size(), 36);
+        QCOMPARE(DagCbor::cidFromBytes(bytes), cid);
+
+        const QJsonObject link{{ "$link", cid }};
+        const QByteArray cbor = DagCbor::encode(link);
+        QCOMPARE(cbor.left(4).toHex(), QByteArray("d82a5825"));
+        QCOMPARE(cbor.mid(4, 1).toHex(), QByteArray("00"));
+        QCOMPARE(cbor.mid(5), bytes);
+    }
+
+    void tidEncode()
+    {
+        QCOMPARE(Tid::encode(0, 0), "2222222222222");
+        const QString tid = Tid::encode(1700000000000000, 42);
+        QVERIFY(Tid::isValid(tid));
+        QVERIFY(Tid::encode(1700000000000001, 0) > tid);
+    }
+
+    void tidNext()
+    {
+        QString prev = Tid::next();
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const QString tid = Tid::next();
+            QVERIFY(Tid::isValid(tid));
+            QVERIFY(tid > prev);
+            prev = tid;
+        }
+    }
+};
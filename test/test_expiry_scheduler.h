@@ -0,0 +1,92 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <expiry_scheduler.h>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestExpiryScheduler : public QObject
+{
+    Q_OBJECT
+private slots:
+    void expireInOrder()
+    {
+        ExpiryScheduler scheduler;
+        const auto now = QDateTime::currentDateTimeUtc();
+        QStringList expired;
+
+        scheduler.schedule(now.addMSecs(150), [&expired]{ expired.push_back("c"); });
+        scheduler.schedule(now.addMSecs(50), [&expired]{ expired.push_back("a"); });
+        scheduler.schedule(now.addMSecs(100), [&expired]{ expired.push_back("b"); });
+        QCOMPARE(scheduler.size(), 3);
+        QCOMPARE(scheduler.getNextExpiry(), now.addMSecs(50));
+
+        QTRY_COMPARE(expired.size(), 3);
+        QCOMPARE(expired, QStringList({ "a", "b", "c" }));
+        QCOMPARE(scheduler.size(), 0);
+        QVERIFY(!scheduler.getNextExpiry().isValid());
+    }
+
+    void expiredFromEventLoop()
+    {
+        ExpiryScheduler scheduler;
+        int expired = 0;
+        scheduler.schedule(QDateTime::currentDateTimeUtc().addSecs(-10), [&expired]{ ++expired; });
+        QCOMPARE(expired, 0);
+        QTRY_COMPARE(expired, 1);
+    }
+
+    void cancel()
+    {
+        ExpiryScheduler scheduler;
+        const auto now = QDateTime::currentDateTimeUtc();
+        QStringList expired;
+
+        const auto idA = scheduler.schedule(now.addMSecs(50), [&expired]{ expired.push_back("a"); });
+        scheduler.schedule(now.addMSecs(100), [&expired]{ expired.push_back("b"); });
+        scheduler.cancel(idA);
+        scheduler.cancel(idA);
+        scheduler.cancel(ExpiryScheduler::NULL_ID);
+        QCOMPARE(scheduler.size(), 1);
+        QCOMPARE(scheduler.getNextExpiry(), now.addMSecs(100));
+
+        QTRY_COMPARE(expired.size(), 1);
+        QCOMPARE(expired, QStringList({ "b" }));
+    }
+
+    void scheduleFromExpiredFn()
+    {
+        ExpiryScheduler scheduler;
+        int expired = 0;
+
+        std::function<void()> expiredFn = [&]{
+            if (++expired < 3)
+                scheduler.schedule(QDateTime::currentDateTimeUtc().addMSecs(10), expiredFn);
+        };
+
+        scheduler.schedule(QDateTime::currentDateTimeUtc().addMSecs(10), expiredFn);
+        QTRY_COMPARE(expired, 3);
+        QCOMPARE(scheduler.size(), 0);
+    }
+
+    void invalidExpiry()
+    {
+        ExpiryScheduler scheduler;
+        QCOMPARE(scheduler.schedule(QDateTime{}, []{}), ExpiryScheduler::NULL_ID);
+        QCOMPARE(scheduler.size(), 0);
+    }
+
+    void farExpiry()
+    {
+        ExpiryScheduler scheduler;
+        const auto expiry = QDateTime::currentDateTimeUtc().addYears(1);
+        int expired = 0;
+        scheduler.schedule(expiry, [&expired]{ ++expired; });
+        QCOMPARE(scheduler.getNextExpiry(), expiry);
+
+        scheduler.expire();
+        QCOMPARE(expired, 0);
+        QCOMPARE(scheduler.size(), 1);
+    }
+};
@@ -0,0 +1,143 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <facet_index.h>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestFacetIndex : public QObject
+{
+    Q_OBJECT
+private slots:
+    void incrementalEdits_data()
+    {
+        QTest::addColumn<QString>("oldText");
+        QTest::addColumn<QString>("newText");
+
+        QTest::newRow("insert mention") << "hello world" << "hello @alice.bsky.social world";
+        QTest::newRow("type in mention") << "hi @alic #tag" << "hi @alice #tag";
+        QTest::newRow("delete mention") << "hi @alice.bsky.social #tag" << "hi #tag";
+        QTest::newRow("split token") << "#foobar https://example.com" << "#foo bar https://example.com";
+        QTest::newRow("join tokens") << "#foo bar https://example.com" << "#foobar https://example.com";
+        QTest::newRow("space before") << "a#tag" << "a #tag";
+        QTest::newRow("replace link") << "see https://foo.com and #x" << "see https://bar.org/path and #x";
+        QTest::newRow("newline") << "#one\n#two\n@bob.test" << "#one\n#two #three\n@bob.test";
+        QTest::newRow("clear") << "#one @bob.test" << "";
+    }
+
+    void incrementalEdits()
+    {
+        QFETCH(QString, oldText);
+        QFETCH(QString, newText);
+
+        FacetIndex index;
+        index.update(oldText);
+        index.update(newText);
+        QCOMPARE(index.getText(), newText);
+        compareFacets(index.getFacets(), ATProto::RichTextMaster::parseFacets(newText));
+    }
+
+    void applyChange_data()
+    {
+        QTest::addColumn<QString>("oldText");
+        QTest::addColumn<int>("position");
+        QTest::addColumn<int>("charsRemoved");
+        QTest::addColumn<QString>("added");
+
+        QTest::newRow("insert mention") << "hello world" << 6 << 0 << "@alice.bsky.social ";
+        QTest::newRow("type in mention") << "hi @alic #tag" << 8 << 0 << "e";
+        QTest::newRow("delete mention") << "hi @alice.bsky.social #tag" << 3 << 19 << "";
+        QTest::newRow("split token") << "#foobar https://example.com" << 4 << 0 << " ";
+        QTest::newRow("replace link") << "see https://foo.com and #x" << 12 << 3 << "bar.org/path";
+        QTest::newRow("new block") << "#one\n#two" << 4 << 0 << " #three\n@bob.test";
+        QTest::newRow("beyond end") << "#one" << 2 << 10 << "x";
+    }
+
+    void applyChange()
+    {
+        QFETCH(QString, oldText);
+        QFETCH(int, position);
+        QFETCH(int, charsRemoved);
+        QFETCH(QString, added);
+
+        FacetIndex index;
+        index.update(oldText);
+        index.applyChange(position, charsRemoved, added);
+
+        const int removed = std::min(charsRemoved, (int)oldText.size() - position);
+        const QString newText = oldText.replace(position, removed, added);
+        QCOMPARE(index.getText(), newText);
+        compareFacets(index.getFacets(), ATProto::RichTextMaster::parseFacets(newText));
+    }
+
+    void parseTokenWindowOnly()
+    {
+        QString text;
+
+        for (int i = 0; i < 100; ++i)
+            text += QString("#tag%1 @user%1.bsky.social ").arg(i);
+
+        FacetIndex index;
+        index.update(text);
+        QCOMPARE(index.getLastParseLength(), text.size());
+
+        const int pos = text.indexOf("#tag50") + 4;
+        text.insert(pos, "x");
+        index.update(text);
+        QCOMPARE(index.getLastParseLength(), QString("#tagx50").size());
+        compareFacets(index.getFacets(), ATProto::RichTextMaster::parseFacets(text));
+
+        index.update(text);
+        QCOMPARE(index.getLastParseLength(), 0);
+    }
+
+    void findFacet()
+    {
+        FacetIndex index;
+        index.update("hi @alice #tag");
+
+        QVERIFY(!index.findFacet(0));
+        QVERIFY(!index.findFacet(3));
+
+        const auto* mention = index.findFacet(4);
+        QVERIFY(mention);
+        QCOMPARE(mention->mMatch, QString("@alice"));
+        QCOMPARE(index.findFacet(9), mention);
+
+        const auto* tag = index.findFacet(14);
+        QVERIFY(tag);
+        QCOMPARE(tag->mMatch, QString("#tag"));
+        QVERIFY(!index.findFacet(15));
+    }
+
+    void blockFacets()
+    {
+        FacetIndex index;
+        index.update("#one\nfoo #two\n#three");
+
+        const auto facets = index.getFacets(5, 13);
+        QCOMPARE((int)facets.size(), 1);
+        QCOMPARE(facets[0].mMatch, QString("#two"));
+        QCOMPARE(facets[0].mStartIndex, 4);
+        QCOMPARE(facets[0].mEndIndex, 8);
+
+        QVERIFY(index.matches(5, "foo #two"));
+        QVERIFY(!index.matches(5, "foo #twa"));
+        QVERIFY(!index.matches(18, "#three"));
+    }
+
+private:
+    void compareFacets(const FacetIndex::FacetList& actual, const FacetIndex::FacetList& expected)
+    {
+        QCOMPARE(actual.size(), expected.size());
+
+        for (size_t i = 0; i < actual.size(); ++i)
+        {
+            QCOMPARE(actual[i].mType, expected[i].mType);
+            QCOMPARE(actual[i].mMatch, expected[i].mMatch);
+            QCOMPARE(actual[i].mStartIndex, expected[i].mStartIndex);
+            QCOMPARE(actual[i].mEndIndex, expected[i].mEndIndex);
+        }
+    }
+};
@@ -0,0 +1,157 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <file_copier.h>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestFileCopier : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase()
+    {
+        QVERIFY(mDir.isValid());
+        mData = createData(3 * FileCopier::BUFFER_SIZE + 123);
+        QVERIFY(writeFile(path("input"), mData));
+    }
+
+    void copy_data()
+    {
+        QTest::addColumn<bool>("kernelCopy");
+        QTest::newRow("kernel") << true;
+        QTest::newRow("buffered") << false;
+    }
+
+    void copy()
+    {
+        QFETCH(bool, kernelCopy);
+        QFile from(path("input"));
+        QFile to(path("output"));
+        QVERIFY(from.open(QFile::ReadOnly));
+        QVERIFY(to.open(QFile::WriteOnly));
+
+        qint64 lastCopied = 0;
+        qint64 lastTotal = 0;
+        const auto progress = [&lastCopied, &lastTotal](qint64 copied, qint64 total){
+            QVERIFY(copied > lastCopied);
+            lastCopied = copied;
+            lastTotal = total;
+        };
+
+        QCOMPARE(FileCopier::copy(from, to, progress, kernelCopy), dataSize());
+        QCOMPARE(lastCopied, dataSize());
+        QCOMPARE(lastTotal, dataSize());
+        QCOMPARE(to.pos(), dataSize());
+        to.close();
+        QCOMPARE(readFile(path("output")), mData);
+    }
+
+    void copyFromPosition()
+    {
+        QFile from(path("input"));
+        QFile to(path("output"));
+        QVERIFY(from.open(QFile::ReadOnly));
+        QVERIFY(to.open(QFile::WriteOnly));
+        QVERIFY(from.seek(100));
+        QCOMPARE(to.write("header"), (qint64)6);
+
+        QCOMPARE(FileCopier::copy(from, to), dataSize() - 100);
+        QVERIFY(from.atEnd());
+        QCOMPARE(to.write("trailer"), (qint64)7);
+        to.close();
+        QCOMPARE(readFile(path("output")), "header" + mData.sliced(100) + "trailer");
+    }
+
+    void copyAsync()
+    {
+        bool done = false;
+        QString error;
+        qint64 lastCopied = 0;
+
+        FileCopier::copyAsync(path("input"), path("async"),
+            [&lastCopied](qint64 copied, qint64){ lastCopied = copied; },
+            [&done]{ done = true; },
+            [&done, &error](const QString& err){ error = err; done = true; });
+
+        QTRY_VERIFY(done);
+        QVERIFY(error.isEmpty());
+        QCOMPARE(lastCopied, dataSize());
+        QCOMPARE(readFile(path("async")), mData);
+    }
+
+    void copyAsyncError()
+    {
+        QString error;
+
+        FileCopier::copyAsync(path("does-not-exist"), path("async-error"),
+            {},
+            []{ QFAIL("Copy should fail"); },
+            [&error](const QString& err){ error = err; });
+
+        QTRY_VERIFY(!error.isEmpty());
+        QVERIFY(!QFile::exists(path("async-error")));
+    }
+
+    // Compare with reading the whole file in memory. The streaming copy
+    // uses at most BUFFER_SIZE of memory, independent of the file size.
+    void benchmarkCopy_data()
+    {
+        QTest::addColumn<int>("method");
+        QTest::newRow("readAll") << 0;
+        QTest::newRow("buffered") << 1;
+        QTest::newRow("kernel") << 2;
+    }
+
+    void benchmarkCopy()
+    {
+        QFETCH(int, method);
+        const QString input = path("large");
+
+        if (!QFile::exists(input))
+            QVERIFY(writeFile(input, createData(64 * 1024 * 1024)));
+
+        QBENCHMARK {
+            QFile from(input);
+            QFile to(path("large-copy"));
+            QVERIFY(from.open(QFile::ReadOnly));
+            QVERIFY(to.open(QFile::WriteOnly));
+
+            if (method == 0)
+                QCOMPARE(to.write(from.readAll()), from.size());
+            else
+                QCOMPARE(FileCopier::copy(from, to, {}, method == 2), from.size());
+        }
+    }
+
+private:
+    QString path(const QString& name) const { return mDir.filePath(name); }
+    qint64 dataSize() const { return mData.size(); }
+
+    static QByteArray createData(qsizetype size)
+    {
+        QByteArray data(size, Qt::Uninitialized);
+
+        for (qsizetype i = 0; i < size; ++i)
+            data[i] = char((i * 31 + i / 7) & 0xff);
+
+        return data;
+    }
+
+    static bool writeFile(const QString& fileName, const QByteArray& data)
+    {
+        QFile file(fileName);
+        return file.open(QFile::WriteOnly) && file.write(data) == data.size();
+    }
+
+    static QByteArray readFile(const QString& fileName)
+    {
+        QFile file(fileName);
+        return file.open(QFile::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    QTemporaryDir mDir;
+    QByteArray mData;
+};
@@ -0,0 +1,274 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <frame_ring_buffer.h>
+#include <gif_to_video_converter.h>
+#include <temp_file_holder.h>
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+#include <atomic>
+
+using namespace Skywalker;
+
+class TestGifToVideoConverter : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase()
+    {
+        QVERIFY(mDir.isValid());
+    }
+
+    void frameRingBuffer()
+    {
+        FrameRingBuffer buffer(4);
+        QCOMPARE(buffer.capacity(), 4);
+        std::atomic<int> maxSize = 0;
+
+        std::unique_ptr<QThread> producer(QThread::create([&buffer, &maxSize]{
+            for (int i = 0; i < 100; ++i)
+            {
+                QImage frame(1, 1, QImage::Format_RGBA8888);
+                frame.setPixel(0, 0, i);
+                buffer.push(std::move(frame));
+                maxSize = std::max(maxSize.load(), buffer.size());
+            }
+
+            buffer.close();
+        }));
+
+        producer->start();
+        std::vector<int> values;
+
+        while (const auto frame = buffer.pop())
+            values.push_back(frame->pixel(0, 0) & 0xff);
+
+        producer->wait();
+        QCOMPARE((int)values.size(), 100);
+
+        for (int i = 0; i < (int)values.size(); ++i)
+            QCOMPARE(values[i], i);
+
+        QVERIFY(maxSize <= 4);
+    }
+
+    void frameRingBufferCancel()
+    {
+        FrameRingBuffer buffer(2);
+        QVERIFY(buffer.push(QImage(1, 1, QImage::Format_RGBA8888)));
+        QVERIFY(buffer.push(QImage(1, 1, QImage::Format_RGBA8888)));
+        std::atomic<bool> pushed = true;
+
+        // Blocks on the full buffer till canceled
+        std::unique_ptr<QThread> producer(QThread::create([&buffer, &pushed]{
+            pushed = buffer.push(QImage(1, 1, QImage::Format_RGBA8888));
+        }));
+
+        producer->start();
+        QVERIFY(!producer->wait(50));
+        buffer.cancel();
+        QVERIFY(producer->wait(5000));
+        QVERIFY(!pushed);
+        QVERIFY(!buffer.pop());
+    }
+
+    void convert()
+    {
+        const QString gif = writeGif("small.gif", 64, 48, 10);
+        std::atomic<int> frames = 0;
+        GifToVideoConverter converter;
+        converter.setEncoderFactory([&frames]{ return std::make_unique<CountingVideoEncoder>(frames); });
+
+        QSignalSpy okSpy(&converter, &GifToVideoConverter::conversionOk);
+        QSignalSpy progressSpy(&converter, &GifToVideoConverter::conversionProgress);
+        converter.convert(gif);
+        QTRY_COMPARE_WITH_TIMEOUT(okSpy.count(), 1, 10000);
+
+        QVERIFY(frames >= 9 && frames <= 11);
+        QCOMPARE(progressSpy.count(), frames.load());
+        TempFileHolder::instance().remove(okSpy.first().first().toString());
+    }
+
+    void encoderFailure()
+    {
+        const QString gif = writeGif("fail.gif", 64, 48, 10);
+        std::atomic<int> frames = 0;
+        GifToVideoConverter converter;
+        converter.setEncoderFactory([&frames]{ return std::make_unique<CountingVideoEncoder>(frames, 3); });
+
+        QSignalSpy okSpy(&converter, &GifToVideoConverter::conversionOk);
+        QSignalSpy failedSpy(&converter, &GifToVideoConverter::conversionFailed);
+        converter.convert(gif);
+        QTRY_COMPARE_WITH_TIMEOUT(failedSpy.count(), 1, 10000);
+        QCOMPARE(okSpy.count(), 0);
+        QCOMPARE(frames.load(), 3);
+    }
+
+#if !defined(Q_OS_ANDROID)
+    void ffmpegEncoder()
+    {
+        if (FfmpegVideoEncoder::findFfmpeg().isEmpty())
+            QSKIP("ffmpeg not installed");
+
+        const QString gif = writeGif("ffmpeg.gif", 64, 48, 10);
+        GifToVideoConverter converter;
+        QSignalSpy okSpy(&converter, &GifToVideoConverter::conversionOk);
+        QSignalSpy failedSpy(&converter, &GifToVideoConverter::conversionFailed);
+        converter.convert(gif);
+        QTRY_VERIFY_WITH_TIMEOUT(okSpy.count() + failedSpy.count() > 0, 30000);
+
+        if (!failedSpy.empty())
+            QSKIP("ffmpeg without libx264");
+
+        const QString video = okSpy.first().first().toString();
+        QVERIFY(QFileInfo(video).size() > 0);
+        TempFileHolder::instance().remove(video);
+    }
+#endif
+
+    // Decoding and color conversion overlap with encoding. The encoder
+    // simulates the time a hardware encoder takes per frame.
+    void benchmarkFramesPerSecond()
+    {
+        const int frameCount = 60;
+        const QString gif = writeGif("large.gif", 720, 480, frameCount);
+        std::atomic<int> frames = 0;
+        GifToVideoConverter converter;
+        converter.setEncoderFactory([&frames]{ return std::make_unique<CountingVideoEncoder>(frames, -1, 2); });
+
+        QSignalSpy okSpy(&converter, &GifToVideoConverter::conversionOk);
+        QElapsedTimer timer;
+        timer.start();
+        converter.convert(gif);
+        QTRY_COMPARE_WITH_TIMEOUT(okSpy.count(), 1, 60000);
+        const qint64 elapsedMs = std::max(timer.elapsed(), qint64(1));
+
+        qInfo() << "GIF 720x480 frames:" << frames.load() << "ms:" << elapsedMs
+                << "frames/s:" << frames * 1000.0 / elapsedMs;
+        QVERIFY(frames >= frameCount - 1);
+        TempFileHolder::instance().remove(okSpy.first().first().toString());
+    }
+
+private:
+    class CountingVideoEncoder : public VideoEncoder
+    {
+    public:
+        // Push fails after failAfter frames (-1 is never). Each push takes at least pushMs.
+        explicit CountingVideoEncoder(std::atomic<int>& frames, int failAfter = -1, int pushMs = 0) :
+            mFrames(frames), mFailAfter(failAfter), mPushMs(pushMs) {}
+
+        bool open(const QString&, int width, int height, int, int) override
+        {
+            mSize = QSize(width, height);
+            return true;
+        }
+
+        bool close() override { return true; }
+
+        bool push(const QImage& frame) override
+        {
+            if (frame.size() != mSize || frame.format() != QImage::Format_RGBA8888)
+                return false;
+
+            if (mFailAfter >= 0 && mFrames >= mFailAfter)
+                return false;
+
+            if (mPushMs > 0)
+                QThread::msleep(mPushMs);
+
+            ++mFrames;
+            return true;
+        }
+
+    private:
+        std::atomic<int>& mFrames;
+        int mFailAfter;
+        int mPushMs;
+        QSize mSize;
+    };
+
+    // Writes an animated GIF with 128 colors. The LZW data is uncompressed:
+    // 8-bit codes with a clear code before the code size would grow.
+    QString writeGif(const QString& name, int width, int height, int frameCount)
+    {
+        const QString fileName = mDir.filePath(name);
+
+        if (QFile::exists(fileName))
+            return fileName;
+
+        QByteArray data("GIF89a");
+        const auto addShort = [&data](int value){
+            data.append(char(value & 0xff));
+            data.append(char((value >> 8) & 0xff));
+        };
+
+        addShort(width);
+        addShort(height);
+        data.append(char(0xf6)); // global color table of 2^(6+1) colors
+        data.append(2, '\0');
+
+        for (int i = 0; i < 128; ++i)
+        {
+            data.append(char(i * 2));
+            data.append(char(255 - i * 2));
+            data.append(char((i * 37) & 0xff));
+        }
+
+        static constexpr int MIN_CODE_SIZE = 7;
+        static constexpr char CLEAR_CODE = char(128);
+        static constexpr char END_CODE = char(129);
+        static constexpr int CODES_PER_CLEAR = 120;
+
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            data.append("\x21\xf9\x04\x04", 4); // graphic control extension
+            addShort(4); // delay in 1/100 s
+            data.append(2, '\0');
+
+            data.append(char(0x2c)); // image descriptor
+            addShort(0);
+            addShort(0);
+            addShort(width);
+            addShort(height);
+            data.append('\0');
+            data.append(char(MIN_CODE_SIZE));
+
+            QByteArray codes;
+            codes.reserve(width * height * 2);
+
+            for (int i = 0; i < width * height; ++i)
+            {
+                if (i % CODES_PER_CLEAR == 0)
+                    codes.append(CLEAR_CODE);
+
+                const int x = i % width;
+                const int y = i / width;
+                codes.append(char((x / 8 + y / 8 + frame) % 128));
+            }
+
+            codes.append(END_CODE);
+
+            for (qsizetype i = 0; i < codes.size(); i += 255)
+            {
+                const qsizetype blockSize = std::min(qsizetype(255), codes.size() - i);
+                data.append(char(blockSize));
+                data.append(codes.sliced(i, blockSize));
+            }
+
+            data.append('\0');
+        }
+
+        data.append(char(0x3b));
+
+        QFile file(fileName);
+
+        if (!file.open(QFile::WriteOnly) || file.write(data) != data.size())
+            qWarning() << "Failed to write:" << fileName;
+
+        return fileName;
+    }
+
+    QTemporaryDir mDir;
+};
@@ -0,0 +1,196 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <image_upload_pipeline.h>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QTimer>
+#include <QtTest/QTest>
+#include <atomic>
+
+using namespace Skywalker;
+
+class TestImageUploadPipeline : public QObject
+{
+    Q_OBJECT
+private slots:
+    void uploadInOrder()
+    {
+        // Simulated PDS with 50ms upload latency
+        int inFlight = 0;
+        int maxInFlight = 0;
+        int uploads = 0;
+        const auto uploader = [&inFlight, &maxInFlight, &uploads](const QByteArray&, const QString&,
+                                  const ImageUploadPipeline::BlobSuccessCb& successCb,
+                                  const ImageUploadPipeline::BlobErrorCb&){
+            ++uploads;
+            maxInFlight = std::max(++inFlight, maxInFlight);
+            QTimer::singleShot(50, [&inFlight, successCb]{
+                --inFlight;
+                successCb(nullptr);
+            });
+        };
+
+        auto pipeline = ImageUploadPipeline::create(uploader, encode, load);
+        std::vector<ImageUploadPipeline::Image> images;
+
+        for (int i = 1; i <= 6; ++i)
+            images.push_back({ QImage(i, 1, QImage::Format_RGB32), QString("image%1.jpg").arg(i) });
+
+        std::vector<ImageUploadPipeline::UploadedImage> result;
+        bool done = false;
+        int progress = 0;
+        pipeline->setProgressCb([&progress](int uploaded, int){ progress = uploaded; });
+
+        QElapsedTimer timer;
+        timer.start();
+
+        pipeline->start(std::move(images),
+            [&result, &done](auto uploaded){ result = std::move(uploaded); done = true; },
+            [&done](int, const QString&, const QString&){ done = true; });
+
+        QTRY_VERIFY_WITH_TIMEOUT(done, 5000);
+        qDebug() << "Pipeline upload time:" << timer.elapsed() << "ms";
+
+        QCOMPARE(uploads, 6);
+        QCOMPARE(progress, 6);
+        QVERIFY(maxInFlight > 1);
+        QVERIFY(maxInFlight <= ImageUploadPipeline::MAX_UPLOADS_IN_FLIGHT);
+        QCOMPARE((int)result.size(), 6);
+
+        for (int i = 0; i < 6; ++i)
+            QCOMPARE(result[i].mSize.width(), i + 1);
+    }
+
+    void encodeFailure()
+    {
+        int uploads = 0;
+        const auto uploader = [&uploads](const QByteArray&, const QString&,
+                                  const ImageUploadPipeline::BlobSuccessCb& successCb,
+                                  const ImageUploadPipeline::BlobErrorCb&){
+            ++uploads;
+            QTimer::singleShot(10, [successCb]{ successCb(nullptr); });
+        };
+
+        auto pipeline = ImageUploadPipeline::create(uploader, encode, load);
+        std::vector<ImageUploadPipeline::Image> images{
+            { QImage(1, 1, QImage::Format_RGB32), "image1.jpg" },
+            { QImage(), "broken.jpg" }
+        };
+
+        bool success = false;
+        int failedIndex = -1;
+        QString failedError;
+
+        pipeline->start(std::move(images),
+            [&success](auto){ success = true; },
+            [&failedIndex, &failedError](int index, const QString& error, const QString&){
+                failedIndex = index;
+                failedError = error;
+            });
+
+        QTRY_COMPARE_WITH_TIMEOUT(failedIndex, 1, 5000);
+        QCOMPARE(failedError, ImageUploadPipeline::ERROR_ENCODE_FAILED);
+        QVERIFY(pipeline->isCancelled());
+
+        // Pending work must not call back after the failure.
+        QTest::qWait(50);
+        QVERIFY(!success);
+    }
+
+    void uploadFailure()
+    {
+        const auto uploader = [](const QByteArray&, const QString&,
+                                 const ImageUploadPipeline::BlobSuccessCb&,
+                                 const ImageUploadPipeline::BlobErrorCb& errorCb){
+            QTimer::singleShot(10, [errorCb]{ errorCb("BlobTooLarge", "too large"); });
+        };
+
+        auto pipeline = ImageUploadPipeline::create(uploader, encode, load);
+        std::vector<ImageUploadPipeline::Image> images{
+            { QImage(1, 1, QImage::Format_RGB32), "image1.jpg" },
+            { QImage(2, 1, QImage::Format_RGB32), "image2.jpg" }
+        };
+
+        int failures = 0;
+        QString failedMsg;
+
+        pipeline->start(std::move(images),
+            [](auto){ QFAIL("unexpected success"); },
+            [&failures, &failedMsg](int, const QString&, const QString& msg){
+                ++failures;
+                failedMsg = msg;
+            });
+
+        QTRY_COMPARE_WITH_TIMEOUT(failures, 1, 5000);
+        QCOMPARE(failedMsg, "too large");
+        QTest::qWait(50);
+        QCOMPARE(failures, 1);
+    }
+
+    void loadAndEncodeInFlight()
+    {
+        const auto uploader = [](const QByteArray&, const QString&,
+                                 const ImageUploadPipeline::BlobSuccessCb& successCb,
+                                 const ImageUploadPipeline::BlobErrorCb&){
+            QTimer::singleShot(1, [successCb]{ successCb(nullptr); });
+        };
+
+        // Simulated slow decoding
+        static std::atomic<int> sEncoding = 0;
+        static std::atomic<int> sMaxEncoding = 0;
+        sEncoding = 0;
+        sMaxEncoding = 0;
+        const auto slowEncode = [](QByteArray& blob, QImage img, const QString& name){
+            const int encoding = ++sEncoding;
+            int maxEncoding = sMaxEncoding;
+
+            while (encoding > maxEncoding && !sMaxEncoding.compare_exchange_weak(maxEncoding, encoding))
+                ;
+
+            QThread::msleep(20);
+            --sEncoding;
+            return encode(blob, img, name);
+        };
+
+        auto pipeline = ImageUploadPipeline::create(uploader, slowEncode, load);
+        pipeline->setMaxEncodesInFlight(2);
+        std::vector<ImageUploadPipeline::Image> images;
+
+        // Images without pixels are loaded by the pipeline.
+        for (int i = 1; i <= 6; ++i)
+            images.push_back({ {}, QString("%1").arg(i) });
+
+        std::vector<ImageUploadPipeline::UploadedImage> result;
+        bool done = false;
+
+        pipeline->start(std::move(images),
+            [&result, &done](auto uploaded){ result = std::move(uploaded); done = true; },
+            [&done](int, const QString&, const QString&){ done = true; });
+
+        QTRY_VERIFY_WITH_TIMEOUT(done, 5000);
+        QCOMPARE((int)result.size(), 6);
+        QVERIFY(sMaxEncoding <= 2);
+
+        for (int i = 0; i < 6; ++i)
+            QCOMPARE(result[i].mSize.width(), i + 1);
+    }
+
+private:
+    // The name of a test image is its width, other names fail to load.
+    static QImage load(const QString& name)
+    {
+        bool ok = false;
+        const int width = name.toInt(&ok);
+        return ok ? QImage(width, 1, QImage::Format_RGB32) : QImage();
+    }
+
+    static std::tuple<QString, QSize> encode(QByteArray& blob, QImage img, const QString& name)
+    {
+        if (img.isNull())
+            return {};
+
+        blob = name.toUtf8();
+        return { "image/jpeg", img.size() };
+    }
+};
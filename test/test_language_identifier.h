@@ -0,0 +1,153 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <language_identifier.h>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestLanguageIdentifier : public QObject
+{
+    Q_OBJECT
+private slots:
+    void identifyLatin_data()
+    {
+        QTest::addColumn<QString>("text");
+        QTest::addColumn<QString>("language");
+
+        QTest::newRow("en") << "I think this is going to be a really good day for all of us" << "en";
+        QTest::newRow("de") << "Das ist wirklich eine sehr gute Idee, danke für den Hinweis" << "de";
+        QTest::newRow("fr") << "Merci beaucoup pour votre aide, elle était très précieuse" << "fr";
+        QTest::newRow("es") << "Gracias por compartir, me encanta esta foto de la playa" << "es";
+        QTest::newRow("nl") << "Dank je wel voor het delen, dit is echt een mooie foto" << "nl";
+        QTest::newRow("links ignored") << "Check this out https://example.com/some/path @alice.bsky.social #news today" << "en";
+        QTest::newRow("too short") << "Hello world" << "";
+        QTest::newRow("no words") << "😂😂😂😂😂😂😂😂😂😂😂😂" << "";
+        QTest::newRow("vi unsupported") << "Hôm nay trời đẹp quá, chúng tôi đi dạo công viên" << "";
+        QTest::newRow("hu unsupported") << "Ma nagyon szép idő van, elmegyünk sétálni a parkba" << "";
+        QTest::newRow("cs unsupported") << "Dnes je krásné počasí, půjdeme se projít do parku" << "";
+    }
+
+    void identifyLatin()
+    {
+        QFETCH(QString, text);
+        QFETCH(QString, language);
+        QCOMPARE(LanguageIdentifier::instance().identify(text).mLanguageCode, language);
+    }
+
+    void identifyScript_data()
+    {
+        QTest::addColumn<QString>("text");
+        QTest::addColumn<QString>("language");
+
+        QTest::newRow("ja") << "今日はとても良い天気ですね。散歩に行きましょう。" << "ja";
+        QTest::newRow("zh") << "今天天气很好，我们一起去公园散步吧，好不好呢？" << "zh";
+        QTest::newRow("ko") << "오늘 날씨가 정말 좋네요. 같이 산책하러 갈까요?" << "ko";
+        QTest::newRow("ru") << "Сегодня очень хорошая погода, пойдём гулять в парк" << "ru";
+        QTest::newRow("uk") << "Сьогодні дуже гарна погода, ходімо гуляти в парк" << "uk";
+        QTest::newRow("el") << "Σήμερα ο καιρός είναι πολύ ωραίος, πάμε βόλτα" << "el";
+    }
+
+    void identifyScript()
+    {
+        QFETCH(QString, text);
+        QFETCH(QString, language);
+        QCOMPARE(LanguageIdentifier::instance().identify(text).mLanguageCode, language);
+    }
+
+    void excludeLanguages()
+    {
+        const auto& identifier = LanguageIdentifier::instance();
+        const QString text = "I think this is going to be a really good day for all of us";
+        QCOMPARE(identifier.identify(text).mLanguageCode, QString("en"));
+        QVERIFY(identifier.identify(text, { "en" }).mLanguageCode != "en");
+        QCOMPARE(identifier.identify(QString("Сегодня очень хорошая погода, пойдём гулять"), { "ru" }).mLanguageCode, QString());
+    }
+
+    void batch()
+    {
+        const QStringList texts = sampleTexts();
+        const auto results = LanguageIdentifier::instance().identify(texts);
+        QCOMPARE((int)results.size(), (int)texts.size());
+
+        for (int i = 0; i < texts.size(); ++i)
+            QCOMPARE(results[i].mLanguageCode, LanguageIdentifier::instance().identify(texts[i]).mLanguageCode);
+    }
+
+    // Sentences that are not used to build the profiles.
+    void accuracy()
+    {
+        int correct = 0;
+
+        for (const auto& sample : SAMPLES)
+        {
+            const auto result = LanguageIdentifier::instance().identify(QString::fromUtf8(sample.mText));
+
+            if (result.mLanguageCode == sample.mLanguage)
+                ++correct;
+            else
+                qDebug() << "Wrong:" << sample.mLanguage << result.mLanguageCode << result.mConfidence << sample.mText;
+        }
+
+        const double accuracy = (double)correct / std::size(SAMPLES);
+        qDebug() << "Accuracy:" << accuracy << correct << "/" << std::size(SAMPLES);
+        QVERIFY(accuracy >= 0.9);
+    }
+
+    void benchmarkThroughput()
+    {
+        const QStringList texts = sampleTexts();
+        const auto& identifier = LanguageIdentifier::instance();
+
+        QBENCHMARK {
+            const auto results = identifier.identify(texts);
+            QCOMPARE((int)results.size(), (int)texts.size());
+        }
+    }
+
+private:
+    struct Sample
+    {
+        const char* mLanguage;
+        const char* mText;
+    };
+
+    static constexpr Sample SAMPLES[] = {
+        { "en", "The weather was terrible so we stayed inside and watched movies" },
+        { "en", "My cat keeps knocking things off the table every morning" },
+        { "de", "Kann mir jemand erklären, warum der Bus schon wieder zu spät ist?" },
+        { "de", "Meine Schwester hat am Wochenende ihren Geburtstag gefeiert" },
+        { "fr", "Mon chat fait tomber les objets de la table tous les matins" },
+        { "fr", "Quelqu'un peut m'expliquer pourquoi le bus est encore en retard?" },
+        { "es", "Mi gato tira las cosas de la mesa todas las mañanas" },
+        { "es", "¿Alguien puede explicarme por qué el autobús llega tarde otra vez?" },
+        { "pt", "Meu gato derruba as coisas da mesa todas as manhãs" },
+        { "pt", "Alguém pode me explicar por que o ônibus está atrasado de novo?" },
+        { "it", "Il mio gatto fa cadere le cose dal tavolo ogni mattina" },
+        { "it", "Qualcuno mi spiega perché l'autobus è di nuovo in ritardo?" },
+        { "nl", "Mijn kat gooit elke ochtend dingen van de tafel" },
+        { "nl", "Kan iemand mij uitleggen waarom de bus alweer te laat is?" },
+        { "sv", "Min katt knuffar ner saker från bordet varje morgon" },
+        { "sv", "Kan någon förklara varför bussen är sen igen?" },
+        { "da", "Min kat skubber ting ned fra bordet hver morgen" },
+        { "da", "Kan nogen forklare mig, hvorfor bussen er forsinket igen?" },
+        { "pl", "Mój kot co rano zrzuca rzeczy ze stołu" },
+        { "pl", "Czy ktoś może mi wyjaśnić, dlaczego autobus znowu się spóźnia?" },
+        { "tr", "Kedim her sabah masadaki eşyaları yere atıyor" },
+        { "tr", "Biri bana otobüsün neden yine geciktiğini açıklayabilir mi?" },
+        { "id", "Kucing saya menjatuhkan barang dari meja setiap pagi" },
+        { "id", "Ada yang bisa menjelaskan kenapa busnya terlambat lagi?" },
+        { "fi", "Kissani pudottaa tavaroita pöydältä joka aamu" },
+        { "fi", "Voiko joku selittää miksi bussi on taas myöhässä?" },
+    };
+
+    static QStringList sampleTexts()
+    {
+        QStringList texts;
+
+        for (const auto& sample : SAMPLES)
+            texts.push_back(QString::fromUtf8(sample.mText));
+
+        return texts;
+    }
+};
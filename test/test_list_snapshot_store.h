@@ -0,0 +1,108 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <list_snapshot_store.h>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestListSnapshotStore : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init()
+    {
+        mDir = std::make_unique<QTemporaryDir>();
+        QVERIFY(mDir->isValid());
+    }
+
+    void saveAndLoad()
+    {
+        const ListSnapshotStore store(mDir->path());
+        const auto snapshot = createSnapshot(LIST_URI, 3);
+        QVERIFY(store.save(snapshot));
+
+        const auto loaded = store.load(LIST_URI);
+        QVERIFY(loaded);
+        QCOMPARE(loaded->mList.getUri(), LIST_URI);
+        QCOMPARE(loaded->mList.getCid(), "bafyreilist");
+        QCOMPARE(loaded->mList.getName(), "Blocked");
+        QCOMPARE(loaded->mList.getPurpose(), QEnums::LIST_PURPOSE_MOD);
+        QCOMPARE(loaded->mSaved, snapshot.mSaved);
+        QCOMPARE((int)loaded->mMembers.size(), 3);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const auto& member = loaded->mMembers[i];
+            QCOMPARE(member.mListItemUri, snapshot.mMembers[i].mListItemUri);
+            QCOMPARE(member.mProfile.getDid(), snapshot.mMembers[i].mProfile.getDid());
+            QCOMPARE(member.mProfile.getHandle(), snapshot.mMembers[i].mProfile.getHandle());
+            QCOMPARE(member.mProfile.getDisplayName(), snapshot.mMembers[i].mProfile.getDisplayName());
+        }
+    }
+
+    void overwrite()
+    {
+        const ListSnapshotStore store(mDir->path());
+        QVERIFY(store.save(createSnapshot(LIST_URI, 3)));
+        QVERIFY(store.save(createSnapshot(LIST_URI, 1)));
+        QVERIFY(store.save(createSnapshot(OTHER_LIST_URI, 2)));
+
+        QCOMPARE((int)store.load(LIST_URI)->mMembers.size(), 1);
+        QCOMPARE((int)store.load(OTHER_LIST_URI)->mMembers.size(), 2);
+        QCOMPARE((int)QDir(mDir->path()).entryList(QDir::Files).size(), 2);
+    }
+
+    void remove()
+    {
+        const ListSnapshotStore store(mDir->path());
+        QVERIFY(store.save(createSnapshot(LIST_URI, 3)));
+        store.remove(LIST_URI);
+        QVERIFY(!store.load(LIST_URI));
+
+        // Removing a list without snapshot is fine
+        store.remove(OTHER_LIST_URI);
+        QVERIFY(!store.load(OTHER_LIST_URI));
+    }
+
+    void corrupt()
+    {
+        const ListSnapshotStore store(mDir->path());
+        QVERIFY(store.save(createSnapshot(LIST_URI, 3)));
+        const QString fileName = QDir(mDir->path()).entryInfoList(QDir::Files).front().absoluteFilePath();
+
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+        file.write("{\"version\":1,");
+        file.close();
+
+        QVERIFY(!store.load(LIST_URI));
+    }
+
+private:
+    static ListSnapshotStore::Snapshot createSnapshot(const QString& listUri, int memberCount)
+    {
+        ListSnapshotStore::Snapshot snapshot;
+        snapshot.mList = ListViewBasic(listUri, "bafyreilist", "Blocked",
+                                       ATProto::AppBskyGraph::ListPurpose::MOD_LIST, "");
+        snapshot.mSaved = QDateTime::fromString("2025-06-01T12:00:00Z", Qt::ISODate);
+
+        for (int i = 0; i < memberCount; ++i)
+        {
+            const QString did = QString("did:plc:member%1").arg(i);
+            const BasicProfile profile(did, QString("member%1.bsky.social").arg(i),
+                                       QString("Member %1").arg(i), "");
+            snapshot.mMembers.push_back({ QString("%1/listitem%2").arg(listUri).arg(i), profile });
+        }
+
+        return snapshot;
+    }
+
+    static inline const QString LIST_URI = "at://did:plc:owner/app.bsky.graph.list/blocked";
+    static inline const QString OTHER_LIST_URI = "at://did:plc:owner/app.bsky.graph.list/other";
+
+    std::unique_ptr<QTemporaryDir> mDir;
+};
@@ -0,0 +1,192 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <list_store.h>
+#include <QJsonArray>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestListStore : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init()
+    {
+        mRequests.clear();
+        mDir = std::make_unique<QTemporaryDir>();
+        QVERIFY(mDir->isValid());
+    }
+
+    void cleanup()
+    {
+        mRequests.clear();
+        mDir = nullptr;
+    }
+
+    void pendingLoadMergesProfileChanges()
+    {
+        auto store = createStore();
+        int successCount = 0;
+        store->loadList(LIST_URI, [&successCount]{ ++successCount; }, [](auto, auto){ QFAIL("Load failed"); });
+        QCOMPARE((int)mRequests.size(), 1);
+
+        reply(0, { "alice", "bob" }, "cursor1");
+        QCOMPARE((int)mRequests.size(), 2);
+        QCOMPARE(mRequests[1].mCursor, "cursor1");
+
+        // Changes made while the next page loads must survive the members
+        // being replaced by the loaded pages.
+        store->addProfile(LIST_URI, profile("carol"), itemUri("carol"));
+        store->removeProfile(LIST_URI, itemUri("alice"));
+
+        reply(1, { "dave" });
+        QCOMPARE(successCount, 1);
+        QVERIFY(!store->containsListMember(LIST_URI, "did:plc:alice"));
+        QVERIFY(store->containsListMember(LIST_URI, "did:plc:bob"));
+        QVERIFY(store->containsListMember(LIST_URI, "did:plc:carol"));
+        QVERIFY(store->containsListMember(LIST_URI, "did:plc:dave"));
+    }
+
+    void failedRefreshKeepsSnapshot()
+    {
+        {
+            auto store = createStore();
+            store->loadList(LIST_URI, []{}, [](auto, auto){ QFAIL("Load failed"); });
+            reply(0, { "alice" });
+            QVERIFY(store->containsListMember(LIST_URI, "did:plc:alice"));
+        }
+
+        mRequests.clear();
+        auto store = createStore();
+        QSignalSpy refreshedSpy(store.get(), &ListStore::listRefreshed);
+        int successCount = 0;
+        int errorCount = 0;
+        store->loadList(LIST_URI, [&successCount]{ ++successCount; }, [&errorCount](auto, auto){ ++errorCount; });
+
+        // The snapshot is served while the list gets refreshed.
+        QCOMPARE(successCount, 1);
+        QVERIFY(store->containsListMember(LIST_URI, "did:plc:alice"));
+        QCOMPARE((int)mRequests.size(), 1);
+
+        fail(0, "InternalServerError");
+        QCOMPARE(errorCount, 0);
+        QCOMPARE(refreshedSpy.count(), 0);
+        QVERIFY(store->hasList(LIST_URI));
+        QVERIFY(store->containsListMember(LIST_URI, "did:plc:alice"));
+        QCOMPARE(store->getListName(LIST_URI), "Test list");
+    }
+
+    void sharedPageRequestQueue()
+    {
+        static constexpr int LIST_COUNT = 3;
+        auto store1 = createStore();
+        auto store2 = createStore();
+        int successCount = 0;
+
+        for (int i = 0; i < LIST_COUNT; ++i)
+        {
+            const auto onSuccess = [&successCount]{ ++successCount; };
+            const auto onError = [](auto, auto){ QFAIL("Load failed"); };
+            store1->loadList(QString("%1/one%2").arg(LIST_URI).arg(i), onSuccess, onError);
+            store2->loadList(QString("%1/two%2").arg(LIST_URI).arg(i), onSuccess, onError);
+        }
+
+        // Both stores share the limit
+        QCOMPARE((int)mRequests.size(), ListStore::MAX_PAGE_REQUESTS_IN_FLIGHT);
+
+        // A finished request starts a queued one
+        reply(0, { "alice" });
+        QCOMPARE(successCount, 1);
+        QCOMPARE((int)mRequests.size(), ListStore::MAX_PAGE_REQUESTS_IN_FLIGHT + 1);
+
+        // A canceled load releases its request. Its waiters get the list as
+        // it is now: removed.
+        const QString removedUri = mRequests[2].mUri;
+        store1->removeList(removedUri);
+        QCOMPARE(successCount, 2);
+        QCOMPARE((int)mRequests.size(), ListStore::MAX_PAGE_REQUESTS_IN_FLIGHT + 2);
+
+        // The reply to the canceled request is ignored
+        for (int i = 1; i < (int)mRequests.size(); ++i)
+            reply(i, { "bob" });
+
+        QCOMPARE((int)mRequests.size(), LIST_COUNT * 2);
+        QCOMPARE(successCount, LIST_COUNT * 2);
+        QVERIFY(!store1->hasList(removedUri));
+    }
+
+private:
+    struct Request
+    {
+        QString mUri;
+        QString mCursor;
+        ListStore::GetListSuccessCb mSuccessCb;
+        ListStore::ErrorCb mErrorCb;
+    };
+
+    std::unique_ptr<ListStore> createStore()
+    {
+        auto store = std::make_unique<ListStore>();
+        store->setSnapshotPath(mDir->path());
+        store->setGetListFun(
+            [this](const QString& uri, int, const QString& cursor, const auto& successCb, const auto& errorCb){
+                mRequests.push_back({ uri, cursor, successCb, errorCb });
+            });
+
+        return store;
+    }
+
+    static QString itemUri(const QString& name)
+    {
+        return QString("at://did:plc:owner/app.bsky.graph.listitem/%1").arg(name);
+    }
+
+    static QJsonObject profileJson(const QString& name)
+    {
+        return QJsonObject{{ "did", "did:plc:" + name }, { "handle", name + ".bsky.social" }};
+    }
+
+    static BasicProfile profile(const QString& name)
+    {
+        return BasicProfile("did:plc:" + name, name + ".bsky.social", name, "");
+    }
+
+    void reply(int index, const QStringList& names, const QString& cursor = {})
+    {
+        QJsonArray items;
+
+        for (const auto& name : names)
+            items.append(QJsonObject{{ "uri", itemUri(name) }, { "subject", profileJson(name) }});
+
+        QJsonObject json;
+        json.insert("list", QJsonObject{
+            { "uri", mRequests[index].mUri },
+            { "cid", "bafyreilist" },
+            { "name", "Test list" },
+            { "purpose", "app.bsky.graph.defs#curatelist" },
+            { "creator", profileJson("owner") },
+            { "indexedAt", "2025-10-01T12:00:00.000Z" }
+        });
+        json.insert("items", items);
+
+        if (!cursor.isEmpty())
+            json.insert("cursor", cursor);
+
+        const auto successCb = mRequests[index].mSuccessCb;
+        successCb(ATProto::AppBskyGraph::GetListOutput::fromJson(json));
+    }
+
+    void fail(int index, const QString& error)
+    {
+        const auto errorCb = mRequests[index].mErrorCb;
+        errorCb(error, "Request failed");
+    }
+
+    static constexpr char const* LIST_URI = "at://did:plc:owner/app.bsky.graph.list/test";
+
+    std::vector<Request> mRequests;
+    std::unique_ptr<QTemporaryDir> mDir;
+};
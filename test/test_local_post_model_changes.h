@@ -0,0 +1,125 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <local_post_model_changes.h>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestLocalPostModelChanges : public QObject
+{
+    Q_OBJECT
+
+    class Changes : public LocalPostModelChanges
+    {
+    public:
+        int mLikeCountChanged = 0;
+        int mBookmarkedChanged = 0;
+        int mOtherChanged = 0;
+        std::vector<LocalChangeKeys> mLikeCountKeys;
+
+    protected:
+        void postIndexedSecondsAgoChanged() override { ++mOtherChanged; }
+        void likeCountChanged() override { ++mLikeCountChanged; mLikeCountKeys.push_back(getChangedPostKeys()); }
+        void likeUriChanged() override { ++mOtherChanged; }
+        void likeTransientChanged() override { ++mOtherChanged; }
+        void replyCountChanged() override { ++mOtherChanged; }
+        void repostCountChanged() override { ++mOtherChanged; }
+        void quoteCountChanged() override { ++mOtherChanged; }
+        void repostUriChanged() override { ++mOtherChanged; }
+        void threadgateUriChanged() override { ++mOtherChanged; }
+        void replyRestrictionChanged() override { ++mOtherChanged; }
+        void replyRestrictionListsChanged() override { ++mOtherChanged; }
+        void hiddenRepliesChanged() override { ++mOtherChanged; }
+        void threadMutedChanged() override { ++mOtherChanged; }
+        void bookmarkedChanged() override { ++mBookmarkedChanged; }
+        void bookmarkTransientChanged() override { ++mOtherChanged; }
+        void feedbackChanged() override { ++mOtherChanged; }
+        void feedbackTransientChanged() override { ++mOtherChanged; }
+        void detachedRecordChanged() override { ++mOtherChanged; }
+        void reAttachedRecordChanged() override { ++mOtherChanged; }
+        void viewerStatePinnedChanged() override { ++mOtherChanged; }
+        void postDeletedChanged() override { ++mOtherChanged; }
+    };
+
+private slots:
+    void noBatch()
+    {
+        Changes changes;
+        changes.updateLikeCountDelta("cid1", 1);
+        changes.updateLikeCountDelta("cid2", 1);
+        QCOMPARE(changes.mLikeCountChanged, 2);
+        QVERIFY(changes.mLikeCountKeys[0].contains("cid1"));
+        QVERIFY(!changes.mLikeCountKeys[0].contains("cid2"));
+        QVERIFY(changes.mLikeCountKeys[1].contains("cid2"));
+    }
+
+    void batch()
+    {
+        Changes changes;
+        changes.beginLocalChangeBatch();
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const QString cid = QString("cid%1").arg(i);
+            changes.updateBookmarked(cid, true);
+            changes.updateLikeCountDelta(cid, 1);
+        }
+
+        QCOMPARE(changes.mBookmarkedChanged, 0);
+        QCOMPARE(changes.mLikeCountChanged, 0);
+        QCOMPARE(changes.getLocalChange("cid42")->mLikeCountDelta, 1);
+
+        changes.endLocalChangeBatch();
+        QCOMPARE(changes.mBookmarkedChanged, 1);
+        QCOMPARE(changes.mLikeCountChanged, 1);
+        QCOMPARE(changes.mOtherChanged, 0);
+        QVERIFY(!changes.isLocalChangeBatchActive());
+
+        const auto& keys = changes.mLikeCountKeys[0];
+        QVERIFY(!keys.isAll());
+        QVERIFY(keys.contains("cid0"));
+        QVERIFY(keys.contains("cid99"));
+        QVERIFY(!keys.contains("cid100"));
+    }
+
+    void batchIndexedSecondsAgo()
+    {
+        Changes changes;
+        changes.beginLocalChangeBatch();
+        changes.updatePostIndexedSecondsAgo();
+        changes.updatePostIndexedSecondsAgo();
+        changes.endLocalChangeBatch();
+        QCOMPARE(changes.mOtherChanged, 1);
+    }
+
+    void rowRanges()
+    {
+        std::vector<std::pair<int, int>> ranges;
+        const auto collect = [&ranges](int first, int last){ ranges.push_back({ first, last }); };
+
+        forEachRowRange({}, collect);
+        QVERIFY(ranges.empty());
+
+        forEachRowRange({ 7, 3, 4, 5, 9, 10, 4 }, collect);
+        const std::vector<std::pair<int, int>> expected{ {3, 5}, {7, 7}, {9, 10} };
+        QCOMPARE(ranges, expected);
+    }
+
+    void nestedBatch()
+    {
+        Changes changes;
+        changes.beginLocalChangeBatch();
+        changes.beginLocalChangeBatch();
+        changes.updateBookmarked("cid1", true);
+        changes.endLocalChangeBatch();
+        QCOMPARE(changes.mBookmarkedChanged, 0);
+        changes.endLocalChangeBatch();
+        QCOMPARE(changes.mBookmarkedChanged, 1);
+
+        // Unbalanced end is ignored
+        changes.endLocalChangeBatch();
+        changes.updateBookmarked("cid1", false);
+        QCOMPARE(changes.mBookmarkedChanged, 2);
+    }
+};
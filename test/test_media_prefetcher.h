@@ -0,0 +1,297 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <media_cache.h>
+#include <media_prefetcher.h>
+#include <QDateTime>
+#include <QLocale>
+#include <QPointer>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+// Minimal HTTP server for cacheable media. Responses for held paths are sent
+// on release.
+class MediaServer : public QTcpServer
+{
+public:
+    MediaServer()
+    {
+        connect(this, &QTcpServer::newConnection, this, [this]{
+            while (QTcpSocket* socket = nextPendingConnection())
+            {
+                connect(socket, &QTcpSocket::readyRead, socket, [this, socket]{ handleRequest(socket); });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+    }
+
+    QString url(const QString& path) const
+    {
+        return QString("http://127.0.0.1:%1%2").arg(serverPort()).arg(path);
+    }
+
+    void hold(bool hold) { mHold = hold; }
+
+    void release()
+    {
+        mHold = false;
+        const auto held = std::move(mHeld);
+        mHeld.clear();
+
+        for (const auto& [socket, path] : held)
+        {
+            if (socket)
+                respond(socket, path);
+        }
+    }
+
+    int mRequests = 0;
+
+private:
+    void handleRequest(QTcpSocket* socket)
+    {
+        mBuffer[socket] += socket->readAll();
+
+        if (!mBuffer[socket].contains("\r\n\r\n"))
+            return;
+
+        const QByteArray request = mBuffer.take(socket);
+        const QString path = QString::fromLatin1(request.split('\n').front().split(' ').value(1));
+        ++mRequests;
+
+        if (mHold)
+            mHeld.push_back({ socket, path });
+        else
+            respond(socket, path);
+    }
+
+    void respond(QTcpSocket* socket, const QString& path)
+    {
+        const QByteArray type = path.endsWith(".m3u8") ? "application/vnd.apple.mpegurl" :
+                                path.endsWith(".ts") ? "video/mp2t" : "image/png";
+        const QByteArray data = "data:" + path.toLatin1();
+        const QByteArray date = QLocale::c().toString(QDateTime::currentDateTimeUtc(),
+                                    "ddd, dd MMM yyyy hh:mm:ss 'GMT'").toLatin1();
+        const QByteArray response = "HTTP/1.1 200 OK\r\nContent-Type: " + type +
+                                    "\r\nCache-Control: public, max-age=3600\r\nDate: " + date +
+                                    "\r\nContent-Length: " + QByteArray::number(data.size()) + "\r\n\r\n" + data;
+        socket->write(response);
+    }
+
+    bool mHold = false;
+    std::vector<std::pair<QPointer<QTcpSocket>, QString>> mHeld;
+    QHash<QTcpSocket*, QByteArray> mBuffer;
+};
+
+class TestMediaPrefetcher : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase()
+    {
+        QVERIFY(mServer.listen(QHostAddress::LocalHost));
+    }
+
+    void init()
+    {
+        MediaCache::instance().clear();
+        mServer.mRequests = 0;
+        mServer.hold(false);
+    }
+
+    void prefetchRows()
+    {
+        const int min = MediaPrefetcher::MIN_PREFETCH_ROWS;
+        const int max = MediaPrefetcher::MAX_PREFETCH_ROWS;
+
+        // Both directions, closest first
+        auto rows = MediaPrefetcher::getPrefetchRows(20, 22, 0.0, 100);
+        QCOMPARE((int)rows.size(), min * 2);
+        QCOMPARE(rows[0], 23);
+        QCOMPARE(rows[1], 19);
+
+        rows = MediaPrefetcher::getPrefetchRows(20, 22, 1.0, 100);
+        QCOMPARE((int)rows.size(), min);
+        QCOMPARE(rows.front(), 23);
+
+        rows = MediaPrefetcher::getPrefetchRows(40, 42, -1.0, 100);
+        QCOMPARE((int)rows.size(), min);
+        QCOMPARE(rows.front(), 39);
+
+        // Further ahead when scrolling faster
+        rows = MediaPrefetcher::getPrefetchRows(0, 2, 4.0 * MediaPrefetcher::VELOCITY_PER_ROW, 1000);
+        QCOMPARE((int)rows.size(), min + 4);
+        rows = MediaPrefetcher::getPrefetchRows(0, 2, 1000.0 * MediaPrefetcher::VELOCITY_PER_ROW, 1000);
+        QCOMPARE((int)rows.size(), max);
+
+        // Bounded by the model
+        rows = MediaPrefetcher::getPrefetchRows(0, 2, 0.0, 5);
+        QCOMPARE(rows, std::vector<int>({ 3, 4 }));
+        QVERIFY(MediaPrefetcher::getPrefetchRows(-1, -1, 0.0, 5).empty());
+        QVERIFY(MediaPrefetcher::getPrefetchRows(0, 2, 0.0, 0).empty());
+    }
+
+    void prefetchToCache()
+    {
+        MediaPrefetcher prefetcher;
+        QSignalSpy prefetchedSpy(&prefetcher, &MediaPrefetcher::prefetched);
+        prefetcher.prefetch(0, 0, 1.0, 11, getRowMediaFn("cache"));
+
+        // 10 rows, 2 images each, and 5 playlists
+        QCOMPARE(prefetcher.getInFlightCount(), MediaPrefetcher::MAX_IN_FLIGHT);
+        QCOMPARE(prefetcher.getQueueSize(), 25 - MediaPrefetcher::MAX_IN_FLIGHT);
+        QTRY_COMPARE(prefetchedSpy.count(), 25);
+        QCOMPARE(prefetcher.getInFlightCount(), 0);
+
+        for (int row = 1; row <= 10; ++row)
+            QVERIFY(MediaCache::instance().contains(QUrl(mServer.url(QString("/cache/%1.png").arg(row)))));
+
+        // Nothing to do for the same range
+        prefetcher.prefetch(0, 0, 1.0, 11, getRowMediaFn("cache"));
+        QCOMPARE(prefetcher.getInFlightCount(), 0);
+        QCOMPARE(mServer.mRequests, 25);
+    }
+
+    void cancelOutOfRange()
+    {
+        MediaPrefetcher prefetcher;
+        QSignalSpy prefetchedSpy(&prefetcher, &MediaPrefetcher::prefetched);
+        mServer.hold(true);
+        prefetcher.prefetch(0, 0, 1.0, 100, getRowMediaFn("cancel"));
+        QCOMPARE(prefetcher.getInFlightCount(), MediaPrefetcher::MAX_IN_FLIGHT);
+        QTRY_COMPARE(mServer.mRequests, MediaPrefetcher::MAX_IN_FLIGHT);
+
+        // Scrolled far away, the rows of the held requests are out of range.
+        prefetcher.prefetch(80, 80, 1.0, 100, getRowMediaFn("cancel"));
+        QCOMPARE(prefetcher.getInFlightCount(), MediaPrefetcher::MAX_IN_FLIGHT);
+        mServer.release();
+
+        QTRY_VERIFY(prefetchedSpy.count() > 0);
+        QTRY_COMPARE(prefetcher.getInFlightCount(), 0);
+
+        for (const auto& args : prefetchedSpy)
+        {
+            const QString path = QUrl(args.first().toString()).path();
+            const int row = path.section('/', 2, 2).remove("avatar").section('.', 0, 0).toInt();
+            QVERIFY2(row > 80, qPrintable(path));
+        }
+
+        QVERIFY(!MediaCache::instance().contains(QUrl(mServer.url("/cancel/1.png"))));
+    }
+
+    void cacheServesNetworkAccessManager()
+    {
+        MediaPrefetcher prefetcher;
+        QSignalSpy prefetchedSpy(&prefetcher, &MediaPrefetcher::prefetched);
+        prefetcher.prefetch(0, 0, 1.0, 2, getRowMediaFn("view"));
+        QTRY_COMPARE(prefetchedSpy.count(), 2);
+        QCOMPARE(mServer.mRequests, 2);
+
+        // The QML engine gets its network access managers from the factory.
+        MediaNetworkAccessManagerFactory factory;
+        std::unique_ptr<QNetworkAccessManager> network(factory.create(nullptr));
+        QNetworkReply* reply = network->get(QNetworkRequest(QUrl(mServer.url("/view/1.png"))));
+        QTRY_VERIFY(reply->isFinished());
+
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        QCOMPARE(reply->readAll(), QByteArray("data:/view/1.png"));
+        QVERIFY(reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool());
+        QCOMPARE(mServer.mRequests, 2);
+        delete reply;
+    }
+
+    void videoSegmentsNotCached()
+    {
+        QNetworkAccessManager network;
+        network.setCache(new MediaNetworkCache);
+        QNetworkReply* reply = network.get(QNetworkRequest(QUrl(mServer.url("/video/1.ts"))));
+        QTRY_VERIFY(reply->isFinished());
+
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        QVERIFY(!MediaCache::instance().contains(QUrl(mServer.url("/video/1.ts"))));
+        delete reply;
+    }
+
+    void putMissingAuthors()
+    {
+        MediaPrefetcher prefetcher;
+        QStringList dids;
+        prefetcher.setPutAuthorFn([&dids](const QString& did){ dids.push_back(did); });
+
+        const auto getRowMedia = [](int row){
+            MediaPrefetcher::RowMedia media;
+            media.mAuthorDid = QString("did:plc:author%1").arg(row % 2);
+            return media;
+        };
+
+        prefetcher.prefetch(0, 0, 1.0, 5, getRowMedia);
+        prefetcher.prefetch(1, 1, 1.0, 5, getRowMedia);
+        QCOMPARE(dids, QStringList({ "did:plc:author1", "did:plc:author0" }));
+    }
+
+    void cacheEviction()
+    {
+        MediaCache cache(1000);
+        QNetworkCacheMetaData metaData;
+
+        for (int i = 0; i < 10; ++i)
+        {
+            metaData.setUrl(QUrl(QString("https://cdn.bsky.app/%1.png").arg(i)));
+            cache.insert(metaData, QByteArray(200, 'x'));
+        }
+
+        QVERIFY(cache.getTotalSize() <= 1000);
+        QVERIFY(cache.contains(QUrl("https://cdn.bsky.app/9.png")));
+        QVERIFY(!cache.contains(QUrl("https://cdn.bsky.app/0.png")));
+
+        QByteArray data;
+        QVERIFY(cache.getData(QUrl("https://cdn.bsky.app/9.png"), data));
+        QCOMPARE(data.size(), 200);
+
+        metaData.setUrl(QUrl("https://cdn.bsky.app/large.png"));
+        cache.insert(metaData, QByteArray(MediaCache::MAX_ENTRY_SIZE + 1, 'x'));
+        QVERIFY(!cache.contains(metaData.url()));
+    }
+
+    void cacheBudgetTrim()
+    {
+        MediaCache cache(1000);
+        cache.registerWithMemoryBudget();
+        QNetworkCacheMetaData metaData;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            metaData.setUrl(QUrl(QString("https://cdn.bsky.app/%1.png").arg(i)));
+            cache.insert(metaData, QByteArray(100, 'x'));
+        }
+
+        const qsizetype size = cache.getTotalSize();
+        MemoryBudget::instance().trim(50);
+        QVERIFY(cache.getTotalSize() <= 500);
+        QVERIFY(cache.getTotalSize() < size);
+        QCOMPARE(cache.getMaxCost(), 1000);
+        QVERIFY(cache.contains(QUrl("https://cdn.bsky.app/3.png")));
+    }
+
+private:
+    // Each row has 2 images, every other row has a video playlist.
+    MediaPrefetcher::GetRowMediaFn getRowMediaFn(const QString& dir) const
+    {
+        return [this, dir](int row){
+            MediaPrefetcher::RowMedia media;
+            media.mImageUrls.push_back(mServer.url(QString("/%1/%2.png").arg(dir).arg(row)));
+            media.mImageUrls.push_back(mServer.url(QString("/%1/avatar%2.png").arg(dir).arg(row)));
+
+            if (row % 2 == 0)
+                media.mPlaylistUrl = mServer.url(QString("/%1/%2.m3u8").arg(dir).arg(row));
+
+            return media;
+        };
+    }
+
+    MediaServer mServer;
+};
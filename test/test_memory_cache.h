@@ -0,0 +1,109 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <memory_cache.h>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestMemoryCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void lruEviction()
+    {
+        MemoryCache<QString, int> cache("test", 2);
+        cache.insert("foo", 1);
+        cache.insert("bar", 2);
+        QCOMPARE(*cache.get("foo"), 1);
+        cache.insert("sky", 3);
+
+        QVERIFY(cache.contains("foo"));
+        QVERIFY(!cache.contains("bar"));
+        QVERIFY(cache.contains("sky"));
+        QCOMPARE(cache.keys(), QList<QString>({"foo", "sky"}));
+        QCOMPARE(cache.getStats().mEvictions, 1);
+    }
+
+    void byteCost()
+    {
+        const auto cost = [](const QString&, const QString& value){ return CacheCost::string(value); };
+        const qsizetype entryCost = CacheCost::string("12345") + MemoryCache<QString, QString>::ENTRY_OVERHEAD;
+        MemoryCache<QString, QString> cache("test", entryCost * 2, cost);
+
+        QVERIFY(cache.insert("foo", QString("12345")));
+        QVERIFY(cache.insert("bar", QString("12345")));
+        QCOMPARE(cache.getTotalCost(), entryCost * 2);
+        QVERIFY(!cache.insert("big", QString(1000, 'x')));
+        QCOMPARE(cache.size(), 2);
+
+        QVERIFY(cache.insert("sky", QString("123")));
+        QVERIFY(!cache.contains("foo"));
+        QVERIFY(cache.getTotalCost() <= cache.getMaxCost());
+    }
+
+    void replace()
+    {
+        MemoryCache<QString, int> cache("test", 2);
+        cache.insert("foo", 1);
+        cache.insert("foo", 2);
+        QCOMPARE(cache.size(), 1);
+        QCOMPARE(*cache.get("foo"), 2);
+    }
+
+    void hitsAndMisses()
+    {
+        MemoryCache<QString, int> cache("test", 10);
+        cache.insert("foo", 1);
+        cache.get("foo");
+        cache.get("bar");
+        cache.get("foo");
+        QCOMPARE(cache.getStats().mHits, 2);
+        QCOMPARE(cache.getStats().mMisses, 1);
+    }
+
+    void evictedCallback()
+    {
+        MemoryCache<QString, int> cache("test", 1);
+        QStringList evicted;
+        cache.setEvictedCallback([&evicted](const QString& key, int){ evicted.push_back(key); });
+        cache.insert("foo", 1);
+        cache.insert("bar", 2);
+        cache.remove("bar");
+        QCOMPARE(evicted, QStringList({"foo", "bar"}));
+    }
+
+    void handleOutlivesEviction()
+    {
+        MemoryCache<QString, QString> cache("test", 10);
+        cache.insert("foo", QString("bar"));
+        const auto value = cache.get("foo");
+        cache.trim(0);
+        QVERIFY(!cache.contains("foo"));
+        QCOMPARE(*value, QString("bar"));
+    }
+
+    void sharedBudget()
+    {
+        auto& budget = MemoryBudget::instance();
+        const qsizetype oldBudget = budget.getBudget();
+        budget.setBudget(300000);
+
+        {
+            MemoryCache<QString, int> cache1("cache1", 0, [](const QString&, int){ return 0; }, 1);
+            MemoryCache<QString, int> cache2("cache2", 0, [](const QString&, int){ return 0; }, 2);
+            QVERIFY(cache1.getMaxCost() > 0);
+            QVERIFY(std::abs(cache2.getMaxCost() - cache1.getMaxCost() * 2) <= 1);
+
+            for (int i = 0; i < 100; ++i)
+                cache2.insert(QString::number(i), i);
+
+            QVERIFY(cache2.getTotalCost() <= cache2.getMaxCost());
+            budget.trim(0);
+            QCOMPARE(cache2.size(), 0);
+            QCOMPARE(budget.getTotalCost(), 0);
+        }
+
+        budget.setBudget(oldBudget);
+    }
+};
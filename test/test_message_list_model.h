@@ -0,0 +1,144 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <message_list_model.h>
+#include <QJsonArray>
+#include <QSignalSpy>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestMessageListModel : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init()
+    {
+        mModel = std::make_unique<MessageListModel>(mUserDid, ChatBasicProfileList{}, mFollowsActivityStore);
+        mModel->addMessages(getMessages({ message("m3"), message("m2"), message("m1") }), "cursor");
+    }
+
+    void cleanup()
+    {
+        mModel = nullptr;
+    }
+
+    void addMessages()
+    {
+        QCOMPARE(mModel->rowCount(), 3);
+        QCOMPARE(getId(0), QString("m1"));
+        QCOMPARE(getId(2), QString("m3"));
+        QCOMPARE(mModel->getCursor(), QString("cursor"));
+    }
+
+    void appendNewMessages()
+    {
+        QSignalSpy insertedSpy(mModel.get(), &MessageListModel::rowsInserted);
+        QSignalSpy removedSpy(mModel.get(), &MessageListModel::rowsRemoved);
+
+        mModel->updateMessages(getMessages({ message("m5"), message("m4"), message("m3"), message("m2") }), "newCursor");
+
+        QCOMPARE(removedSpy.count(), 0);
+        QCOMPARE(insertedSpy.count(), 1);
+        QCOMPARE(insertedSpy.at(0).at(1).toInt(), 3);
+        QCOMPARE(insertedSpy.at(0).at(2).toInt(), 4);
+        QCOMPARE(mModel->rowCount(), 5);
+        QCOMPARE(getId(3), QString("m4"));
+        QCOMPARE(getId(4), QString("m5"));
+        QCOMPARE(mModel->getLastMessage()->getId(), QString("m5"));
+
+        // Older messages stay loaded
+        QCOMPARE(mModel->getCursor(), QString("cursor"));
+    }
+
+    void patchUpdatedMessage()
+    {
+        QSignalSpy insertedSpy(mModel.get(), &MessageListModel::rowsInserted);
+        QSignalSpy changedSpy(mModel.get(), &MessageListModel::dataChanged);
+
+        mModel->updateMessages(getMessages({ message("m3"), message("m2", "rev2", "edited"), message("m1") }), "cursor");
+
+        QCOMPARE(insertedSpy.count(), 0);
+        QCOMPARE(changedSpy.count(), 1);
+        QCOMPARE(changedSpy.at(0).at(0).value<QModelIndex>().row(), 1);
+        QCOMPARE(getMessage(1).getText(), QString("edited"));
+        QCOMPARE(getMessage(1).getRev(), QString("rev2"));
+    }
+
+    void patchDeletedMessage()
+    {
+        mModel->updateMessages(getMessages({ message("m4"), message("m3", "rev2", "", true) }), "cursor");
+        QCOMPARE(mModel->rowCount(), 4);
+        QVERIFY(getMessage(2).isDeleted());
+        QCOMPARE(getId(3), QString("m4"));
+    }
+
+    void noOverlap()
+    {
+        QSignalSpy removedSpy(mModel.get(), &MessageListModel::rowsRemoved);
+
+        mModel->updateMessages(getMessages({ message("m9"), message("m8") }), "newCursor");
+
+        QCOMPARE(removedSpy.count(), 1);
+        QCOMPARE(mModel->rowCount(), 2);
+        QCOMPARE(getId(0), QString("m8"));
+        QCOMPARE(mModel->getCursor(), QString("newCursor"));
+    }
+
+    void indexAfterOlderPage()
+    {
+        mModel->addMessages(getMessages({ message("m0"), message("m-1") }), "");
+        QCOMPARE(getId(0), QString("m-1"));
+
+        mModel->updateMessages(getMessages({ message("m4"), message("m3"), message("m2", "rev2", "edited") }), "cursor");
+        QCOMPARE(mModel->rowCount(), 6);
+        QCOMPARE(getMessage(3).getText(), QString("edited"));
+        QCOMPARE(getId(5), QString("m4"));
+
+        mModel->updateMessage(MessageView(getMessages({ message("m-1", "rev2", "first") }).front()));
+        QCOMPARE(getMessage(0).getText(), QString("first"));
+    }
+
+private:
+    static QJsonObject message(const QString& id, const QString& rev = "rev1", const QString& text = "hello", bool deleted = false)
+    {
+        QJsonObject json;
+        json.insert("$type", deleted ? "chat.bsky.convo.defs#deletedMessageView" : "chat.bsky.convo.defs#messageView");
+        json.insert("id", id);
+        json.insert("rev", rev);
+        json.insert("sender", QJsonObject{{ "did", "did:plc:sender" }});
+        json.insert("sentAt", "2025-10-01T12:00:00.000Z");
+
+        if (!deleted)
+            json.insert("text", text);
+
+        return json;
+    }
+
+    static ATProto::ChatBskyConvo::GetMessagesOutput::MessageList getMessages(const QList<QJsonObject>& messages)
+    {
+        QJsonArray messageArray;
+
+        for (const auto& msg : messages)
+            messageArray.append(msg);
+
+        QJsonObject json;
+        json.insert("messages", messageArray);
+        return ATProto::ChatBskyConvo::GetMessagesOutput::fromJson(json)->mMessages;
+    }
+
+    MessageView getMessage(int row) const
+    {
+        return mModel->data(mModel->index(row), int(MessageListModel::Role::Message)).value<MessageView>();
+    }
+
+    QString getId(int row) const
+    {
+        return getMessage(row).getId();
+    }
+
+    QString mUserDid = "did:plc:user";
+    Following mFollowing;
+    FollowsActivityStore mFollowsActivityStore{mFollowing, this};
+    std::unique_ptr<MessageListModel> mModel;
+};
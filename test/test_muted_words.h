@@ -235,6 +235,40 @@ private slots:
         QVERIFY(!mutedWords.match(post2).first);
     }
 
+    void expiresLater()
+    {
+        MutedWords mutedWords;
+        mutedWords.addEntry("hello", QEnums::ACTOR_TARGET_ALL, QDateTime::currentDateTimeUtc().addMSecs(100));
+        mutedWords.addEntry("#world", QEnums::ACTOR_TARGET_ALL, QDateTime::currentDateTimeUtc().addMSecs(100));
+
+        const auto post1 = setPost("hello");
+        QVERIFY(mutedWords.match(post1).first);
+        const auto post2 = setPost("#world");
+        QVERIFY(mutedWords.match(post2).first);
+
+        QTRY_VERIFY(!mutedWords.match(post1).first);
+        QVERIFY(!mutedWords.match(post2).first);
+
+        // Expired entries are kept
+        QCOMPARE(mutedWords.getEntries().size(), 2);
+        mutedWords.removeEntry("hello");
+        QCOMPARE(mutedWords.getEntries().size(), 1);
+    }
+
+    void expiresWithoutScheduler()
+    {
+        const int scheduled = ExpiryScheduler::instance().size();
+        MutedWords mutedWords(nullptr, nullptr);
+        mutedWords.addEntry("hello", QEnums::ACTOR_TARGET_ALL, QDateTime::currentDateTimeUtc().addMSecs(100));
+        QCOMPARE(ExpiryScheduler::instance().size(), scheduled);
+
+        const auto post = setPost("hello");
+        QVERIFY(mutedWords.match(post).first);
+        QTRY_VERIFY(!mutedWords.match(post).first);
+        mutedWords.removeEntry("hello");
+        QCOMPARE(mutedWords.getEntries().size(), 0);
+    }
+
     void remove()
     {
         MutedWords mutedWords;
@@ -0,0 +1,145 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <content_filter.h>
+#include <list_store.h>
+#include <muted_words.h>
+#include <notification_list_model.h>
+#include <user_settings.h>
+#include <QJsonArray>
+#include <QSignalSpy>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestNotificationListModel : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init()
+    {
+        mModel = std::make_unique<NotificationListModel>(mContentFilter, mMutedWords, nullptr);
+    }
+
+    void cleanup()
+    {
+        mModel = nullptr;
+    }
+
+    void groupWithinPage()
+    {
+        addPage({ follow("alice"), follow("bob"), verified("carol") });
+
+        QCOMPARE(mModel->rowCount(), 2);
+        QCOMPARE(getAuthorDids(0), QStringList({ "did:plc:alice", "did:plc:bob" }));
+        QCOMPARE(getAuthorDids(1), QStringList({ "did:plc:carol" }));
+    }
+
+    void groupAcrossPages()
+    {
+        addPage({ follow("alice") });
+        QSignalSpy insertedSpy(mModel.get(), &NotificationListModel::rowsInserted);
+        QSignalSpy changedSpy(mModel.get(), &NotificationListModel::dataChanged);
+
+        addPage({ follow("bob"), verified("carol") });
+
+        QCOMPARE(mModel->rowCount(), 2);
+        QCOMPARE(getAuthorDids(0), QStringList({ "did:plc:alice", "did:plc:bob" }));
+        QCOMPARE(getAuthorDids(1), QStringList({ "did:plc:carol" }));
+        QCOMPARE(insertedSpy.count(), 1);
+        QCOMPARE(changedSpy.count(), 1);
+        QCOMPARE(changedSpy.at(0).at(0).value<QModelIndex>().row(), 0);
+    }
+
+    void dedupWithinPage()
+    {
+        addPage({ follow("alice"), follow("bob"), follow("alice"), follow("bob") });
+
+        QCOMPARE(mModel->rowCount(), 1);
+        QCOMPARE(getAuthorDids(0), QStringList({ "did:plc:alice", "did:plc:bob" }));
+    }
+
+    void dedupAcrossPages()
+    {
+        addPage({ follow("alice"), follow("bob") });
+        addPage({ follow("bob"), follow("carol"), follow("alice") });
+
+        QCOMPARE(mModel->rowCount(), 1);
+        QCOMPARE(getAuthorDids(0), QStringList({ "did:plc:alice", "did:plc:bob", "did:plc:carol" }));
+    }
+
+private:
+    static QJsonObject notification(const QString& name, const QString& reason, const QJsonObject& record)
+    {
+        static int sNextId = 1;
+        const QString did = "did:plc:" + name;
+
+        QJsonObject json;
+        json.insert("uri", QString("at://%1/record/%2").arg(did).arg(sNextId++));
+        json.insert("cid", QString("cid%1").arg(sNextId));
+        json.insert("author", QJsonObject{{ "did", did }, { "handle", name + ".bsky.social" }});
+        json.insert("reason", reason);
+        json.insert("record", record);
+        json.insert("isRead", false);
+        json.insert("indexedAt", "2025-10-01T12:00:00.000Z");
+        return json;
+    }
+
+    static QJsonObject follow(const QString& name)
+    {
+        const QJsonObject record{
+            { "$type", "app.bsky.graph.follow" },
+            { "subject", "did:plc:user" },
+            { "createdAt", "2025-10-01T12:00:00.000Z" }
+        };
+
+        return notification(name, "follow", record);
+    }
+
+    static QJsonObject verified(const QString& name)
+    {
+        const QJsonObject record{
+            { "$type", "app.bsky.graph.verification" },
+            { "subject", "did:plc:user" },
+            { "handle", "user.bsky.social" },
+            { "displayName", "User" },
+            { "createdAt", "2025-10-01T12:00:00.000Z" }
+        };
+
+        return notification(name, "verified", record);
+    }
+
+    // The notifications of these reasons have no posts to fetch, so no client
+    // is needed.
+    void addPage(const QList<QJsonObject>& notifications)
+    {
+        QJsonArray notificationArray;
+
+        for (const auto& json : notifications)
+            notificationArray.append(json);
+
+        QJsonObject json;
+        json.insert("notifications", notificationArray);
+        json.insert("cursor", "cursor");
+        mModel->addNotifications(ATProto::AppBskyNotification::ListNotificationsOutput::fromJson(json), nullptr);
+    }
+
+    QStringList getAuthorDids(int row) const
+    {
+        const auto authors = mModel->data(mModel->index(row), int(NotificationListModel::Role::NotificationAllAuthors)).value<BasicProfileList>();
+        QStringList dids;
+
+        for (const auto& author : authors)
+            dids.push_back(author.getDid());
+
+        return dids;
+    }
+
+    QString mUserDid = "did:plc:user";
+    ListStore mContentFilterPolicies;
+    ATProto::UserPreferences mUserPreferences;
+    UserSettings mUserSettings;
+    ContentFilter mContentFilter{mUserDid, mContentFilterPolicies, mUserPreferences, &mUserSettings};
+    MutedWords mMutedWords;
+    NotificationListModel::Ptr mModel;
+};
@@ -0,0 +1,90 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <post.h>
+#include <atproto/lib/post_master.h>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestPost : public QObject
+{
+    Q_OBJECT
+private slots:
+    void overridesCopyOnWrite()
+    {
+        const Post post = createPost("hello world");
+        Post copy = post;
+        copy.setOverrideLikeCount(5);
+        copy.setOverrideLikeUri("at://like");
+
+        QCOMPARE(copy.getLikeCount(), 5);
+        QCOMPARE(copy.getLikeUri(), "at://like");
+        QCOMPARE(post.getLikeCount(), 0);
+        QVERIFY(post.getLikeUri().isEmpty());
+
+        Post copy2 = copy;
+        copy2.setOverrideLikeCount(6);
+        QCOMPARE(copy2.getLikeCount(), 6);
+        QCOMPARE(copy2.getLikeUri(), "at://like");
+        QCOMPARE(copy.getLikeCount(), 5);
+    }
+
+    void placeHolders()
+    {
+        const Post gap = Post::createGapPlaceHolder("CURSOR");
+        QVERIFY(gap.isGap());
+        QCOMPARE(gap.getGapCursor(), "CURSOR");
+
+        const Post notFound = Post::createNotFound("at://uri", "cid");
+        QVERIFY(notFound.isNotFound());
+        QCOMPARE(notFound.getUri(), "at://uri");
+        QCOMPARE(notFound.getCid(), "cid");
+
+        const Post notSupported = Post::createNotSupported("app.bsky.unknown");
+        QVERIFY(notSupported.isNotSupported());
+        QCOMPARE(notSupported.getUnsupportedType(), "app.bsky.unknown");
+        QVERIFY(notSupported.getGapCursor().isEmpty());
+        QVERIFY(notSupported.getUri().isEmpty());
+    }
+
+    void jsonRoundTrip()
+    {
+        Post gap = Post::createGapPlaceHolder("CURSOR");
+        gap.setEndOfFeed(true);
+        const Post post = Post::fromJson(gap.toJson());
+
+        QCOMPARE(post.getGapId(), gap.getGapId());
+        QCOMPARE(post.getGapCursor(), "CURSOR");
+        QVERIFY(post.isEndOfFeed());
+    }
+
+    void overrideTextResetsIndex()
+    {
+        Post post = createPost("hello world");
+        QCOMPARE(post.getNormalizedWords(), std::vector<QString>({ "hello", "world" }));
+
+        const Post copy = post;
+        post.setOverrideText("goodbye");
+        QCOMPARE(post.getNormalizedWords(), std::vector<QString>({ "goodbye" }));
+        QCOMPARE(copy.getNormalizedWords(), std::vector<QString>({ "hello", "world" }));
+    }
+
+private:
+    Post createPost(const QString& text)
+    {
+        ATProto::Client client(nullptr);
+        ATProto::PostMaster pm(client);
+        auto postView = std::make_shared<ATProto::AppBskyFeed::PostView>();
+
+        pm.createPost(text, "", nullptr, {}, [postView](auto&& postRecord){
+            const auto json = postRecord->toJson();
+            postView->mRecordType = ATProto::RecordType::APP_BSKY_FEED_POST;
+            postView->mRecord = ATProto::AppBskyFeed::Record::Post::fromJson(json);
+            postView->mAuthor = std::make_shared<ATProto::AppBskyActor::ProfileViewBasic>();
+            postView->mAuthor->mDid = "did:plc:test";
+        });
+
+        return Post(postView);
+    }
+};
@@ -0,0 +1,264 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <post_filter.h>
+#include <post_filter_evaluator.h>
+#include <QtTest/QTest>
+#include <algorithm>
+
+using namespace Skywalker;
+using namespace std::chrono_literals;
+
+class TestPostFilterEvaluator : public QObject
+{
+    Q_OBJECT
+private slots:
+    void cleanup()
+    {
+        mNextPostId = 1;
+    }
+
+    void matchesPerFilter()
+    {
+        auto posts = getTimeline(40);
+        posts.insert(posts.begin() + 10, Post::createGapPlaceHolder("GAP"));
+        const auto filters = createFilters();
+        const auto filterPtrs = getFilterPtrs(filters);
+
+        PostFilterEvaluator evaluator(filterPtrs);
+        evaluator.evaluate(posts, 0, posts.size());
+        QCOMPARE(evaluator.getNumFilters(), (int)filters.size());
+
+        for (int i = 0; i < (int)filters.size(); ++i)
+            QCOMPARE(evaluator.getMatchedIndices(i), matchOneByOne(*filters[i], posts, 0, posts.size()));
+
+        // Author foo
+        QCOMPARE((int)evaluator.getMatchedIndices(0).size(), 31);
+
+        // Every filter has the gap
+        for (int i = 0; i < (int)filters.size(); ++i)
+        {
+            const auto& indices = evaluator.getMatchedIndices(i);
+            QVERIFY(std::find(indices.begin(), indices.end(), 10) != indices.end());
+        }
+    }
+
+    void evaluateRange()
+    {
+        const auto posts = getTimeline(20);
+        const auto filters = createFilters();
+        PostFilterEvaluator evaluator(getFilterPtrs(filters));
+        evaluator.evaluate(posts, 5, 10);
+
+        for (int i = 0; i < (int)filters.size(); ++i)
+        {
+            const auto& indices = evaluator.getMatchedIndices(i);
+            QCOMPARE(indices, matchOneByOne(*filters[i], posts, 5, 10));
+
+            for (int index : indices)
+                QVERIFY(index >= 5 && index < 15);
+        }
+
+        // A new evaluation replaces the previous result
+        evaluator.evaluate(posts, 0, 0);
+
+        for (int i = 0; i < (int)filters.size(); ++i)
+            QVERIFY(evaluator.getMatchedIndices(i).empty());
+    }
+
+    void moreFiltersThanMaskBits()
+    {
+        std::vector<IPostFilter::Ptr> filters;
+
+        for (int i = 0; i < 130; ++i)
+        {
+            const QString author = i % 2 == 0 ? "foo" : QString("author%1").arg(i);
+            filters.push_back(std::make_unique<AuthorPostFilter>(
+                BasicProfile("did:plc:" + author, author + ".bsky.social", "", "")));
+        }
+
+        const auto posts = getTimeline(8);
+        PostFilterEvaluator evaluator(getFilterPtrs(filters));
+        evaluator.evaluate(posts, 0, posts.size());
+
+        for (int i = 0; i < (int)filters.size(); ++i)
+        {
+            const auto& indices = evaluator.getMatchedIndices(i);
+            QCOMPARE(indices, matchOneByOne(*filters[i], posts, 0, posts.size()));
+            QCOMPARE(indices.empty(), i % 2 != 0);
+        }
+    }
+
+    void noFilters()
+    {
+        const auto posts = getTimeline(4);
+        PostFilterEvaluator evaluator(std::vector<const IPostFilter*>{});
+        evaluator.evaluate(posts, 0, posts.size());
+        QCOMPARE(evaluator.getNumFilters(), 0);
+    }
+
+    // Total cost of filtering a timeline page for 10 filtered views: each
+    // view matching every post with its own filter, compared to a single pass.
+    void benchmarkFilterPage_data()
+    {
+        QTest::addColumn<bool>("singlePass");
+        QTest::newRow("perModel") << false;
+        QTest::newRow("singlePass") << true;
+    }
+
+    void benchmarkFilterPage()
+    {
+        QFETCH(bool, singlePass);
+        const auto posts = getTimeline(1000);
+        const auto filters = createFilters();
+        const auto filterPtrs = getFilterPtrs(filters);
+        size_t matchCount = 0;
+
+        QBENCHMARK {
+            matchCount = 0;
+
+            if (singlePass)
+            {
+                PostFilterEvaluator evaluator(filterPtrs);
+                evaluator.evaluate(posts, 0, posts.size());
+
+                for (int i = 0; i < (int)filters.size(); ++i)
+                    matchCount += evaluator.getMatchedIndices(i).size();
+            }
+            else
+            {
+                for (const auto& filter : filters)
+                    matchCount += matchOneByOne(*filter, posts, 0, posts.size()).size();
+            }
+        }
+
+        qInfo() << (singlePass ? "Single pass" : "Per model") << "filters:" << filters.size()
+                << "posts:" << posts.size() << "matches:" << matchCount;
+        QVERIFY(matchCount > 0);
+    }
+
+private:
+    // A filter the evaluator cannot compile, matched with match()
+    class OddPostFilter : public IPostFilter
+    {
+    public:
+        QString getName() const override { return "odd"; }
+        bool match(const Post& post) const override { return !post.isPlaceHolder() && post.getCid().back().digitValue() % 2 == 1; }
+        QJsonObject toJson() const override { return {}; }
+    };
+
+    static constexpr char const* POST_TEMPLATE = R"##({
+        "post": {
+            "uri": "at://did:plc:foo/app.bsky.feed.post/r%1",
+            "cid": "cid%1",
+            "author": {
+                "did": "did:plc:%3",
+                "handle": "%3.bsky.social"
+            },
+            "record": {
+                "$type": "app.bsky.feed.post",
+                "text": "#%4 Hello world!",
+                "facets": [{
+                    "index": { "byteStart": 0, "byteEnd": %5 },
+                    "features": [{ "$type": "app.bsky.richtext.facet#tag", "tag": "%4" }]
+                }],
+                "createdAt": "%2"
+            },
+            "indexedAt": "%2"
+        }
+    })##";
+
+    const QDateTime TEST_DATE = QDateTime::fromString("2023-11-20T18:46:00.000Z", Qt::ISODateWithMs);
+    const QStringList TAGS = { "sky", "Blue", "cat", "dog", "SKYWALKER" };
+
+    static std::vector<IPostFilter::Ptr> createFilters()
+    {
+        std::vector<IPostFilter::Ptr> filters;
+        filters.push_back(std::make_unique<AuthorPostFilter>(BasicProfile("did:plc:foo", "foo.bsky.social", "", "")));
+        filters.push_back(std::make_unique<AuthorPostFilter>(BasicProfile("did:plc:bar", "bar.bsky.social", "", "")));
+        filters.push_back(std::make_unique<HashtagPostFilter>("#sky"));
+        filters.push_back(std::make_unique<HashtagPostFilter>("cat"));
+        filters.push_back(std::make_unique<HashtagPostFilter>("none"));
+
+        FocusHashtagEntry entry;
+        entry.addHashtag("blue");
+        entry.addHashtag("sky");
+        filters.push_back(std::make_unique<FocusHashtagsPostFilter>(entry));
+
+        FocusHashtagEntry entry2;
+        entry2.addHashtag("skywalker");
+        filters.push_back(std::make_unique<FocusHashtagsPostFilter>(entry2));
+
+        filters.push_back(std::make_unique<VideoPostFilter>());
+        filters.push_back(std::make_unique<MediaPostFilter>());
+        filters.push_back(std::make_unique<OddPostFilter>());
+        return filters;
+    }
+
+    static std::vector<const IPostFilter*> getFilterPtrs(const std::vector<IPostFilter::Ptr>& filters)
+    {
+        std::vector<const IPostFilter*> ptrs;
+
+        for (const auto& filter : filters)
+            ptrs.push_back(filter.get());
+
+        return ptrs;
+    }
+
+    // How FilteredPostFeedModel matched posts before the evaluator
+    static std::vector<int> matchOneByOne(const IPostFilter& filter, const std::deque<Post>& posts, int startIndex, size_t numPosts)
+    {
+        std::vector<int> indices;
+
+        for (int i = startIndex; i < startIndex + (int)numPosts; ++i)
+        {
+            if (posts[i].isGap() || filter.match(posts[i]))
+                indices.push_back(i);
+        }
+
+        return indices;
+    }
+
+    std::deque<Post> getTimeline(int numPosts)
+    {
+        std::deque<Post> timeline;
+        auto feed = getFeed(numPosts, TEST_DATE);
+
+        for (const auto& viewPost : feed->mFeed)
+            timeline.push_back(Post(viewPost));
+
+        return timeline;
+    }
+
+    ATProto::AppBskyFeed::OutputFeed::SharedPtr getFeed(int numPosts, QDateTime startTime)
+    {
+        QString feedData = R"###({ "feed": [)###";
+
+        for (int i = 1; i <= numPosts; ++i)
+        {
+            auto postTime = startTime - (i-1) * 1s;
+            const QString author = (i % 4) == 0 ? "bar" : "foo";
+            const QString& tag = TAGS[i % TAGS.size()];
+            QString postData = QString(POST_TEMPLATE).arg(QString::number(mNextPostId++),
+                                                          postTime.toString(Qt::ISODateWithMs),
+                                                          author, tag,
+                                                          QString::number(tag.size() + 1));
+            feedData += postData;
+
+            if (i < numPosts)
+                feedData += ',';
+        }
+
+        feedData += "]}";
+
+        QJsonParseError error;
+        auto json = QJsonDocument::fromJson(feedData.toUtf8(), &error);
+
+        if (error.error != QJsonParseError::NoError)
+            qFatal() << "Failed to parse json:" << error.errorString() << "offset:" << error.offset;
+
+        return ATProto::AppBskyFeed::OutputFeed::fromJson(json.object());
+    }
+
+    int mNextPostId = 1;
+};
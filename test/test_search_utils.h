@@ -1,7 +1,10 @@
 // Copyright (C) 2023 Michel de Boer
 // License: GPLv3
 #pragma once
+#include <ascii_text.h>
 #include <search_utils.h>
+#include <atproto/lib/rich_text_master.h>
+#include <QElapsedTimer>
 #include <QtTest/QTest>
 
 using namespace Skywalker;
@@ -50,4 +53,147 @@ private slots:
         QFETCH(std::vector<QString>, output);
         QCOMPARE(SearchUtils::getNormalizedWords(input), output);
     }
+
+    void asciiWords_data()
+    {
+        QTest::addColumn<QString>("input");
+        QTest::addColumn<bool>("fastPath");
+        QTest::newRow("sentence") << "The quick brown fox jumps over the lazy dog." << true;
+        QTest::newRow("apostrophe") << "Don't stop rock'n'roll 'quoted' it's" << true;
+        QTest::newRow("abbreviation") << "e.g. i.e. U.S.A. end." << true;
+        QTest::newRow("numbers") << "1,000,000 and 3.14 or 1.5.2; 7;8 12'34" << true;
+        QTest::newRow("letters and digits") << "abc123 123abc a1.2 1.a a.1 x2y" << true;
+        QTest::newRow("punctuation") << "hello...world!! (yes) [no] {x} a--b a-b" << true;
+        QTest::newRow("mid at edges") << ".start end. ,a a, 'a a' ''a a''" << true;
+        QTest::newRow("double mid") << "a..b a''b 1..2 1,,2 a.,b" << true;
+        QTest::newRow("whitespace") << "line1\nline2\r\nline3\ttab  two  spaces" << true;
+        QTest::newRow("tags") << "#hashtag @handle.bsky.social $cash 50% a&b" << true;
+        QTest::newRow("colon") << "Note: https://bsky.app/profile a:b 1:2 a:1 :a a::b" << true;
+        QTest::newRow("underscore") << "snake_case _lead trail_ __ a_1 1_a a_.b 1_,2" << true;
+        QTest::newRow("non-ascii") << "caf\u00e9 na\u00efve" << false;
+    }
+
+    void asciiWords()
+    {
+        QFETCH(QString, input);
+        QFETCH(bool, fastPath);
+        std::vector<QStringView> views;
+        QCOMPARE(AsciiText::getWords(input, views), fastPath);
+        QCOMPARE(SearchUtils::getWords(input), SearchUtils::getUnicodeWords(input));
+    }
+
+    void asciiNormalize_data()
+    {
+        QTest::addColumn<QString>("input");
+        QTest::newRow("empty") << "";
+        QTest::newRow("mixed case") << "Hello World, THIS is Skywalker 2025!";
+        QTest::newRow("all printable") << QString::fromLatin1(allPrintableAscii());
+        QTest::newRow("chunk tail") << "ABCDEFGHIJKLMNOPQRSTUVWXYZabc";
+    }
+
+    void asciiNormalize()
+    {
+        QFETCH(QString, input);
+        QCOMPARE(SearchUtils::normalizeText(input), ATProto::RichTextMaster::normalizeText(input));
+    }
+
+    void isAscii()
+    {
+        QVERIFY(AsciiText::isAscii(u""));
+        QVERIFY(AsciiText::isAscii(u"0123456789abcdefXYZ"));
+
+        // Non-ASCII in the vectorized part and in the tail
+        QString text(17, 'a');
+        QVERIFY(AsciiText::isAscii(text));
+        text[9] = QChar(0x80);
+        QVERIFY(!AsciiText::isAscii(text));
+        text[9] = 'a';
+        text[16] = QChar(0xFF41);
+        QVERIFY(!AsciiText::isAscii(text));
+
+        QString lower;
+        QVERIFY(!AsciiText::toLower(text, lower));
+    }
+
+    // Throughput of normalizing and word splitting post texts in MB/s (UTF-16
+    // bytes), ASCII fast path compared to the full Unicode path.
+    void benchmarkWordsThroughput()
+    {
+        const QStringList texts = postTexts();
+        qint64 bytes = 0;
+
+        for (const auto& text : texts)
+            bytes += text.size() * sizeof(QChar);
+
+        const auto fastWords = [](const QString& text){
+            return SearchUtils::getWords(SearchUtils::normalizeText(text));
+        };
+
+        const auto unicodeWords = [](const QString& text){
+            return SearchUtils::getUnicodeWords(ATProto::RichTextMaster::normalizeText(text));
+        };
+
+        const double fastMBs = measureThroughput(texts, bytes, fastWords);
+        const double unicodeMBs = measureThroughput(texts, bytes, unicodeWords);
+        qInfo() << "Words throughput ASCII:" << fastMBs << "MB/s Unicode:" << unicodeMBs << "MB/s";
+
+        for (const auto& text : texts)
+            QCOMPARE(fastWords(text), unicodeWords(text));
+    }
+
+private:
+    static QByteArray allPrintableAscii()
+    {
+        QByteArray chars;
+
+        for (char c = ' '; c < 127; ++c)
+            chars += c;
+
+        return chars;
+    }
+
+    static QStringList postTexts()
+    {
+        static const char* SENTENCES[] = {
+            "Just finished reading a great book about the history of the internet.",
+            "Can't believe it's already October, where did 2025 go?",
+            "The new release is out: version 2.5.1 has 1,200 fixes, e.g. the crash on startup.",
+            "Anyone else watching the game tonight? #football @friend.bsky.social",
+            "Coffee first. Then everything else...",
+            "Rock'n'roll never dies! Saw the band live yesterday, what a show!!"
+        };
+
+        QStringList texts;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            QString text;
+
+            for (int j = 0; j <= i % 4; ++j)
+                text += QString(SENTENCES[(i + j) % std::size(SENTENCES)]) + ' ';
+
+            texts.push_back(text);
+        }
+
+        return texts;
+    }
+
+    template<typename WordsFun>
+    static double measureThroughput(const QStringList& texts, qint64 bytes, WordsFun wordsFun)
+    {
+        static constexpr int ROUNDS = 5;
+        QElapsedTimer timer;
+        timer.start();
+        qsizetype wordCount = 0;
+
+        for (int i = 0; i < ROUNDS; ++i)
+        {
+            for (const auto& text : texts)
+                wordCount += wordsFun(text).size();
+        }
+
+        const double seconds = std::max(timer.nsecsElapsed(), qint64(1)) / 1e9;
+        qDebug() << "Words:" << wordCount;
+        return (bytes * ROUNDS) / seconds / (1024.0 * 1024.0);
+    }
 };
@@ -0,0 +1,120 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <startup_tracer.h>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestStartupTracer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init()
+    {
+        StartupTracer::instance().setEnabled(true);
+        StartupTracer::instance().clear();
+    }
+
+    void cleanupTestCase()
+    {
+        StartupTracer::instance().setEnabled(false);
+        StartupTracer::instance().clear();
+    }
+
+    void disabled()
+    {
+        StartupTracer::instance().setEnabled(false);
+        StartupTracer::beginPhase("login");
+        StartupTracer::endPhase("login");
+        QVERIFY(StartupTracer::instance().getPhases().empty());
+    }
+
+    void phases()
+    {
+        StartupTracer::beginPhase("login");
+        QTest::qWait(2);
+        StartupTracer::endPhase("login");
+        StartupTracer::beginPhase("getUserProfile", { "login", "resumeSession" });
+        StartupTracer::beginPhase("getUserProfile"); // ignored
+
+        const auto phases = StartupTracer::instance().getPhases();
+        QCOMPARE((int)phases.size(), 2);
+        QCOMPARE(QString(phases[0].mName), QString("login"));
+        QVERIFY(phases[0].isFinished());
+        QVERIFY(phases[0].mEndNs - phases[0].mStartNs >= 2000000);
+        QCOMPARE(QString(phases[1].mName), QString("getUserProfile"));
+        QVERIFY(!phases[1].isFinished());
+        QVERIFY(phases[1].mStartNs >= phases[0].mEndNs);
+        QCOMPARE((int)phases[1].mDependsOn.size(), 1); // resumeSession not recorded
+        QCOMPARE(QString(phases[1].mDependsOn[0]), QString("login"));
+    }
+
+    void criticalPath()
+    {
+        StartupTracer::beginPhase("prefs");
+        StartupTracer::beginPhase("fonts");
+        StartupTracer::endPhase("fonts");
+        QTest::qWait(2);
+        StartupTracer::endPhase("prefs");
+        StartupTracer::beginPhase("timeline", { "fonts", "prefs" });
+        StartupTracer::endPhase("timeline");
+
+        QCOMPARE(StartupTracer::instance().getCriticalPath(), QStringList({ "prefs", "timeline" }));
+        QCOMPARE(StartupTracer::instance().getCriticalPath("fonts"), QStringList({ "fonts" }));
+
+        // Concurrent phases are on different lanes.
+        const auto phases = StartupTracer::instance().getPhases();
+        QVERIFY(phases[0].mLane != phases[1].mLane);
+        QCOMPARE(phases[2].mLane, 0);
+    }
+
+    void chromeTrace()
+    {
+        StartupTracer::beginPhase("login");
+        StartupTracer::endPhase("login");
+        StartupTracer::beginPhase("getUserProfile", { "login" });
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString fileName = dir.filePath("trace.json");
+        QVERIFY(StartupTracer::instance().save(fileName));
+
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::ReadOnly));
+        QJsonParseError error;
+        const auto doc = QJsonDocument::fromJson(file.readAll(), &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+
+        const QJsonArray events = doc.object()["traceEvents"].toArray();
+        QCOMPARE(events.size(), 4); // 2 phases, flow start and end
+        const QJsonObject login = events[0].toObject();
+        QCOMPARE(login["name"].toString(), QString("login"));
+        QCOMPARE(login["ph"].toString(), QString("X"));
+        QVERIFY(login["dur"].toDouble() >= 0.0);
+        const QJsonObject profile = events[1].toObject();
+        QCOMPARE(profile["name"].toString(), QString("getUserProfile"));
+        QVERIFY(profile["args"].toObject()["unfinished"].toBool());
+        QCOMPARE(profile["args"].toObject()["dependsOn"].toArray().first().toString(), QString("login"));
+        QCOMPARE(events[2].toObject()["ph"].toString(), QString("s"));
+        QCOMPARE(events[3].toObject()["ph"].toString(), QString("f"));
+        QCOMPARE(events[2].toObject()["id"].toInt(), events[3].toObject()["id"].toInt());
+    }
+
+    void benchmarkDisabled()
+    {
+        StartupTracer::instance().setEnabled(false);
+
+        QBENCHMARK {
+            for (int i = 0; i < 1000; ++i)
+            {
+                StartupTracer::beginPhase("phase", { "dependency" });
+                StartupTracer::endPhase("phase");
+            }
+        }
+    }
+};
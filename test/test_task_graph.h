@@ -0,0 +1,235 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <task_graph.h>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestTaskGraph : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty()
+    {
+        TaskGraph graph;
+        bool finished = false;
+        graph.run([&finished]{ finished = true; }, {});
+        QVERIFY(finished);
+    }
+
+    void synchronous()
+    {
+        TaskGraph graph;
+        QStringList order;
+        graph.addTask("a", {}, syncTask(order, "a"));
+        graph.addTask("b", { "a" }, syncTask(order, "b"));
+        graph.addTask("c", { "a", "b" }, syncTask(order, "c"));
+        graph.addTask("d", {}, syncTask(order, "d"));
+
+        bool finished = false;
+        graph.run([&finished]{ finished = true; }, {});
+        QVERIFY(finished);
+        QVERIFY(graph.isFinished());
+        QCOMPARE(order, QStringList({ "a", "b", "c", "d" }));
+    }
+
+    void concurrent()
+    {
+        TaskGraph graph;
+        QStringList started;
+        QStringList done;
+        graph.addTask("slow", {}, delayedTask(started, done, "slow", 50));
+        graph.addTask("fast", {}, delayedTask(started, done, "fast", 10));
+        graph.addTask("last", { "slow", "fast" }, delayedTask(started, done, "last", 0));
+
+        bool finished = false;
+        graph.run([&finished]{ finished = true; }, {});
+
+        // Independent tasks start together
+        QCOMPARE(started, QStringList({ "slow", "fast" }));
+        QVERIFY(!graph.isDone("slow"));
+
+        QTRY_VERIFY(finished);
+        QCOMPARE(done, QStringList({ "fast", "slow", "last" }));
+        QCOMPARE(started.back(), QString("last"));
+    }
+
+    void missingPrerequisite()
+    {
+        TaskGraph graph;
+        QStringList order;
+        graph.addTask("a", { "optional" }, syncTask(order, "a"));
+
+        bool finished = false;
+        graph.run([&finished]{ finished = true; }, {});
+        QVERIFY(finished);
+        QCOMPARE(order, QStringList({ "a" }));
+    }
+
+    void failure()
+    {
+        TaskGraph graph;
+        QStringList order;
+        TaskGraph::DoneCb slowDone;
+        graph.addTask("slow", {}, [&slowDone](const auto& done, const auto&){ slowDone = done; });
+        graph.addTask("bad", {}, [](const auto&, const auto& fail){ fail("boom"); });
+        graph.addTask("after", { "slow" }, syncTask(order, "after"));
+
+        QString failedTask;
+        QString failedError;
+        int failCount = 0;
+
+        graph.run([]{ QFAIL("Graph should fail"); },
+            [&](const char* task, const QString& error){
+                failedTask = task;
+                failedError = error;
+                ++failCount;
+            });
+
+        QVERIFY(graph.isFailed());
+        QCOMPARE(failedTask, QString("bad"));
+        QCOMPARE(failedError, QString("boom"));
+
+        // Results after the failure are ignored
+        slowDone();
+        QVERIFY(order.empty());
+        QVERIFY(!graph.isDone("slow"));
+        QCOMPARE(failCount, 1);
+    }
+
+    void cancel()
+    {
+        TaskGraph graph;
+        QStringList order;
+        TaskGraph::DoneCb firstDone;
+        graph.addTask("first", {}, [&firstDone](const auto& done, const auto&){ firstDone = done; });
+        graph.addTask("second", { "first" }, syncTask(order, "second"));
+        graph.run([]{ QFAIL("Graph is canceled"); }, {});
+
+        graph.cancel();
+        firstDone();
+        QVERIFY(graph.isCanceled());
+        QVERIFY(order.empty());
+    }
+
+    void deleteInCallback()
+    {
+        auto* graph = new TaskGraph;
+        QPointer<TaskGraph> guard(graph);
+        QStringList order;
+        graph->addTask("a", {}, syncTask(order, "a"));
+        graph->addTask("b", {}, syncTask(order, "b"));
+        graph->run([graph]{ delete graph; }, {});
+        QVERIFY(!guard);
+        QCOMPARE(order, QStringList({ "a", "b" }));
+    }
+
+    void doneAfterDelete()
+    {
+        TaskGraph::DoneCb doneCb;
+
+        {
+            TaskGraph graph;
+            graph.addTask("a", {}, [&doneCb](const auto& done, const auto&){ doneCb = done; });
+            graph.run({}, {});
+        }
+
+        doneCb(); // must not crash
+    }
+
+    // Startup shaped graph with simulated network latencies compared to
+    // loading the same data one after the other.
+    void startupLatency()
+    {
+        const std::vector<std::pair<const char*, int>> latencies = {
+            { "getUserProfile", 3 },
+            { "getUserPreferences", 3 },
+            { "loadLabelSettings", 4 },
+            { "loadMutedReposts", 3 },
+            { "loadTimelineHide", 6 },
+            { "loadContentFilterPolicies", 3 },
+            { "syncTimeline", 6 }
+        };
+
+        const auto latency = [&latencies](const char* name){
+            for (const auto& [task, units] : latencies)
+            {
+                if (qstrcmp(task, name) == 0)
+                    return units * UNIT_MS;
+            }
+
+            return 0;
+        };
+
+        QStringList started;
+        QStringList done;
+
+        // Serial: each task waits for the previous one
+        TaskGraph serial;
+        const char* previous = nullptr;
+
+        for (const auto& [task, units] : latencies)
+        {
+            serial.addTask(task, previous ? std::vector<const char*>{ previous } : std::vector<const char*>{},
+                           delayedTask(started, done, task, units * UNIT_MS));
+            previous = task;
+        }
+
+        const qint64 serialMs = runTimed(serial);
+
+        TaskGraph graph;
+        graph.addTask("getUserProfile", {}, delayedTask(started, done, "getUserProfile", latency("getUserProfile")));
+        graph.addTask("getUserPreferences", {}, delayedTask(started, done, "getUserPreferences", latency("getUserPreferences")));
+        graph.addTask("loadLabelSettings", { "getUserPreferences" }, delayedTask(started, done, "loadLabelSettings", latency("loadLabelSettings")));
+        graph.addTask("loadContentFilterPolicies", { "loadLabelSettings" }, delayedTask(started, done, "loadContentFilterPolicies", latency("loadContentFilterPolicies")));
+        graph.addTask("loadMutedReposts", {}, delayedTask(started, done, "loadMutedReposts", latency("loadMutedReposts")));
+        graph.addTask("loadTimelineHide", {}, delayedTask(started, done, "loadTimelineHide", latency("loadTimelineHide")));
+        graph.addTask("syncTimeline", { "getUserPreferences", "loadContentFilterPolicies", "loadMutedReposts", "loadTimelineHide" },
+                      delayedTask(started, done, "syncTimeline", latency("syncTimeline")));
+
+        const qint64 graphMs = runTimed(graph);
+
+        qInfo() << "Login to first timeline page, serial:" << serialMs << "ms graph:" << graphMs << "ms";
+        QVERIFY(serialMs >= 28 * UNIT_MS);
+        QVERIFY(graphMs < serialMs * 3 / 4);
+    }
+
+private:
+    static constexpr int UNIT_MS = 20;
+
+    static TaskGraph::TaskFn syncTask(QStringList& order, const QString& name)
+    {
+        return [&order, name](const auto& done, const auto&){
+            order.push_back(name);
+            done();
+        };
+    }
+
+    static TaskGraph::TaskFn delayedTask(QStringList& started, QStringList& done, const QString& name, int ms)
+    {
+        return [&started, &done, name, ms](const TaskGraph::DoneCb& doneCb, const auto&){
+            started.push_back(name);
+            QTimer::singleShot(ms, [&done, name, doneCb]{
+                done.push_back(name);
+                doneCb();
+            });
+        };
+    }
+
+    static qint64 runTimed(TaskGraph& graph)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        bool finished = false;
+        graph.run([&finished]{ finished = true; }, {});
+
+        if (!QTest::qWaitFor([&finished]{ return finished; }, 10000))
+            qWarning() << "Timeout";
+
+        return timer.elapsed();
+    }
+};
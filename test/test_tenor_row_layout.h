@@ -0,0 +1,221 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <tenor_gif_overview_model.h>
+#include <tenor_row_layout.h>
+#include <QSignalSpy>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestTenorRowLayout : public QObject
+{
+    Q_OBJECT
+private slots:
+    void fullRowsFillWidth()
+    {
+        TenorRowLayout layout(300, 4);
+        layout.addGifs(createSizes(0, 100));
+        int nextGif = 0;
+
+        for (int i = 0; i < (int)layout.getRows().size(); ++i)
+        {
+            const auto& row = layout.getRows()[i];
+            QCOMPARE(row.mFirstGif, nextGif);
+            nextGif += row.mGifCount;
+
+            const auto sizes = layout.getGifSizes(i);
+            QCOMPARE((int)sizes.size(), row.mGifCount);
+            int width = (row.mGifCount - 1) * 4;
+
+            for (const auto& size : sizes)
+            {
+                QCOMPARE(size.height(), layout.getRowHeight(i));
+                width += size.width();
+            }
+
+            if (row.mFull)
+                QCOMPARE(width, 300);
+            else
+                QVERIFY(width < 300);
+        }
+
+        QCOMPARE(nextGif, 100);
+
+        for (int i = 0; i < (int)layout.getRows().size() - 1; ++i)
+            QVERIFY(layout.getRows()[i].mFull);
+    }
+
+    void appendKeepsEarlierRows()
+    {
+        TenorRowLayout layout(300, 4);
+
+        for (int page = 0; page < 10; ++page)
+        {
+            const auto rowsBefore = layout.getRows();
+            const auto append = layout.prepareAppend(createSizes(page * 7, 7));
+            const int firstChangedRow = rowsBefore.empty() || rowsBefore.back().mFull ?
+                    (int)rowsBefore.size() : (int)rowsBefore.size() - 1;
+            QCOMPARE(append.mFirstRow, firstChangedRow);
+
+            layout.commitAppend(createSizes(page * 7, 7), append);
+
+            for (int i = 0; i < firstChangedRow; ++i)
+                QVERIFY(sameRow(layout.getRows()[i], rowsBefore[i]));
+        }
+
+        TenorRowLayout expected(300, 4);
+        expected.addGifs(createSizes(0, 70));
+        QVERIFY(sameLayout(layout, expected));
+    }
+
+    void modelAddGifs()
+    {
+        TenorOverviewModel model(300, 4);
+        QSignalSpy insertedSpy(&model, &TenorOverviewModel::rowsInserted);
+        QSignalSpy removedSpy(&model, &TenorOverviewModel::rowsRemoved);
+        QSignalSpy changedSpy(&model, &TenorOverviewModel::dataChanged);
+
+        model.addGifs(createGifs(0, 5));
+        const int rowCount = model.rowCount();
+        QVERIFY(rowCount > 0);
+        QCOMPARE(insertedSpy.count(), 1);
+        QCOMPARE(changedSpy.count(), 0);
+
+        model.addGifs(createGifs(5, 5));
+        QVERIFY(model.rowCount() >= rowCount);
+        QCOMPARE(removedSpy.count(), 0);
+
+        // Only the open last row may change
+        for (const auto& args : changedSpy)
+        {
+            QCOMPARE(args[0].value<QModelIndex>().row(), rowCount - 1);
+            QCOMPARE(args[1].value<QModelIndex>().row(), rowCount - 1);
+        }
+
+        const auto row = model.data(model.index(0), int(TenorOverviewModel::Role::PreviewRow)).value<TenorGifList>();
+        QVERIFY(!row.empty());
+        QCOMPARE(row.front().getId(), QString("gif0"));
+        QCOMPARE(model.data(model.index(0), int(TenorOverviewModel::Role::PreviewRowSpacing)).toInt(), 4);
+    }
+
+    void modelReflow()
+    {
+        TenorOverviewModel model(300, 4);
+        model.addGifs(createGifs(0, 50));
+        QSignalSpy reflowedSpy(&model, &TenorOverviewModel::reflowed);
+
+        model.setMaxRowWidth(500);
+        QVERIFY(model.isReflowing());
+
+        // Added during the reflow
+        model.addGifs(createGifs(50, 10));
+        QTRY_COMPARE(reflowedSpy.count(), 1);
+        QVERIFY(!model.isReflowing());
+
+        TenorRowLayout expected(500, 4);
+        expected.addGifs(createSizes(0, 60));
+        QCOMPARE(model.rowCount(), (int)expected.getRows().size());
+
+        for (int i = 0; i < model.rowCount(); ++i)
+        {
+            const auto row = model.data(model.index(i), int(TenorOverviewModel::Role::PreviewRow)).value<TenorGifList>();
+            const auto sizes = expected.getGifSizes(i);
+            QCOMPARE(row.size(), (qsizetype)sizes.size());
+
+            for (int j = 0; j < row.size(); ++j)
+                QCOMPARE(row[j].getOverviewSize(), sizes[j]);
+        }
+    }
+
+    void modelReflowOutdated()
+    {
+        TenorOverviewModel model(300, 4);
+        model.addGifs(createGifs(0, 50));
+        QSignalSpy reflowedSpy(&model, &TenorOverviewModel::reflowed);
+
+        // Only the last reflow gets applied
+        model.setMaxRowWidth(400);
+        model.setMaxRowWidth(500);
+        model.setSpacing(2);
+        QTRY_COMPARE(reflowedSpy.count(), 1);
+        QTest::qWait(50);
+        QCOMPARE(reflowedSpy.count(), 1);
+
+        TenorRowLayout expected(500, 2);
+        expected.addGifs(createSizes(0, 50));
+        QCOMPARE(model.rowCount(), (int)expected.getRows().size());
+
+        // A reflow in progress is dropped by clear
+        model.setMaxRowWidth(300);
+        model.clear();
+        QTest::qWait(50);
+        QCOMPARE(reflowedSpy.count(), 1);
+        QCOMPARE(model.rowCount(), 0);
+    }
+
+    void benchmarkAddPages()
+    {
+        const int pageSize = 50;
+        const int pageCount = 40;
+        std::vector<std::vector<QSize>> pages;
+
+        for (int i = 0; i < pageCount; ++i)
+            pages.push_back(createSizes(i * pageSize, pageSize));
+
+        QBENCHMARK {
+            TenorRowLayout layout(400, 4);
+
+            for (const auto& page : pages)
+                layout.addGifs(page);
+
+            QVERIFY(layout.getGifCount() == pageSize * pageCount);
+        }
+    }
+
+private:
+    static std::vector<QSize> createSizes(int first, int count)
+    {
+        std::vector<QSize> sizes;
+
+        for (int i = first; i < first + count; ++i)
+            sizes.emplace_back(100 + (i * 37) % 200, 80 + (i * 53) % 150);
+
+        return sizes;
+    }
+
+    static TenorGifList createGifs(int first, int count)
+    {
+        TenorGifList gifs;
+
+        for (const auto& size : createSizes(first, count))
+        {
+            const QString id = QString("gif%1").arg(first + gifs.size());
+            const QString url = QString("https://media.tenor.com/%1.gif").arg(id);
+            gifs.append(TenorGif(id, id, "", url, size * 2, url, size, url, size));
+        }
+
+        return gifs;
+    }
+
+    static bool sameRow(const TenorRowLayout::Row& lhs, const TenorRowLayout::Row& rhs)
+    {
+        return lhs.mFirstGif == rhs.mFirstGif && lhs.mGifCount == rhs.mGifCount &&
+               lhs.mAspectSum == rhs.mAspectSum && lhs.mMinHeight == rhs.mMinHeight &&
+               lhs.mFull == rhs.mFull;
+    }
+
+    static bool sameLayout(const TenorRowLayout& lhs, const TenorRowLayout& rhs)
+    {
+        if (lhs.getRows().size() != rhs.getRows().size())
+            return false;
+
+        for (int i = 0; i < (int)lhs.getRows().size(); ++i)
+        {
+            if (!sameRow(lhs.getRows()[i], rhs.getRows()[i]))
+                return false;
+        }
+
+        return true;
+    }
+};
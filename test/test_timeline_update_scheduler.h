@@ -0,0 +1,69 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <timeline_update_scheduler.h>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestTimelineUpdateScheduler : public QObject
+{
+    Q_OBJECT
+private slots:
+    void defaultInterval()
+    {
+        TimelineUpdateScheduler scheduler;
+        QCOMPARE(scheduler.getInterval(), TimelineUpdateScheduler::DEFAULT_INTERVAL);
+    }
+
+    void highPostRate()
+    {
+        TimelineUpdateScheduler scheduler;
+        const QDateTime start(QDate(2025, 6, 1), QTime(12, 0));
+        scheduler.prependDone(50, start);
+        scheduler.prependDone(100, start.addSecs(60));
+        QCOMPARE(scheduler.getPostsPerMinute(), 100.0);
+        QCOMPARE(scheduler.getInterval(), TimelineUpdateScheduler::MIN_INTERVAL);
+    }
+
+    void lowPostRate()
+    {
+        TimelineUpdateScheduler scheduler;
+        const QDateTime start(QDate(2025, 6, 1), QTime(12, 0));
+        scheduler.prependDone(50, start);
+        scheduler.prependDone(5, start.addSecs(600));
+        QCOMPARE(scheduler.getInterval(), TimelineUpdateScheduler::MAX_INTERVAL);
+    }
+
+    void emptyProbeBackoff()
+    {
+        TimelineUpdateScheduler scheduler;
+        const QDateTime start(QDate(2025, 6, 1), QTime(12, 0));
+        scheduler.prependDone(50, start);
+        scheduler.prependDone(15, start.addSecs(60));
+        const auto interval = scheduler.getInterval();
+        QCOMPARE(interval, std::chrono::seconds(60));
+
+        scheduler.probeDone(false, start.addSecs(120));
+        QVERIFY(scheduler.getInterval() > interval);
+        QCOMPARE(scheduler.getStats().mEmptyProbes, 1);
+
+        scheduler.probeDone(true, start.addSecs(180));
+        QCOMPARE(scheduler.getInterval(), interval);
+    }
+
+    void meteredAndInactive()
+    {
+        TimelineUpdateScheduler scheduler;
+        const auto interval = scheduler.getInterval();
+
+        scheduler.setMetered(true);
+        QVERIFY(scheduler.getInterval() > interval);
+        QVERIFY(scheduler.getInterval() >= TimelineUpdateScheduler::METERED_MIN_INTERVAL);
+
+        scheduler.setMetered(false);
+        scheduler.setAppActive(false);
+        QVERIFY(scheduler.getInterval() > interval);
+        QVERIFY(scheduler.getInterval() <= TimelineUpdateScheduler::MAX_INTERVAL);
+    }
+};
@@ -2,6 +2,7 @@
 // License: GPLv3
 #pragma once
 #include <uri_with_expiry.h>
+#include <QSignalSpy>
 #include <QtTest/QTest>
 
 using namespace Skywalker;
@@ -131,4 +132,46 @@ private slots:
         uriSet.fromJson(json);
         QCOMPARE(*uriSet.getFirstExpiry(), bar);
     }
+
+    void expired()
+    {
+        UriWithExpirySet uriSet;
+        QSignalSpy expiredSpy(&uriSet, &UriWithExpirySet::expired);
+        const auto now = QDateTime::currentDateTimeUtc();
+        uriSet.insert(UriWithExpiry("foo", now.addMSecs(200)));
+        uriSet.insert(UriWithExpiry("bar", now.addMSecs(50)));
+        uriSet.insert(UriWithExpiry("sky", now.addDays(1)));
+
+        QTRY_COMPARE(expiredSpy.count(), 1);
+        QCOMPARE(expiredSpy.takeFirst().first().toString(), "bar");
+        uriSet.remove("bar");
+
+        QTRY_COMPARE(expiredSpy.count(), 1);
+        QCOMPARE(expiredSpy.takeFirst().first().toString(), "foo");
+        uriSet.remove("foo");
+
+        QTest::qWait(100);
+        QCOMPARE(expiredSpy.count(), 0);
+    }
+
+    void inactive()
+    {
+        UriWithExpirySet uriSet;
+        QSignalSpy expiredSpy(&uriSet, &UriWithExpirySet::expired);
+        uriSet.setActive(false);
+        uriSet.insert(UriWithExpiry("foo", QDateTime::currentDateTimeUtc().addMSecs(50)));
+
+        QTest::qWait(100);
+        QCOMPARE(expiredSpy.count(), 0);
+
+        // Expired while not active
+        uriSet.setActive(true);
+        QTRY_COMPARE(expiredSpy.count(), 1);
+        QCOMPARE(expiredSpy.takeFirst().first().toString(), "foo");
+
+        // No retry while not active
+        const int scheduled = ExpiryScheduler::instance().size();
+        uriSet.setActive(false);
+        QCOMPARE(ExpiryScheduler::instance().size(), scheduled - 1);
+    }
 };
@@ -0,0 +1,126 @@
+// Copyright (C) 2025 Michel de Boer
+// License: GPLv3
+#pragma once
+#include <profile.h>
+#include <viewer_cache.h>
+#include <QtTest/QTest>
+
+using namespace Skywalker;
+
+class TestViewerCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init()
+    {
+        mCache = std::make_unique<ViewerCache<BasicProfile>>("test", 100000,
+            [](const QString&, const BasicProfile&){ return 100; },
+            [](const BasicProfile&){ return 50; },
+            [](const BasicProfile& author, const BasicProfile& viewerSource){ return author.withViewer(viewerSource.getViewer()); },
+            [](const BasicProfile& author){ return author.getViewer().isValid(); });
+    }
+
+    void cleanup()
+    {
+        mCache = nullptr;
+    }
+
+    void switchViewer()
+    {
+        mCache->setViewer(ALICE);
+        mCache->put(SKY, createProfile("Sky", "at://alice/follow/1"));
+        QCOMPARE(mCache->get(SKY)->getViewer().getFollowing(), QString("at://alice/follow/1"));
+
+        // Profile is warm for bob, without the viewer state of alice
+        mCache->setViewer(BOB);
+        QVERIFY(mCache->contains(SKY));
+        QCOMPARE(mCache->get(SKY)->getDisplayName(), QString("Sky"));
+        QVERIFY(!mCache->get(SKY)->getViewer().isFollowing());
+
+        mCache->put(SKY, createProfile("Sky", "at://bob/follow/2"));
+        QCOMPARE(mCache->get(SKY)->getViewer().getFollowing(), QString("at://bob/follow/2"));
+
+        mCache->setViewer(ALICE);
+        QCOMPARE(mCache->get(SKY)->getViewer().getFollowing(), QString("at://alice/follow/1"));
+        QCOMPARE(mCache->size(), 1);
+        QCOMPARE(mCache->overlaySize(), 2);
+    }
+
+    void nonActiveViewer()
+    {
+        mCache->setViewer(ALICE);
+        mCache->put(SKY, createProfile("Sky", "at://bob/follow/2"), BOB);
+        QCOMPARE(mCache->get(SKY)->getDisplayName(), QString("Sky"));
+        QVERIFY(!mCache->get(SKY)->getViewer().isFollowing());
+
+        mCache->setViewer(BOB);
+        QCOMPARE(mCache->get(SKY)->getViewer().getFollowing(), QString("at://bob/follow/2"));
+    }
+
+    void updateSharedData()
+    {
+        mCache->setViewer(ALICE);
+        mCache->put(SKY, createProfile("Sky", "at://alice/follow/1"));
+
+        // New data without viewer state keeps the viewer state of alice
+        mCache->setViewer(BOB);
+        mCache->put(SKY, BasicProfile(SKY, "sky.bsky.social", "Blue Sky", ""));
+
+        mCache->setViewer(ALICE);
+        QCOMPARE(mCache->get(SKY)->getDisplayName(), QString("Blue Sky"));
+        QCOMPARE(mCache->get(SKY)->getViewer().getFollowing(), QString("at://alice/follow/1"));
+    }
+
+    void removeViewer()
+    {
+        mCache->setViewer(ALICE);
+        mCache->put(SKY, createProfile("Sky", "at://alice/follow/1"));
+        mCache->removeViewer(ALICE);
+        QCOMPARE(mCache->overlaySize(), 0);
+        QVERIFY(mCache->get(SKY));
+        QVERIFY(!mCache->get(SKY)->getViewer().isFollowing());
+    }
+
+    void evictOverlay()
+    {
+        mCache = std::make_unique<ViewerCache<BasicProfile>>("test", 3000,
+            [](const QString&, const BasicProfile&){ return 100; },
+            [](const BasicProfile&){ return 1500; },
+            [](const BasicProfile& author, const BasicProfile& viewerSource){ return author.withViewer(viewerSource.getViewer()); },
+            [](const BasicProfile& author){ return author.getViewer().isValid(); });
+
+        mCache->setViewer(ALICE);
+        mCache->put(SKY, createProfile("Sky", "at://alice/follow/1"));
+        mCache->put(OTHER, createProfile("Other", "at://alice/follow/2"));
+
+        // The overlay of sky is evicted, sky must not show up as not followed
+        QCOMPARE(mCache->overlaySize(), 1);
+        QVERIFY(!mCache->contains(SKY));
+        QVERIFY(!mCache->get(SKY));
+        QCOMPARE(mCache->get(OTHER)->getViewer().getFollowing(), QString("at://alice/follow/2"));
+    }
+
+    void withViewerCopies()
+    {
+        const BasicProfile profile = createProfile("Sky", "at://alice/follow/1");
+        const BasicProfile stripped = profile.withViewer({});
+        QVERIFY(!stripped.getViewer().isValid());
+        QCOMPARE(profile.getViewer().getFollowing(), QString("at://alice/follow/1"));
+        QCOMPARE(stripped.getDisplayName(), QString("Sky"));
+    }
+
+private:
+    static constexpr char const* ALICE = "did:plc:alice";
+    static constexpr char const* BOB = "did:plc:bob";
+    static constexpr char const* SKY = "did:plc:sky";
+    static constexpr char const* OTHER = "did:plc:other";
+
+    static BasicProfile createProfile(const QString& displayName, const QString& followingUri)
+    {
+        BasicProfile profile(SKY, "sky.bsky.social", displayName, "");
+        profile.setViewer(followingUri);
+        return profile;
+    }
+
+    std::unique_ptr<ViewerCache<BasicProfile>> mCache;
+};